@@ -8,16 +8,23 @@
 #include "Misc/Paths.h"
 #include "Misc/ScopeLock.h"
 #include "AssetRegistryPrivate.h"
-#include "NameTableArchive.h"
 #include "PackageReader.h"
 #include "AssetRegistry.h"
 #include "Async/ParallelFor.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/Thread.h"
+#include "Misc/Parse.h"
+#include <atomic>
 
 namespace AssetDataGathererConstants
 {
-	static const int32 CacheSerializationVersion = 15;
+	static const int32 CacheSerializationVersion = 16;
 	static const int32 MaxFilesToDiscoverBeforeFlush = 2500;
 	static const int32 MaxFilesToGatherBeforeFlush = 250;
+	static const int32 MaxQueuedFilesPerParser = 64;
+	static const uint32 MaxMillisecondsToWaitForParsers = 10;
 	static const int32 MinSecondsToElapseBeforeCacheWrite = 60;
 }
 
@@ -48,6 +55,164 @@ namespace
 	}
 }
 
+static int32 GAssetGathererParserThreads = 0;
+static FAutoConsoleVariableRef CVarAssetGathererParserThreads(
+	TEXT("AssetRegistry.GathererParserThreads"),
+	GAssetGathererParserThreads,
+	TEXT("Number of threads reading package headers in an asynchronous asset gather, read when the gather starts. 0 uses one less than the number of cores. -AssetGathererThreads=N overrides it."));
+
+namespace AssetDataGathererUtil
+{
+	/** Number of threads reading package headers for an asynchronous gather, can be overridden with -AssetGathererThreads=N */
+	static int32 GetNumParserThreads()
+	{
+		int32 NumThreads = GAssetGathererParserThreads > 0 ? GAssetGathererParserThreads : FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1, 1, 32);
+		FParse::Value(FCommandLine::Get(), TEXT("-AssetGathererThreads="), NumThreads);
+		return FMath::Max(NumThreads, 1);
+	}
+}
+
+/**
+ * A discovered package file being gathered, along with the results of reading it
+ */
+struct FPackageReadContext
+{
+	FPackageReadContext(FName InPackageName, FName InExtension, const FDiscoveredPackageFile& InAssetFileData)
+		: PackageName(InPackageName)
+		, Extension(InExtension)
+		, AssetFileData(InAssetFileData)
+	{
+	}
+
+	FName PackageName;
+	FName Extension;
+	FDiscoveredPackageFile AssetFileData;
+	TArray<FAssetData*> AssetDataFromFile;
+	FPackageDependencyData DependencyData;
+	TArray<FString> CookedPackageNamesWithoutAssetData;
+
+	/** Up to date cached data for the package if it did not need to be read, deserialized from the disk cache until its results are merged */
+	TUniquePtr<FDiskCachedAssetData> CachedAssetData;
+
+	bool bCanAttemptAssetRetry = false;
+	bool bResult = false;
+
+	/** Set once the results above can be read by the gatherer thread */
+	std::atomic<bool> bDone{ false };
+};
+
+/**
+ * Pool of threads reading package headers for FAssetDataGatherer.
+ * Files are read in the order they were queued; each finished file is flagged on its context and signals ReadCompletedEvent.
+ */
+class FAssetDataParserPool
+{
+public:
+	typedef TFunction<void(FPackageReadContext&)> FReadFunction;
+
+	FAssetDataParserPool(int32 NumThreads, FEvent* InReadCompletedEvent, FReadFunction InReadFunction)
+		: ReadFunction(MoveTemp(InReadFunction))
+		, ReadCompletedEvent(InReadCompletedEvent)
+		, WorkAvailableEvent(FPlatformProcess::GetSynchEventFromPool(false))
+		, QueueHead(0)
+		, bStopping(false)
+	{
+		Threads.Reserve(NumThreads);
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+		{
+			Threads.Emplace(*FString::Printf(TEXT("FAssetDataParser %d"), ThreadIndex), [this]() { ParseFiles(); }, 0, TPri_BelowNormal);
+		}
+	}
+
+	/** Stops the threads once they finish their current file. Files that were not started are left unfinished. */
+	~FAssetDataParserPool()
+	{
+		{
+			FScopeLock QueueLock(&QueueCriticalSection);
+			bStopping = true;
+			Queue.Reset();
+			QueueHead = 0;
+		}
+		WorkAvailableEvent->Trigger();
+		for (FThread& Thread : Threads)
+		{
+			Thread.Join();
+		}
+		FPlatformProcess::ReturnSynchEventToPool(WorkAvailableEvent);
+	}
+
+	/** Queues files to be read after the ones already queued */
+	void Enqueue(TArrayView<FPackageReadContext* const> ReadContexts)
+	{
+		if (ReadContexts.Num() > 0)
+		{
+			{
+				FScopeLock QueueLock(&QueueCriticalSection);
+				Queue.Append(ReadContexts.GetData(), ReadContexts.Num());
+			}
+			WorkAvailableEvent->Trigger();
+		}
+	}
+
+private:
+	void ParseFiles()
+	{
+		while (true)
+		{
+			FPackageReadContext* ReadContext = nullptr;
+			bool bMoreWork = false;
+			{
+				FScopeLock QueueLock(&QueueCriticalSection);
+				if (bStopping)
+				{
+					break;
+				}
+				if (QueueHead < Queue.Num())
+				{
+					ReadContext = Queue[QueueHead++];
+					if (QueueHead == Queue.Num())
+					{
+						Queue.Reset();
+						QueueHead = 0;
+					}
+				}
+				bMoreWork = QueueHead < Queue.Num();
+			}
+
+			if (bMoreWork)
+			{
+				// The event only wakes one thread, pass it on while there is work left
+				WorkAvailableEvent->Trigger();
+			}
+
+			if (ReadContext)
+			{
+				ReadFunction(*ReadContext);
+				ReadContext->bDone.store(true, std::memory_order_release);
+				ReadCompletedEvent->Trigger();
+			}
+			else
+			{
+				WorkAvailableEvent->Wait();
+			}
+		}
+
+		// Wake the next thread so it sees the stop request as well
+		WorkAvailableEvent->Trigger();
+	}
+
+	FReadFunction ReadFunction;
+	FEvent* ReadCompletedEvent;
+	FEvent* WorkAvailableEvent;
+
+	FCriticalSection QueueCriticalSection;
+	TArray<FPackageReadContext*> Queue;
+	int32 QueueHead;
+	bool bStopping;
+
+	TArray<FThread> Threads;
+};
+
 namespace AssetDataDiscoveryUtil
 {
 	bool PassesScanFilters(const TArray<FString>& InBlacklistFilters, const FString& InPath)
@@ -418,7 +583,8 @@ void FAssetDataDiscovery::SortPathsByPriority(const int32 MaxNumToSort)
 
 
 FAssetDataGatherer::FAssetDataGatherer(const TArray<FString>& InPaths, const TArray<FString>& InSpecificFiles, const TArray<FString>& InBlacklistScanFilters, bool bInIsSynchronous, EAssetDataCacheMode AssetDataCacheMode)
-	: StopTaskCounter( 0 )
+	: NumFilesInFlight( 0 )
+	, StopTaskCounter( 0 )
 	, bIsSynchronous( bInIsSynchronous )
 	, bIsDiscoveringFiles( false )
 	, SearchStartTime( 0 )
@@ -486,7 +652,8 @@ FAssetDataGatherer::FAssetDataGatherer(const TArray<FString>& InPaths, const TAr
 FAssetDataGatherer::~FAssetDataGatherer()
 {
 	NewCachedAssetDataMap.Empty();
-	DiskCachedAssetDataMap.Empty();
+	DiskCacheHits.Empty();
+	DiskCache.Reset();
 
 	for ( auto CacheIt = NewCachedAssetData.CreateConstIterator(); CacheIt; ++CacheIt )
 	{
@@ -503,22 +670,18 @@ bool FAssetDataGatherer::Init()
 uint32 FAssetDataGatherer::Run()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FAssetDataGatherer::Run)
-	int32 CacheSerializationVersion = AssetDataGathererConstants::CacheSerializationVersion;
-	
+
 	if ( bLoadAndSaveCache )
 	{
-		// load the cached data
-		FNameTableArchiveReader CachedAssetDataReader(CacheSerializationVersion, CacheFilename);
-		if (!CachedAssetDataReader.IsError())
+		// map the cached data, packages are only read from it as they are discovered
+		const double OpenStartTime = FPlatformTime::Seconds();
+		DiskCache = FMappedAssetRegistryCache::Open(CacheFilename, AssetDataGathererConstants::CacheSerializationVersion);
+		if (DiskCache)
 		{
-			FAssetRegistryVersion::Type Version = FAssetRegistryVersion::LatestVersion;
-			if (FAssetRegistryVersion::SerializeVersion(CachedAssetDataReader, Version))
-			{
-				SerializeCache(CachedAssetDataReader);
+			DependencyResults.Reserve(DiskCache->Num());
+			AssetResults.Reserve(DiskCache->Num());
 
-				DependencyResults.Reserve(DiskCachedAssetDataMap.Num());
-				AssetResults.Reserve(DiskCachedAssetDataMap.Num());
-			}
+			UE_LOG(LogAssetRegistry, Verbose, TEXT("Asset data gatherer cache with %d packages opened in %0.6f seconds"), DiskCache->Num(), FPlatformTime::Seconds() - OpenStartTime);
 		}
 	}
 
@@ -527,21 +690,28 @@ uint32 FAssetDataGatherer::Run()
 	TArray<FPackageDependencyData> LocalDependencyResults;
 	TArray<FString> LocalCookedPackageNamesWithoutAssetDataResults;
 
-	const double InitialScanStartTime = FPlatformTime::Seconds();
-	double LastCacheWriteTime = InitialScanStartTime;
-	int32 NumCachedFiles = 0;
-	int32 NumUncachedFiles = 0;
-
-	auto WriteAssetCacheFile = [&]()
+	// Files being gathered, in the order they were taken from FilesToSearch. Results are only merged from the front of this list,
+	// so they come out in the same order regardless of which parser finishes first.
+	TArray<TUniquePtr<FPackageReadContext>> FilesInFlight;
+
+	// Asynchronous gathers read package headers on a pool of parser threads and keep them fed while merging results, synchronous
+	// gathers read each batch with a ParallelFor on the calling thread
+	const int32 NumParserThreads = bIsSynchronous ? 0 : AssetDataGathererUtil::GetNumParserThreads();
+	const int32 MaxFilesInFlight = FMath::Max(NumParserThreads * AssetDataGathererConstants::MaxQueuedFilesPerParser, AssetDataGathererConstants::MaxFilesToGatherBeforeFlush);
+	FEvent* ReadCompletedEvent = nullptr;
+	TUniquePtr<FAssetDataParserPool> ParserPool;
+	if (NumParserThreads > 0)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(WriteAssetCacheFile)
-		FNameTableArchiveWriter CachedAssetDataWriter(CacheSerializationVersion, CacheFilename);
-
-		FAssetRegistryVersion::Type Version = FAssetRegistryVersion::LatestVersion;
-		FAssetRegistryVersion::SerializeVersion(CachedAssetDataWriter, Version);
+		ReadCompletedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		ParserPool = MakeUnique<FAssetDataParserPool>(NumParserThreads, ReadCompletedEvent, [this](FPackageReadContext& ReadContext)
+		{
+			ReadContext.bResult = ReadAssetFile(ReadContext.AssetFileData.PackageFilename, ReadContext.AssetDataFromFile, ReadContext.DependencyData, ReadContext.CookedPackageNamesWithoutAssetData, ReadContext.bCanAttemptAssetRetry);
+		});
+		UE_LOG(LogAssetRegistry, Verbose, TEXT("Gathering asset data with %d parser threads"), NumParserThreads);
+	}
 
-		SerializeCache(CachedAssetDataWriter);
-	};
+	const double InitialScanStartTime = FPlatformTime::Seconds();
+	double LastCacheWriteTime = InitialScanStartTime;
 
 	while ( true )
 	{
@@ -569,49 +739,32 @@ uint32 FAssetDataGatherer::Run()
 				LocalIsDiscoveringFiles = bIsDiscoveringFiles;
 			}
 
-
-			if (FilesToSearch.Num() > 0)
+			// Only take a few files at a time so PrioritizeSearchPath can still reorder the ones that are waiting in FilesToSearch
+			const int32 NumFilesToProcess = FMath::Min3<int32>(AssetDataGathererConstants::MaxFilesToGatherBeforeFlush, FilesToSearch.Num(), MaxFilesInFlight - FilesInFlight.Num());
+			if (NumFilesToProcess > 0)
 			{
 				if (SearchStartTime == 0)
 				{
 					SearchStartTime = FPlatformTime::Seconds();
 				}
 
-				const int32 NumFilesToProcess = FMath::Min<int32>(AssetDataGathererConstants::MaxFilesToGatherBeforeFlush, FilesToSearch.Num());
 				LocalFilesToSearch.Append(FilesToSearch.GetData(), NumFilesToProcess);
 				FilesToSearch.RemoveAt(0, NumFilesToProcess, false);
 			}
-			else if (SearchStartTime != 0 && !LocalIsDiscoveringFiles)
+			else if (FilesToSearch.Num() == 0 && FilesInFlight.Num() == 0 && LocalFilesToSearch.Num() == 0 && SearchStartTime != 0 && !LocalIsDiscoveringFiles)
 			{
 				SearchTimes.Add(FPlatformTime::Seconds() - SearchStartTime);
 				SearchStartTime = 0;
 			}
-		}
 
-		TArray<FDiscoveredPackageFile> LocalFilesToRetry;
+			NumFilesInFlight = FilesInFlight.Num() + LocalFilesToSearch.Num();
+		}
 
-		if (LocalFilesToSearch.Num() > 0)
+		const bool bStartedFiles = LocalFilesToSearch.Num() > 0;
+		if (bStartedFiles)
 		{
-			struct FReadContext
-			{
-				FName PackageName;
-				FName Extension;
-				const FDiscoveredPackageFile& AssetFileData;
-				TArray<FAssetData*> AssetDataFromFile;
-				FPackageDependencyData DependencyData;
-				TArray<FString> CookedPackageNamesWithoutAssetData;
-				bool bCanAttemptAssetRetry = false;
-				bool bResult = false;
-
-				FReadContext(FName InPackageName, FName InExtension, const FDiscoveredPackageFile& InAssetFileData)
-					: PackageName(InPackageName)
-					, Extension(InExtension)
-					, AssetFileData(InAssetFileData)
-				{
-				}
-			};
-
-			TArray<FReadContext> ReadContexts;
+			// Packages that are up to date in the cache complete right away, the rest need their header read
+			TArray<FPackageReadContext*> ContextsToRead;
 			for (const FDiscoveredPackageFile& AssetFileData : LocalFilesToSearch)
 			{
 				if (StopTaskCounter.GetValue() != 0)
@@ -622,135 +775,135 @@ uint32 FAssetDataGatherer::Run()
 
 				const FName PackageName = FName(*FPackageName::FilenameToLongPackageName(AssetFileData.PackageFilename));
 				const FName Extension = FName(*FPaths::GetExtension(AssetFileData.PackageFilename));
+				FPackageReadContext& ReadContext = *FilesInFlight.Add_GetRef(MakeUnique<FPackageReadContext>(PackageName, Extension, AssetFileData));
 
-				bool bLoadedFromCache = false;
 				if (bLoadAndSaveCache)
 				{
-					FDiskCachedAssetData* DiskCachedAssetData = DiskCachedAssetDataMap.Find(PackageName);
-					if (DiskCachedAssetData)
+					ReadContext.CachedAssetData = FindCachedAssetData(PackageName, Extension, AssetFileData.PackageTimestamp);
+					if (ReadContext.CachedAssetData)
 					{
-						const FDateTime& CachedTimestamp = DiskCachedAssetData->Timestamp;
-						if (AssetFileData.PackageTimestamp != CachedTimestamp)
-						{
-							DiskCachedAssetData = nullptr;
-						}
-						else if ((DiskCachedAssetData->DependencyData.PackageName != PackageName && DiskCachedAssetData->DependencyData.PackageName != NAME_None) ||
-								DiskCachedAssetData->Extension != Extension)
-						{
-							UE_LOG(LogAssetRegistry, Display, TEXT("Cached dependency data for package '%s' is invalid. Discarding cached data."), *PackageName.ToString());
-							DiskCachedAssetData = nullptr;
-						}
+						ReadContext.bDone.store(true, std::memory_order_relaxed);
+						continue;
 					}
+				}
 
-					if (DiskCachedAssetData)
-					{
-						bLoadedFromCache = true;
-
-						++NumCachedFiles;
-
-						LocalAssetResults.Reserve(LocalAssetResults.Num() + DiskCachedAssetData->AssetDataList.Num());
-						for (const FAssetData& AssetData : DiskCachedAssetData->AssetDataList)
-						{
-							LocalAssetResults.Add(new FAssetData(AssetData));
-						}
+				ContextsToRead.Add(&ReadContext);
+			}
+			LocalFilesToSearch.Reset();
 
-						if (bGatherDependsData)
-						{
-							LocalDependencyResults.Add(DiskCachedAssetData->DependencyData);
-						}
+			if (ParserPool.IsValid())
+			{
+				ParserPool->Enqueue(ContextsToRead);
+			}
+			else
+			{
+				ParallelFor(ContextsToRead.Num(),
+					[this, &ContextsToRead](int32 Index)
+					{
+						FPackageReadContext& ReadContext = *ContextsToRead[Index];
+						ReadContext.bResult = ReadAssetFile(ReadContext.AssetFileData.PackageFilename, ReadContext.AssetDataFromFile, ReadContext.DependencyData, ReadContext.CookedPackageNamesWithoutAssetData, ReadContext.bCanAttemptAssetRetry);
+						ReadContext.bDone.store(true, std::memory_order_release);
+					},
+					EParallelForFlags::Unbalanced | EParallelForFlags::BackgroundPriority
+				);
+			}
+		}
 
-						AddToCache(PackageName, DiskCachedAssetData);
-					}
-				}
+		// Merge the finished files from the front of the list, stopping at the first one still being read
+		int32 NumMergedFiles = 0;
+		for (; NumMergedFiles < FilesInFlight.Num() && FilesInFlight[NumMergedFiles]->bDone.load(std::memory_order_acquire); ++NumMergedFiles)
+		{
+			FPackageReadContext& ReadContext = *FilesInFlight[NumMergedFiles];
+			if (FDiskCachedAssetData* DiskCachedAssetData = ReadContext.CachedAssetData.Get())
+			{
+				NumCachedFiles.Increment();
 
-				if (!bLoadedFromCache)
+				LocalAssetResults.Reserve(LocalAssetResults.Num() + DiskCachedAssetData->AssetDataList.Num());
+				for (const FAssetData& AssetData : DiskCachedAssetData->AssetDataList)
 				{
-					ReadContexts.Emplace(PackageName, Extension, AssetFileData);
+					LocalAssetResults.Add(new FAssetData(AssetData));
 				}
-			}
 
-			ParallelFor(ReadContexts.Num(),
-				[this, &ReadContexts](int32 Index)
+				if (bGatherDependsData)
 				{
-					FReadContext& ReadContext = ReadContexts[Index];
-					ReadContext.bResult = ReadAssetFile(ReadContext.AssetFileData.PackageFilename, ReadContext.AssetDataFromFile, ReadContext.DependencyData, ReadContext.CookedPackageNamesWithoutAssetData, ReadContext.bCanAttemptAssetRetry);
-				},
-				EParallelForFlags::Unbalanced | EParallelForFlags::BackgroundPriority
-			);
+					LocalDependencyResults.Add(DiskCachedAssetData->DependencyData);
+				}
 
-			for (FReadContext& ReadContext : ReadContexts)
+				// Only remember that the package was answered by the disk cache, its data is copied from there again when saving
+				AddDiskCacheHit(ReadContext.PackageName, DiskCachedAssetData->Extension);
+				ReadContext.CachedAssetData.Reset();
+			}
+			else if (ReadContext.bResult)
 			{
-				if (ReadContext.bResult)
-				{
-					++NumUncachedFiles;
+				NumUncachedFiles.Increment();
 
-					LocalCookedPackageNamesWithoutAssetDataResults.Append(MoveTemp(ReadContext.CookedPackageNamesWithoutAssetData));
+				LocalCookedPackageNamesWithoutAssetDataResults.Append(MoveTemp(ReadContext.CookedPackageNamesWithoutAssetData));
 
-					// Don't store info on cooked packages
-					bool bCachePackage = bLoadAndSaveCache && LocalCookedPackageNamesWithoutAssetDataResults.Num() == 0;
-					if (bCachePackage)
+				// Don't store info on cooked packages
+				bool bCachePackage = bLoadAndSaveCache && LocalCookedPackageNamesWithoutAssetDataResults.Num() == 0;
+				if (bCachePackage)
+				{
+					for (const FAssetData* AssetData : ReadContext.AssetDataFromFile)
 					{
-						for (const FAssetData* AssetData : ReadContext.AssetDataFromFile)
+						if (!!(AssetData->PackageFlags & PKG_FilterEditorOnly))
 						{
-							if (!!(AssetData->PackageFlags & PKG_FilterEditorOnly))
-							{
-								bCachePackage = false;
-								break;
-							}
+							bCachePackage = false;
+							break;
 						}
 					}
+				}
 
-					if (bCachePackage)
+				if (bCachePackage)
+				{
+					// Update the cache
+					FDiskCachedAssetData* NewData = new FDiskCachedAssetData(ReadContext.AssetFileData.PackageTimestamp, ReadContext.Extension);
+					NewData->AssetDataList.Reserve(ReadContext.AssetDataFromFile.Num());
+					for (const FAssetData* BackgroundAssetData : ReadContext.AssetDataFromFile)
 					{
-						// Update the cache
-						FDiskCachedAssetData* NewData = new FDiskCachedAssetData(ReadContext.AssetFileData.PackageTimestamp, ReadContext.Extension);
-						NewData->AssetDataList.Reserve(ReadContext.AssetDataFromFile.Num());
-						for (const FAssetData* BackgroundAssetData : ReadContext.AssetDataFromFile)
-						{
-							NewData->AssetDataList.Add(*BackgroundAssetData);
-						}
-
-						// MoveTemp only used if we don't need DependencyData anymore
-						if (bGatherDependsData)
-						{
-							NewData->DependencyData = ReadContext.DependencyData;
-						}
-						else
-						{
-							NewData->DependencyData = MoveTemp(ReadContext.DependencyData);
-						}
-
-						NewCachedAssetData.Add(NewData);
-						AddToCache(ReadContext.PackageName, NewData);
+						NewData->AssetDataList.Add(*BackgroundAssetData);
 					}
 
-					LocalAssetResults.Append(MoveTemp(ReadContext.AssetDataFromFile));
+					// MoveTemp only used if we don't need DependencyData anymore
 					if (bGatherDependsData)
 					{
-						LocalDependencyResults.Add(MoveTemp(ReadContext.DependencyData));
+						NewData->DependencyData = ReadContext.DependencyData;
+					}
+					else
+					{
+						NewData->DependencyData = MoveTemp(ReadContext.DependencyData);
 					}
+
+					NewCachedAssetData.Add(NewData);
+					AddToCache(ReadContext.PackageName, NewData);
 				}
-				else if (ReadContext.bCanAttemptAssetRetry)
+
+				LocalAssetResults.Append(MoveTemp(ReadContext.AssetDataFromFile));
+				ReadContext.AssetDataFromFile.Reset();
+				if (bGatherDependsData)
 				{
-					LocalFilesToRetry.Add(ReadContext.AssetFileData);
+					LocalDependencyResults.Add(MoveTemp(ReadContext.DependencyData));
 				}
 			}
+			else if (ReadContext.bCanAttemptAssetRetry)
+			{
+				// Try again on the next pass, a module providing the missing custom version may have been loaded by then
+				LocalFilesToSearch.Add(ReadContext.AssetFileData);
+			}
+		}
+		FilesInFlight.RemoveAt(0, NumMergedFiles, false);
 
-			LocalFilesToSearch.Reset();
-			LocalFilesToSearch.Append(LocalFilesToRetry);
-			LocalFilesToRetry.Reset();
-
-			if (bLoadAndSaveCache)
+		if (NumMergedFiles > 0 && bLoadAndSaveCache)
+		{
+			// Only write intermediate state cache file if we have spent a good amount of time working on it. The mapped cache from the
+			// previous run still answers lookups until the initial discovery is done, and a partial cache must not replace it before then.
+			if (FPlatformTime::Seconds() - LastCacheWriteTime >= AssetDataGathererConstants::MinSecondsToElapseBeforeCacheWrite && (!DiskCache || bFinishedInitialDiscovery))
 			{
-				// Only write intermediate state cache file if we have spent a good amount of time working on it
-				if (FPlatformTime::Seconds() - LastCacheWriteTime >= AssetDataGathererConstants::MinSecondsToElapseBeforeCacheWrite)
-				{
-					WriteAssetCacheFile();
-					LastCacheWriteTime = FPlatformTime::Seconds();
-				}
+				SaveCache(true);
+				LastCacheWriteTime = FPlatformTime::Seconds();
 			}
 		}
-		else
+
+		if (!bStartedFiles && FilesInFlight.Num() == 0 && LocalFilesToSearch.Num() == 0)
 		{
 			if (bIsSynchronous)
 			{
@@ -761,28 +914,47 @@ uint32 FAssetDataGatherer::Run()
 			{
 				if (!LocalIsDiscoveringFiles && !bFinishedInitialDiscovery)
 				{
-					bFinishedInitialDiscovery = true;
-
-					UE_LOG(LogAssetRegistry, Verbose, TEXT("Initial scan took %0.6f seconds (found %d cached assets, and loaded %d)"), FPlatformTime::Seconds() - InitialScanStartTime, NumCachedFiles, NumUncachedFiles);
+					UE_LOG(LogAssetRegistry, Verbose, TEXT("Initial scan took %0.6f seconds (found %d cached assets, and loaded %d)"), FPlatformTime::Seconds() - InitialScanStartTime, NumCachedFiles.GetValue(), NumUncachedFiles.GetValue());
 
 					// If we are caching discovered assets and this is the first time we had no work to do, save off the cache now in case the user terminates unexpectedly
 					if (bLoadAndSaveCache)
 					{
-						WriteAssetCacheFile();
+						SaveCache(true);
 					}
+					bFinishedInitialDiscovery = true;
 				}
 
 				// No work to do. Sleep for a little and try again later.
 				FPlatformProcess::Sleep(0.1);
 			}
 		}
+		else if (!bStartedFiles && NumMergedFiles == 0 && ReadCompletedEvent)
+		{
+			// Everything we can take is waiting on the parsers, wait for one of them to finish a file
+			ReadCompletedEvent->Wait(AssetDataGathererConstants::MaxMillisecondsToWaitForParsers);
+		}
 	}
 
 	check(LocalAssetResults.Num() == 0); // All LocalAssetResults needed to be copied to AssetResults to avoid leaking memory
 
+	// Stop the parsers before releasing the files they may still be reading
+	ParserPool.Reset();
+	if (ReadCompletedEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(ReadCompletedEvent);
+	}
+	for (TUniquePtr<FPackageReadContext>& ReadContext : FilesInFlight)
+	{
+		for (FAssetData* AssetData : ReadContext->AssetDataFromFile)
+		{
+			delete AssetData;
+		}
+	}
+	FilesInFlight.Empty();
+
 	if ( bLoadAndSaveCache )
 	{
-		WriteAssetCacheFile();
+		SaveCache(false);
 	}
 
 	return 0;
@@ -795,18 +967,46 @@ void FAssetDataGatherer::AddToCache(FName PackageName, FDiskCachedAssetData* Dis
 	{
 		// An updated DiskCachedAssetData for the same package; replace the existing DiskCachedAssetData with the new one.
 		// Note that memory management of the DiskCachedAssetData is handled in a separate structure; we do not need to delete the old value here.
-		if (DiskCachedAssetData->Extension != ValueInMap->Extension)
-		{
-			// Two files with the same package name but different extensions, e.g. basename.umap and basename.uasset
-			// This is invalid - some systems in the engine (Cooker's FPackageNameCache) assume that package : filename is 1 : 1 - so issue a warning
-			// Because it is invalid, we don't fully support it here (our map is keyed only by packagename), and will remove from cache all but the last filename we find with the same packagename
-			// TODO: Turn this into a warning once all sample projects have fixed it
-			UE_LOG(LogAssetRegistry, Display, TEXT("Multiple files exist with the same package name %s but different extensions (%s and %s). ")
-				TEXT("This is invalid and will cause errors; merge or rename or delete one of the files."),
-				*PackageName.ToString(), *ValueInMap->Extension.ToString(), *DiskCachedAssetData->Extension.ToString());
-		}
+		CheckPackageNameCollision(PackageName, ValueInMap->Extension, DiskCachedAssetData->Extension);
 		ValueInMap = DiskCachedAssetData;
 	}
+
+	// The newly read data replaces whatever the disk cache had for the package
+	if (const FName* HitExtension = DiskCacheHits.Find(PackageName))
+	{
+		CheckPackageNameCollision(PackageName, *HitExtension, DiskCachedAssetData->Extension);
+		DiskCacheHits.Remove(PackageName);
+	}
+}
+
+void FAssetDataGatherer::AddDiskCacheHit(FName PackageName, FName Extension)
+{
+	if (FDiskCachedAssetData** ValueInMap = NewCachedAssetDataMap.Find(PackageName))
+	{
+		CheckPackageNameCollision(PackageName, (*ValueInMap)->Extension, Extension);
+		NewCachedAssetDataMap.Remove(PackageName);
+	}
+
+	FName& HitExtension = DiskCacheHits.FindOrAdd(PackageName, Extension);
+	if (HitExtension != Extension)
+	{
+		CheckPackageNameCollision(PackageName, HitExtension, Extension);
+		HitExtension = Extension;
+	}
+}
+
+void FAssetDataGatherer::CheckPackageNameCollision(FName PackageName, FName ExistingExtension, FName NewExtension)
+{
+	if (ExistingExtension != NewExtension)
+	{
+		// Two files with the same package name but different extensions, e.g. basename.umap and basename.uasset
+		// This is invalid - some systems in the engine (Cooker's FPackageNameCache) assume that package : filename is 1 : 1 - so issue a warning
+		// Because it is invalid, we don't fully support it here (our map is keyed only by packagename), and will remove from cache all but the last filename we find with the same packagename
+		// TODO: Turn this into a warning once all sample projects have fixed it
+		UE_LOG(LogAssetRegistry, Display, TEXT("Multiple files exist with the same package name %s but different extensions (%s and %s). ")
+			TEXT("This is invalid and will cause errors; merge or rename or delete one of the files."),
+			*PackageName.ToString(), *ExistingExtension.ToString(), *NewExtension.ToString());
+	}
 }
 
 void FAssetDataGatherer::Stop()
@@ -864,7 +1064,7 @@ bool FAssetDataGatherer::GetAndTrimSearchResults(TBackgroundGatherResults<FAsset
 	OutSearchTimes.Append(MoveTemp(SearchTimes));
 	SearchTimes.Reset();
 
-	OutNumFilesToSearch = FilesToSearch.Num();
+	OutNumFilesToSearch = FilesToSearch.Num() + NumFilesInFlight;
 	OutNumPathsToSearch = NumPathsToSearchAtLastSyncPoint;
 	OutIsDiscoveringFiles = bIsDiscoveringFiles;
 
@@ -1000,68 +1200,55 @@ bool FAssetDataGatherer::ReadAssetFile(const FString& AssetFilename, TArray<FAss
 	return true;
 }
 
-void FAssetDataGatherer::SerializeCache(FArchive& Ar)
+TUniquePtr<FDiskCachedAssetData> FAssetDataGatherer::FindCachedAssetData(FName PackageName, FName Extension, const FDateTime& PackageTimestamp)
 {
-	double SerializeStartTime = FPlatformTime::Seconds();
-
-	// serialize number of objects
-	int32 LocalNumAssets = NewCachedAssetDataMap.Num();
-	Ar << LocalNumAssets;
-
-	if (Ar.IsSaving())
+	FMappedAssetRegistryCache::FPackageView PackageView;
+	if (!DiskCache || !DiskCache->FindPackage(PackageName, PackageView) || PackageView.Timestamp != PackageTimestamp)
 	{
-		// save out by walking the TMap
-		for (TPair<FName, FDiskCachedAssetData*>& Pair : NewCachedAssetDataMap)
-		{
-			Ar << Pair.Key;
-			Pair.Value->SerializeForCache(Ar);
-		}
+		return nullptr;
 	}
-	else
+
+	if (PackageView.Extension != Extension)
 	{
-		// allocate one single block for all asset data structs (to reduce tens of thousands of heap allocations)
-		if (Ar.IsError() || LocalNumAssets < 0)
-		{
-			Ar.SetError();
-		}
-		else
-		{
-			const int32 MinAssetEntrySize = sizeof(int32);
-			int32 MaxReservation = (Ar.TotalSize() - Ar.Tell()) / MinAssetEntrySize;
-			DiskCachedAssetDataMap.Empty(FMath::Min(LocalNumAssets, MaxReservation));
+		UE_LOG(LogAssetRegistry, Display, TEXT("Cached dependency data for package '%s' is invalid. Discarding cached data."), *PackageName.ToString());
+		return nullptr;
+	}
 
-			for (int32 AssetIndex = 0; AssetIndex < LocalNumAssets; ++AssetIndex)
-			{
-				// Load the name first to add the entry to the tmap below
-				FName PackageName;
-				Ar << PackageName;
-				if (Ar.IsError())
-				{
-					// There was an error reading the cache. Bail out.
-					break;
-				}
+	TUniquePtr<FDiskCachedAssetData> CachedAssetData = MakeUnique<FDiskCachedAssetData>();
+	if (!DiskCache->Materialize(PackageView, *CachedAssetData))
+	{
+		// There was an error reading the cache, abandon it so we can build a clean one
+		UE_LOG(LogAssetRegistry, Error, TEXT("There was an error loading the asset registry cache. Generating a new one."));
+		DiskCache.Reset();
+		return nullptr;
+	}
 
-				// Add to the cached map
-				FDiskCachedAssetData& CachedAssetData = DiskCachedAssetDataMap.Add(PackageName);
+	if (CachedAssetData->DependencyData.PackageName != PackageName && CachedAssetData->DependencyData.PackageName != NAME_None)
+	{
+		UE_LOG(LogAssetRegistry, Display, TEXT("Cached dependency data for package '%s' is invalid. Discarding cached data."), *PackageName.ToString());
+		return nullptr;
+	}
 
-				// Now load the data
-				CachedAssetData.SerializeForCache(Ar);
+	return CachedAssetData;
+}
 
-				if (Ar.IsError())
-				{
-					// There was an error reading the cache. Bail out.
-					break;
-				}
-			}
-		}
+void FAssetDataGatherer::SaveCache(bool bReopenCache)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FAssetDataGatherer::SaveCache)
 
-		// If there was an error loading the cache, abandon all data loaded from it so we can build a clean one.
-		if (Ar.IsError())
+	// Packages answered by the disk cache are copied from the mapping into the new file, which releases the mapping before replacing the file.
+	// Intermediate saves also keep the packages that have not been discovered yet, so paths added later in the run (e.g. by mounting
+	// a plugin) still find them. The final save only keeps the packages discovered during the run, like the cache always did.
+	FMappedAssetRegistryCache::Save(CacheFilename, AssetDataGathererConstants::CacheSerializationVersion, NewCachedAssetDataMap, DiskCache,
+		[this, bReopenCache](FName PackageName)
 		{
-			UE_LOG(LogAssetRegistry, Error, TEXT("There was an error loading the asset registry cache. Generating a new one."));
-			DiskCachedAssetDataMap.Empty();
-		}
-	}
+			return bReopenCache || DiskCacheHits.Contains(PackageName);
+		});
+	check(!DiskCache);
 
-	UE_LOG(LogAssetRegistry, Verbose, TEXT("Asset data gatherer serialized in %0.6f seconds"), FPlatformTime::Seconds() - SerializeStartTime);
+	if (bReopenCache)
+	{
+		// The new file if it was saved, otherwise the old one is still there
+		DiskCache = FMappedAssetRegistryCache::Open(CacheFilename, AssetDataGathererConstants::CacheSerializationVersion);
+	}
 }
@@ -3,12 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
 #include "HAL/ThreadSafeCounter.h"
 #include "PackageDependencyData.h"
 #include "HAL/FileManager.h"
 #include "HAL/Runnable.h"
 #include "DiskCachedAssetData.h"
 #include "BackgroundGatherResults.h"
+#include "MappedAssetRegistryCache.h"
 
 /**
  * Minimal amount of information needed about a discovered asset file
@@ -102,6 +104,21 @@ public:
 	/** Set the blacklist filters to use during scanning. */
 	void SetBlacklistScanFilters(const TArray<FString>& InBlacklistScanFilters);
 
+	/** Number of discovered packages whose results came from the disk cache */
+	int32 GetNumCachedFiles() const { return NumCachedFiles.GetValue(); }
+
+	/** Number of discovered packages that had to be read from disk */
+	int32 GetNumUncachedFiles() const { return NumUncachedFiles.GetValue(); }
+
+	/** Number of packages whose cached data is held in memory rather than left in the mapped disk cache. Only stable once the search completed */
+	int32 GetNumCachedPackagesInMemory() const { return NewCachedAssetData.Num(); }
+
+	/** True once the first wave of files was gathered, and the cache saved for it if the gatherer uses one */
+	bool HasFinishedInitialDiscovery() const { return bFinishedInitialDiscovery; }
+
+	/** The cache file this gatherer loads and saves, empty if it does not use one */
+	const FString& GetCacheFilename() const { return CacheFilename; }
+
 private:
 	/** Sort the paths so that items belonging to the current priority path is processed first */
 	void SortPathsByPriority(const int32 MaxNumToSort);
@@ -160,7 +177,9 @@ enum class EAssetDataCacheMode : uint8
 
 
 /**
- * Async task for gathering asset data from from the file list in FAssetRegistry
+ * Async task for gathering asset data from from the file list in FAssetRegistry.
+ * The gatherer thread takes files from the discovery results, answers what it can from the cache and hands the rest to a pool
+ * of parser threads, merging their results back in the order the files were taken.
  */
 class FAssetDataGatherer : public FRunnable
 {
@@ -209,12 +228,21 @@ private:
 	 */
 	bool ReadAssetFile(const FString& AssetFilename, TArray<FAssetData*>& AssetDataList, FPackageDependencyData& DependencyData, TArray<FString>& CookedPackagesToLoadUponDiscovery, bool& OutCanRetry) const;
 
-	/** Serializes the timestamped cache of discovered assets. Used for quick loading of data for assets that have not changed on disk */
-	void SerializeCache(FArchive& Ar);
+	/** Looks PackageName up in the disk cache and deserializes its data if it is still valid for the given file */
+	TUniquePtr<FDiskCachedAssetData> FindCachedAssetData(FName PackageName, FName Extension, const FDateTime& PackageTimestamp);
+
+	/** Writes the timestamped cache of discovered assets. Used for quick loading of data for assets that have not changed on disk */
+	void SaveCache(bool bReopenCache);
 
 	/* Adds the given PackageName,DiskCachedAssetData pair into NewCachedAssetDataMap, and detects collisions for multiple files with the same PackageName */
 	void AddToCache(FName PackageName, FDiskCachedAssetData* DiskCachedAssetData);
 
+	/** Records that PackageName was answered by the disk cache, so its data is carried over from there when the cache is saved */
+	void AddDiskCacheHit(FName PackageName, FName Extension);
+
+	/** Reports files with the same PackageName but different extensions */
+	static void CheckPackageNameCollision(FName PackageName, FName ExistingExtension, FName NewExtension);
+
 private:
 	/** A critical section to protect data transfer to the main thread */
 	FCriticalSection WorkerThreadCriticalSection;
@@ -225,6 +253,9 @@ private:
 	/** List of files that need to be processed by the search. It is not threadsafe to directly access this array */
 	TArray<FDiscoveredPackageFile> FilesToSearch;
 
+	/** Number of files taken from FilesToSearch whose results have not been merged yet */
+	int32 NumFilesInFlight;
+
 	/** > 0 if we've been asked to abort work in progress at the next opportunity */
 	FThreadSafeCounter StopTaskCounter;
 
@@ -271,8 +302,8 @@ private:
 	/** True if this gather request should both load and save the asset cache. Only one gatherer should do this at a time! */
 	bool bLoadAndSaveCache;
 
-	/** True if we have finished discovering our first wave of files */
-	bool bFinishedInitialDiscovery;
+	/** True if we have finished discovering our first wave of files and saved the cache for it */
+	FThreadSafeBool bFinishedInitialDiscovery;
 
 	/** The name of the file that contains the timestamped cache of discovered assets */
 	FString CacheFilename;
@@ -280,16 +311,22 @@ private:
 	/** An array of all cached data that was newly discovered this run. This array is just used to make sure they are all deleted at shutdown */
 	TArray<FDiskCachedAssetData*> NewCachedAssetData;
 
-	/** 
-	 * Map of PackageName to cached discovered assets that were loaded from disk. 
-	 * This should only be modified in the loading section of SerializeCache and remain const after
-	 * since NewCachedAssetDataMap keeps pointers to the values in this map.
+	/**
+	 * Cached discovered assets, mapped from disk and queried in place. Packages are only deserialized while their results are
+	 * produced and when they are copied into a newly saved cache.
 	 */
-	TMap<FName, FDiskCachedAssetData> DiskCachedAssetDataMap;
+	TUniquePtr<FMappedAssetRegistryCache> DiskCache;
 
 	/** Map of PackageName to cached discovered assets that will be written to disk at shutdown */
 	TMap<FName, FDiskCachedAssetData*> NewCachedAssetDataMap;
 
+	/** Packages discovered this run that were up to date in DiskCache, with their extension. They are written to disk from DiskCache */
+	TMap<FName, FName> DiskCacheHits;
+
+	/** Number of discovered packages answered by the disk cache and read from disk */
+	FThreadSafeCounter NumCachedFiles;
+	FThreadSafeCounter NumUncachedFiles;
+
 	/** Thread to run the cleanup FRunnable on */
 	FRunnableThread* Thread;
 };
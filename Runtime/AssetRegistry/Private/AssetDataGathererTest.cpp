@@ -0,0 +1,265 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AssetDataGatherer.h"
+#include "AssetRegistry/AssetData.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetDataGathererParserScalingTest, "System.AssetRegistry.GathererParserScaling", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetDataGathererCacheCarryOverTest, "System.AssetRegistry.GathererCacheCarryOver", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AssetDataGathererTest
+{
+	/** Gives up on a gather that takes longer than this, in seconds */
+	static const double GatherTimeout = 600.0;
+
+	/** Collects the results of a gatherer and deletes the gathered assets */
+	struct FGatherResults
+	{
+		TBackgroundGatherResults<FAssetData*> AssetResults;
+		TBackgroundGatherResults<FString> PathResults;
+		TBackgroundGatherResults<FPackageDependencyData> DependencyResults;
+		TBackgroundGatherResults<FString> CookedPackageNamesWithoutAssetDataResults;
+		TArray<double> SearchTimes;
+		int32 NumFilesToSearch = 0;
+		int32 NumPathsToSearch = 0;
+		bool bIsDiscoveringFiles = false;
+		int32 NumAssets = 0;
+
+		~FGatherResults()
+		{
+			while (AssetResults.Num() > 0)
+			{
+				delete AssetResults.Pop();
+			}
+		}
+
+		/** Takes the latest results of Gatherer and returns true once it has no work left, i.e. it ran out of files after discovery finished */
+		bool Poll(FAssetDataGatherer& Gatherer)
+		{
+			const int32 NumSearchTimes = SearchTimes.Num();
+			const bool bIsSearching = Gatherer.GetAndTrimSearchResults(AssetResults, PathResults, DependencyResults, CookedPackageNamesWithoutAssetDataResults,
+				SearchTimes, NumFilesToSearch, NumPathsToSearch, bIsDiscoveringFiles);
+			NumAssets += AssetResults.Num();
+			while (AssetResults.Num() > 0)
+			{
+				delete AssetResults.Pop();
+			}
+			return !bIsSearching && SearchTimes.Num() > NumSearchTimes && NumFilesToSearch == 0 && !bIsDiscoveringFiles;
+		}
+
+		/** Polls Gatherer until it has no work left, returns false if that takes longer than GatherTimeout */
+		bool WaitForIdle(FAssetDataGatherer& Gatherer)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			while (!Poll(Gatherer))
+			{
+				if (FPlatformTime::Seconds() - StartTime > GatherTimeout)
+				{
+					return false;
+				}
+				FPlatformProcess::Sleep(0.001f);
+			}
+			return true;
+		}
+	};
+
+	/** Runs a gather over Path without the gatherer cache and returns its wall time in seconds, or a negative value if it timed out */
+	static double TimeUncachedGather(const FString& Path, bool bSynchronous, int32& OutNumAssets)
+	{
+		FGatherResults Results;
+		const double StartTime = FPlatformTime::Seconds();
+		FAssetDataGatherer Gatherer({ Path }, TArray<FString>(), TArray<FString>(), bSynchronous, EAssetDataCacheMode::NoCache);
+		double GatherTime = -1.0;
+		if (bSynchronous)
+		{
+			Results.Poll(Gatherer);
+			GatherTime = FPlatformTime::Seconds() - StartTime;
+		}
+		else if (Results.WaitForIdle(Gatherer))
+		{
+			GatherTime = FPlatformTime::Seconds() - StartTime;
+		}
+		Gatherer.EnsureCompletion();
+		Results.Poll(Gatherer);
+
+		OutNumAssets = Results.NumAssets;
+		return GatherTime;
+	}
+
+	/** Returns the first two subfolders of Root that contain packages */
+	static bool FindTwoPackageFolders(const FString& Root, FString& OutFirst, FString& OutSecond)
+	{
+		TArray<FString> SubFolders;
+		IFileManager::Get().FindFiles(SubFolders, *(Root / TEXT("*")), false, true);
+		SubFolders.Sort();
+		TArray<FString> PackageFolders;
+		for (const FString& SubFolder : SubFolders)
+		{
+			TArray<FString> Packages;
+			IFileManager::Get().FindFilesRecursive(Packages, *(Root / SubFolder), TEXT("*.uasset"), true, false);
+			if (Packages.Num() > 0)
+			{
+				PackageFolders.Add(Root / SubFolder);
+				if (PackageFolders.Num() == 2)
+				{
+					OutFirst = PackageFolders[0];
+					OutSecond = PackageFolders[1];
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+}
+
+/**
+ * Times gathers of a content folder without the asset registry cache for a range of parser pool sizes, plus the synchronous
+ * ParallelFor path as a reference. Scans engine content unless -AssetGathererBenchmarkPath=<Folder> points at a larger corpus.
+ * The OS file cache can't be dropped from here, so one gather warms it first and the times are for header parsing, not disk reads.
+ */
+bool FAssetDataGathererParserScalingTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetDataGathererTest;
+
+	IConsoleVariable* ParserThreadsVar = IConsoleManager::Get().FindConsoleVariable(TEXT("AssetRegistry.GathererParserThreads"));
+	if (!ParserThreadsVar)
+	{
+		AddError(TEXT("AssetRegistry.GathererParserThreads is not registered"));
+		return false;
+	}
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		AddInfo(TEXT("Asynchronous gathers need multithreading, skipping"));
+		return true;
+	}
+	int32 CommandLineParserThreads = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-AssetGathererThreads="), CommandLineParserThreads))
+	{
+		AddWarning(TEXT("-AssetGathererThreads overrides every pool size, remove it to measure scaling"));
+	}
+
+	FString Path = FPaths::EngineContentDir();
+	FParse::Value(FCommandLine::Get(), TEXT("-AssetGathererBenchmarkPath="), Path);
+	Path = FPaths::ConvertRelativePathToFull(Path);
+
+	const int32 PreviousParserThreads = ParserThreadsVar->GetInt();
+
+	int32 NumAssets = 0;
+	TimeUncachedGather(Path, false, NumAssets);
+
+	const double SynchronousTime = TimeUncachedGather(Path, true, NumAssets);
+	AddInfo(FString::Printf(TEXT("%s: %d assets, synchronous gather %.2fs"), *Path, NumAssets, SynchronousTime));
+
+	const int32 MaxParserThreads = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1, 1, 32);
+	double SingleThreadTime = 0.0;
+	for (int32 NumParserThreads = 1; ; NumParserThreads = FMath::Min(NumParserThreads * 2, MaxParserThreads))
+	{
+		ParserThreadsVar->Set(NumParserThreads, ECVF_SetByCode);
+		int32 NumAsyncAssets = 0;
+		const double GatherTime = TimeUncachedGather(Path, false, NumAsyncAssets);
+		if (GatherTime < 0.0)
+		{
+			AddError(FString::Printf(TEXT("Gather with %d parser threads did not finish within %.0fs"), NumParserThreads, GatherTimeout));
+			break;
+		}
+		if (NumParserThreads == 1)
+		{
+			SingleThreadTime = GatherTime;
+		}
+		TestEqual(TEXT("Every pool size gathers the same assets"), NumAsyncAssets, NumAssets);
+		AddInfo(FString::Printf(TEXT("%2d parser threads: %.2fs (%.2fx the single parser, %.2fx the synchronous gather)"), NumParserThreads, GatherTime,
+			GatherTime > 0.0 ? SingleThreadTime / GatherTime : 0.0, GatherTime > 0.0 ? SynchronousTime / GatherTime : 0.0));
+
+		if (NumParserThreads == MaxParserThreads)
+		{
+			break;
+		}
+	}
+
+	ParserThreadsVar->Set(PreviousParserThreads, ECVF_SetByCode);
+	return true;
+}
+
+/**
+ * Gathers a content folder with the modular cache and then a second folder added while the gatherer runs, as a mounted plugin
+ * would be, and does the same again from the saved cache. The cache is saved and reopened after the initial discovery of the
+ * second run, which must carry over the entries of the folder that was not discovered yet so that it is answered from the cache
+ * too. Packages answered by the cache must not be kept in memory, they stay in the mapped cache file.
+ */
+bool FAssetDataGathererCacheCarryOverTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetDataGathererTest;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		AddInfo(TEXT("Adding paths to a gather needs an asynchronous gatherer, skipping"));
+		return true;
+	}
+	FString FirstFolder;
+	FString SecondFolder;
+	if (!FindTwoPackageFolders(FPaths::ConvertRelativePathToFull(FPaths::EngineContentDir()), FirstFolder, SecondFolder))
+	{
+		AddInfo(TEXT("Engine content has fewer than two folders with packages, skipping"));
+		return true;
+	}
+
+	// The first run fills the cache, the second one is answered by it
+	FString CacheFilename;
+	int32 NumAssetsPerRun[2] = { 0, 0 };
+	for (int32 Run = 0; Run < 2; ++Run)
+	{
+		FGatherResults Results;
+		FAssetDataGatherer Gatherer({ FirstFolder }, TArray<FString>(), TArray<FString>(), false, EAssetDataCacheMode::UseModularCache);
+		CacheFilename = Gatherer.GetCacheFilename();
+		if (CacheFilename.IsEmpty())
+		{
+			Gatherer.EnsureCompletion();
+			AddInfo(TEXT("The gatherer cache is disabled on the command line, skipping"));
+			return true;
+		}
+
+		// Wait for the intermediate save at the end of the initial discovery before adding the second folder
+		bool bFinished = Results.WaitForIdle(Gatherer);
+		const double StartTime = FPlatformTime::Seconds();
+		while (bFinished && !Gatherer.HasFinishedInitialDiscovery())
+		{
+			bFinished = FPlatformTime::Seconds() - StartTime < GatherTimeout;
+			FPlatformProcess::Sleep(0.001f);
+		}
+		Gatherer.AddPathToSearch(SecondFolder);
+		bFinished = bFinished && Results.WaitForIdle(Gatherer);
+		Gatherer.EnsureCompletion();
+		Results.Poll(Gatherer);
+		if (!TestTrue(TEXT("The gather finishes"), bFinished))
+		{
+			break;
+		}
+
+		NumAssetsPerRun[Run] = Results.NumAssets;
+		AddInfo(FString::Printf(TEXT("Run %d: %d assets, %d packages from the cache, %d read from disk, %d cached packages held in memory"),
+			Run + 1, Results.NumAssets, Gatherer.GetNumCachedFiles(), Gatherer.GetNumUncachedFiles(), Gatherer.GetNumCachedPackagesInMemory()));
+		TestEqual(TEXT("Every package read from disk is held in memory until the cache is saved"), Gatherer.GetNumCachedPackagesInMemory(), Gatherer.GetNumUncachedFiles());
+		if (Run == 1)
+		{
+			TestEqual(TEXT("Both runs gather the same assets"), NumAssetsPerRun[1], NumAssetsPerRun[0]);
+			TestEqual(TEXT("Both folders are answered from the cache"), Gatherer.GetNumUncachedFiles(), 0);
+			TestTrue(TEXT("Both folders are answered from the cache"), Gatherer.GetNumCachedFiles() > 0);
+		}
+	}
+
+	IFileManager::Get().Delete(*CacheFilename, false, true, true);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
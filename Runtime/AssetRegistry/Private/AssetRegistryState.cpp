@@ -12,6 +12,7 @@
 #include "UObject/MetaData.h"
 #include "AssetRegistryPrivate.h"
 #include "AssetRegistry/ARFilter.h"
+#include "AssetTagValueIndex.h"
 #include "DependsNode.h"
 #include "PackageReader.h"
 #include "NameTableArchive.h"
@@ -115,6 +116,7 @@ bool FAssetDataTagMapValueStorage::KeyShouldHaveLocTextExportTextValue(FName Key
 
 
 FAssetRegistryState::FAssetRegistryState()
+	: CachedTagValueIndexes(MakeUnique<FAssetTagValueIndexCache>())
 {
 	NumAssets = 0;
 	NumDependsNodes = 0;
@@ -211,6 +213,7 @@ void FAssetRegistryState::Reset()
 	CachedAssetsByPath.Empty();
 	CachedAssetsByClass.Empty();
 	CachedAssetsByTag.Empty();
+	CachedTagValueIndexes->Reset();
 	CachedDependsNodes.Empty();
 	CachedPackageData.Empty();
 }
@@ -729,20 +732,15 @@ bool FAssetRegistryState::EnumerateAssets(const FARCompiledFilter& Filter, const
 
 			if (TagAssets != nullptr)
 			{
-				for (FAssetData* AssetData : *TagAssets)
+				if (Value.IsSet())
 				{
-					if (AssetData != nullptr)
+					CachedTagValueIndexes->FindAssets(Tag, Value.GetValue(), *TagAssets, TagAndValuesFilter);
+				}
+				else
+				{
+					for (FAssetData* AssetData : *TagAssets)
 					{
-						bool bAccept;
-						if (!Value.IsSet())
-						{
-							bAccept = AssetData->TagsAndValues.Contains(Tag);
-						}
-						else
-						{
-							bAccept = AssetData->TagsAndValues.ContainsKeyValue(Tag, Value.GetValue());
-						}
-						if (bAccept)
+						if (AssetData != nullptr && AssetData->TagsAndValues.Contains(Tag))
 						{
 							TagAndValuesFilter.Add(AssetData);
 						}
@@ -1280,6 +1278,7 @@ void FAssetRegistryState::StripAssetRegistryKeyForObject(FName ObjectPath, FName
 	FAssetData** Found = CachedAssetsByObjectPath.Find(ObjectPath);
 	if (Found)
 	{
+		CachedTagValueIndexes->Invalidate(Key);
 		(*Found)->TagsAndValues.StripKey(Key);
 	}
 }
@@ -1383,9 +1382,19 @@ uint32 FAssetRegistryState::GetAllocatedSize(bool bLogDetailed) const
 		UE_LOG(LogAssetRegistry, Log, TEXT("Dependency Arrays Size: %dk"), DependenciesSize / 1024);
 	}
 
+	const uint32 TagValueIndexSize = (uint32)CachedTagValueIndexes->GetAllocatedSize();
+
+	if (bLogDetailed)
+	{
+		const int32 NumAssetsForAverage = FMath::Max(CachedAssetsByObjectPath.Num(), 1);
+		UE_LOG(LogAssetRegistry, Log, TEXT("Tag Value Indexes: %dk for %d tags"), TagValueIndexSize / 1024, CachedTagValueIndexes->GetNumIndexes());
+		UE_LOG(LogAssetRegistry, Log, TEXT("Tag Bytes Per Asset: %d"), (TagOverHead + TotalTagSize) / NumAssetsForAverage);
+		UE_LOG(LogAssetRegistry, Log, TEXT("Tag Value Index Bytes Per Asset: %d"), TagValueIndexSize / NumAssetsForAverage);
+	}
+
 	uint32 PackageDataSize = CachedPackageData.Num() * sizeof(FAssetPackageData);
 
-	TotalBytes = MapMemory + AssetDataSize + TagOverHead + TotalTagSize + DependNodesSize + DependenciesSize + PackageDataSize + MapArrayMemory
+	TotalBytes = MapMemory + AssetDataSize + TagOverHead + TotalTagSize + TagValueIndexSize + DependNodesSize + DependenciesSize + PackageDataSize + MapArrayMemory
 #if USE_COMPACT_ASSET_REGISTRY
 		+ CompactOverhead
 #endif
@@ -1497,6 +1506,7 @@ void FAssetRegistryState::AddAssetData(FAssetData* AssetData)
 	TArray<FAssetData*>& ClassAssets = CachedAssetsByClass.FindOrAdd(AssetData->AssetClass);
 
 	CachedAssetsByObjectPath.Add(AssetData->ObjectPath, AssetData);
+	CachedTagValueIndexes->Invalidate(*AssetData);
 	PackageAssets.Add(AssetData);
 	PathAssets.Add(AssetData);
 	ClassAssets.Add(AssetData);
@@ -1599,6 +1609,10 @@ void FAssetRegistryState::UpdateAssetData(FAssetData* AssetData, const FAssetDat
 		}
 	}
 
+	// Values may have changed even if the tags did not
+	CachedTagValueIndexes->Invalidate(*AssetData);
+	CachedTagValueIndexes->Invalidate(NewAssetData);
+
 	// Copy in new values
 	*AssetData = NewAssetData;
 }
@@ -1624,6 +1638,7 @@ void FAssetRegistryState::RemoveAssetData(FAssetData* AssetData, bool bRemoveDep
 			TArray<FAssetData*>* OldTagAssets = CachedAssetsByTag.Find(TagIt.Key());
 			OldTagAssets->RemoveSingleSwap(AssetData);
 		}
+		CachedTagValueIndexes->Invalidate(*AssetData);
 
 		// Only remove dependencies and package data if there are no other known assets in the package
 		if (OldPackageAssets->Num() == 0)
@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AssetTagValueIndex.h"
+#include "AssetRegistry/AssetData.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+static int32 GAssetRegistryTagValueIndexBudgetKB = 16 * 1024;
+static FAutoConsoleVariableRef CVarAssetRegistryTagValueIndexBudgetKB(
+	TEXT("AssetRegistry.TagValueIndexBudgetKB"),
+	GAssetRegistryTagValueIndexBudgetKB,
+	TEXT("Memory in KB the tag value query indexes of an asset registry state may use on top of the tag maps. Tags whose index does not fit are answered by scanning their assets. 0 disables the indexes."));
+
+FAssetTagValueIndex::FAssetTagValueIndex(FName InTag, const TArray<FAssetData*>& TagAssets)
+	: Tag(InTag)
+{
+	// Give each distinct value an id, the strings only live as long as the build
+	TArray<int32> AssetValueIds;
+	AssetValueIds.Reserve(TagAssets.Num());
+	TSet<FString> Values;
+	for (FAssetData* AssetData : TagAssets)
+	{
+		int32 ValueId = INDEX_NONE;
+		if (AssetData)
+		{
+			FAssetDataTagMapSharedView::FFindTagResult Result = AssetData->TagsAndValues.FindTag(Tag);
+			if (Result.IsSet())
+			{
+				ValueId = Values.Add(Result.GetValue()).AsInteger();
+			}
+		}
+		AssetValueIds.Add(ValueId);
+	}
+
+	ValueHashes.Reserve(Values.Num());
+	for (auto It = Values.CreateConstIterator(); It; ++It)
+	{
+		ValueHashes.Add({ GetTypeHash(*It), It.GetId().AsInteger() });
+	}
+	ValueHashes.Sort([](const FValueHash& A, const FValueHash& B) { return A.Hash < B.Hash; });
+
+	// Counting sort of the assets by value id
+	ValueOffsets.SetNumZeroed(Values.Num() + 1);
+	for (int32 ValueId : AssetValueIds)
+	{
+		if (ValueId != INDEX_NONE)
+		{
+			++ValueOffsets[ValueId + 1];
+		}
+	}
+	for (int32 ValueId = 0; ValueId < Values.Num(); ++ValueId)
+	{
+		ValueOffsets[ValueId + 1] += ValueOffsets[ValueId];
+	}
+
+	AssetsByValue.SetNumUninitialized(ValueOffsets.Last());
+	TArray<int32> NextOffsets(ValueOffsets.GetData(), Values.Num());
+	for (int32 AssetIndex = 0; AssetIndex < TagAssets.Num(); ++AssetIndex)
+	{
+		const int32 ValueId = AssetValueIds[AssetIndex];
+		if (ValueId != INDEX_NONE)
+		{
+			AssetsByValue[NextOffsets[ValueId]++] = TagAssets[AssetIndex];
+		}
+	}
+}
+
+void FAssetTagValueIndex::FindAssets(const FString& Value, TSet<FAssetData*>& OutAssets) const
+{
+	const uint32 Hash = GetTypeHash(Value);
+	for (int32 HashIndex = Algo::LowerBoundBy(ValueHashes, Hash, &FValueHash::Hash); HashIndex < ValueHashes.Num() && ValueHashes[HashIndex].Hash == Hash; ++HashIndex)
+	{
+		const int32 ValueId = ValueHashes[HashIndex].ValueId;
+		const int32 Begin = ValueOffsets[ValueId];
+		const int32 End = ValueOffsets[ValueId + 1];
+
+		// Every asset of a group has the same value, the first one tells whether the hash matched the queried value
+		if (AssetsByValue[Begin]->TagsAndValues.ContainsKeyValue(Tag, Value))
+		{
+			OutAssets.Reserve(OutAssets.Num() + End - Begin);
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				OutAssets.Add(AssetsByValue[Index]);
+			}
+			return;
+		}
+	}
+}
+
+SIZE_T FAssetTagValueIndex::GetAllocatedSize() const
+{
+	return AssetsByValue.GetAllocatedSize() + ValueOffsets.GetAllocatedSize() + ValueHashes.GetAllocatedSize();
+}
+
+SIZE_T FAssetTagValueIndex::GetMaxAllocatedSize(int32 NumAssets)
+{
+	// Every asset may have its own value
+	return NumAssets * (sizeof(FAssetData*) + sizeof(int32) + sizeof(FValueHash)) + sizeof(int32);
+}
+
+void FAssetTagValueIndexCache::FindAssets(FName Tag, const FString& Value, const TArray<FAssetData*>& TagAssets, TSet<FAssetData*>& OutAssets)
+{
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		const FAssetTagValueIndex* Index = Indexes.Find(Tag);
+		if (!Index && TagAssets.Num() >= MinAssetsToIndex && ++QueryCounts.FindOrAdd(Tag) >= QueriesBeforeIndexing)
+		{
+			QueryCounts.Remove(Tag);
+			if (GetIndexesAllocatedSize() + FAssetTagValueIndex::GetMaxAllocatedSize(TagAssets.Num()) <= SIZE_T(FMath::Max(GAssetRegistryTagValueIndexBudgetKB, 0)) * 1024)
+			{
+				Index = &Indexes.Emplace(Tag, FAssetTagValueIndex(Tag, TagAssets));
+			}
+		}
+
+		if (Index)
+		{
+			Index->FindAssets(Value, OutAssets);
+			return;
+		}
+	}
+
+	for (FAssetData* AssetData : TagAssets)
+	{
+		if (AssetData && AssetData->TagsAndValues.ContainsKeyValue(Tag, Value))
+		{
+			OutAssets.Add(AssetData);
+		}
+	}
+}
+
+void FAssetTagValueIndexCache::Invalidate(const FAssetData& AssetData)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (Indexes.Num() == 0 && QueryCounts.Num() == 0)
+	{
+		return;
+	}
+
+	for (const auto& TagPair : AssetData.TagsAndValues)
+	{
+		Indexes.Remove(TagPair.Key);
+		QueryCounts.Remove(TagPair.Key);
+	}
+}
+
+void FAssetTagValueIndexCache::Invalidate(FName Tag)
+{
+	FScopeLock Lock(&CriticalSection);
+	Indexes.Remove(Tag);
+	QueryCounts.Remove(Tag);
+}
+
+void FAssetTagValueIndexCache::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+	Indexes.Empty();
+	QueryCounts.Empty();
+}
+
+int32 FAssetTagValueIndexCache::GetNumIndexes() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Indexes.Num();
+}
+
+SIZE_T FAssetTagValueIndexCache::GetAllocatedSize() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return GetIndexesAllocatedSize() + QueryCounts.GetAllocatedSize();
+}
+
+SIZE_T FAssetTagValueIndexCache::GetIndexesAllocatedSize() const
+{
+	SIZE_T Size = Indexes.GetAllocatedSize();
+	for (const TPair<FName, FAssetTagValueIndex>& Pair : Indexes)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	return Size;
+}
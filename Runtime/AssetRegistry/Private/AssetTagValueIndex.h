@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+struct FAssetData;
+
+/**
+ * Inverted query index of the values one tag takes across the assets of an FAssetRegistryState. It is an addition to the
+ * per-asset tag maps, which still own the values: the index keeps the assets grouped by value and one hash per distinct value,
+ * and compares a query against the value of the first asset of a group. It costs about one pointer per asset carrying the tag
+ * plus 12 bytes per distinct value. Values are compared without case, the same as FAssetDataTagMapSharedView::ContainsKeyValue.
+ */
+class FAssetTagValueIndex
+{
+public:
+	/** Builds the index from the assets that carry Tag */
+	FAssetTagValueIndex(FName Tag, const TArray<FAssetData*>& TagAssets);
+
+	/** Adds the assets whose value of the tag equals Value */
+	void FindAssets(const FString& Value, TSet<FAssetData*>& OutAssets) const;
+
+	/** Number of distinct values of the tag */
+	int32 GetNumValues() const
+	{
+		return ValueOffsets.Num() - 1;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+	/** Upper bound of the memory an index over NumAssets assets allocates */
+	static SIZE_T GetMaxAllocatedSize(int32 NumAssets);
+
+private:
+	/** Hash of a distinct value and its value id, sorted by hash */
+	struct FValueHash
+	{
+		uint32 Hash;
+		int32 ValueId;
+	};
+
+	FName Tag;
+
+	/** Assets grouped by value id, the assets with value id N start at ValueOffsets[N] */
+	TArray<FAssetData*> AssetsByValue;
+
+	/** Start of each value's group in AssetsByValue, with one extra entry for the end of the last group */
+	TArray<int32> ValueOffsets;
+
+	/** Case insensitive hashes of the distinct values */
+	TArray<FValueHash> ValueHashes;
+};
+
+/**
+ * Tag value indexes of an FAssetRegistryState, built on demand for tags that are frequently queried with a value.
+ * Indexes are dropped when an asset carrying their tag is added, changed or removed, and built again by later queries.
+ * Their memory is bounded by AssetRegistry.TagValueIndexBudgetKB, tags that do not fit are scanned.
+ */
+class FAssetTagValueIndexCache
+{
+public:
+	/** Number of value queries of a tag before it gets an index */
+	static constexpr int32 QueriesBeforeIndexing = 4;
+
+	/** Tags carried by fewer assets are cheap enough to scan and are never indexed */
+	static constexpr int32 MinAssetsToIndex = 256;
+
+	/** Adds the assets of TagAssets whose value of Tag equals Value, from the tag's index if it has one or from a scan otherwise */
+	void FindAssets(FName Tag, const FString& Value, const TArray<FAssetData*>& TagAssets, TSet<FAssetData*>& OutAssets);
+
+	/** Drops the indexes of every tag the asset carries, called before it is added, changed or removed */
+	void Invalidate(const FAssetData& AssetData);
+
+	/** Drops the index of a tag */
+	void Invalidate(FName Tag);
+
+	/** Drops every index and query count */
+	void Reset();
+
+	/** Number of tags that currently have an index */
+	int32 GetNumIndexes() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Memory of the indexes, CriticalSection must be held */
+	SIZE_T GetIndexesAllocatedSize() const;
+
+	mutable FCriticalSection CriticalSection;
+	TMap<FName, FAssetTagValueIndex> Indexes;
+	TMap<FName, int32> QueryCounts;
+};
@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AssetRegistry/AssetRegistryState.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetTagValueIndex.h"
+#include "HAL/IConsoleManager.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetTagValueIndexTest, "System.AssetRegistry.TagValueIndex", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AssetTagValueIndexTest
+{
+	static const int32 NumAssets = 50000;
+	static const int32 NumCategories = 32;
+	static const int32 NumQueries = 1000;
+
+	static FAssetData* MakeAssetData(int32 Index)
+	{
+		FAssetDataTagMap Tags;
+		Tags.Add(FName(TEXT("Category")), FString::Printf(TEXT("Category%d"), Index % NumCategories));
+		Tags.Add(FName(TEXT("Index")), FString::FromInt(Index));
+		if (Index % 2 == 0)
+		{
+			Tags.Add(FName(TEXT("Even")), TEXT("True"));
+		}
+
+		const FString PackagePath = FString::Printf(TEXT("/Game/TagValueIndexTest/Folder%d"), Index % 64);
+		return new FAssetData(FName(*FString::Printf(TEXT("%s/Asset%d"), *PackagePath, Index)), FName(*PackagePath), FName(*FString::Printf(TEXT("Asset%d"), Index)), FName(TEXT("StaticMesh")), MoveTemp(Tags));
+	}
+
+	static FARCompiledFilter MakeFilter(const TCHAR* Tag, const FString& Value)
+	{
+		FARCompiledFilter Filter;
+		Filter.TagsAndValues.Add(FName(Tag), Value);
+		return Filter;
+	}
+
+	static int32 CountAssets(const FAssetRegistryState& State, const FARCompiledFilter& Filter)
+	{
+		int32 NumFound = 0;
+		State.EnumerateAssets(Filter, TSet<FName>(), [&NumFound](const FAssetData&)
+		{
+			++NumFound;
+			return true;
+		});
+		return NumFound;
+	}
+}
+
+bool FAssetTagValueIndexTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetTagValueIndexTest;
+
+	FAssetRegistryState State;
+	for (int32 Index = 0; Index < NumAssets; ++Index)
+	{
+		State.AddAssetData(MakeAssetData(Index));
+	}
+	const uint32 SizeWithoutIndexes = State.GetAllocatedSize();
+
+	// The first queries of a tag scan its assets, later ones go through the index built for it
+	const int32 NumPerCategory = NumAssets / NumCategories;
+	double ScanTime = 0.0;
+	double IndexedTime = 0.0;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		const FARCompiledFilter Filter = MakeFilter(TEXT("Category"), FString::Printf(TEXT("Category%d"), QueryIndex % NumCategories));
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 NumFound = CountAssets(State, Filter);
+		(QueryIndex < FAssetTagValueIndexCache::QueriesBeforeIndexing - 1 ? ScanTime : IndexedTime) += FPlatformTime::Seconds() - StartTime;
+
+		if (NumFound != NumPerCategory)
+		{
+			AddError(FString::Printf(TEXT("Query %d found %d assets in a category instead of %d"), QueryIndex, NumFound, NumPerCategory));
+			return false;
+		}
+	}
+	const double ScanQueryTime = ScanTime / (FAssetTagValueIndexCache::QueriesBeforeIndexing - 1);
+	const double IndexedQueryTime = IndexedTime / (NumQueries - FAssetTagValueIndexCache::QueriesBeforeIndexing + 1);
+
+	TestEqual(TEXT("Values are compared without case"), CountAssets(State, MakeFilter(TEXT("Category"), TEXT("CATEGORY3"))), NumPerCategory);
+	TestEqual(TEXT("A value no asset has finds nothing"), CountAssets(State, MakeFilter(TEXT("Category"), TEXT("Missing"))), 0);
+
+	FARCompiledFilter CombinedFilter = MakeFilter(TEXT("Category"), TEXT("Category4"));
+	CombinedFilter.TagsAndValues.Add(FName(TEXT("Category")), FString(TEXT("Category5")));
+	TestEqual(TEXT("Values of the same tag are combined"), CountAssets(State, CombinedFilter), NumPerCategory * 2);
+
+	FARCompiledFilter ClassAndTagFilter = MakeFilter(TEXT("Category"), TEXT("Category6"));
+	ClassAndTagFilter.ClassNames.Add(FName(TEXT("StaticMesh")));
+	TestEqual(TEXT("Indexed tags intersect with other filters"), CountAssets(State, ClassAndTagFilter), NumPerCategory);
+
+	FARCompiledFilter TagOnlyFilter;
+	TagOnlyFilter.TagsAndValues.Add(FName(TEXT("Even")), TOptional<FString>());
+	TestEqual(TEXT("Tag queries without a value are unaffected"), CountAssets(State, TagOnlyFilter), NumAssets / 2);
+
+	const uint32 SizeWithIndexes = State.GetAllocatedSize();
+	TestTrue(TEXT("Index memory is reported"), SizeWithIndexes > SizeWithoutIndexes);
+
+	// Changing an asset drops the index of its tags, the next queries see the new value
+	FAssetData* ChangedAsset = MakeAssetData(NumAssets);
+	State.AddAssetData(ChangedAsset);
+	FAssetDataTagMap ChangedTags = ChangedAsset->TagsAndValues.GetMap();
+	ChangedTags.Add(FName(TEXT("Category")), TEXT("Changed"));
+	State.UpdateAssetData(ChangedAsset, FAssetData(ChangedAsset->PackageName, ChangedAsset->PackagePath, ChangedAsset->AssetName, ChangedAsset->AssetClass, ChangedTags));
+	for (int32 QueryIndex = 0; QueryIndex < FAssetTagValueIndexCache::QueriesBeforeIndexing + 1; ++QueryIndex)
+	{
+		TestEqual(TEXT("Updated values are found"), CountAssets(State, MakeFilter(TEXT("Category"), TEXT("Changed"))), 1);
+	}
+
+	bool bRemovedAssetData = false;
+	bool bRemovedPackageData = false;
+	State.RemoveAssetData(ChangedAsset, false, bRemovedAssetData, bRemovedPackageData);
+	for (int32 QueryIndex = 0; QueryIndex < FAssetTagValueIndexCache::QueriesBeforeIndexing + 1; ++QueryIndex)
+	{
+		TestEqual(TEXT("Removed assets are not found"), CountAssets(State, MakeFilter(TEXT("Category"), TEXT("Changed"))), 0);
+	}
+
+	// The indexes are an addition to the tag maps, report what they cost
+	AddInfo(FString::Printf(TEXT("%d assets: %.1f bytes per asset without indexes, %.1f with (the Category index adds %.1f); scanned query %.3f ms, indexed query %.3f ms"),
+		NumAssets, double(SizeWithoutIndexes) / NumAssets, double(SizeWithIndexes) / NumAssets, double(SizeWithIndexes - SizeWithoutIndexes) / NumAssets,
+		ScanQueryTime * 1000.0, IndexedQueryTime * 1000.0));
+	TestTrue(TEXT("An index costs about a pointer per asset"), SizeWithIndexes - SizeWithoutIndexes <= FAssetTagValueIndex::GetMaxAllocatedSize(NumAssets) + 1024);
+
+	// Tags whose index does not fit in the budget are scanned
+	IConsoleVariable* BudgetVar = IConsoleManager::Get().FindConsoleVariable(TEXT("AssetRegistry.TagValueIndexBudgetKB"));
+	if (TestNotNull(TEXT("AssetRegistry.TagValueIndexBudgetKB is registered"), BudgetVar))
+	{
+		const int32 PreviousBudget = BudgetVar->GetInt();
+		BudgetVar->Set(0, ECVF_SetByCode);
+
+		TArray<FAssetData*> TagAssets;
+		for (int32 Index = 0; Index < FAssetTagValueIndexCache::MinAssetsToIndex; ++Index)
+		{
+			TagAssets.Add(MakeAssetData(Index));
+		}
+		FAssetTagValueIndexCache Cache;
+		for (int32 QueryIndex = 0; QueryIndex < FAssetTagValueIndexCache::QueriesBeforeIndexing + 1; ++QueryIndex)
+		{
+			TSet<FAssetData*> Found;
+			Cache.FindAssets(FName(TEXT("Category")), TEXT("Category1"), TagAssets, Found);
+			TestEqual(TEXT("Scanned tags find the same assets"), Found.Num(), FAssetTagValueIndexCache::MinAssetsToIndex / NumCategories);
+		}
+		TestEqual(TEXT("No index is built without a budget"), Cache.GetNumIndexes(), 0);
+
+		BudgetVar->Set(PreviousBudget, ECVF_SetByCode);
+		for (FAssetData* AssetData : TagAssets)
+		{
+			delete AssetData;
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,467 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MappedAssetRegistryCache.h"
+#include "AssetRegistryPrivate.h"
+#include "DiskCachedAssetData.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MappedAssetRegistryCache
+{
+	static const uint32 Magic = 0x43524D41; // 'AMRC'
+	static const uint64 Alignment = 8;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		int32 SerializationVersion;
+		int32 RegistryVersion;
+		uint32 NumNames;
+		uint32 NumPackages;
+		uint32 NumBuckets;
+		uint64 NamesOffset;
+		uint64 StringsOffset;
+		uint64 StringsSize;
+		uint64 BucketsOffset;
+		uint64 PackagesOffset;
+		uint64 BlobsOffset;
+		uint64 FileSize;
+	};
+
+	/** Case insensitive hash of a package name, matching FName equality. */
+	static uint32 HashPackageName(FName PackageName)
+	{
+		FString NameString = PackageName.ToString();
+		NameString.ToLowerInline();
+		return FCrc::StrCrc32(*NameString);
+	}
+
+	static uint64 AlignOffset(uint64 Offset)
+	{
+		return Align(Offset, Alignment);
+	}
+}
+
+/** Entry of the name table, Length is negative for names stored as wide characters. */
+struct FMappedCacheNameRecord
+{
+	uint32 StringOffset;
+	int32 Length;
+};
+
+/** An FName stored as an index into the name table and its number. */
+struct FMappedCacheNameRef
+{
+	uint32 Index;
+	int32 Number;
+};
+
+struct FMappedCachePackageRecord
+{
+	FMappedCacheNameRef PackageName;
+	FMappedCacheNameRef Extension;
+	int64 TimestampTicks;
+	uint64 BlobOffset;
+	uint32 BlobSize;
+	uint32 NameHash;
+};
+
+static_assert(sizeof(FMappedCachePackageRecord) % MappedAssetRegistryCache::Alignment == 0, "Package records must stay aligned when stored back to back");
+static_assert(sizeof(WIDECHAR) == sizeof(uint16), "Wide names are stored as UTF-16 code units");
+
+/** Writes FNames of a package blob as references into the shared name table. */
+class FMappedAssetRegistryCacheWriter : public FMemoryWriter
+{
+public:
+	FMappedAssetRegistryCacheWriter(TArray<uint8>& InBytes, TMap<FNameEntryId, uint32>& InNameIndices, TArray<FNameEntryId>& InNames)
+		: FMemoryWriter(InBytes)
+		, NameIndices(InNameIndices)
+		, Names(InNames)
+	{
+	}
+
+	using FMemoryWriter::operator<<;
+
+	virtual FArchive& operator<<(FName& Name) override
+	{
+		FMappedCacheNameRef Ref = MakeRef(Name);
+		*this << Ref.Index;
+		*this << Ref.Number;
+		return *this;
+	}
+
+	FMappedCacheNameRef MakeRef(FName Name)
+	{
+		const FNameEntryId DisplayId = Name.GetDisplayIndex();
+		uint32* Index = NameIndices.Find(DisplayId);
+		if (!Index)
+		{
+			Index = &NameIndices.Add(DisplayId, Names.Add(DisplayId));
+		}
+		return FMappedCacheNameRef{ *Index, Name.GetNumber() };
+	}
+
+private:
+	TMap<FNameEntryId, uint32>& NameIndices;
+	TArray<FNameEntryId>& Names;
+};
+
+/** Reads a package blob, resolving names through the cache's name table. */
+class FMappedAssetRegistryCacheReader : public FMemoryReaderView
+{
+public:
+	FMappedAssetRegistryCacheReader(TArrayView<const uint8> InBytes, FMappedAssetRegistryCache& InCache)
+		: FMemoryReaderView(InBytes)
+		, Cache(InCache)
+	{
+	}
+
+	using FMemoryReaderView::operator<<;
+
+	virtual FArchive& operator<<(FName& Name) override
+	{
+		uint32 Index = 0;
+		int32 Number = 0;
+		*this << Index;
+		*this << Number;
+		if (IsError() || Index >= Cache.NumNames)
+		{
+			SetError();
+			Name = NAME_None;
+		}
+		else
+		{
+			Name = Cache.GetName(Index, Number);
+		}
+		return *this;
+	}
+
+private:
+	FMappedAssetRegistryCache& Cache;
+};
+
+TUniquePtr<FMappedAssetRegistryCache> FMappedAssetRegistryCache::Open(const FString& Filename, int32 SerializationVersion)
+{
+	TUniquePtr<FMappedAssetRegistryCache> Cache(new FMappedAssetRegistryCache());
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	Cache->MappedHandle = PlatformFile.OpenMapped(*Filename);
+	if (Cache->MappedHandle)
+	{
+		Cache->MappedRegion = Cache->MappedHandle->GetFileSize() > 0 ? Cache->MappedHandle->MapRegion() : nullptr;
+		if (Cache->MappedRegion)
+		{
+			Cache->Data = Cache->MappedRegion->GetMappedPtr();
+			Cache->DataSize = Cache->MappedRegion->GetMappedSize();
+		}
+	}
+	else if (FFileHelper::LoadFileToArray(Cache->LoadedBytes, *Filename, FILEREAD_Silent))
+	{
+		Cache->Data = Cache->LoadedBytes.GetData();
+		Cache->DataSize = Cache->LoadedBytes.Num();
+	}
+
+	if (!Cache->Data || !Cache->Initialize(SerializationVersion))
+	{
+		return nullptr;
+	}
+	return Cache;
+}
+
+FMappedAssetRegistryCache::~FMappedAssetRegistryCache()
+{
+	delete MappedRegion;
+	delete MappedHandle;
+}
+
+bool FMappedAssetRegistryCache::Initialize(int32 SerializationVersion)
+{
+	using namespace MappedAssetRegistryCache;
+
+	if (DataSize < (int64)sizeof(FHeader))
+	{
+		return false;
+	}
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(Data);
+	if (Header.Magic != MappedAssetRegistryCache::Magic ||
+		Header.SerializationVersion != SerializationVersion ||
+		Header.RegistryVersion != FAssetRegistryVersion::LatestVersion)
+	{
+		// Written by a different version, silently rebuild
+		return false;
+	}
+
+	const uint64 FileSize = (uint64)DataSize;
+	const bool bValid = Header.FileSize == FileSize &&
+		FMath::IsPowerOfTwo(Header.NumBuckets) && Header.NumBuckets > Header.NumPackages &&
+		Header.NamesOffset + (uint64)Header.NumNames * sizeof(FMappedCacheNameRecord) <= FileSize &&
+		Header.StringsOffset + Header.StringsSize <= FileSize &&
+		Header.BucketsOffset + (uint64)Header.NumBuckets * sizeof(uint32) <= FileSize &&
+		Header.PackagesOffset + (uint64)Header.NumPackages * sizeof(FMappedCachePackageRecord) <= FileSize &&
+		Header.BlobsOffset <= FileSize &&
+		Header.NamesOffset % Alignment == 0 && Header.BucketsOffset % Alignment == 0 && Header.PackagesOffset % Alignment == 0;
+	if (!bValid)
+	{
+		UE_LOG(LogAssetRegistry, Error, TEXT("There was an error loading the asset registry cache. Generating a new one."));
+		return false;
+	}
+
+	NumPackages = (int32)Header.NumPackages;
+	NumNames = Header.NumNames;
+	NumBuckets = Header.NumBuckets;
+	Names = reinterpret_cast<const FMappedCacheNameRecord*>(Data + Header.NamesOffset);
+	Strings = Data + Header.StringsOffset;
+	StringsSize = Header.StringsSize;
+	Buckets = reinterpret_cast<const uint32*>(Data + Header.BucketsOffset);
+	Packages = reinterpret_cast<const FMappedCachePackageRecord*>(Data + Header.PackagesOffset);
+	ResolvedNames.SetNumZeroed(NumNames);
+	return true;
+}
+
+FName FMappedAssetRegistryCache::GetName(uint32 NameIndex, int32 Number)
+{
+	FNameEntryId& DisplayId = ResolvedNames[NameIndex];
+	if (!DisplayId)
+	{
+		const FMappedCacheNameRecord& Record = Names[NameIndex];
+		const bool bWide = Record.Length < 0;
+		const uint64 Length = (uint64)FMath::Abs((int64)Record.Length);
+		const uint64 NumBytes = Length * (bWide ? sizeof(WIDECHAR) : sizeof(ANSICHAR));
+		if (Record.StringOffset + NumBytes > StringsSize || Length > NAME_SIZE)
+		{
+			return NAME_None;
+		}
+
+		const uint8* String = Strings + Record.StringOffset;
+		DisplayId = bWide ? FName((int32)Length, (const WIDECHAR*)String, 0).GetDisplayIndex() : FName((int32)Length, (const ANSICHAR*)String, 0).GetDisplayIndex();
+	}
+	return FName::CreateFromDisplayId(DisplayId, DisplayId ? Number : 0);
+}
+
+bool FMappedAssetRegistryCache::FindPackage(FName PackageName, FPackageView& OutView)
+{
+	if (NumPackages == 0)
+	{
+		return false;
+	}
+
+	const uint32 Hash = MappedAssetRegistryCache::HashPackageName(PackageName);
+	const uint32 BucketMask = NumBuckets - 1;
+	for (uint32 Probe = 0; Probe < NumBuckets; ++Probe)
+	{
+		const uint32 Slot = Buckets[(Hash + Probe) & BucketMask];
+		if (Slot == 0)
+		{
+			return false;
+		}
+
+		const uint32 PackageIndex = Slot - 1;
+		if (PackageIndex >= (uint32)NumPackages)
+		{
+			return false;
+		}
+
+		const FMappedCachePackageRecord& Record = Packages[PackageIndex];
+		if (Record.NameHash == Hash && Record.PackageName.Index < NumNames && GetName(Record.PackageName.Index, Record.PackageName.Number) == PackageName)
+		{
+			OutView.Timestamp = FDateTime(Record.TimestampTicks);
+			OutView.Extension = Record.Extension.Index < NumNames ? GetName(Record.Extension.Index, Record.Extension.Number) : NAME_None;
+			OutView.PackageIndex = (int32)PackageIndex;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FMappedAssetRegistryCache::Materialize(const FPackageView& View, FDiskCachedAssetData& OutData)
+{
+	check(View.PackageIndex >= 0 && View.PackageIndex < NumPackages);
+	const FMappedCachePackageRecord& Record = Packages[View.PackageIndex];
+	if (Record.BlobOffset + Record.BlobSize > (uint64)DataSize || Record.BlobSize > (uint32)MAX_int32)
+	{
+		return false;
+	}
+
+	FMappedAssetRegistryCacheReader Reader(MakeArrayView(Data + Record.BlobOffset, (int32)Record.BlobSize), *this);
+	OutData.SerializeForCache(Reader);
+	return !Reader.IsError();
+}
+
+SIZE_T FMappedAssetRegistryCache::GetAllocatedSize() const
+{
+	return sizeof(*this) + ResolvedNames.GetAllocatedSize() + LoadedBytes.GetAllocatedSize();
+}
+
+bool FMappedAssetRegistryCache::Save(const FString& Filename, int32 SerializationVersion, const TMap<FName, FDiskCachedAssetData*>& InPackages)
+{
+	TUniquePtr<FMappedAssetRegistryCache> NoCarryOver;
+	return Save(Filename, SerializationVersion, InPackages, NoCarryOver, [](FName) { return false; });
+}
+
+bool FMappedAssetRegistryCache::Save(const FString& Filename, int32 SerializationVersion, const TMap<FName, FDiskCachedAssetData*>& InPackages,
+	TUniquePtr<FMappedAssetRegistryCache>& CarryOverFrom, TFunctionRef<bool(FName PackageName)> ShouldCarryOver)
+{
+	using namespace MappedAssetRegistryCache;
+
+	const double SaveStartTime = FPlatformTime::Seconds();
+
+	// Serialize every package into one blob buffer, collecting the names they use
+	TMap<FNameEntryId, uint32> NameIndices;
+	TArray<FNameEntryId> NameIds;
+	TArray<uint8> Blobs;
+	TArray<FMappedCachePackageRecord> Records;
+	Records.Reserve(InPackages.Num() + (CarryOverFrom ? CarryOverFrom->Num() : 0));
+	int32 NumCarriedOver = 0;
+	{
+		FMappedAssetRegistryCacheWriter Writer(Blobs, NameIndices, NameIds);
+		auto WritePackage = [&Writer, &Records, &Blobs](FName PackageName, FDiskCachedAssetData& PackageData)
+		{
+			FMappedCachePackageRecord& Record = Records.AddDefaulted_GetRef();
+			Record.PackageName = Writer.MakeRef(PackageName);
+			Record.Extension = Writer.MakeRef(PackageData.Extension);
+			Record.TimestampTicks = PackageData.Timestamp.GetTicks();
+			Record.NameHash = HashPackageName(PackageName);
+			Record.BlobOffset = Blobs.Num();
+			PackageData.SerializeForCache(Writer);
+			Record.BlobSize = uint32(Blobs.Num() - Record.BlobOffset);
+		};
+
+		for (const TPair<FName, FDiskCachedAssetData*>& Pair : InPackages)
+		{
+			WritePackage(Pair.Key, *Pair.Value);
+		}
+
+		if (CarryOverFrom)
+		{
+			FMappedAssetRegistryCache& OldCache = *CarryOverFrom;
+			for (int32 PackageIndex = 0; PackageIndex < OldCache.NumPackages; ++PackageIndex)
+			{
+				const FMappedCachePackageRecord& OldRecord = OldCache.Packages[PackageIndex];
+				if (OldRecord.PackageName.Index >= OldCache.NumNames || OldRecord.Extension.Index >= OldCache.NumNames)
+				{
+					continue;
+				}
+
+				const FName PackageName = OldCache.GetName(OldRecord.PackageName.Index, OldRecord.PackageName.Number);
+				if (PackageName.IsNone() || InPackages.Contains(PackageName) || !ShouldCarryOver(PackageName))
+				{
+					continue;
+				}
+
+				FPackageView View;
+				View.PackageIndex = PackageIndex;
+				FDiskCachedAssetData PackageData;
+				if (OldCache.Materialize(View, PackageData))
+				{
+					WritePackage(PackageName, PackageData);
+					++NumCarriedOver;
+				}
+			}
+		}
+	}
+
+	// Name strings, narrow when possible
+	TArray<FMappedCacheNameRecord> NameRecords;
+	TArray<uint8> Strings;
+	NameRecords.Reserve(NameIds.Num());
+	for (FNameEntryId DisplayId : NameIds)
+	{
+		const FString NameString = FName::CreateFromDisplayId(DisplayId, 0).GetPlainNameString();
+		FMappedCacheNameRecord& NameRecord = NameRecords.AddDefaulted_GetRef();
+		NameRecord.StringOffset = Strings.Num();
+		if (FCString::IsPureAnsi(*NameString))
+		{
+			NameRecord.Length = NameString.Len();
+			for (TCHAR Char : NameString)
+			{
+				Strings.Add((uint8)Char);
+			}
+		}
+		else
+		{
+			NameRecord.Length = -NameString.Len();
+			Strings.Append((const uint8*)*NameString, NameString.Len() * sizeof(WIDECHAR));
+		}
+	}
+
+	// Open addressing index, at most half full
+	const uint32 NumBuckets = FMath::RoundUpToPowerOfTwo(FMath::Max(Records.Num() * 2, 16));
+	TArray<uint32> Buckets;
+	Buckets.SetNumZeroed(NumBuckets);
+	for (int32 PackageIndex = 0; PackageIndex < Records.Num(); ++PackageIndex)
+	{
+		uint32 Bucket = Records[PackageIndex].NameHash & (NumBuckets - 1);
+		while (Buckets[Bucket] != 0)
+		{
+			Bucket = (Bucket + 1) & (NumBuckets - 1);
+		}
+		Buckets[Bucket] = PackageIndex + 1;
+	}
+
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = MappedAssetRegistryCache::Magic;
+	Header.SerializationVersion = SerializationVersion;
+	Header.RegistryVersion = FAssetRegistryVersion::LatestVersion;
+	Header.NumNames = NameRecords.Num();
+	Header.NumPackages = Records.Num();
+	Header.NumBuckets = NumBuckets;
+	Header.NamesOffset = AlignOffset(sizeof(FHeader));
+	Header.StringsOffset = Header.NamesOffset + NameRecords.Num() * sizeof(FMappedCacheNameRecord);
+	Header.StringsSize = Strings.Num();
+	Header.BucketsOffset = AlignOffset(Header.StringsOffset + Header.StringsSize);
+	Header.PackagesOffset = AlignOffset(Header.BucketsOffset + NumBuckets * sizeof(uint32));
+	Header.BlobsOffset = Header.PackagesOffset + Records.Num() * sizeof(FMappedCachePackageRecord);
+	Header.FileSize = Header.BlobsOffset + Blobs.Num();
+	for (FMappedCachePackageRecord& Record : Records)
+	{
+		Record.BlobOffset += Header.BlobsOffset;
+	}
+
+	const FString TempFilename = Filename + TEXT(".tmp");
+	TUniquePtr<FArchive> FileAr(IFileManager::Get().CreateFileWriter(*TempFilename));
+	if (!FileAr)
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("Could not write the asset registry cache to %s"), *TempFilename);
+		CarryOverFrom.Reset();
+		return false;
+	}
+
+	auto WritePadding = [&FileAr](uint64 Offset)
+	{
+		static const uint8 Zeros[MappedAssetRegistryCache::Alignment] = {};
+		const int64 NumPadding = (int64)Offset - FileAr->Tell();
+		check(NumPadding >= 0 && NumPadding < (int64)MappedAssetRegistryCache::Alignment);
+		FileAr->Serialize((void*)Zeros, NumPadding);
+	};
+
+	FileAr->Serialize(&Header, sizeof(Header));
+	WritePadding(Header.NamesOffset);
+	FileAr->Serialize(NameRecords.GetData(), NameRecords.Num() * sizeof(FMappedCacheNameRecord));
+	FileAr->Serialize(Strings.GetData(), Strings.Num());
+	WritePadding(Header.BucketsOffset);
+	FileAr->Serialize(Buckets.GetData(), Buckets.Num() * sizeof(uint32));
+	WritePadding(Header.PackagesOffset);
+	FileAr->Serialize(Records.GetData(), Records.Num() * sizeof(FMappedCachePackageRecord));
+	FileAr->Serialize(Blobs.GetData(), Blobs.Num());
+
+	const bool bWriteSucceeded = !FileAr->IsError() && FileAr->Close();
+	FileAr.Reset();
+
+	// Release the old file before replacing it, some platforms can't move over a mapped file
+	CarryOverFrom.Reset();
+	if (!bWriteSucceeded || !IFileManager::Get().Move(*Filename, *TempFilename))
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("Could not write the asset registry cache to %s"), *Filename);
+		IFileManager::Get().Delete(*TempFilename);
+		return false;
+	}
+
+	UE_LOG(LogAssetRegistry, Verbose, TEXT("Asset data gatherer cache with %d packages (%d carried over) saved in %0.6f seconds"), Records.Num(), NumCarriedOver, FPlatformTime::Seconds() - SaveStartTime);
+	return true;
+}
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+class FDiskCachedAssetData;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Flat, offset based form of the asset data gatherer cache that is queried in place.
+ *
+ * The file holds a name table, an open addressing hash index of package names and one serialized FDiskCachedAssetData blob
+ * per package, with names written as indices into the shared table. Opening a cache maps the file and validates the header;
+ * nothing is deserialized until a package is looked up, and the timestamp and extension of a package are compared without
+ * touching its blob. Only the packages that are actually discovered get materialized into FDiskCachedAssetData, and the
+ * rest of the file stays in clean, evictable pages instead of being copied into the heap.
+ */
+class FMappedAssetRegistryCache
+{
+public:
+	/** Header fields of one cached package, read without deserializing its data. */
+	struct FPackageView
+	{
+		FDateTime Timestamp;
+		FName Extension;
+		int32 PackageIndex = INDEX_NONE;
+	};
+
+	/** Maps a cache file. Returns null if the file is missing, was written by a different version or fails validation. */
+	static TUniquePtr<FMappedAssetRegistryCache> Open(const FString& Filename, int32 SerializationVersion);
+
+	/** Writes the given packages as a cache file, going through a temporary file so a mapped copy is never partially overwritten. */
+	static bool Save(const FString& Filename, int32 SerializationVersion, const TMap<FName, FDiskCachedAssetData*>& Packages);
+
+	/**
+	 * Writes the given packages as a cache file along with the packages of CarryOverFrom that are not in Packages and pass ShouldCarryOver.
+	 * Carried over packages are deserialized one at a time while writing. CarryOverFrom is released once the new file is written, before
+	 * it replaces the old one, so it may be a mapping of the file being saved.
+	 */
+	static bool Save(const FString& Filename, int32 SerializationVersion, const TMap<FName, FDiskCachedAssetData*>& Packages,
+		TUniquePtr<FMappedAssetRegistryCache>& CarryOverFrom, TFunctionRef<bool(FName PackageName)> ShouldCarryOver);
+
+	~FMappedAssetRegistryCache();
+
+	/** Number of packages in the cache. */
+	int32 Num() const
+	{
+		return NumPackages;
+	}
+
+	/** Looks up a package by name. */
+	bool FindPackage(FName PackageName, FPackageView& OutView);
+
+	/** Deserializes the cached data of a package found with FindPackage. Returns false if the blob is corrupt. */
+	bool Materialize(const FPackageView& View, FDiskCachedAssetData& OutData);
+
+	/** Heap memory used to query the cache, not counting the mapped file. */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	friend class FMappedAssetRegistryCacheReader;
+
+	FMappedAssetRegistryCache() = default;
+
+	/** Resolves an entry of the name table, creating its FName the first time it is used. */
+	FName GetName(uint32 NameIndex, int32 Number);
+
+	/** Validates the header and the table bounds against the mapped size. */
+	bool Initialize(int32 SerializationVersion);
+
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+
+	/** Fallback storage when the platform can't map files. */
+	TArray64<uint8> LoadedBytes;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	int32 NumPackages = 0;
+	uint32 NumNames = 0;
+	uint32 NumBuckets = 0;
+	const struct FMappedCacheNameRecord* Names = nullptr;
+	const uint8* Strings = nullptr;
+	uint64 StringsSize = 0;
+	const uint32* Buckets = nullptr;
+	const struct FMappedCachePackageRecord* Packages = nullptr;
+
+	/** Name table entries resolved so far, a null id means not resolved yet. */
+	TArray<FNameEntryId> ResolvedNames;
+};
@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "MappedAssetRegistryCache.h"
+#include "DiskCachedAssetData.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/Paths.h"
+#include "NameTableArchive.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMappedAssetRegistryCacheTest, "System.AssetRegistry.MappedCache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace MappedAssetRegistryCacheTest
+{
+	static const int32 SerializationVersion = 1;
+	static const int32 NumPackages = 100000;
+
+	static FName MakePackageName(int32 Index)
+	{
+		return FName(*FString::Printf(TEXT("/Game/MappedCacheTest/Folder%d/Package_%d"), Index % 64, Index));
+	}
+
+	static FDiskCachedAssetData* MakeCachedAssetData(int32 Index)
+	{
+		const FName PackageName = MakePackageName(Index);
+		FDiskCachedAssetData* CachedAssetData = new FDiskCachedAssetData(FDateTime(2020, 1, 1) + FTimespan::FromSeconds(Index), FName(TEXT("uasset")));
+
+		FAssetDataTagMap Tags;
+		Tags.Add(FName(TEXT("Index")), FString::FromInt(Index));
+		Tags.Add(FName(TEXT("Category")), FString::Printf(TEXT("Category%d"), Index % 16));
+		CachedAssetData->AssetDataList.Emplace(PackageName, FName(*FString::Printf(TEXT("/Game/MappedCacheTest/Folder%d"), Index % 64)),
+			FName(TEXT("Package"), Index + 1), FName(TEXT("StaticMesh")), MoveTemp(Tags));
+
+		CachedAssetData->DependencyData.PackageName = PackageName;
+		CachedAssetData->DependencyData.PackageData.DiskSize = Index;
+		return CachedAssetData;
+	}
+
+	/** Writes the same packages in the FNameTableArchive layout the gatherer cache used before it was mapped. */
+	static void SaveLegacyCache(const FString& Filename, const TMap<FName, FDiskCachedAssetData*>& Packages)
+	{
+		FNameTableArchiveWriter Writer(SerializationVersion, Filename);
+		int32 LocalNumAssets = Packages.Num();
+		Writer << LocalNumAssets;
+		for (const TPair<FName, FDiskCachedAssetData*>& Pair : Packages)
+		{
+			FName PackageName = Pair.Key;
+			Writer << PackageName;
+			Pair.Value->SerializeForCache(Writer);
+		}
+	}
+
+	static bool LoadLegacyCache(const FString& Filename, TMap<FName, FDiskCachedAssetData>& OutPackages)
+	{
+		FNameTableArchiveReader Reader(SerializationVersion, Filename);
+		int32 LocalNumAssets = 0;
+		Reader << LocalNumAssets;
+		OutPackages.Reserve(LocalNumAssets);
+		for (int32 AssetIndex = 0; AssetIndex < LocalNumAssets && !Reader.IsError(); ++AssetIndex)
+		{
+			FName PackageName;
+			Reader << PackageName;
+			OutPackages.Add(PackageName).SerializeForCache(Reader);
+		}
+		return !Reader.IsError();
+	}
+
+	static int64 GetUsedPhysical()
+	{
+		return (int64)FPlatformMemory::GetStats().UsedPhysical;
+	}
+}
+
+bool FMappedAssetRegistryCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace MappedAssetRegistryCacheTest;
+
+	const FString LegacyFilename = FPaths::AutomationTransientDir() / TEXT("MappedCacheTest_Legacy.bin");
+	const FString MappedFilename = FPaths::AutomationTransientDir() / TEXT("MappedCacheTest_Mapped.bin");
+
+	{
+		TMap<FName, FDiskCachedAssetData*> Packages;
+		Packages.Reserve(NumPackages);
+		for (int32 Index = 0; Index < NumPackages; ++Index)
+		{
+			Packages.Add(MakePackageName(Index), MakeCachedAssetData(Index));
+		}
+
+		SaveLegacyCache(LegacyFilename, Packages);
+		TestTrue(TEXT("The mapped cache is saved"), FMappedAssetRegistryCache::Save(MappedFilename, SerializationVersion, Packages));
+
+		for (TPair<FName, FDiskCachedAssetData*>& Pair : Packages)
+		{
+			delete Pair.Value;
+		}
+	}
+
+	// Legacy: the whole file is deserialized up front
+	double LegacyLoadTime = 0.0;
+	int64 LegacyMemory = 0;
+	{
+		const int64 UsedBefore = GetUsedPhysical();
+		const double StartTime = FPlatformTime::Seconds();
+		TMap<FName, FDiskCachedAssetData> LegacyPackages;
+		const bool bLoaded = LoadLegacyCache(LegacyFilename, LegacyPackages);
+		LegacyLoadTime = FPlatformTime::Seconds() - StartTime;
+		LegacyMemory = GetUsedPhysical() - UsedBefore;
+
+		TestTrue(TEXT("The legacy cache is loaded"), bLoaded);
+		TestEqual(TEXT("The legacy cache holds every package"), LegacyPackages.Num(), NumPackages);
+	}
+
+	// Mapped: opening validates the header, and only the packages that are looked up get deserialized
+	{
+		const int64 UsedBefore = GetUsedPhysical();
+		const double StartTime = FPlatformTime::Seconds();
+		TUniquePtr<FMappedAssetRegistryCache> Cache = FMappedAssetRegistryCache::Open(MappedFilename, SerializationVersion);
+		const double OpenTime = FPlatformTime::Seconds() - StartTime;
+		const int64 OpenMemory = GetUsedPhysical() - UsedBefore;
+
+		if (!TestTrue(TEXT("The mapped cache is opened"), Cache.IsValid()))
+		{
+			return false;
+		}
+		TestEqual(TEXT("The mapped cache holds every package"), Cache->Num(), NumPackages);
+		TestFalse(TEXT("A cache written with another version is rejected"), FMappedAssetRegistryCache::Open(MappedFilename, SerializationVersion + 1).IsValid());
+
+		// Query every package in place, then materialize a sample of them
+		const double QueryStartTime = FPlatformTime::Seconds();
+		int32 NumFound = 0;
+		for (int32 Index = 0; Index < NumPackages; ++Index)
+		{
+			FMappedAssetRegistryCache::FPackageView View;
+			if (Cache->FindPackage(MakePackageName(Index), View) && View.Timestamp == FDateTime(2020, 1, 1) + FTimespan::FromSeconds(Index))
+			{
+				++NumFound;
+			}
+		}
+		const double QueryTime = FPlatformTime::Seconds() - QueryStartTime;
+		TestEqual(TEXT("Every package is found with its timestamp"), NumFound, NumPackages);
+
+		FMappedAssetRegistryCache::FPackageView MissingView;
+		TestFalse(TEXT("A package that was not saved is not found"), Cache->FindPackage(MakePackageName(NumPackages), MissingView));
+
+		for (int32 Index = 0; Index < NumPackages; Index += 997)
+		{
+			FMappedAssetRegistryCache::FPackageView View;
+			FDiskCachedAssetData CachedAssetData;
+			if (!Cache->FindPackage(MakePackageName(Index), View) || !TestTrue(TEXT("A package is materialized"), Cache->Materialize(View, CachedAssetData)))
+			{
+				continue;
+			}
+
+			TestEqual(TEXT("Extension round trips"), View.Extension, FName(TEXT("uasset")));
+			TestEqual(TEXT("Dependency package name round trips"), CachedAssetData.DependencyData.PackageName, MakePackageName(Index));
+			TestEqual(TEXT("Package data round trips"), CachedAssetData.DependencyData.PackageData.DiskSize, (int64)Index);
+			if (TestEqual(TEXT("Asset data round trips"), CachedAssetData.AssetDataList.Num(), 1))
+			{
+				const FAssetData& AssetData = CachedAssetData.AssetDataList[0];
+				TestEqual(TEXT("Numbered asset names round trip"), AssetData.AssetName, FName(TEXT("Package"), Index + 1));
+				FString IndexTag;
+				TestTrue(TEXT("Tags round trip"), AssetData.GetTagValue(FName(TEXT("Index")), IndexTag) && IndexTag == FString::FromInt(Index));
+			}
+		}
+
+		AddInfo(FString::Printf(TEXT("%d packages: legacy load %.2f ms using %lld KB, mapped open %.2f ms using %lld KB (%llu KB allocated by the cache), %d lookups %.2f ms"),
+			NumPackages, LegacyLoadTime * 1000.0, LegacyMemory / 1024, OpenTime * 1000.0, OpenMemory / 1024, (uint64)Cache->GetAllocatedSize() / 1024, NumPackages, QueryTime * 1000.0));
+	}
+
+	IFileManager::Get().Delete(*LegacyFilename);
+	IFileManager::Get().Delete(*MappedFilename);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
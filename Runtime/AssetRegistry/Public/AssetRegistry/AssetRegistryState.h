@@ -7,6 +7,7 @@
 #include "AssetRegistry/IAssetRegistry.h"
 #include "Misc/AssetRegistryInterface.h"
 
+class FAssetTagValueIndexCache;
 class FDependsNode;
 struct FARCompiledFilter;
 
@@ -387,6 +388,9 @@ private:
 	/** The map of asset tag to asset data for assets saved to disk */
 	TMap<FName, TArray<FAssetData*> > CachedAssetsByTag;
 
+	/** Value indexes of tags that are frequently queried with a value, built on demand by tag queries */
+	TUniquePtr<FAssetTagValueIndexCache> CachedTagValueIndexes;
+
 	/** A map of object names to dependency data */
 	TMap<FAssetIdentifier, FDependsNode*> CachedDependsNodes;
 
@@ -107,6 +107,18 @@ bool FCborReader::ReadNext(FCborContext& OutContext)
 		return true;
 	}
 
+	// A tag and the item it applies to are a single item of the parent context, which is counted when reading the item
+	if (OutContext.MajorType() == ECborCode::Tag)
+	{
+		OutContext.UIntValue = ReadUIntValue(OutContext, *Stream);
+		if (OutContext.IsError())
+		{
+			SetError(OutContext.RawCode());
+			return false;
+		}
+		return true;
+	}
+
 	// if the type is indefinite, we increment the length of the parent context
 	if (ParentContext.IsIndefiniteContainer())
 	{
@@ -160,9 +172,6 @@ bool FCborReader::ReadNext(FCborContext& OutContext)
 			OutContext.Length = OutContext.AdditionalValue() == ECborCode::Indefinite ? 0 : ReadUIntValue(OutContext, *Stream) * 2;
 			ContextStack.Push(OutContext);
 			break;
-		case ECborCode::Tag:
-			OutContext.UIntValue = ReadUIntValue(OutContext, *Stream);
-			break;
 		case ECborCode::Prim:
 			ReadPrimValue(OutContext, *Stream);
 			break;
@@ -149,6 +149,21 @@ void FCborWriter::WriteValue(const uint8* Bytes, uint64 Length)
 	WriteValue(reinterpret_cast<const char*>(Bytes), Length);
 }
 
+void FCborWriter::WriteTag(uint64 Tag)
+{
+	ScopedCborArchiveEndianness ScopedArchiveEndianness(*Stream, Endianness);
+
+	// The tagged item accounts for the tag in the context
+	WriteUIntValue(ECborCode::Tag, *Stream, Tag);
+}
+
+void FCborWriter::WriteTypedArray(ECborTypedArrayType Type, const void* Elements, int64 NumElements)
+{
+	check(NumElements >= 0);
+	WriteTag(CborTypedArray::GetTag(Type));
+	WriteValue(static_cast<const uint8*>(Elements), (uint64)(NumElements * CborTypedArray::GetElementSize(Type)));
+}
+
 FCborHeader FCborWriter::WriteUIntValue(FCborHeader Header, FArchive& Ar, uint64 Value)
 {
 	if (Value < 24)
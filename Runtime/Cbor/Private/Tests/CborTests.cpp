@@ -261,6 +261,38 @@ bool FCborAutomationTest::RunTest(const FString& Parameters)
 		check(Context.IsBreak());
 		check(Context.AsLength() == IntArray.Num());
 
+		// Tagged items in a finite array, a tag and its item count as a single item
+		TArray<float> FloatArray { 0.0f, 1.5f, -2.25f, 3.0e20f };
+		Writer.WriteContainerStart(ECborCode::Array, 2);
+		Writer.WriteTypedArray(ECborTypedArrayType::Float, FloatArray.GetData(), FloatArray.Num());
+		Writer.WriteTag(1); // Epoch based date/time
+		Writer.WriteValue((int64)1363896240);
+
+		check(Reader.ReadNext(Context) == true);
+		check(Context.MajorType() == ECborCode::Array);
+		check(Context.AsLength() == 2);
+
+		ECborTypedArrayType TypedArrayType;
+		bool bTypedArrayByteSwapped;
+		check(Reader.ReadNext(Context) == true);
+		check(Context.MajorType() == ECborCode::Tag);
+		check(CborTypedArray::ParseTag(Context.AsTag(), TypedArrayType, bTypedArrayByteSwapped));
+		check(TypedArrayType == ECborTypedArrayType::Float && !bTypedArrayByteSwapped);
+		check(Reader.ReadNext(Context) == true);
+		check(Context.MajorType() == ECborCode::ByteString);
+		check(Context.AsByteArray().Num() == FloatArray.Num() * sizeof(float));
+		check(FMemory::Memcmp(FloatArray.GetData(), Context.AsByteArray().GetData(), FloatArray.Num() * sizeof(float)) == 0);
+
+		check(Reader.ReadNext(Context) == true);
+		check(Context.MajorType() == ECborCode::Tag);
+		check(Context.AsTag() == 1);
+		check(Reader.ReadNext(Context) == true);
+		check(Context.AsInt() == 1363896240);
+
+		check(Reader.ReadNext(Context) == true);
+		check(Context.IsBreak());
+		check(Context.AsLength() == 0);
+
 		// Map
 		TMap<FString, FString> StringMap = { {TEXT("Apple"), TEXT("Orange")}, {TEXT("Potato"), TEXT("Tomato")}, {TEXT("Meat"), TEXT("Treat")} };
 		Writer.WriteContainerStart(ECborCode::Map, StringMap.Num());
@@ -331,6 +363,29 @@ bool FCborAutomationTest::RunTest(const FString& Parameters)
 		check(BytesPlatform == Bytes);
 	}
 
+	// Ensure typed array tags match RFC 8746.
+	{
+		const uint64 LittleEndianBit = PLATFORM_LITTLE_ENDIAN ? 4 : 0;
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Uint8) == 64);
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Int8) == 72);
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Uint16) == (65 | LittleEndianBit));
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Uint64) == (67 | LittleEndianBit));
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Int32) == (74 | LittleEndianBit));
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Float) == (81 | LittleEndianBit));
+		check(CborTypedArray::GetTag(ECborTypedArrayType::Double) == (82 | LittleEndianBit));
+
+		ECborTypedArrayType Type;
+		bool bByteSwapped;
+		check(CborTypedArray::ParseTag(68, Type, bByteSwapped) && Type == ECborTypedArrayType::Uint8 && !bByteSwapped); // Clamped
+		check(CborTypedArray::ParseTag(79, Type, bByteSwapped) && Type == ECborTypedArrayType::Int64 && bByteSwapped == !PLATFORM_LITTLE_ENDIAN);
+		check(CborTypedArray::ParseTag(70, Type, bByteSwapped) && Type == ECborTypedArrayType::Uint32 && bByteSwapped == !PLATFORM_LITTLE_ENDIAN);
+		check(CborTypedArray::ParseTag(82, Type, bByteSwapped) && Type == ECborTypedArrayType::Double && bByteSwapped == !!PLATFORM_LITTLE_ENDIAN);
+		check(!CborTypedArray::ParseTag(76, Type, bByteSwapped)); // Reserved
+		check(!CborTypedArray::ParseTag(80, Type, bByteSwapped)); // Half floats
+		check(!CborTypedArray::ParseTag(87, Type, bByteSwapped)); // Quad floats
+		check(!CborTypedArray::ParseTag(1, Type, bByteSwapped));
+	}
+
 	// Run full types check for each supported endianness.
 	return RunWithEndiannessFn(ECborEndianness::LittleEndian) && RunWithEndiannessFn(ECborEndianness::BigEndian);
 }
@@ -227,6 +227,13 @@ struct FCborContext
 		return IntValue;
 	}
 
+	/** @return the context as a semantic tag number. */
+	uint64 AsTag() const
+	{
+		check(MajorType() == ECborCode::Tag);
+		return UIntValue;
+	}
+
 	/** @return the context as a bool. */
 	bool AsBool() const
 	{
@@ -295,6 +302,117 @@ private:
 	TArray<char> RawTextValue;
 };
 
+/** Element types of CBOR typed arrays, which are byte strings tagged with the type and endianness of their elements. */
+enum class ECborTypedArrayType : uint8
+{
+	Uint8,
+	Uint16,
+	Uint32,
+	Uint64,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	Float,
+	Double,
+};
+
+/**
+ * Helpers for the typed array tags of RFC 8746.
+ * @see https://tools.ietf.org/html/rfc8746
+ */
+namespace CborTypedArray
+{
+	/** First and last tags reserved by RFC 8746 for typed arrays. */
+	constexpr const uint64 FirstTag = 64;
+	constexpr const uint64 LastTag = 87;
+
+	/**
+	 * Tag of the Unreal specific arrays of structures written column by column, as an array holding the number of structures
+	 * and a map from property names to the typed arrays of their values. It isn't registered, so only Unreal reads it.
+	 */
+	constexpr const uint64 StructColumnsTag = 0x55454353;
+
+	/** @return the size in bytes of an element of the given type. */
+	static FORCEINLINE int32 GetElementSize(ECborTypedArrayType Type)
+	{
+		switch (Type)
+		{
+		case ECborTypedArrayType::Uint8:
+		case ECborTypedArrayType::Int8:
+			return 1;
+		case ECborTypedArrayType::Uint16:
+		case ECborTypedArrayType::Int16:
+			return 2;
+		case ECborTypedArrayType::Uint32:
+		case ECborTypedArrayType::Int32:
+		case ECborTypedArrayType::Float:
+			return 4;
+		default:
+			return 8;
+		}
+	}
+
+	/** @return the tag of a typed array of the given type whose elements are stored in the platform endianness. */
+	static FORCEINLINE uint64 GetTag(ECborTypedArrayType Type)
+	{
+		// Tags are 0b010_f_s_e_ll: floating point, signed, little endian and log2 of the element size (of the float size minus one).
+		const uint64 bFloat = Type == ECborTypedArrayType::Float || Type == ECborTypedArrayType::Double;
+		const uint64 bSigned = Type >= ECborTypedArrayType::Int8 && Type <= ECborTypedArrayType::Int64;
+		const uint64 bLittleEndian = PLATFORM_LITTLE_ENDIAN != 0 && GetElementSize(Type) > 1; // The bit means clamped or is reserved for 8 bit integers
+		const uint64 SizeBits = bFloat ? (Type == ECborTypedArrayType::Float ? 1 : 2) : FMath::FloorLog2(GetElementSize(Type));
+		return FirstTag | (bFloat << 4) | (bSigned << 3) | (bLittleEndian << 2) | SizeBits;
+	}
+
+	/**
+	 * Parses the tag of a typed array.
+	 * @param Tag The tag to parse.
+	 * @param OutType The type of the elements of the array.
+	 * @param bOutByteSwapped Whether the elements are stored in the other endianness than the platform one.
+	 * @return false if this isn't a typed array tag, or the elements are half or quad precision floats, which aren't supported.
+	 */
+	static FORCEINLINE bool ParseTag(uint64 Tag, ECborTypedArrayType& OutType, bool& bOutByteSwapped)
+	{
+		if (Tag < FirstTag || Tag > LastTag)
+		{
+			return false;
+		}
+
+		const bool bFloat = (Tag & (1 << 4)) != 0;
+		const bool bSigned = (Tag & (1 << 3)) != 0;
+		const bool bLittleEndian = (Tag & (1 << 2)) != 0;
+		const uint64 SizeBits = Tag & 3;
+
+		if (bFloat)
+		{
+			if (SizeBits != 1 && SizeBits != 2)
+			{
+				return false;
+			}
+			OutType = SizeBits == 1 ? ECborTypedArrayType::Float : ECborTypedArrayType::Double;
+		}
+		else if (SizeBits == 0)
+		{
+			// Clamped uint8 reads as uint8, the signed counterpart is reserved
+			if (bSigned && bLittleEndian)
+			{
+				return false;
+			}
+			OutType = bSigned ? ECborTypedArrayType::Int8 : ECborTypedArrayType::Uint8;
+			bOutByteSwapped = false;
+			return true;
+		}
+		else
+		{
+			const ECborTypedArrayType FirstType = bSigned ? ECborTypedArrayType::Int8 : ECborTypedArrayType::Uint8;
+			OutType = (ECborTypedArrayType)((uint8)FirstType + SizeBits);
+		}
+
+		bOutByteSwapped = bLittleEndian != (PLATFORM_LITTLE_ENDIAN != 0);
+		return true;
+	}
+}
+
 /** Defines in which endianness the CBOR data must be written. The official endiannes is 'big endian' but Unreal use both. */
 enum class ECborEndianness
 {
@@ -47,6 +47,21 @@ public:
 	void WriteValue(const char* CString, uint64 Length);
 	void WriteValue(const uint8* Bytes, uint64 Length);
 
+	/**
+	 * Write a semantic tag, which applies to the next item written. The tag and its item count as a single item of their container.
+	 * @param Tag the tag number.
+	 */
+	void WriteTag(uint64 Tag);
+
+	/**
+	 * Write a typed array, a byte string tagged with the type of its elements, which are written as is in the platform endianness.
+	 * @param Type the type of the elements.
+	 * @param Elements the elements to write.
+	 * @param NumElements the number of elements.
+	 * @see https://tools.ietf.org/html/rfc8746
+	 */
+	void WriteTypedArray(ECborTypedArrayType Type, const void* Elements, int64 NumElements);
+
 private:
 	/** Write a uint Value for Header in Ar and return the final generated cbor Header. */
 	static FCborHeader WriteUIntValue(FCborHeader Header, FArchive& Ar, uint64 Value);
@@ -81,6 +81,20 @@ static FAutoConsoleVariableRef CVarTestDontCompleteUntilForAlreadyComplete(
 
 UE_DEPRECATED(4.26, "No longer supported") CORE_API int32 GEnablePowerSavingThreadPriorityReductionCVar = 0;
 
+static int32 GTaskGraphUseWorkStealing = 0;
+static FAutoConsoleVariableRef CVarTaskGraphUseWorkStealing(
+	TEXT("TaskGraph.UseWorkStealing"),
+	GTaskGraphUseWorkStealing,
+	TEXT("If 1, any thread tasks queued from a worker thread for its own priority set go to a per worker deque that idle workers of the set steal from. If 0, all any thread tasks go through the shared incoming queues.")
+);
+
+static int32 GTaskGraphWorkStealingSpinCount = 32;
+static FAutoConsoleVariableRef CVarTaskGraphWorkStealingSpinCount(
+	TEXT("TaskGraph.WorkStealingSpinCount"),
+	GTaskGraphWorkStealingSpinCount,
+	TEXT("Number of times an idle worker looks for work to steal before it goes to sleep. Only used when TaskGraph.UseWorkStealing is 1.")
+);
+
 CORE_API bool GAllowTaskGraphForkMultithreading = true;
 static FAutoConsoleVariableRef CVarEnableForkedMultithreading(
 	TEXT("TaskGraph.EnableForkedMultithreading"),
@@ -1153,6 +1167,132 @@ struct FWorkerThread
 	}
 };
 
+/**
+*	FWorkStealingQueue
+*	Bounded Chase-Lev deque of tasks. The owning worker pushes and pops at the bottom (LIFO), other workers steal from the top (FIFO).
+**/
+class FWorkStealingQueue : public FNoncopyable
+{
+public:
+	enum
+	{
+		/** Must be a power of two. When the deque is full, tasks go to the shared incoming queue instead. **/
+		Capacity = 256
+	};
+
+	FWorkStealingQueue()
+		: Top(0)
+		, Bottom(0)
+	{
+		for (TAtomic<FBaseGraphTask*>& Item : Items)
+		{
+			Item.Store(nullptr, EMemoryOrder::Relaxed);
+		}
+	}
+
+	/** Called from the owning worker only. @return false if the deque is full. **/
+	bool Push(FBaseGraphTask* Task)
+	{
+		const int64 LocalBottom = Bottom.Load(EMemoryOrder::Relaxed);
+		if (LocalBottom - Top.Load() >= Capacity)
+		{
+			return false;
+		}
+		Items[LocalBottom & (Capacity - 1)].Store(Task, EMemoryOrder::Relaxed);
+		Bottom.Store(LocalBottom + 1);
+		return true;
+	}
+
+	/** Called from the owning worker only. @return the most recently pushed task or nullptr if the deque is empty. **/
+	FBaseGraphTask* Pop()
+	{
+		const int64 LocalBottom = Bottom.Load(EMemoryOrder::Relaxed) - 1;
+		Bottom.Store(LocalBottom);
+		int64 LocalTop = Top.Load();
+		if (LocalTop > LocalBottom)
+		{
+			Bottom.Store(LocalBottom + 1, EMemoryOrder::Relaxed);
+			return nullptr;
+		}
+		FBaseGraphTask* Task = Items[LocalBottom & (Capacity - 1)].Load(EMemoryOrder::Relaxed);
+		if (LocalTop == LocalBottom)
+		{
+			// last item, race the thieves for it
+			if (!Top.CompareExchange(LocalTop, LocalTop + 1))
+			{
+				Task = nullptr;
+			}
+			Bottom.Store(LocalBottom + 1, EMemoryOrder::Relaxed);
+		}
+		return Task;
+	}
+
+	/** 
+	 *	Called from any thread.
+	 *	@param bOutContended; set to true if the deque was not empty but another thread won the race for the task.
+	 *	@return the oldest task or nullptr.
+	**/
+	FBaseGraphTask* Steal(bool& bOutContended)
+	{
+		int64 LocalTop = Top.Load();
+		const int64 LocalBottom = Bottom.Load();
+		if (LocalTop >= LocalBottom)
+		{
+			return nullptr;
+		}
+		FBaseGraphTask* Task = Items[LocalTop & (Capacity - 1)].Load(EMemoryOrder::Relaxed);
+		if (!Top.CompareExchange(LocalTop, LocalTop + 1))
+		{
+			bOutContended = true;
+			return nullptr;
+		}
+		return Task;
+	}
+
+private:
+	/** Index of the oldest task, advanced by thieves and by the owner when it takes the last task. **/
+	TAtomic<int64> Top;
+	uint8 PadToAvoidContention1[PLATFORM_CACHE_LINE_SIZE];
+	/** Index one past the newest task, only written by the owner. **/
+	TAtomic<int64> Bottom;
+	uint8 PadToAvoidContention2[PLATFORM_CACHE_LINE_SIZE];
+	TAtomic<FBaseGraphTask*> Items[Capacity];
+};
+
+/** 
+*	FWorkStealingWorkerState
+*	Per worker thread state of the work stealing scheduler. Only the queues are accessed by other threads.
+**/
+struct FWorkStealingWorkerState
+{
+	/** Local deques indexed by task priority, 0 is high task priority. **/
+	FWorkStealingQueue Queues[2];
+	/** State of the xorshift generator used to pick the first victim. **/
+	uint32 RandomState;
+	/** True if this worker is counted in NumIdleWorkers of its priority set. **/
+	bool bCountedAsIdle;
+
+	FWorkStealingWorkerState()
+		: RandomState(0)
+		, bCountedAsIdle(false)
+	{
+	}
+
+	FBaseGraphTask* PopLocal()
+	{
+		FBaseGraphTask* Task = Queues[0].Pop();
+		return Task ? Task : Queues[1].Pop();
+	}
+
+	uint32 NextRandom()
+	{
+		RandomState ^= RandomState << 13;
+		RandomState ^= RandomState >> 17;
+		RandomState ^= RandomState << 5;
+		return RandomState;
+	}
+};
+
 /**
 *	FTaskGraphImplementation
 *	Implementation of the centralized part of the task graph system.
@@ -1183,6 +1323,10 @@ public:
 	{
 		bCreatedHiPriorityThreads = !!ENamedThreads::bHasHighPriorityThreads;
 		bCreatedBackgroundPriorityThreads = !!ENamedThreads::bHasBackgroundThreads;
+		for (TAtomic<int32>& NumIdle : NumIdleWorkers)
+		{
+			NumIdle.Store(0, EMemoryOrder::Relaxed);
+		}
 
 		int32 MaxTaskThreads = MAX_THREADS;
 		int32 NumTaskThreads = FPlatformMisc::NumberOfWorkerThreadsToSpawn();
@@ -1230,6 +1374,11 @@ public:
 		UE_LOG(LogTaskGraph, Log, TEXT("Started task graph with %d named threads and %d total threads with %d sets of task threads."), NumNamedThreads, NumThreads, NumTaskThreadSets);
 		check(NumThreads - NumNamedThreads >= 1);  // need at least one pure worker thread
 		check(NumThreads <= MAX_THREADS);
+		WorkStealingStates = new FWorkStealingWorkerState[NumThreads - NumNamedThreads];
+		for (int32 StateIndex = 0; StateIndex < NumThreads - NumNamedThreads; StateIndex++)
+		{
+			WorkStealingStates[StateIndex].RandomState = 0x9E3779B9u * uint32(StateIndex + 1);
+		}
 		check(!ReentrancyCheck.GetValue()); // reentrant?
 		ReentrancyCheck.Increment(); // just checking for reentrancy
 		PerThreadIDTLSSlot = FPlatformTLS::AllocTlsSlot();
@@ -1343,6 +1492,8 @@ public:
 		}
 		TaskGraphImplementationSingleton = NULL;
 		NumTaskThreadsPerSet = 0;
+		delete[] WorkStealingStates;
+		WorkStealingStates = nullptr;
 		FPlatformTLS::FreeTlsSlot(PerThreadIDTLSSlot);
 	}
 
@@ -1377,6 +1528,10 @@ public:
 				}
 				uint32 PriIndex = TaskPriority ? 0 : 1;
 				check(Priority >= 0 && Priority < MAX_THREAD_PRIORITIES);
+				if (GTaskGraphUseWorkStealing && QueueTaskToLocalWorker(Task, Priority, PriIndex))
+				{
+					return;
+				}
 				{
 					TASKGRAPH_SCOPE_CYCLE_COUNTER(4, STAT_TaskGraph_QueueTask_IncomingAnyThreadTasks_Push);
 					int32 IndexToStart = IncomingAnyThreadTasks[Priority].Push(Task, PriIndex);
@@ -1622,7 +1777,150 @@ public:
 			MyIndex < (PLATFORM_64BITS ? 63 : 32) &&
 			Priority >= 0 && Priority < ENamedThreads::NumThreadPriorities);
 
-		return IncomingAnyThreadTasks[Priority].Pop(MyIndex, true);
+		FWorkStealingWorkerState& LocalState = WorkStealingStates[ThreadInNeed - NumNamedThreads];
+		if (LocalState.bCountedAsIdle)
+		{
+			// we stalled last time around and have been woken up
+			LocalState.bCountedAsIdle = false;
+			NumIdleWorkers[Priority].DecrementExchange();
+		}
+
+		if (!GTaskGraphUseWorkStealing || !FTaskGraphInterface::IsMultithread())
+		{
+			// the local deque is drained even if work stealing was switched off after tasks were pushed to it
+			FBaseGraphTask* Task = LocalState.PopLocal();
+			return Task ? Task : IncomingAnyThreadTasks[Priority].Pop(MyIndex, true);
+		}
+
+		FBaseGraphTask* Task = nullptr;
+		for (int32 Spin = 0; ; Spin++)
+		{
+			Task = FindWorkStealingTask(Priority, MyIndex, LocalState);
+			if (Task || Spin >= GTaskGraphWorkStealingSpinCount)
+			{
+				break;
+			}
+			FPlatformProcess::Yield();
+		}
+		if (Task)
+		{
+			return Task;
+		}
+
+		// Announce that we are going idle before the final look around. A worker pushing to its local deque concurrently either sees
+		// the count and hands a task to the incoming queue, which wakes us, or we find its task here. Our own deque stays empty from now on.
+		LocalState.bCountedAsIdle = true;
+		NumIdleWorkers[Priority].IncrementExchange();
+		Task = StealTask(Priority, MyIndex, 0, LocalState);
+		if (!Task)
+		{
+			Task = IncomingAnyThreadTasks[Priority].PopPriority(0);
+		}
+		if (!Task)
+		{
+			Task = StealTask(Priority, MyIndex, 1, LocalState);
+		}
+		if (!Task)
+		{
+			Task = IncomingAnyThreadTasks[Priority].Pop(MyIndex, true);
+		}
+		if (Task)
+		{
+			LocalState.bCountedAsIdle = false;
+			NumIdleWorkers[Priority].DecrementExchange();
+		}
+		return Task;
+	}
+
+	/** 
+	 *	Looks for a task for a worker of the work stealing scheduler, high task priority first: from the local deque, then the incoming queue, 
+	 *	then the deques of the other workers of the set, before moving on to normal task priority.
+	**/
+	FBaseGraphTask* FindWorkStealingTask(int32 Priority, int32 MyIndex, FWorkStealingWorkerState& LocalState)
+	{
+		for (uint32 PriIndex = 0; PriIndex < 2; PriIndex++)
+		{
+			FBaseGraphTask* Task = LocalState.Queues[PriIndex].Pop();
+			if (!Task)
+			{
+				Task = IncomingAnyThreadTasks[Priority].PopPriority(PriIndex);
+			}
+			if (!Task)
+			{
+				Task = StealTask(Priority, MyIndex, PriIndex, LocalState);
+			}
+			if (Task)
+			{
+				return Task;
+			}
+		}
+		return nullptr;
+	}
+
+	/** 
+	 *	Tries to steal a task of one task priority from the local deques of the other workers in a priority set, starting at a random victim.
+	 *	Keeps trying as long as there was contention, so a nullptr return means all deques were seen empty.
+	**/
+	FBaseGraphTask* StealTask(int32 Priority, int32 MyIndex, uint32 PriIndex, FWorkStealingWorkerState& LocalState)
+	{
+		FWorkStealingWorkerState* SetStates = WorkStealingStates + Priority * NumTaskThreadsPerSet;
+		bool bContended;
+		do
+		{
+			bContended = false;
+			const int32 FirstVictim = int32(LocalState.NextRandom() % uint32(NumTaskThreadsPerSet));
+			for (int32 Offset = 0; Offset < NumTaskThreadsPerSet; Offset++)
+			{
+				const int32 Victim = (FirstVictim + Offset) % NumTaskThreadsPerSet;
+				if (Victim != MyIndex)
+				{
+					FBaseGraphTask* Task = SetStates[Victim].Queues[PriIndex].Steal(bContended);
+					if (Task)
+					{
+						return Task;
+					}
+				}
+			}
+		} while (bContended);
+		return nullptr;
+	}
+
+	/** 
+	 *	Queues an any thread task to the local deque of the calling worker thread.
+	 *	Only done if the caller is a worker of the target priority set and no worker of that set is going idle, otherwise the shared incoming queue is responsible for waking them.
+	 *	@return true if the task was queued.
+	**/
+	bool QueueTaskToLocalWorker(FBaseGraphTask* Task, int32 Priority, uint32 PriIndex)
+	{
+		FWorkerThread* TLSPointer = (FWorkerThread*)FPlatformTLS::GetTlsValue(PerThreadIDTLSSlot);
+		if (!TLSPointer)
+		{
+			return false;
+		}
+		const int32 ThreadIndex = UE_PTRDIFF_TO_INT32(TLSPointer - WorkerThreads);
+		if (ThreadIndex < NumNamedThreads || ThreadIndexToPriorityIndex(ThreadIndex) != Priority || NumIdleWorkers[Priority].Load(EMemoryOrder::Relaxed) > 0)
+		{
+			return false;
+		}
+		FWorkStealingQueue& LocalQueue = WorkStealingStates[ThreadIndex - NumNamedThreads].Queues[PriIndex];
+		if (!LocalQueue.Push(Task))
+		{
+			return false;
+		}
+		if (NumIdleWorkers[Priority].Load() > 0)
+		{
+			// a worker started going idle while we were pushing, hand a task over to the incoming queue so it gets woken up
+			FBaseGraphTask* HandOffTask = LocalQueue.Pop();
+			if (HandOffTask)
+			{
+				int32 IndexToStart = IncomingAnyThreadTasks[Priority].Push(HandOffTask, PriIndex);
+				if (IndexToStart >= 0)
+				{
+					StartTaskThread(Priority, IndexToStart);
+				}
+			}
+		}
+		return true;
 	}
 
 	void StallForTuning(int32 Index, bool Stall)
@@ -1730,6 +2028,11 @@ private:
 	TArray<TFunction<void()> > ShutdownCallbacks;
 
 	FStallingTaskQueue<FBaseGraphTask, PLATFORM_CACHE_LINE_SIZE, 2>	IncomingAnyThreadTasks[MAX_THREAD_PRIORITIES];
+
+	/** Work stealing state of the unnamed threads, indexed by thread index - NumNamedThreads. **/
+	FWorkStealingWorkerState* WorkStealingStates;
+	/** Number of workers per priority set that are going idle or are stalled. While non-zero, tasks are not pushed to local deques. **/
+	TAtomic<int32> NumIdleWorkers[MAX_THREAD_PRIORITIES];
 };
 
 
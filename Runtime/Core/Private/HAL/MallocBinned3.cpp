@@ -13,6 +13,7 @@ PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 #include "HAL/IConsoleManager.h"
 #include "HAL/MemoryMisc.h"
 #include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
 
 #if USE_CACHED_PAGE_ALLOCATOR_FOR_LARGE_ALLOCS
 #include "HAL/Allocators/CachedOSPageAllocator.h"
@@ -92,6 +93,11 @@ int64 Binned3TLSMemory = 0;
 TAtomic<int64> Binned3TotalPoolSearches;
 TAtomic<int64> Binned3TotalPointerTests;
 
+TAtomic<int64> Binned3MutexWaits; // number of times the allocator mutex was already held when a thread wanted it
+TAtomic<int64> Binned3MutexWaitCycles;
+TAtomic<int64> Binned3CrossArenaBundles; // bundles freed on one CPU and picked up by a thread running on another
+TAtomic<int64> Binned3DeferredBundleFrees; // bundles handed to the deferred free queue instead of waiting for the mutex
+
 
 #endif
 
@@ -520,12 +526,65 @@ struct FMallocBinned3::Private
 	{
 		bool PushBundle(uint32 InPoolIndex, FBundleNode* InBundle)
 		{
-			uint32 NumCachedBundles = FMath::Min<uint32>(GMallocBinned3MaxBundlesBeforeRecycle, BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle);
+			const uint32 LocalArena = GetCurrentArena();
+			for (uint32 ArenaOffset = 0; ArenaOffset < BINNED3_RECYCLER_ARENA_COUNT; ArenaOffset++)
+			{
+				if (PushBundleToArena((LocalArena + ArenaOffset) % BINNED3_RECYCLER_ARENA_COUNT, InPoolIndex, InBundle))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		FBundleNode* PopBundle(uint32 InPoolIndex)
+		{
+			const uint32 LocalArena = GetCurrentArena();
+			for (uint32 ArenaOffset = 0; ArenaOffset < BINNED3_RECYCLER_ARENA_COUNT; ArenaOffset++)
+			{
+				if (FBundleNode* Result = PopBundleFromArena((LocalArena + ArenaOffset) % BINNED3_RECYCLER_ARENA_COUNT, InPoolIndex))
+				{
+#if BINNED3_ALLOCATOR_STATS
+					if (ArenaOffset != 0)
+					{
+						Binned3CrossArenaBundles++;
+					}
+#endif
+					return Result;
+				}
+			}
+			return nullptr;
+		}
+
+	private:
+		static FORCEINLINE uint32 GetCurrentArena()
+		{
+#if BINNED3_RECYCLER_ARENA_COUNT > 1
+			// sched_getcpu() on Linux; recent glibc answers this from the rseq area without a syscall
+			return FPlatformProcess::GetCurrentCoreNumber() % BINNED3_RECYCLER_ARENA_COUNT;
+#else
+			return 0;
+#endif
+		}
+
+		/**
+		 * The recycler capacity is split across the arenas rather than repeated in each of them, so the total number of cached
+		 * bundles per pool (and the memory they can strand) stays at GMallocBinned3MaxBundlesBeforeRecycle however many arenas there are.
+		 */
+		static FORCEINLINE uint32 GetNumCachedBundlesInArena(uint32 InArena)
+		{
+			const uint32 NumCachedBundles = FMath::Min<uint32>(GMallocBinned3MaxBundlesBeforeRecycle, BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle);
+			return NumCachedBundles / BINNED3_RECYCLER_ARENA_COUNT + (InArena < NumCachedBundles % BINNED3_RECYCLER_ARENA_COUNT ? 1 : 0);
+		}
+
+		bool PushBundleToArena(uint32 InArena, uint32 InPoolIndex, FBundleNode* InBundle)
+		{
+			uint32 NumCachedBundles = GetNumCachedBundlesInArena(InArena);
 			for (uint32 Slot = 0; Slot < NumCachedBundles; Slot++)
 			{
-				if (!Bundles[InPoolIndex].FreeBundles[Slot])
+				if (!Bundles[InArena][InPoolIndex].FreeBundles[Slot])
 				{
-					if (!FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Bundles[InPoolIndex].FreeBundles[Slot], InBundle, nullptr))
+					if (!FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Bundles[InArena][InPoolIndex].FreeBundles[Slot], InBundle, nullptr))
 					{
 						return true;
 					}
@@ -534,15 +593,15 @@ struct FMallocBinned3::Private
 			return false;
 		}
 
-		FBundleNode* PopBundle(uint32 InPoolIndex)
+		FBundleNode* PopBundleFromArena(uint32 InArena, uint32 InPoolIndex)
 		{
-			uint32 NumCachedBundles = FMath::Min<uint32>(GMallocBinned3MaxBundlesBeforeRecycle, BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle);
+			uint32 NumCachedBundles = GetNumCachedBundlesInArena(InArena);
 			for (uint32 Slot = 0; Slot < NumCachedBundles; Slot++)
 			{
-				FBundleNode* Result = Bundles[InPoolIndex].FreeBundles[Slot];
+				FBundleNode* Result = Bundles[InArena][InPoolIndex].FreeBundles[Slot];
 				if (Result)
 				{
-					if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Bundles[InPoolIndex].FreeBundles[Slot], nullptr, Result) == Result)
+					if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Bundles[InArena][InPoolIndex].FreeBundles[Slot], nullptr, Result) == Result)
 					{
 						return Result;
 					}
@@ -551,7 +610,6 @@ struct FMallocBinned3::Private
 			return nullptr;
 		}
 
-	private:
 		struct FPaddedBundlePointer
 		{
 			FBundleNode* FreeBundles[BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle];
@@ -565,7 +623,7 @@ struct FMallocBinned3::Private
 			}
 		};
 		static_assert(sizeof(FPaddedBundlePointer) == PLATFORM_CACHE_LINE_SIZE, "FPaddedBundlePointer should be the same size as a cache line");
-		MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) FPaddedBundlePointer Bundles[BINNED3_SMALL_POOL_COUNT] GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
+		MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) FPaddedBundlePointer Bundles[BINNED3_RECYCLER_ARENA_COUNT][BINNED3_SMALL_POOL_COUNT] GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
 	};
 
 	static FGlobalRecycler GGlobalRecycler;
@@ -642,6 +700,86 @@ struct FMallocBinned3::Private
 	}
 
 
+#if BINNED3_DEFERRED_BUNDLE_FREES
+	/** Per-pool lock-free stacks of bundles waiting to be returned to their pools, linked through FBundleNode::NextBundle. */
+	struct FDeferredBundleFrees
+	{
+		void Push(uint32 InPoolIndex, FBundleNode* InBundle)
+		{
+			FBundleNode* volatile* Head = &Pending[InPoolIndex].Head;
+			FBundleNode* OldHead;
+			do
+			{
+				OldHead = *Head;
+				InBundle->NextBundle = OldHead;
+			}
+			while (FPlatformAtomics::InterlockedCompareExchangePointer((void**)Head, InBundle, OldHead) != OldHead);
+		}
+
+		/** Takes the whole list for a pool; the caller must hold the allocator mutex while returning it. */
+		FBundleNode* PopAll(uint32 InPoolIndex)
+		{
+			FBundleNode* volatile* Head = &Pending[InPoolIndex].Head;
+			if (!*Head)
+			{
+				return nullptr;
+			}
+			return (FBundleNode*)FPlatformAtomics::InterlockedExchangePtr((void**)Head, nullptr);
+		}
+
+	private:
+		struct FPaddedHead
+		{
+			FBundleNode* volatile Head = nullptr;
+			uint8 Padding[PLATFORM_CACHE_LINE_SIZE - sizeof(FBundleNode*)];
+		};
+		static_assert(sizeof(FPaddedHead) == PLATFORM_CACHE_LINE_SIZE, "FPaddedHead should be the same size as a cache line");
+		MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) FPaddedHead Pending[BINNED3_SMALL_POOL_COUNT] GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
+	};
+
+	static FDeferredBundleFrees GDeferredBundleFrees;
+
+	/** Returns any deferred bundles of a pool. Must be called with the allocator mutex held. */
+	static void FreeDeferredBundles(FMallocBinned3& Allocator, uint32 InPoolIndex)
+	{
+		if (FBundleNode* Bundles = GDeferredBundleFrees.PopAll(InPoolIndex))
+		{
+			FreeBundles(Allocator, Bundles, Allocator.PoolIndexToBlockSize(InPoolIndex), InPoolIndex);
+		}
+	}
+#endif
+
+	/** Scoped lock on the allocator mutex that records contention in the allocator stats. */
+	class FScopeLockCountingWaits
+	{
+	public:
+		UE_NONCOPYABLE(FScopeLockCountingWaits);
+
+		explicit FScopeLockCountingWaits(FCriticalSection& InMutex)
+			: Mutex(InMutex)
+		{
+#if BINNED3_ALLOCATOR_STATS
+			if (!Mutex.TryLock())
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Mutex.Lock();
+				Binned3MutexWaits++;
+				Binned3MutexWaitCycles += FPlatformTime::Cycles64() - StartCycles;
+			}
+#else
+			Mutex.Lock();
+#endif
+		}
+
+		~FScopeLockCountingWaits()
+		{
+			Mutex.Unlock();
+		}
+
+	private:
+		FCriticalSection& Mutex;
+	};
+
 	static FCriticalSection& GetFreeBlockListsRegistrationMutex()
 	{
 		static FCriticalSection FreeBlockListsRegistrationMutex;
@@ -668,6 +806,9 @@ struct FMallocBinned3::Private
 };
 
 FMallocBinned3::Private::FGlobalRecycler FMallocBinned3::Private::GGlobalRecycler;
+#if BINNED3_DEFERRED_BUNDLE_FREES
+FMallocBinned3::Private::FDeferredBundleFrees FMallocBinned3::Private::GDeferredBundleFrees;
+#endif
 
 #if BINNED3_ALLOCATOR_STATS
 TAtomic<int64> FMallocBinned3::FPerThreadFreeBlockLists::ConsolidatedMemory;
@@ -978,7 +1119,11 @@ void* FMallocBinned3::MallocExternal(SIZE_T Size, uint32 Alignment)
 			}
 		}
 
-		FScopeLock Lock(&Mutex);
+		Private::FScopeLockCountingWaits Lock(Mutex);
+
+#if BINNED3_DEFERRED_BUNDLE_FREES
+		Private::FreeDeferredBundles(*this, PoolIndex);
+#endif
 
 		// Allocate from small object pool.
 		FPoolTable& Table = SmallPoolTables[PoolIndex];
@@ -1184,10 +1329,29 @@ void FMallocBinned3::FreeExternal(void* Ptr)
 			BundlesToRecycle = (FBundleNode*)Ptr;
 			BundlesToRecycle->NextNodeInCurrentBundle = nullptr;
 		}
+#if BINNED3_DEFERRED_BUNDLE_FREES
+		if (BundlesToRecycle && Lists)
+		{
+			// Don't wait behind another thread for the mutex; whoever owns it next for this pool will return the bundle.
+			Private::GDeferredBundleFrees.Push(PoolIndex, BundlesToRecycle);
+			if (Mutex.TryLock())
+			{
+				Private::FreeDeferredBundles(*this, PoolIndex);
+				Mutex.Unlock();
+			}
+			else
+			{
+#if BINNED3_ALLOCATOR_STATS
+				Binned3DeferredBundleFrees++;
+#endif
+			}
+			BundlesToRecycle = nullptr;
+		}
+#endif
 		if (BundlesToRecycle)
 		{
 			BundlesToRecycle->NextBundle = nullptr;
-			FScopeLock Lock(&Mutex);
+			Private::FScopeLockCountingWaits Lock(Mutex);
 			Private::FreeBundles(*this, BundlesToRecycle, BlockSize, PoolIndex);
 #if BINNED3_ALLOCATOR_STATS
 			if (!Lists)
@@ -1302,10 +1466,13 @@ void FMallocBinned3::FlushCurrentThreadCache()
 
 	if (Lists)
 	{
-		FScopeLock Lock(&Mutex);
+		Private::FScopeLockCountingWaits Lock(Mutex);
 		WaitForMutexTime = FPlatformTime::Seconds() - StartTimeInner;
 		for (int32 PoolIndex = 0; PoolIndex != BINNED3_SMALL_POOL_COUNT; ++PoolIndex)
 		{
+#if BINNED3_DEFERRED_BUNDLE_FREES
+			Private::FreeDeferredBundles(*this, PoolIndex);
+#endif
 			FBundleNode* Bundles = Lists->PopBundles(PoolIndex);
 			if (Bundles)
 			{
@@ -1499,6 +1666,10 @@ void FMallocBinned3::GetAllocatorStats( FGenericMemoryStats& OutStats )
 
 	OutStats.Add(TEXT("TotalAllocated"), TotalAllocated);
 	OutStats.Add(TEXT("TotalOSAllocated"), TotalOSAllocated);
+
+	OutStats.Add(TEXT("Binned3MutexWaits"), Binned3MutexWaits.Load());
+	OutStats.Add(TEXT("Binned3CrossArenaBundles"), Binned3CrossArenaBundles.Load());
+	OutStats.Add(TEXT("Binned3DeferredBundleFrees"), Binned3DeferredBundleFrees.Load());
 #endif
 	FMalloc::GetAllocatorStats(OutStats);
 }
@@ -1532,6 +1703,9 @@ void FMallocBinned3::DumpAllocatorStats(class FOutputDevice& Ar)
 	Ar.Logf(TEXT("TLS: %fmb"), ((double)Binned3TLSMemory) / (1024.0f * 1024.0f));
 	Ar.Logf(TEXT("Slab Commits: %llu"), Binned3Commits.Load());
 	Ar.Logf(TEXT("Slab Decommits: %llu"), Binned3Decommits.Load());
+	Ar.Logf(TEXT("Recycler Arenas: %d"), int32(BINNED3_RECYCLER_ARENA_COUNT));
+	Ar.Logf(TEXT("Cross-CPU Reuse: %llu bundles reused on another CPU, %llu bundles deferred while the mutex was busy"), Binned3CrossArenaBundles.Load(), Binned3DeferredBundleFrees.Load());
+	Ar.Logf(TEXT("Mutex Waits: %llu  (%6.3fms total)"), Binned3MutexWaits.Load(), FPlatformTime::ToMilliseconds64(Binned3MutexWaitCycles.Load()));
 #if BINNED3_USE_SEPARATE_VM_PER_POOL
 	Ar.Logf(TEXT("BINNED3_USE_SEPARATE_VM_PER_POOL is true - VM is Contiguous = %d"), PoolSearchDiv == 0);
 	if (PoolSearchDiv)
@@ -0,0 +1,447 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	MallocSamplingProfiler.cpp: Sampling allocation site profiler
+=============================================================================*/
+#include "HAL/MallocSamplingProfiler.h"
+#include "CoreGlobals.h"
+#include "Logging/LogMacros.h"
+#include "Misc/Crc.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UnrealTemplate.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformProcess.h"
+#include "Trace/Trace.inl"
+#include <cmath>
+
+CORE_API FMallocSamplingProfiler* GMallocSamplingProfiler = nullptr;
+CORE_API bool GMallocSamplingProfilerEnabled = false;
+
+static int32 GMallocSamplingProfilerInterval = 512 * 1024;
+static FAutoConsoleVariableRef CVarMallocSamplingProfilerInterval(
+	TEXT("Memory.SamplingProfiler.Interval"),
+	GMallocSamplingProfilerInterval,
+	TEXT("Average number of bytes allocated between two samples of the sampling allocation profiler. Read when the profiler is enabled."),
+	ECVF_Default
+);
+
+#if UE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL(MemSamplingChannel, "Sampled heap snapshots")
+
+UE_TRACE_EVENT_BEGIN(MemSampling, Snapshot)
+	UE_TRACE_EVENT_FIELD(uint32, SnapshotId)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, SampleInterval)
+	UE_TRACE_EVENT_FIELD(int64, EstimatedBytes)
+	UE_TRACE_EVENT_FIELD(uint32, NumSites)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(MemSampling, Callstack)
+	UE_TRACE_EVENT_FIELD(uint32, SnapshotId)
+	UE_TRACE_EVENT_FIELD(uint32, CallstackId)
+	UE_TRACE_EVENT_FIELD(uint64[], Frames)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(MemSampling, Site)
+	UE_TRACE_EVENT_FIELD(uint32, SnapshotId)
+	UE_TRACE_EVENT_FIELD(uint32, CallstackId)
+	UE_TRACE_EVENT_FIELD(int64, Tag)
+	UE_TRACE_EVENT_FIELD(int64, EstimatedBytes)
+	UE_TRACE_EVENT_FIELD(uint32, NumSamples)
+UE_TRACE_EVENT_END()
+
+#endif // UE_TRACE_ENABLED
+
+namespace MallocSamplingProfiler
+{
+	// Frames inside the profiler and FMemory that are dropped from every captured callstack
+	static const int32 CallstackEntriesToSkipCount = 3;
+
+	static thread_local int64 BytesUntilNextSample = 0;
+	static thread_local bool bCountdownSeeded = false;
+	static thread_local uint64 RandomState = 0;
+	// Set while the profiler itself allocates so its own bookkeeping is never sampled
+	static thread_local bool bInProfiler = false;
+
+	/** Draws the number of bytes until the next sample from an exponential distribution with the given mean. */
+	static int64 DrawBytesUntilNextSample(uint64 SampleInterval)
+	{
+		if (RandomState == 0)
+		{
+			RandomState = (FPlatformTime::Cycles64() ^ (uint64(FPlatformTLS::GetCurrentThreadId()) << 32)) | 1;
+		}
+		// xorshift64*
+		RandomState ^= RandomState >> 12;
+		RandomState ^= RandomState << 25;
+		RandomState ^= RandomState >> 27;
+		const uint64 Random = RandomState * 0x2545F4914F6CDD1DULL;
+
+		// Uniform in (0, 1]
+		const double Uniform = double((Random >> 11) + 1) * (1.0 / 9007199254740992.0);
+		return int64(-std::log(Uniform) * double(SampleInterval)) + 1;
+	}
+}
+
+FMallocSamplingProfiler::FMallocSamplingProfiler(FMalloc* InMalloc, uint64 InSampleInterval)
+	: UsedMalloc(InMalloc)
+	, SampleInterval(FMath::Max<uint64>(InSampleInterval, 1))
+	, NextSnapshotId(1)
+	, TotalSamples(0)
+{
+	for (std::atomic<uint16>& Count : SampledFilter)
+	{
+		Count.store(0, std::memory_order_relaxed);
+	}
+}
+
+FORCEINLINE uint32 FMallocSamplingProfiler::FilterIndex(const void* Ptr)
+{
+	return uint32((UPTRINT(Ptr) * 0x9E3779B97F4A7C15ULL) >> (64 - FilterBits));
+}
+
+FORCEINLINE bool FMallocSamplingProfiler::ShouldSample(SIZE_T Size)
+{
+	using namespace MallocSamplingProfiler;
+
+	BytesUntilNextSample -= int64(Size);
+	if (LIKELY(BytesUntilNextSample > 0))
+	{
+		return false;
+	}
+
+	// A thread's first pass through here only seeds its countdown, otherwise the first allocation of every thread would be sampled
+	const bool bSample = bCountdownSeeded;
+	bCountdownSeeded = true;
+	BytesUntilNextSample = DrawBytesUntilNextSample(SampleInterval);
+	return bSample;
+}
+
+void* FMallocSamplingProfiler::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	void* Ptr = UsedMalloc->Malloc(Size, Alignment);
+	if (!MallocSamplingProfiler::bInProfiler && ShouldSample(Size) && Ptr)
+	{
+		RecordSample(Ptr, Size);
+	}
+	return Ptr;
+}
+
+void* FMallocSamplingProfiler::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
+{
+	const bool bInProfiler = MallocSamplingProfiler::bInProfiler;
+
+	// The sample is detached before the inner realloc, like in Free, so a successful realloc can't race with another thread reusing
+	// and sampling the old address. If the realloc fails the old block is still live and gets its sample back.
+	FLiveSample OldSample;
+	const bool bHadSample = Ptr && !bInProfiler && SampledFilter[FilterIndex(Ptr)].load(std::memory_order_relaxed) != 0 && RemoveSample(Ptr, &OldSample);
+
+	void* NewPtr = UsedMalloc->Realloc(Ptr, NewSize, Alignment);
+	if (bHadSample && !NewPtr && NewSize)
+	{
+		RestoreSample(Ptr, OldSample);
+	}
+	if (!bInProfiler && NewSize && ShouldSample(NewSize) && NewPtr)
+	{
+		RecordSample(NewPtr, NewSize);
+	}
+	return NewPtr;
+}
+
+void FMallocSamplingProfiler::Free(void* Ptr)
+{
+	// Forget the sample before the memory goes back, so another thread can't reuse and sample the address in between
+	if (Ptr && SampledFilter[FilterIndex(Ptr)].load(std::memory_order_relaxed) != 0 && !MallocSamplingProfiler::bInProfiler)
+	{
+		RemoveSample(Ptr);
+	}
+	UsedMalloc->Free(Ptr);
+}
+
+void FMallocSamplingProfiler::RecordSample(void* Ptr, SIZE_T Size)
+{
+	TGuardValue<bool> InProfiler(MallocSamplingProfiler::bInProfiler, true);
+
+	uint64 Frames[MaxCallstackDepth + MallocSamplingProfiler::CallstackEntriesToSkipCount] = { 0 };
+	FPlatformStackWalk::CaptureStackBackTrace(Frames, UE_ARRAY_COUNT(Frames));
+	const uint64* CallerFrames = Frames + MallocSamplingProfiler::CallstackEntriesToSkipCount;
+	int32 NumFrames = 0;
+	while (NumFrames < MaxCallstackDepth && CallerFrames[NumFrames])
+	{
+		++NumFrames;
+	}
+
+	// An allocation of Size bytes is sampled with probability 1 - e^(-Size / SampleInterval), so it stands for Size divided by that
+	FLiveSample Sample;
+	Sample.EstimatedBytes = int64(double(Size) / -std::expm1(-double(Size) / double(SampleInterval)));
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	Sample.Tag = FLowLevelMemTracker::IsEnabled() ? FLowLevelMemTracker::Get().GetActiveTag(ELLMTracker::Default) : 0;
+#else
+	Sample.Tag = 0;
+#endif
+
+	FScopeLock Lock(&Mutex);
+	Sample.CallstackIndex = FindOrAddCallstack(CallerFrames, NumFrames);
+	LiveSamples.Add(Ptr, Sample);
+	SampledFilter[FilterIndex(Ptr)].fetch_add(1, std::memory_order_relaxed);
+	TotalSamples.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool FMallocSamplingProfiler::RemoveSample(void* Ptr, FLiveSample* OutSample)
+{
+	TGuardValue<bool> InProfiler(MallocSamplingProfiler::bInProfiler, true);
+
+	FScopeLock Lock(&Mutex);
+	FLiveSample Removed;
+	if (!LiveSamples.RemoveAndCopyValue(Ptr, Removed))
+	{
+		return false;
+	}
+	SampledFilter[FilterIndex(Ptr)].fetch_sub(1, std::memory_order_relaxed);
+	if (OutSample)
+	{
+		*OutSample = Removed;
+	}
+	return true;
+}
+
+void FMallocSamplingProfiler::RestoreSample(void* Ptr, const FLiveSample& Sample)
+{
+	TGuardValue<bool> InProfiler(MallocSamplingProfiler::bInProfiler, true);
+
+	FScopeLock Lock(&Mutex);
+	LiveSamples.Add(Ptr, Sample);
+	SampledFilter[FilterIndex(Ptr)].fetch_add(1, std::memory_order_relaxed);
+}
+
+int32 FMallocSamplingProfiler::FindOrAddCallstack(const uint64* Frames, int32 NumFrames)
+{
+	const uint32 Hash = FCrc::MemCrc32(Frames, NumFrames * sizeof(uint64));
+	if (const int32* ExistingIndex = CallstackHashToIndex.Find(Hash))
+	{
+		const FCallstack& Existing = Callstacks[*ExistingIndex];
+		if (Existing.NumFrames == NumFrames && FMemory::Memcmp(CallstackFrames.GetData() + Existing.FirstFrame, Frames, NumFrames * sizeof(uint64)) == 0)
+		{
+			return *ExistingIndex;
+		}
+	}
+
+	const int32 Index = Callstacks.Add(FCallstack{ Hash, CallstackFrames.Num(), NumFrames });
+	CallstackFrames.Append(Frames, NumFrames);
+	CallstackHashToIndex.Add(Hash, Index);
+	return Index;
+}
+
+void FMallocSamplingProfiler::GetCallstack(int32 CallstackIndex, TArray<uint64>& OutFrames)
+{
+	TGuardValue<bool> InProfiler(MallocSamplingProfiler::bInProfiler, true);
+
+	FScopeLock Lock(&Mutex);
+	const FCallstack& Callstack = Callstacks[CallstackIndex];
+	OutFrames.Reset();
+	OutFrames.Append(CallstackFrames.GetData() + Callstack.FirstFrame, Callstack.NumFrames);
+}
+
+void FMallocSamplingProfiler::GetLiveSites(TArray<FSiteSummary>& OutSites)
+{
+	TGuardValue<bool> InProfiler(MallocSamplingProfiler::bInProfiler, true);
+
+	OutSites.Reset();
+	{
+		FScopeLock Lock(&Mutex);
+		TMap<TTuple<int32, int64>, int32> SiteToIndex;
+		for (const TPair<void*, FLiveSample>& Pair : LiveSamples)
+		{
+			const FLiveSample& Sample = Pair.Value;
+			int32& SiteIndex = SiteToIndex.FindOrAdd(MakeTuple(Sample.CallstackIndex, Sample.Tag), INDEX_NONE);
+			if (SiteIndex == INDEX_NONE)
+			{
+				SiteIndex = OutSites.AddDefaulted();
+				OutSites[SiteIndex].CallstackIndex = Sample.CallstackIndex;
+				OutSites[SiteIndex].Tag = Sample.Tag;
+			}
+			OutSites[SiteIndex].EstimatedBytes += Sample.EstimatedBytes;
+			OutSites[SiteIndex].NumSamples++;
+		}
+	}
+
+	OutSites.Sort([](const FSiteSummary& A, const FSiteSummary& B) { return A.EstimatedBytes > B.EstimatedBytes; });
+}
+
+int64 FMallocSamplingProfiler::GetEstimatedLiveBytes()
+{
+	TGuardValue<bool> InProfiler(MallocSamplingProfiler::bInProfiler, true);
+
+	FScopeLock Lock(&Mutex);
+	int64 EstimatedBytes = 0;
+	for (const TPair<void*, FLiveSample>& Pair : LiveSamples)
+	{
+		EstimatedBytes += Pair.Value.EstimatedBytes;
+	}
+	return EstimatedBytes;
+}
+
+void FMallocSamplingProfiler::DumpLiveSites(FOutputDevice& Ar, int32 MaxSites)
+{
+	TArray<FSiteSummary> Sites;
+	GetLiveSites(Sites);
+
+	int64 EstimatedBytes = 0;
+	for (const FSiteSummary& Site : Sites)
+	{
+		EstimatedBytes += Site.EstimatedBytes;
+	}
+	Ar.Logf(TEXT("Sampled heap: %.2fmb estimated live in %d sites (one sample every %llu bytes, %lld samples taken)"),
+		double(EstimatedBytes) / (1024.0 * 1024.0), Sites.Num(), SampleInterval, TotalSamples.load(std::memory_order_relaxed));
+
+	TArray<uint64> Frames;
+	for (int32 SiteIndex = 0; SiteIndex < FMath::Min(MaxSites, Sites.Num()); ++SiteIndex)
+	{
+		const FSiteSummary& Site = Sites[SiteIndex];
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		const TCHAR* TagName = Site.Tag ? FLowLevelMemTracker::Get().FindTagName(Site.Tag) : nullptr;
+#else
+		const TCHAR* TagName = nullptr;
+#endif
+		Ar.Logf(TEXT("%8.2fmb %6d samples  LLM tag %s"), double(Site.EstimatedBytes) / (1024.0 * 1024.0), Site.NumSamples, TagName ? TagName : TEXT("None"));
+
+		GetCallstack(Site.CallstackIndex, Frames);
+		for (int32 Depth = 0; Depth < Frames.Num(); ++Depth)
+		{
+			ANSICHAR FrameString[1024];
+			FrameString[0] = 0;
+			FPlatformStackWalk::ProgramCounterToHumanReadableString(Depth, Frames[Depth], FrameString, UE_ARRAY_COUNT(FrameString));
+			Ar.Logf(TEXT("    %s"), ANSI_TO_TCHAR(FrameString));
+		}
+	}
+}
+
+uint32 FMallocSamplingProfiler::TraceSnapshot()
+{
+	const uint32 SnapshotId = NextSnapshotId.fetch_add(1, std::memory_order_relaxed);
+#if UE_TRACE_ENABLED
+	if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(MemSamplingChannel))
+	{
+		return SnapshotId;
+	}
+
+	TArray<FSiteSummary> Sites;
+	GetLiveSites(Sites);
+
+	int64 EstimatedBytes = 0;
+	for (const FSiteSummary& Site : Sites)
+	{
+		EstimatedBytes += Site.EstimatedBytes;
+	}
+	UE_TRACE_LOG(MemSampling, Snapshot, MemSamplingChannel)
+		<< Snapshot.SnapshotId(SnapshotId)
+		<< Snapshot.Cycle(FPlatformTime::Cycles64())
+		<< Snapshot.SampleInterval(SampleInterval)
+		<< Snapshot.EstimatedBytes(EstimatedBytes)
+		<< Snapshot.NumSites(uint32(Sites.Num()));
+
+	// Every snapshot carries the callstacks it references so it can be decoded on its own
+	TSet<int32> TracedCallstacks;
+	TArray<uint64> Frames;
+	for (const FSiteSummary& Summary : Sites)
+	{
+		bool bAlreadyTraced = false;
+		TracedCallstacks.Add(Summary.CallstackIndex, &bAlreadyTraced);
+		if (!bAlreadyTraced)
+		{
+			GetCallstack(Summary.CallstackIndex, Frames);
+			UE_TRACE_LOG(MemSampling, Callstack, MemSamplingChannel)
+				<< Callstack.SnapshotId(SnapshotId)
+				<< Callstack.CallstackId(uint32(Summary.CallstackIndex))
+				<< Callstack.Frames(Frames.GetData(), Frames.Num());
+		}
+
+		UE_TRACE_LOG(MemSampling, Site, MemSamplingChannel)
+			<< Site.SnapshotId(SnapshotId)
+			<< Site.CallstackId(uint32(Summary.CallstackIndex))
+			<< Site.Tag(Summary.Tag)
+			<< Site.EstimatedBytes(Summary.EstimatedBytes)
+			<< Site.NumSamples(uint32(Summary.NumSamples));
+	}
+#endif // UE_TRACE_ENABLED
+	return SnapshotId;
+}
+
+void FMallocSamplingProfiler::GetAllocatorStats(FGenericMemoryStats& OutStats)
+{
+	UsedMalloc->GetAllocatorStats(OutStats);
+	OutStats.Add(TEXT("SampledLiveBytesEstimate"), SIZE_T(GetEstimatedLiveBytes()));
+}
+
+bool FMallocSamplingProfiler::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (FParse::Command(&Cmd, TEXT("MallocSampling")))
+	{
+		if (FParse::Command(&Cmd, TEXT("Snapshot")))
+		{
+			const uint32 SnapshotId = TraceSnapshot();
+			Ar.Logf(TEXT("Traced sampled heap snapshot %u"), SnapshotId);
+			return true;
+		}
+		if (FParse::Command(&Cmd, TEXT("Dump")))
+		{
+			int32 MaxSites = 20;
+			FParse::Value(Cmd, TEXT("Sites="), MaxSites);
+			DumpLiveSites(Ar, MaxSites);
+			return true;
+		}
+		return false;
+	}
+
+	return UsedMalloc->Exec(InWorld, Cmd, Ar);
+}
+
+FMalloc* FMallocSamplingProfiler::OverrideIfEnabled(FMalloc* InUsedAlloc)
+{
+	if (GMallocSamplingProfilerEnabled)
+	{
+		GMallocSamplingProfiler = new FMallocSamplingProfiler(InUsedAlloc, GMallocSamplingProfilerInterval);
+		return GMallocSamplingProfiler;
+	}
+	return InUsedAlloc;
+}
+
+static void EnableMallocSamplingProfiler()
+{
+	if (PLATFORM_USES_FIXED_GMalloc_CLASS)
+	{
+		UE_LOG(LogMemory, Error, TEXT("Sampling profiler cannot be turned on because we are using PLATFORM_USES_FIXED_GMalloc_CLASS"));
+		return;
+	}
+	if (GMallocSamplingProfiler)
+	{
+		UE_LOG(LogMemory, Error, TEXT("Sampling profiler was already turned on."));
+		return;
+	}
+
+	// Allocations made before this point are unknown to the profiler; their frees miss the filter and pass straight through
+	while (true)
+	{
+		FMalloc* LocalGMalloc = GMalloc;
+		FMallocSamplingProfiler* Proxy = new FMallocSamplingProfiler(LocalGMalloc, GMallocSamplingProfilerInterval);
+		if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&GMalloc, Proxy, LocalGMalloc) == LocalGMalloc)
+		{
+			GMallocSamplingProfiler = Proxy;
+			UE_LOG(LogConsoleResponse, Display, TEXT("Sampling profiler is now on, one sample every %d bytes."), GMallocSamplingProfilerInterval);
+			return;
+		}
+		delete Proxy;
+	}
+}
+
+static FAutoConsoleCommand CmdEnableMallocSamplingProfiler(
+	TEXT("Memory.SamplingProfiler.Enable"),
+	TEXT("Wraps the allocator in the sampling allocation profiler. Use 'MallocSampling Dump' and 'MallocSampling Snapshot' to inspect it."),
+	FConsoleCommandDelegate::CreateStatic(&EnableMallocSamplingProfiler)
+);
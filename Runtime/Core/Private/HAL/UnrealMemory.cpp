@@ -26,6 +26,7 @@
 #include "HAL/MallocPoisonProxy.h"
 #include "HAL/MallocDoubleFreeFinder.h"
 #include "HAL/MallocFrameProfiler.h"
+#include "HAL/MallocSamplingProfiler.h"
 
 #if MALLOC_GT_HOOKS
 
@@ -381,6 +382,7 @@ static int FMemory_GCreateMalloc_ThreadUnsafe()
 
 	GMalloc = FMallocDoubleFreeFinder::OverrideIfEnabled(GMalloc);
 	GMalloc = FMallocFrameProfiler::OverrideIfEnabled(GMalloc);
+	GMalloc = FMallocSamplingProfiler::OverrideIfEnabled(GMalloc);
 	return 0;
 }
 
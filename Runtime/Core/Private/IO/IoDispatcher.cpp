@@ -17,6 +17,7 @@
 #include "Async/MappedFileHandle.h"
 #include "ProfilingDebugging/CountersTrace.h"
 #include "ProfilingDebugging/CsvProfiler.h"
+#include "Misc/AutomationTest.h"
 
 DEFINE_LOG_CATEGORY(LogIoDispatcher);
 
@@ -142,7 +143,7 @@ public:
 		: bIsMultithreaded(bInIsMultithreaded)
 		, FileIoStore(EventQueue, SignatureErrorEvent, bIsMultithreaded)
 	{
-		FCoreDelegates::GetMemoryTrimDelegate().AddLambda([this]()
+		MemoryTrimDelegateHandle = FCoreDelegates::GetMemoryTrimDelegate().AddLambda([this]()
 		{
 			RequestAllocator.Trim();
 			BatchAllocator.Trim();
@@ -151,6 +152,7 @@ public:
 
 	~FIoDispatcherImpl()
 	{
+		FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimDelegateHandle);
 		delete Thread;
 	}
 
@@ -166,6 +168,11 @@ public:
 		return true;
 	}
 
+	FIoBatch NewBatch()
+	{
+		return FIoBatch(*this);
+	}
+
 	FIoRequestImpl* AllocRequest(const FIoChunkId& ChunkId, FIoReadOptions Options)
 	{
 		LLM_SCOPE(ELLMTag::FileSystem);
@@ -460,6 +467,13 @@ private:
 				RequestsToSubmitTail = nullptr;
 			}
 
+			if (Request->bCancelled)
+			{
+				CompleteRequest(Request, EIoErrorCode::Cancelled);
+				Request->ReleaseRef();
+				continue;
+			}
+
 			// Make sure that the FIoChunkId in the request is valid before we try to do anything with it.
 			if (Request->ChunkId.IsValid())
 			{
@@ -529,6 +543,7 @@ private:
 	FRequestAllocator RequestAllocator;
 	FBatchAllocator BatchAllocator;
 	FRunnableThread* Thread = nullptr;
+	FDelegateHandle MemoryTrimDelegateHandle;
 	FCriticalSection WaitingLock;
 	FIoRequestImpl* WaitingRequestsHead = nullptr;
 	FIoRequestImpl* WaitingRequestsTail = nullptr;
@@ -559,7 +574,7 @@ FIoStatus FIoDispatcher::Mount(const FIoStoreEnvironment& Environment, const FGu
 FIoBatch
 FIoDispatcher::NewBatch()
 {
-	return FIoBatch(*Impl);
+	return Impl->NewBatch();
 }
 
 TIoStatusOr<FIoMappedRegion>
@@ -866,3 +881,59 @@ FIoRequest::GetResult()
 	}
 }
 
+void
+FIoRequest::Cancel()
+{
+	if (Impl)
+	{
+		Impl->bCancelled = true;
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIoDispatcherCancelTest, "System.Core.IO.IoDispatcher.Cancel", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FIoDispatcherCancelTest::RunTest(const FString& Parameters)
+{
+	// A dispatcher of its own without containers, which processes requests as they are issued instead of on its thread
+	FIoDispatcherImpl Dispatcher(false);
+	const FIoChunkId ChunkId = CreateIoChunkId(0x1234, 0, EIoChunkType::BulkData);
+
+	{
+		FIoBatch Batch = Dispatcher.NewBatch();
+		FIoRequest Request = Batch.Read(ChunkId, FIoReadOptions(), IoDispatcherPriority_Medium);
+		Batch.Issue();
+		TestEqual(TEXT("A request for a chunk that is not mounted fails to resolve"), Request.Status().GetErrorCode(), EIoErrorCode::NotFound);
+	}
+
+	{
+		EIoErrorCode CallbackErrorCode = EIoErrorCode::Unknown;
+		FIoBatch Batch = Dispatcher.NewBatch();
+		FIoRequest Request = Batch.ReadWithCallback(ChunkId, FIoReadOptions(), IoDispatcherPriority_Medium, [&CallbackErrorCode](TIoStatusOr<FIoBuffer> Result)
+		{
+			CallbackErrorCode = Result.Status().GetErrorCode();
+		});
+		Request.Cancel();
+		Batch.Issue();
+		TestEqual(TEXT("A request canceled before it is resolved completes as canceled"), Request.Status().GetErrorCode(), EIoErrorCode::Cancelled);
+		TestEqual(TEXT("The callback of a request canceled before it is resolved gets the cancellation"), CallbackErrorCode, EIoErrorCode::Cancelled);
+
+		Request.Cancel();
+		TestEqual(TEXT("Canceling a completed request does not change its result"), Request.Status().GetErrorCode(), EIoErrorCode::Cancelled);
+	}
+
+	{
+		FIoBatch Batch = Dispatcher.NewBatch();
+		FIoRequest Canceled = Batch.Read(ChunkId, FIoReadOptions(), IoDispatcherPriority_Medium);
+		FIoRequest NotCanceled = Batch.Read(ChunkId, FIoReadOptions(), IoDispatcherPriority_Medium);
+		Canceled.Cancel();
+		Batch.Issue();
+		TestEqual(TEXT("Only the canceled request of a batch is canceled"), Canceled.Status().GetErrorCode(), EIoErrorCode::Cancelled);
+		TestEqual(TEXT("The other requests of a batch are resolved as usual"), NotCanceled.Status().GetErrorCode(), EIoErrorCode::NotFound);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
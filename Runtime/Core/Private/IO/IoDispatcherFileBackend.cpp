@@ -17,6 +17,10 @@ TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherTotalBytesRead, TEXT("IoDispatcher/Tota
 TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherTotalBytesScattered, TEXT("IoDispatcher/TotalBytesScattered"));
 TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheHits, TEXT("IoDispatcher/CacheHits"));
 TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheMisses, TEXT("IoDispatcher/CacheMisses"));
+TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherDecompressionMemoryInFlight, TEXT("IoDispatcher/DecompressionMemoryInFlight"));
+TRACE_DECLARE_FLOAT_COUNTER(IoDispatcherReadWaitTime, TEXT("IoDispatcher/ReadWaitTime"));
+TRACE_DECLARE_FLOAT_COUNTER(IoDispatcherDecompressionQueueTime, TEXT("IoDispatcher/DecompressionQueueTime"));
+TRACE_DECLARE_FLOAT_COUNTER(IoDispatcherDecompressionTime, TEXT("IoDispatcher/DecompressionTime"));
 
 //PRAGMA_DISABLE_OPTIMIZATION
 
@@ -41,11 +45,18 @@ static FAutoConsoleVariableRef CVar_IoDispatcherBufferMemoryMB(
 	TEXT("IoDispatcher buffer memory size (in megabytes).")
 );
 
-int32 GIoDispatcherDecompressionWorkerCount = 4;
+int32 GIoDispatcherDecompressionWorkerCount = 0;
 static FAutoConsoleVariableRef CVar_IoDispatcherDecompressionWorkerCount(
 	TEXT("s.IoDispatcherDecompressionWorkerCount"),
 	GIoDispatcherDecompressionWorkerCount,
-	TEXT("IoDispatcher decompression worker count.")
+	TEXT("IoDispatcher decompression worker count, i.e. the maximum number of blocks being decompressed concurrently. 0 uses one per task graph worker thread.")
+);
+
+int32 GIoDispatcherDecompressionMemoryBudgetKB = 16 << 10;
+static FAutoConsoleVariableRef CVar_IoDispatcherDecompressionMemoryBudgetKB(
+	TEXT("s.IoDispatcherDecompressionMemoryBudgetKB"),
+	GIoDispatcherDecompressionMemoryBudgetKB,
+	TEXT("IoDispatcher upper bound for the uncompressed size of all blocks being decompressed concurrently (in kilobytes).")
 );
 
 int32 GIoDispatcherCacheSizeMB = 0;
@@ -421,13 +432,16 @@ void FFileIoStore::Initialize()
 	uint64 CacheMemorySize = uint64(GIoDispatcherCacheSizeMB) << 20ull;
 	BlockCache.Initialize(CacheMemorySize, BufferSize);
 
-	uint64 DecompressionContextCount = uint64(GIoDispatcherDecompressionWorkerCount > 0 ? GIoDispatcherDecompressionWorkerCount : 4);
-	for (uint64 ContextIndex = 0; ContextIndex < DecompressionContextCount; ++ContextIndex)
+	// Compression contexts are created on demand, up to one per decompression worker
+	if (GIoDispatcherDecompressionWorkerCount > 0)
+	{
+		MaxCompressionContextCount = uint32(GIoDispatcherDecompressionWorkerCount);
+	}
+	else
 	{
-		FFileIoStoreCompressionContext* Context = new FFileIoStoreCompressionContext();
-		Context->Next = FirstFreeCompressionContext;
-		FirstFreeCompressionContext = Context;
+		MaxCompressionContextCount = FTaskGraphInterface::IsRunning() ? uint32(FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1)) : 4;
 	}
+	DecompressionMemoryBudget = uint64(FMath::Max(GIoDispatcherDecompressionMemoryBudgetKB, 0)) << 10ull;
 
 	Thread = FRunnableThread::Create(this, TEXT("IoService"), 0, TPri_AboveNormal);
 }
@@ -622,6 +636,7 @@ void FFileIoStore::ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bo
 	}
 	if (!CompressedBlock->bFailed)
 	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
 		if (CompressedBlock->EncryptionKey.IsValid())
 		{
 			FAES::DecryptData(CompressedBuffer, CompressedBlock->RawSize, CompressedBlock->EncryptionKey);
@@ -653,6 +668,7 @@ void FFileIoStore::ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bo
 		{
 			FMemory::Memcpy(Scatter.Request->IoBuffer.Data() + Scatter.DstOffset, UncompressedBuffer + Scatter.SrcOffset, Scatter.Size);
 		}
+		CompressedBlock->DecompressionCycles = FPlatformTime::Cycles64() - StartCycles;
 	}
 
 	if (bIsAsync)
@@ -699,6 +715,10 @@ void FFileIoStore::FinalizeCompressedBlock(FFileIoStoreCompressedBlock* Compress
 	}
 	check(CompressedBlock->CompressionContext);
 	FreeCompressionContext(CompressedBlock->CompressionContext);
+	check(DecompressionMemoryInFlight >= CompressedBlock->UncompressedSize);
+	DecompressionMemoryInFlight -= CompressedBlock->UncompressedSize;
+	TRACE_COUNTER_SET(IoDispatcherDecompressionMemoryInFlight, DecompressionMemoryInFlight);
+	TRACE_COUNTER_ADD(IoDispatcherDecompressionTime, FPlatformTime::ToMilliseconds64(CompressedBlock->DecompressionCycles));
 	for (FFileIoStoreBlockScatter& Scatter : CompressedBlock->ScatterList)
 	{
 		TRACE_COUNTER_ADD(IoDispatcherTotalBytesScattered, Scatter.Size);
@@ -730,6 +750,10 @@ FIoRequestImpl* FFileIoStore::GetCompletedRequests()
 		FFileIoStoreReadRequest* NextRequest = CompletedRequest->Next;
 
 		TRACE_COUNTER_ADD(IoDispatcherTotalBytesRead, CompletedRequest->Size);
+		if (CompletedRequest->QueuedCycles)
+		{
+			TRACE_COUNTER_ADD(IoDispatcherReadWaitTime, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - CompletedRequest->QueuedCycles));
+		}
 
 		if (!CompletedRequest->ImmediateScatter.Request)
 		{
@@ -786,6 +810,7 @@ FIoRequestImpl* FFileIoStore::GetCompletedRequests()
 						ReadyForDecompressionTail = CompressedBlock;
 					}
 					CompressedBlock->Next = nullptr;
+					CompressedBlock->ReadyForDecompressionCycles = FPlatformTime::Cycles64();
 				}
 			}
 			if (CompletedRequest->CompressedBlocksRefCount == 0)
@@ -830,11 +855,18 @@ FIoRequestImpl* FFileIoStore::GetCompletedRequests()
 	while (BlockToDecompress)
 	{
 		FFileIoStoreCompressedBlock* Next = BlockToDecompress->Next;
+		if (!CanStartDecompression(BlockToDecompress))
+		{
+			break;
+		}
 		BlockToDecompress->CompressionContext = AllocCompressionContext();
 		if (!BlockToDecompress->CompressionContext)
 		{
 			break;
 		}
+		DecompressionMemoryInFlight += BlockToDecompress->UncompressedSize;
+		TRACE_COUNTER_SET(IoDispatcherDecompressionMemoryInFlight, DecompressionMemoryInFlight);
+		TRACE_COUNTER_ADD(IoDispatcherDecompressionQueueTime, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - BlockToDecompress->ReadyForDecompressionCycles));
 		// Scatter block asynchronous when the block is compressed, encrypted or signed
 		const bool bScatterAsync = bIsMultithreaded && (!BlockToDecompress->CompressionMethod.IsNone() || BlockToDecompress->EncryptionKey.IsValid() || BlockToDecompress->SignatureHash);
 		if (bScatterAsync)
@@ -987,6 +1019,7 @@ void FFileIoStore::ReadBlocks(const FFileIoStoreReader& Reader, const FFileIoSto
 
 					RawBlock->Key = RawBlockKey;
 					RawBlock->Priority = ResolvedRequest.Request->Priority;
+					RawBlock->QueuedCycles = FPlatformTime::Cycles64();
 					RawBlock->FileHandle = Reader.GetContainerFile().FileHandle;
 					RawBlock->bIsCacheable = bCacheable;
 					RawBlock->Offset = RawBlockIndex * ReadBufferSize;
@@ -1042,9 +1075,24 @@ FFileIoStoreCompressionContext* FFileIoStore::AllocCompressionContext()
 	{
 		FirstFreeCompressionContext = FirstFreeCompressionContext->Next;
 	}
+	else if (CompressionContextCount < MaxCompressionContextCount)
+	{
+		Result = new FFileIoStoreCompressionContext();
+		++CompressionContextCount;
+	}
 	return Result;
 }
 
+bool FFileIoStore::CanStartDecompression(const FFileIoStoreCompressedBlock* CompressedBlock) const
+{
+	// Always let one block through so that a block larger than the budget can't stall the pipeline
+	if (DecompressionMemoryInFlight == 0 || DecompressionMemoryBudget == 0)
+	{
+		return true;
+	}
+	return DecompressionMemoryInFlight + CompressedBlock->UncompressedSize <= DecompressionMemoryBudget;
+}
+
 void FFileIoStore::FreeCompressionContext(FFileIoStoreCompressionContext* CompressionContext)
 {
 	CompressionContext->Next = FirstFreeCompressionContext;
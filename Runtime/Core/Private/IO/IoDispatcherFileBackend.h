@@ -117,6 +117,7 @@ private:
 	void FreeBuffer(FFileIoStoreBuffer& Buffer);
 	FFileIoStoreCompressionContext* AllocCompressionContext();
 	void FreeCompressionContext(FFileIoStoreCompressionContext* CompressionContext);
+	bool CanStartDecompression(const FFileIoStoreCompressedBlock* CompressedBlock) const;
 	void ScatterBlock(FFileIoStoreCompressedBlock* CompressedBlock, bool bIsAsync);
 	void CompleteDispatcherRequest(FIoRequestImpl* Request);
 	void FinalizeCompressedBlock(FFileIoStoreCompressedBlock* CompressedBlock);
@@ -136,6 +137,10 @@ private:
 	TArray<FFileIoStoreReader*> UnorderedIoStoreReaders;
 	TArray<FFileIoStoreReader*> OrderedIoStoreReaders;
 	FFileIoStoreCompressionContext* FirstFreeCompressionContext = nullptr;
+	uint32 CompressionContextCount = 0;
+	uint32 MaxCompressionContextCount = 0;
+	uint64 DecompressionMemoryBudget = 0;
+	uint64 DecompressionMemoryInFlight = 0;
 	TMap<FFileIoStoreBlockKey, FFileIoStoreCompressedBlock*> CompressedBlocksMap;
 	TMap<FFileIoStoreBlockKey, FFileIoStoreReadRequest*> RawBlocksMap;
 	FFileIoStoreCompressedBlock* ReadyForDecompressionHead = nullptr;
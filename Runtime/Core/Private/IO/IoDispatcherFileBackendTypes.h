@@ -75,6 +75,8 @@ struct FFileIoStoreCompressedBlock
 	uint8* CompressedDataBuffer = nullptr;
 	FAES::FAESKey EncryptionKey;
 	const FSHAHash* SignatureHash = nullptr;
+	uint64 ReadyForDecompressionCycles = 0;
+	uint64 DecompressionCycles = 0;
 	bool bFailed = false;
 };
 
@@ -96,6 +98,7 @@ struct FFileIoStoreReadRequest
 	uint32 CompressedBlocksRefCount = 0;
 	uint32 Sequence = 0;
 	int32 Priority = 0;
+	uint64 QueuedCycles = 0;
 	FFileIoStoreBlockScatter ImmediateScatter;
 	bool bIsCacheable = false;
 	bool bFailed = false;
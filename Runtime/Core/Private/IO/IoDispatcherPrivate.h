@@ -65,6 +65,7 @@ public:
 	uint32 UnfinishedReadsCount = 0;
 	int32 Priority = 0;
 	TAtomic<EIoErrorCode> ErrorCode{ EIoErrorCode::Unknown };
+	TAtomic<bool> bCancelled{ false };
 	bool bFailed = false;
 
 private:
@@ -6,11 +6,18 @@
 #include "Stats/Stats.h"
 #include "HAL/IConsoleManager.h"
 #include "Misc/CoreDelegates.h"
+#include "CoreGlobals.h"
 #include <atomic>
 
 DECLARE_MEMORY_STAT(TEXT("MemStack Large Block"), STAT_MemStackLargeBLock,STATGROUP_Memory);
 DECLARE_MEMORY_STAT(TEXT("PageAllocator Free"), STAT_PageAllocatorFree, STATGROUP_Memory);
 DECLARE_MEMORY_STAT(TEXT("PageAllocator Used"), STAT_PageAllocatorUsed, STATGROUP_Memory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Allocations GT"), STAT_FrameMemStackAllocationsGT, STATGROUP_Memory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Allocations RT"), STAT_FrameMemStackAllocationsRT, STATGROUP_Memory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Allocator Heap Fallbacks GT"), STAT_FrameMemStackHeapFallbacksGT, STATGROUP_Memory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Allocator Heap Fallbacks RT"), STAT_FrameMemStackHeapFallbacksRT, STATGROUP_Memory);
+DECLARE_MEMORY_STAT(TEXT("Frame MemStack GT"), STAT_FrameMemStackBytesGT, STATGROUP_Memory);
+DECLARE_MEMORY_STAT(TEXT("Frame MemStack RT"), STAT_FrameMemStackBytesRT, STATGROUP_Memory);
 
 FPageAllocator& FPageAllocator::Get()
 {
@@ -61,6 +68,12 @@ static FAutoConsoleVariableRef CVarTestProtectionRead(
 	GMemStackProtectionTestRead,
 	TEXT("For debugging. If > 0, then a newly freed memstack page will be read from. This will (correctly) cause a GPF the next time a memstack frees a page."));
 
+static int32 GFrameMemStackMaxBytesPerFrame = 4 * 1024 * 1024;
+static FAutoConsoleVariableRef CVarFrameMemStackMaxBytesPerFrame(
+	TEXT("memstack.FrameAllocator.MaxBytesPerFrame"),
+	GFrameMemStackMaxBytesPerFrame,
+	TEXT("Most bytes a thread may take from its frame stack before TFrameAllocator containers fall back to the heap until the frame ends."));
+
 static int32 GMemStackProtection = 0;
 static int32 GMemStackProtectionLatched = 0;
 
@@ -375,4 +388,48 @@ bool FMemStackBase::ContainsPointer(const void* Pointer) const
 	}
 
 	return false;
-}
\ No newline at end of file
+}
+
+
+/*-----------------------------------------------------------------------------
+	FFrameMemStack implementation.
+-----------------------------------------------------------------------------*/
+
+void* FFrameMemStack::TryAllocFrameBytes(SIZE_T AllocSize, int32 Alignment)
+{
+	// Only threads that have ended a frame are known to reset their stack; everything else would grow it without bound
+	if (GetFrameIndex() == 0 || NumFrameBytes + AllocSize > (SIZE_T)FMath::Max(GFrameMemStackMaxBytesPerFrame, 0))
+	{
+		++NumHeapFallbacks;
+		return nullptr;
+	}
+
+	++NumFrameAllocations;
+	NumFrameBytes += AllocSize;
+	return PushBytes((int32)AllocSize, Alignment);
+}
+
+void FFrameMemStack::EndFrame()
+{
+#if STATS
+	// Every frame allocation is a heap allocation the container would have made with the default allocator
+	if (IsInGameThread())
+	{
+		INC_DWORD_STAT_BY(STAT_FrameMemStackAllocationsGT, NumFrameAllocations);
+		INC_DWORD_STAT_BY(STAT_FrameMemStackHeapFallbacksGT, NumHeapFallbacks);
+		SET_MEMORY_STAT(STAT_FrameMemStackBytesGT, GetByteCount());
+	}
+	else if (IsInActualRenderingThread())
+	{
+		INC_DWORD_STAT_BY(STAT_FrameMemStackAllocationsRT, NumFrameAllocations);
+		INC_DWORD_STAT_BY(STAT_FrameMemStackHeapFallbacksRT, NumHeapFallbacks);
+		SET_MEMORY_STAT(STAT_FrameMemStackBytesRT, GetByteCount());
+	}
+#endif
+
+	Flush();
+	NumFrameAllocations = 0;
+	NumHeapFallbacks = 0;
+	NumFrameBytes = 0;
+	FrameIndex.store(FrameIndex.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
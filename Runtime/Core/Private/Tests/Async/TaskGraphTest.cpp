@@ -13,6 +13,8 @@
 #include "Math/RandomStream.h"
 #include "Containers/CircularQueue.h"
 #include "Containers/Queue.h"
+#include "HAL/IConsoleManager.h"
+#include "Templates/UniquePtr.h"
 #include <atomic>
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -1254,6 +1256,349 @@ namespace TaskGraphTests
 		return true;
 	}
 
+	// all tasks are spawned from the game thread and go through the shared incoming queue
+	template<int32 NumTasks>
+	void TestFanOutFanIn()
+	{
+		FGraphEventArray Tasks;
+		Tasks.Reserve(NumTasks);
+		for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+		{
+			Tasks.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([] {}));
+		}
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(MoveTemp(Tasks));
+	}
+
+	// tasks are spawned from worker threads, so with work stealing they start in the spawning worker's local deque
+	template<int32 NumTasks, int32 NumSpawners>
+	void TestNestedFanOutFanIn()
+	{
+		static_assert(NumTasks % NumSpawners == 0, "`NumTasks` must be divisible by `NumSpawners`");
+
+		FGraphEventArray Spawners;
+		for (int32 SpawnerIndex = 0; SpawnerIndex < NumSpawners; ++SpawnerIndex)
+		{
+			Spawners.Add(FFunctionGraphTask::CreateAndDispatchWhenReady(
+				[](ENamedThreads::Type CurrentThread, const FGraphEventRef& CompletionEvent)
+				{
+					for (int32 TaskIndex = 0; TaskIndex < NumTasks / NumSpawners; ++TaskIndex)
+					{
+						CompletionEvent->DontCompleteUntil(FFunctionGraphTask::CreateAndDispatchWhenReady([] {}));
+					}
+				}
+			));
+		}
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(MoveTemp(Spawners));
+	}
+
+	// each task is queued by the worker that completed its prerequisite
+	template<int32 NumChains, int32 ChainLength>
+	void TestDependencyChains()
+	{
+		FGraphEventArray Chains;
+		for (int32 ChainIndex = 0; ChainIndex < NumChains; ++ChainIndex)
+		{
+			FGraphEventRef Last = FFunctionGraphTask::CreateAndDispatchWhenReady([] {});
+			for (int32 LinkIndex = 1; LinkIndex < ChainLength; ++LinkIndex)
+			{
+				Last = FFunctionGraphTask::CreateAndDispatchWhenReady([] {}, TStatId{}, Last);
+			}
+			Chains.Add(Last);
+		}
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(MoveTemp(Chains));
+	}
+
+	template<int32 Num>
+	void TestFineGrainedParallelFor()
+	{
+		std::atomic<int32> NumOdd{ 0 };
+		ParallelFor(Num, [&NumOdd](int32 Index) { NumOdd += (Index & 1); });
+		check(NumOdd == Num / 2);
+	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSchedulerBenchmark, "System.Core.Async.TaskGraph.SchedulerBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FSchedulerBenchmark::RunTest(const FString& Parameters)
+	{
+		if (!FTaskGraphInterface::IsMultithread())
+		{
+			UE_LOG(LogTemp, Display, TEXT("SchedulerBenchmark disabled for non multi-threading platforms"));
+			return true;
+		}
+
+		IConsoleVariable* UseWorkStealing = IConsoleManager::Get().FindConsoleVariable(TEXT("TaskGraph.UseWorkStealing"));
+		if (!UseWorkStealing)
+		{
+			AddError(TEXT("TaskGraph.UseWorkStealing not found"));
+			return false;
+		}
+
+		const int32 OriginalValue = UseWorkStealing->GetInt();
+		for (int32 bWorkStealing = 0; bWorkStealing < 2; ++bWorkStealing)
+		{
+			UseWorkStealing->Set(bWorkStealing, ECVF_SetByConsole);
+			UE_LOG(LogTemp, Display, TEXT("\n===============================\nScheduler: %s"), bWorkStealing ? TEXT("work stealing") : TEXT("shared incoming queues"));
+
+			BENCHMARK(5, TestFanOutFanIn<1 << 16>);
+			BENCHMARK(5, TestNestedFanOutFanIn<1 << 16, 16>);
+			BENCHMARK(5, TestDependencyChains<64, 256>);
+			BENCHMARK(5, TestFineGrainedParallelFor<1 << 20>);
+			BENCHMARK(5, Fib<18>);
+		}
+		UseWorkStealing->Set(OriginalValue, ECVF_SetByConsole);
+
+		return true;
+	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorkStealingStressTest, "System.Core.Async.TaskGraph.WorkStealingStressTest", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	// many workers push to their local deques at once while the others steal from them; every task must run exactly once
+	bool FWorkStealingStressTest::RunTest(const FString& Parameters)
+	{
+		if (!FTaskGraphInterface::IsMultithread())
+		{
+			UE_LOG(LogTemp, Display, TEXT("WorkStealingStressTest disabled for non multi-threading platforms"));
+			return true;
+		}
+
+		IConsoleVariable* UseWorkStealing = IConsoleManager::Get().FindConsoleVariable(TEXT("TaskGraph.UseWorkStealing"));
+		if (!UseWorkStealing)
+		{
+			AddError(TEXT("TaskGraph.UseWorkStealing not found"));
+			return false;
+		}
+		const int32 OriginalValue = UseWorkStealing->GetInt();
+		UseWorkStealing->Set(1, ECVF_SetByConsole);
+
+		constexpr int32 NumRounds = 10;
+		constexpr int32 NumProducers = 64;
+		constexpr int32 NumTasksPerProducer = 1024;
+		constexpr int32 NumTasks = NumProducers * NumTasksPerProducer;
+		TUniquePtr<std::atomic<int32>[]> RunCounts = MakeUnique<std::atomic<int32>[]>(NumTasks);
+
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			for (int32 Index = 0; Index < NumTasks; ++Index)
+			{
+				RunCounts[Index].store(0, std::memory_order_relaxed);
+			}
+
+			FGraphEventArray Producers;
+			for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+			{
+				Producers.Add(FFunctionGraphTask::CreateAndDispatchWhenReady(
+					[&RunCounts, ProducerIndex](ENamedThreads::Type CurrentThread, const FGraphEventRef& CompletionEvent)
+					{
+						for (int32 TaskIndex = 0; TaskIndex < NumTasksPerProducer; ++TaskIndex)
+						{
+							const int32 Index = ProducerIndex * NumTasksPerProducer + TaskIndex;
+							// alternate task priorities so that both deques of every worker are used
+							const ENamedThreads::Type Thread = (TaskIndex & 1) ? ENamedThreads::AnyNormalThreadHiPriTask : ENamedThreads::AnyNormalThreadNormalTask;
+							if (TaskIndex % 8 == 0)
+							{
+								// a task that may have been stolen pushes to its new worker's deque in turn
+								CompletionEvent->DontCompleteUntil(FFunctionGraphTask::CreateAndDispatchWhenReady(
+									[&RunCounts, Index, Thread](ENamedThreads::Type, const FGraphEventRef& NestedCompletionEvent)
+									{
+										NestedCompletionEvent->DontCompleteUntil(FFunctionGraphTask::CreateAndDispatchWhenReady(
+											[&RunCounts, Index] { RunCounts[Index].fetch_add(1, std::memory_order_relaxed); }, TStatId{}, nullptr, Thread));
+									},
+									TStatId{}, nullptr, Thread));
+							}
+							else
+							{
+								CompletionEvent->DontCompleteUntil(FFunctionGraphTask::CreateAndDispatchWhenReady(
+									[&RunCounts, Index] { RunCounts[Index].fetch_add(1, std::memory_order_relaxed); }, TStatId{}, nullptr, Thread));
+							}
+						}
+					},
+					TStatId{}, nullptr, ENamedThreads::AnyNormalThreadNormalTask));
+			}
+			FTaskGraphInterface::Get().WaitUntilTasksComplete(MoveTemp(Producers));
+
+			int32 NumLost = 0;
+			int32 NumRunTwice = 0;
+			for (int32 Index = 0; Index < NumTasks; ++Index)
+			{
+				const int32 RunCount = RunCounts[Index].load(std::memory_order_relaxed);
+				NumLost += RunCount == 0 ? 1 : 0;
+				NumRunTwice += RunCount > 1 ? 1 : 0;
+			}
+			if (NumLost != 0 || NumRunTwice != 0)
+			{
+				AddError(FString::Printf(TEXT("Round %d: %d of %d tasks never ran and %d ran more than once"), Round, NumLost, NumTasks, NumRunTwice));
+				break;
+			}
+		}
+
+		UseWorkStealing->Set(OriginalValue, ECVF_SetByConsole);
+		return !HasAnyErrors();
+	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForRangeTest, "System.Core.Async.ParallelForRange", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FParallelForRangeTest::RunTest(const FString& Parameters)
+	{
+		for (int32 Num : { 0, 1, 7, 1000, 100'000 })
+		{
+			for (int32 MinBatchSize : { 1, 16, 1024 })
+			{
+				TArray<int32> Visited;
+				Visited.SetNumZeroed(Num);
+				ParallelForRange(Num, [&Visited](int32 Begin, int32 End)
+				{
+					check(Begin < End);
+					for (int32 Index = Begin; Index < End; Index++)
+					{
+						FPlatformAtomics::InterlockedIncrement(&Visited[Index]);
+					}
+				}, MinBatchSize);
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					if (Visited[Index] != 1)
+					{
+						AddError(FString::Printf(TEXT("ParallelForRange(%d, MinBatchSize %d) visited index %d %d times"), Num, MinBatchSize, Index, Visited[Index]));
+						return false;
+					}
+				}
+
+				const int64 Sum = ParallelReduce(Num, int64(0),
+					[](int32 Begin, int32 End)
+					{
+						int64 RangeSum = 0;
+						for (int32 Index = Begin; Index < End; Index++)
+						{
+							RangeSum += Index;
+						}
+						return RangeSum;
+					},
+					[](int64 A, int64 B) { return A + B; },
+					MinBatchSize);
+				TestEqual(TEXT("ParallelReduce sum"), Sum, int64(Num) * (Num - 1) / 2);
+
+				// not commutative, checks the partial results are combined in order
+				const FString Concatenated = ParallelReduce(FMath::Min(Num, 1000), FString(),
+					[](int32 Begin, int32 End)
+					{
+						FString Result;
+						for (int32 Index = Begin; Index < End; Index++)
+						{
+							Result.AppendChar(TCHAR('a' + Index % 26));
+						}
+						return Result;
+					},
+					[](const FString& A, const FString& B) { return A + B; },
+					MinBatchSize);
+				for (int32 Index = 0; Index < Concatenated.Len(); Index++)
+				{
+					if (Concatenated[Index] != TCHAR('a' + Index % 26))
+					{
+						AddError(FString::Printf(TEXT("ParallelReduce(%d, MinBatchSize %d) combined out of order"), Num, MinBatchSize));
+						return false;
+					}
+				}
+
+				TArray<int64> Prefix;
+				Prefix.SetNumUninitialized(Num);
+				ParallelScan(Num, int64(0),
+					[](int32 Begin, int32 End) { return int64(End - Begin); },
+					[&Prefix](int32 Begin, int32 End, int64 RangePrefix)
+					{
+						for (int32 Index = Begin; Index < End; Index++)
+						{
+							RangePrefix += 1;
+							Prefix[Index] = RangePrefix;
+						}
+					},
+					[](int64 A, int64 B) { return A + B; },
+					MinBatchSize);
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					if (Prefix[Index] != Index + 1)
+					{
+						AddError(FString::Printf(TEXT("ParallelScan(%d, MinBatchSize %d) wrong prefix at %d"), Num, MinBatchSize, Index));
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	// the cost of element i grows with i, so equal sized blocks are badly balanced
+	static FORCEINLINE uint32 IrregularWork(int32 Index, int32 Num)
+	{
+		uint32 Hash = uint32(Index);
+		const int32 Iterations = 1 + (64 * Index) / Num;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Hash = Hash * 1103515245u + 12345u;
+		}
+		return Hash;
+	}
+
+	static constexpr int32 ParallelForRangeBenchmarkNum = 1 << 20;
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForRangeBenchmark, "System.Core.Async.ParallelForRange.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FParallelForRangeBenchmark::RunTest(const FString& Parameters)
+	{
+		TArray<uint32> Results;
+		Results.SetNumZeroed(ParallelForRangeBenchmarkNum);
+
+		Benchmark<5>(TEXT("ParallelFor, per element, uniform"), [&Results]
+		{
+			ParallelFor(ParallelForRangeBenchmarkNum, [&Results](int32 Index) { Results[Index] = Index * 2654435761u; });
+		});
+		Benchmark<5>(TEXT("ParallelForRange, uniform"), [&Results]
+		{
+			ParallelForRange(ParallelForRangeBenchmarkNum, [&Results](int32 Begin, int32 End)
+			{
+				for (int32 Index = Begin; Index < End; Index++)
+				{
+					Results[Index] = Index * 2654435761u;
+				}
+			}, 1024);
+		});
+
+		Benchmark<5>(TEXT("ParallelFor, per element, irregular"), [&Results]
+		{
+			ParallelFor(ParallelForRangeBenchmarkNum, [&Results](int32 Index) { Results[Index] = IrregularWork(Index, ParallelForRangeBenchmarkNum); });
+		});
+		Benchmark<5>(TEXT("ParallelFor, per element, irregular, unbalanced"), [&Results]
+		{
+			ParallelFor(ParallelForRangeBenchmarkNum, [&Results](int32 Index) { Results[Index] = IrregularWork(Index, ParallelForRangeBenchmarkNum); }, EParallelForFlags::Unbalanced);
+		});
+		Benchmark<5>(TEXT("ParallelForRange, irregular"), [&Results]
+		{
+			ParallelForRange(ParallelForRangeBenchmarkNum, [&Results](int32 Begin, int32 End)
+			{
+				for (int32 Index = Begin; Index < End; Index++)
+				{
+					Results[Index] = IrregularWork(Index, ParallelForRangeBenchmarkNum);
+				}
+			}, 256);
+		});
+
+		Benchmark<5>(TEXT("ParallelReduce, irregular"), []
+		{
+			ParallelReduce(ParallelForRangeBenchmarkNum, uint32(0),
+				[](int32 Begin, int32 End)
+				{
+					uint32 RangeResult = 0;
+					for (int32 Index = Begin; Index < End; Index++)
+					{
+						RangeResult ^= IrregularWork(Index, ParallelForRangeBenchmarkNum);
+					}
+					return RangeResult;
+				},
+				[](uint32 A, uint32 B) { return A ^ B; },
+				256);
+		});
+
+		return true;
+	}
+
 #undef BENCHMARK
 }
 #endif //WITH_DEV_AUTOMATION_TESTS
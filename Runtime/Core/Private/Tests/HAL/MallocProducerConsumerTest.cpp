@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreGlobals.h"
+#include "HAL/Thread.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/MallocAnsi.h"
+#include "HAL/MallocJemalloc.h"
+#include "HAL/MallocMimalloc.h"
+#include "Containers/Array.h"
+#include "Math/RandomStream.h"
+#include <atomic>
+
+// Run with -binnedmalloc2 / -binnedmalloc3 (or -jemalloc / -mimalloc where supported) to compare the engine allocator; the
+// stateless system allocators available on the platform are measured side by side in the same run.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocProducerConsumerPerfTest, "System.Core.HAL.Malloc.ProducerConsumerPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace MallocProducerConsumerTest
+{
+	static constexpr uint32 RingCapacity = 4096;
+	static constexpr uint32 NumSizes = 1024;
+	static constexpr int32 AllocationsPerProducer = 1 << 19;
+	// One allocation out of this many is freed by the producer itself instead of being handed to the consumer
+	static constexpr int32 LocalFreeInterval = 4;
+
+	/** Single producer / single consumer ring handing blocks from the allocating thread to the freeing thread. */
+	struct FBlockRing
+	{
+		void* Slots[RingCapacity];
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head{ 0 };
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail{ 0 };
+
+		bool TryPush(void* Block)
+		{
+			const uint32 LocalHead = Head.load(std::memory_order_relaxed);
+			if (LocalHead - Tail.load(std::memory_order_acquire) == RingCapacity)
+			{
+				return false;
+			}
+			Slots[LocalHead % RingCapacity] = Block;
+			Head.store(LocalHead + 1, std::memory_order_release);
+			return true;
+		}
+
+		void* TryPop()
+		{
+			const uint32 LocalTail = Tail.load(std::memory_order_relaxed);
+			if (LocalTail == Head.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			}
+			void* Block = Slots[LocalTail % RingCapacity];
+			Tail.store(LocalTail + 1, std::memory_order_release);
+			return Block;
+		}
+	};
+
+	/** Mostly small sizes with a tail of larger ones, roughly what gameplay and task code hands between threads. */
+	static TArray<uint32> MakeSizes()
+	{
+		FRandomStream Random(0x5eed);
+		TArray<uint32> Sizes;
+		Sizes.Reserve(NumSizes);
+		for (uint32 Index = 0; Index < NumSizes; ++Index)
+		{
+			Sizes.Add(Random.FRand() < 0.9f ? Random.RandRange(8, 256) : Random.RandRange(257, 8192));
+		}
+		return Sizes;
+	}
+
+	/** Returns the wall time in seconds for NumPairs producer threads allocating and NumPairs consumer threads freeing. */
+	static double Run(FMalloc& Allocator, int32 NumPairs, const TArray<uint32>& Sizes)
+	{
+		TArray<FBlockRing*> Rings;
+		for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+		{
+			Rings.Add(new FBlockRing);
+		}
+
+		std::atomic<int32> NumReady{ 0 };
+		std::atomic<bool> bStart{ false };
+		TArray<FThread> Threads;
+		Threads.Reserve(NumPairs * 2);
+		for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+		{
+			FBlockRing& Ring = *Rings[Pair];
+			Threads.Emplace(TEXT("MallocProducer"), [&Allocator, &Ring, &Sizes, &NumReady, &bStart]()
+			{
+				NumReady++;
+				while (!bStart.load(std::memory_order_acquire))
+				{
+					FPlatformProcess::Yield();
+				}
+				for (int32 Index = 0; Index < AllocationsPerProducer; ++Index)
+				{
+					uint8* Block = (uint8*)Allocator.Malloc(Sizes[Index % NumSizes]);
+					Block[0] = uint8(Index);
+					if (Index % LocalFreeInterval == 0)
+					{
+						Allocator.Free(Block);
+						continue;
+					}
+					while (!Ring.TryPush(Block))
+					{
+						FPlatformProcess::Yield();
+					}
+				}
+			});
+			Threads.Emplace(TEXT("MallocConsumer"), [&Allocator, &Ring, &NumReady, &bStart]()
+			{
+				NumReady++;
+				while (!bStart.load(std::memory_order_acquire))
+				{
+					FPlatformProcess::Yield();
+				}
+				const int32 NumToFree = AllocationsPerProducer - (AllocationsPerProducer + LocalFreeInterval - 1) / LocalFreeInterval;
+				for (int32 Index = 0; Index < NumToFree; ++Index)
+				{
+					void* Block;
+					while ((Block = Ring.TryPop()) == nullptr)
+					{
+						FPlatformProcess::Yield();
+					}
+					Allocator.Free(Block);
+				}
+			});
+		}
+
+		while (NumReady.load() != Threads.Num())
+		{
+			FPlatformProcess::Yield();
+		}
+		const double StartTime = FPlatformTime::Seconds();
+		bStart.store(true, std::memory_order_release);
+		for (FThread& Thread : Threads)
+		{
+			Thread.Join();
+		}
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		for (FBlockRing* Ring : Rings)
+		{
+			delete Ring;
+		}
+		return Elapsed;
+	}
+}
+
+bool FMallocProducerConsumerPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace MallocProducerConsumerTest;
+
+	const int32 NumPairs = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() / 2, 1, 8);
+	const TArray<uint32> Sizes = MakeSizes();
+	const double TotalOps = 2.0 * NumPairs * AllocationsPerProducer;
+
+	auto Measure = [this, NumPairs, &Sizes, TotalOps](FMalloc& Allocator, const TCHAR* Name)
+	{
+		// Warm up so the first measured run doesn't pay for committing fresh pages
+		Run(Allocator, NumPairs, Sizes);
+		const double Elapsed = Run(Allocator, NumPairs, Sizes);
+		AddInfo(FString::Printf(TEXT("%-24s %d producer/consumer pairs: %8.2fms  %6.2f Mops/s"), Name, NumPairs, Elapsed * 1000.0, TotalOps / Elapsed / 1000000.0));
+	};
+
+	Measure(*GMalloc, GMalloc->GetDescriptiveName());
+
+	FMallocAnsi Ansi;
+	Measure(Ansi, TEXT("Ansi"));
+
+#if PLATFORM_SUPPORTS_JEMALLOC
+	FMallocJemalloc Jemalloc;
+	Measure(Jemalloc, TEXT("jemalloc"));
+#endif
+
+#if PLATFORM_SUPPORTS_MIMALLOC && MIMALLOC_ALLOCATOR_ALLOWED
+	FMallocMimalloc Mimalloc;
+	Measure(Mimalloc, TEXT("mimalloc"));
+#endif
+
+	GMalloc->DumpAllocatorStats(*GLog);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreGlobals.h"
+#include "HAL/MallocSamplingProfiler.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/UniquePtr.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocSamplingProfilerTest, "System.Core.HAL.Malloc.SamplingProfiler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocSamplingProfilerFailedReallocTest, "System.Core.HAL.Malloc.SamplingProfilerFailedRealloc", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocSamplingProfilerOverheadTest, "System.Core.HAL.Malloc.SamplingProfilerOverhead", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace MallocSamplingProfilerTest
+{
+	static FORCENOINLINE void AllocateBlocks(FMalloc& Allocator, TArray<void*>& OutBlocks, int32 NumBlocks, SIZE_T BlockSize)
+	{
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			OutBlocks.Add(Allocator.Malloc(BlockSize, DEFAULT_ALIGNMENT));
+		}
+	}
+
+	/** Passes everything through to another allocator but can be told to fail reallocations */
+	class FFailingReallocMalloc : public FMalloc
+	{
+	public:
+		explicit FFailingReallocMalloc(FMalloc* InUsedMalloc)
+			: UsedMalloc(InUsedMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			return UsedMalloc->Malloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override
+		{
+			return bFailRealloc ? nullptr : UsedMalloc->Realloc(Ptr, NewSize, Alignment);
+		}
+
+		virtual void Free(void* Ptr) override
+		{
+			UsedMalloc->Free(Ptr);
+		}
+
+		FMalloc* UsedMalloc;
+		bool bFailRealloc = false;
+	};
+
+	/** Runs a mixed size allocate/free workload and returns the time it took in seconds */
+	static FORCENOINLINE double TimeAllocationWorkload(FMalloc& Allocator, int32 NumOperations)
+	{
+		constexpr int32 NumLiveBlocks = 1024;
+		void* LiveBlocks[NumLiveBlocks] = { nullptr };
+		uint32 RandomState = 0x12345678;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Operation = 0; Operation < NumOperations; ++Operation)
+		{
+			// xorshift32, so both runs see exactly the same sizes
+			RandomState ^= RandomState << 13;
+			RandomState ^= RandomState >> 17;
+			RandomState ^= RandomState << 5;
+			void*& Block = LiveBlocks[RandomState % NumLiveBlocks];
+			Allocator.Free(Block);
+			Block = Allocator.Malloc(16 + (RandomState >> 20), DEFAULT_ALIGNMENT);
+		}
+		for (void* Block : LiveBlocks)
+		{
+			Allocator.Free(Block);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+bool FMallocSamplingProfilerTest::RunTest(const FString& Parameters)
+{
+	using namespace MallocSamplingProfilerTest;
+
+	const uint64 SampleInterval = 16 * 1024;
+	const int32 NumBlocks = 20000;
+	const SIZE_T BlockSize = 1024;
+	// ~1250 samples are expected for the full set, so a 15% tolerance is several standard deviations wide
+	const double Tolerance = 0.15;
+
+	TUniquePtr<FMallocSamplingProfiler> Profiler = MakeUnique<FMallocSamplingProfiler>(GMalloc, SampleInterval);
+
+	TArray<void*> Blocks;
+	Blocks.Reserve(NumBlocks);
+	AllocateBlocks(*Profiler, Blocks, NumBlocks, BlockSize);
+
+	const double AllocatedBytes = double(NumBlocks) * BlockSize;
+	const int64 EstimatedBytes = Profiler->GetEstimatedLiveBytes();
+	TestTrue(FString::Printf(TEXT("Estimated live bytes %lld are within %.0f%% of the %.0f allocated"), EstimatedBytes, Tolerance * 100.0, AllocatedBytes),
+		FMath::Abs(double(EstimatedBytes) - AllocatedBytes) <= AllocatedBytes * Tolerance);
+
+	TArray<FMallocSamplingProfiler::FSiteSummary> Sites;
+	Profiler->GetLiveSites(Sites);
+	TestTrue(TEXT("Live samples are reported as allocation sites"), Sites.Num() > 0);
+	for (int32 Index = 1; Index < Sites.Num(); ++Index)
+	{
+		TestTrue(TEXT("Sites are sorted by estimated bytes"), Sites[Index - 1].EstimatedBytes >= Sites[Index].EstimatedBytes);
+	}
+
+	// Free every other block; the estimate must follow
+	for (int32 Index = 0; Index < Blocks.Num(); Index += 2)
+	{
+		Profiler->Free(Blocks[Index]);
+		Blocks[Index] = nullptr;
+	}
+	const int64 EstimatedAfterFree = Profiler->GetEstimatedLiveBytes();
+	TestTrue(FString::Printf(TEXT("Estimated live bytes %lld are within %.0f%% of the %.0f still allocated"), EstimatedAfterFree, Tolerance * 100.0, AllocatedBytes / 2),
+		FMath::Abs(double(EstimatedAfterFree) - AllocatedBytes / 2) <= AllocatedBytes / 2 * Tolerance);
+
+	// Reallocating moves samples along with the memory
+	for (int32 Index = 1; Index < Blocks.Num(); Index += 2)
+	{
+		Blocks[Index] = Profiler->Realloc(Blocks[Index], BlockSize * 2, DEFAULT_ALIGNMENT);
+	}
+	const int64 EstimatedAfterRealloc = Profiler->GetEstimatedLiveBytes();
+	TestTrue(FString::Printf(TEXT("Estimated live bytes %lld are within %.0f%% of the %.0f reallocated"), EstimatedAfterRealloc, Tolerance * 100.0, AllocatedBytes),
+		FMath::Abs(double(EstimatedAfterRealloc) - AllocatedBytes) <= AllocatedBytes * Tolerance);
+
+	for (void* Block : Blocks)
+	{
+		Profiler->Free(Block);
+	}
+	TestEqual(TEXT("No estimated live bytes once everything is freed"), Profiler->GetEstimatedLiveBytes(), int64(0));
+	Profiler->GetLiveSites(Sites);
+	TestEqual(TEXT("No live sites once everything is freed"), Sites.Num(), 0);
+
+	return true;
+}
+
+bool FMallocSamplingProfilerFailedReallocTest::RunTest(const FString& Parameters)
+{
+	using namespace MallocSamplingProfilerTest;
+
+	FFailingReallocMalloc FailingMalloc(GMalloc);
+	// A one byte interval samples every allocation once the thread's countdown is seeded
+	TUniquePtr<FMallocSamplingProfiler> Profiler = MakeUnique<FMallocSamplingProfiler>(&FailingMalloc, 1);
+
+	void* Block = nullptr;
+	for (int32 Attempt = 0; Attempt < 4 && Profiler->GetEstimatedLiveBytes() == 0; ++Attempt)
+	{
+		Profiler->Free(Block);
+		Block = Profiler->Malloc(256, DEFAULT_ALIGNMENT);
+	}
+	const int64 EstimatedBeforeRealloc = Profiler->GetEstimatedLiveBytes();
+	TestTrue(TEXT("The block is sampled"), EstimatedBeforeRealloc > 0);
+
+	FailingMalloc.bFailRealloc = true;
+	void* FailedRealloc = Profiler->Realloc(Block, 1024, DEFAULT_ALIGNMENT);
+	FailingMalloc.bFailRealloc = false;
+	TestNull(TEXT("The reallocation failed"), FailedRealloc);
+	TestEqual(TEXT("A failed realloc keeps the sample of the still live block"), Profiler->GetEstimatedLiveBytes(), EstimatedBeforeRealloc);
+
+	Profiler->Free(Block);
+	TestEqual(TEXT("Freeing the block removes its sample"), Profiler->GetEstimatedLiveBytes(), int64(0));
+
+	return true;
+}
+
+bool FMallocSamplingProfilerOverheadTest::RunTest(const FString& Parameters)
+{
+	using namespace MallocSamplingProfilerTest;
+
+	constexpr int32 NumOperations = 2 * 1024 * 1024;
+	constexpr int32 NumRuns = 5;
+	// Default value of Memory.SamplingProfiler.Interval
+	constexpr uint64 SampleInterval = 512 * 1024;
+	// Target overhead of the profiler at the default interval
+	constexpr double MaxOverhead = 0.02;
+
+	TUniquePtr<FMallocSamplingProfiler> Profiler = MakeUnique<FMallocSamplingProfiler>(GMalloc, SampleInterval);
+
+	// Interleave the runs and keep the fastest of each so frequency changes and other threads affect both sides alike
+	double BestUnprofiled = TNumericLimits<double>::Max();
+	double BestProfiled = TNumericLimits<double>::Max();
+	for (int32 Run = 0; Run < NumRuns; ++Run)
+	{
+		BestUnprofiled = FMath::Min(BestUnprofiled, TimeAllocationWorkload(*GMalloc, NumOperations));
+		BestProfiled = FMath::Min(BestProfiled, TimeAllocationWorkload(*Profiler, NumOperations));
+	}
+
+	const double Overhead = BestUnprofiled > 0.0 ? BestProfiled / BestUnprofiled - 1.0 : 0.0;
+	AddInfo(FString::Printf(TEXT("%d allocations: %.2fms through %s, %.2fms through the sampling profiler (%.2f%% overhead)"),
+		NumOperations, BestUnprofiled * 1000.0, GMalloc->GetDescriptiveName(), BestProfiled * 1000.0, Overhead * 100.0));
+	if (Overhead > MaxOverhead)
+	{
+		AddWarning(FString::Printf(TEXT("Sampling profiler overhead of %.2f%% is above the %.0f%% target"), Overhead * 100.0, MaxOverhead * 100.0));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,266 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Containers/Array.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/Thread.h"
+#include "Misc/MemStack.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameAllocatorTest, "System.Core.Misc.FrameAllocator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameAllocatorFallbackTest, "System.Core.Misc.FrameAllocatorFallback", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameAllocatorAllocationCountTest, "System.Core.Misc.FrameAllocatorAllocationCount", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace FrameAllocatorTest
+{
+	static int32 NumHeapAllocations = 0;
+
+	/** Heap allocator counting every allocation and reallocation it makes, to compare against TFrameAllocator */
+	struct FCountingHeapAllocator : public FHeapAllocator
+	{
+		template<typename ElementType>
+		class ForElementType : public FHeapAllocator::ForElementType<ElementType>
+		{
+		public:
+			void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement)
+			{
+				if (NumElements)
+				{
+					++NumHeapAllocations;
+				}
+				FHeapAllocator::ForElementType<ElementType>::ResizeAllocation(PreviousNumElements, NumElements, NumBytesPerElement);
+			}
+		};
+	};
+
+	/** Stand-in for FOverlapInfo, which lives in the engine */
+	struct FTestOverlap
+	{
+		void* Component;
+		int32 BodyIndex;
+		bool bFromSweep;
+	};
+}
+
+template <>
+struct TAllocatorTraits<FrameAllocatorTest::FCountingHeapAllocator> : TAllocatorTraits<FHeapAllocator>
+{
+};
+
+bool FFrameAllocatorTest::RunTest(const FString& Parameters)
+{
+	// The game thread stack is reset by the engine loop, so run the frames on a thread of our own that ends them itself
+	bool bValuesPreserved = true;
+	bool bDataOnFrameStack = false;
+	bool bInlineUntilSpill = false;
+	bool bSpillOnFrameStack = false;
+	int32 NumFrameAllocations = 0;
+	bool bFrameIndexAdvanced = false;
+	bool bStackEmptyAfterFrame = false;
+	bool bStackReusedNextFrame = false;
+
+	FThread Thread(TEXT("FrameAllocatorTest"), [&]()
+	{
+		FFrameMemStack& Stack = FFrameMemStack::Get();
+		// Frame memory is only handed out on threads that end their frames
+		Stack.EndFrame();
+		const uint32 FirstFrame = Stack.GetFrameIndex();
+		{
+			TArray<int32, TFrameAllocator<>> Values;
+			for (int32 Index = 0; Index < 10000; ++Index)
+			{
+				Values.Add(Index);
+			}
+			for (int32 Index = 0; Index < Values.Num(); ++Index)
+			{
+				bValuesPreserved &= Values[Index] == Index;
+			}
+			bDataOnFrameStack = Stack.ContainsPointer(Values.GetData());
+
+			TArray<int32, TInlineAllocator<4, TFrameAllocator<>>> Inline;
+			Inline.Append({ 0, 1, 2, 3 });
+			bInlineUntilSpill = !Stack.ContainsPointer(Inline.GetData());
+			Inline.Add(4);
+			bSpillOnFrameStack = Stack.ContainsPointer(Inline.GetData());
+			for (int32 Index = 0; Index < Inline.Num(); ++Index)
+			{
+				bValuesPreserved &= Inline[Index] == Index;
+			}
+
+			NumFrameAllocations = Stack.GetNumFrameAllocations();
+		}
+		Stack.EndFrame();
+		bFrameIndexAdvanced = Stack.GetFrameIndex() == FirstFrame + 1;
+		bStackEmptyAfterFrame = Stack.IsEmpty() && Stack.GetNumFrameAllocations() == 0;
+
+		{
+			TArray<int32, TFrameAllocator<>> Values;
+			Values.Add(1);
+			bStackReusedNextFrame = Stack.ContainsPointer(Values.GetData());
+		}
+		Stack.EndFrame();
+	});
+	Thread.Join();
+
+	TestTrue(TEXT("Growing a frame container preserves its elements"), bValuesPreserved);
+	TestTrue(TEXT("Frame containers allocate from the frame stack"), bDataOnFrameStack);
+	TestTrue(TEXT("Inline storage is used before spilling"), bInlineUntilSpill);
+	TestTrue(TEXT("Inline containers spill to the frame stack"), bSpillOnFrameStack);
+	TestTrue(TEXT("Frame allocations are counted"), NumFrameAllocations > 1);
+	TestTrue(TEXT("Ending the frame advances the frame index"), bFrameIndexAdvanced);
+	TestTrue(TEXT("Ending the frame releases everything"), bStackEmptyAfterFrame);
+	TestTrue(TEXT("The stack is used again on the next frame"), bStackReusedNextFrame);
+
+	return true;
+}
+
+bool FFrameAllocatorFallbackTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* MaxBytesVar = IConsoleManager::Get().FindConsoleVariable(TEXT("memstack.FrameAllocator.MaxBytesPerFrame"));
+	if (!MaxBytesVar)
+	{
+		AddError(TEXT("memstack.FrameAllocator.MaxBytesPerFrame is not registered"));
+		return false;
+	}
+
+	// A thread that never ends a frame must not grow its frame stack
+	bool bHeapWithoutFrames = false;
+	bool bFallbackCounted = false;
+	bool bStackUntouched = false;
+	bool bValuesPreserved = true;
+	{
+		FThread Thread(TEXT("FrameAllocatorFallbackTest"), [&]()
+		{
+			FFrameMemStack& Stack = FFrameMemStack::Get();
+			{
+				TArray<int32, TFrameAllocator<>> Values;
+				for (int32 Index = 0; Index < 1000; ++Index)
+				{
+					Values.Add(Index);
+				}
+				for (int32 Index = 0; Index < Values.Num(); ++Index)
+				{
+					bValuesPreserved &= Values[Index] == Index;
+				}
+				bHeapWithoutFrames = !Stack.ContainsPointer(Values.GetData());
+				bFallbackCounted = Stack.GetNumHeapFallbacks() > 0;
+			}
+			bStackUntouched = Stack.IsEmpty() && Stack.GetNumFrameAllocations() == 0;
+		});
+		Thread.Join();
+	}
+	TestTrue(TEXT("Threads that don't end frames allocate from the heap"), bHeapWithoutFrames);
+	TestTrue(TEXT("Heap fallbacks are counted"), bFallbackCounted);
+	TestTrue(TEXT("The frame stack of a thread that doesn't end frames stays empty"), bStackUntouched);
+
+	// A frame that goes over budget moves its containers to the heap until the frame ends
+	const int32 PreviousMaxBytes = MaxBytesVar->GetInt();
+	MaxBytesVar->Set(1024, ECVF_SetByCode);
+	bool bFrameStackWithinBudget = false;
+	bool bHeapOverBudget = false;
+	bool bHeapContainerShrinks = false;
+	bool bFrameStackAfterBudgetReset = false;
+	{
+		FThread Thread(TEXT("FrameAllocatorBudgetTest"), [&]()
+		{
+			FFrameMemStack& Stack = FFrameMemStack::Get();
+			Stack.EndFrame();
+			{
+				TArray<int32, TFrameAllocator<>> Values;
+				Values.Add(0);
+				bFrameStackWithinBudget = Stack.ContainsPointer(Values.GetData());
+				for (int32 Index = 1; Index < 10000; ++Index)
+				{
+					Values.Add(Index);
+				}
+				for (int32 Index = 0; Index < Values.Num(); ++Index)
+				{
+					bValuesPreserved &= Values[Index] == Index;
+				}
+				bHeapOverBudget = !Stack.ContainsPointer(Values.GetData());
+				Values.SetNum(10);
+				Values.Shrink();
+				bHeapContainerShrinks = Values.Max() < 10000;
+				for (int32 Index = 0; Index < Values.Num(); ++Index)
+				{
+					bValuesPreserved &= Values[Index] == Index;
+				}
+			}
+			Stack.EndFrame();
+			{
+				TArray<int32, TFrameAllocator<>> Values;
+				Values.Add(1);
+				bFrameStackAfterBudgetReset = Stack.ContainsPointer(Values.GetData());
+			}
+			Stack.EndFrame();
+		});
+		Thread.Join();
+	}
+	MaxBytesVar->Set(PreviousMaxBytes, ECVF_SetByCode);
+
+	TestTrue(TEXT("Container elements survive moving to the heap"), bValuesPreserved);
+	TestTrue(TEXT("Allocations within budget come from the frame stack"), bFrameStackWithinBudget);
+	TestTrue(TEXT("Allocations over budget come from the heap"), bHeapOverBudget);
+	TestTrue(TEXT("Containers on the heap give memory back when shrunk"), bHeapContainerShrinks);
+	TestTrue(TEXT("The budget is reset by the next frame"), bFrameStackAfterBudgetReset);
+
+	return true;
+}
+
+/**
+ * Counts the heap allocations of an UpdateOverlaps-like workload with the default inline allocator and with the frame allocator:
+ * every move gathers a list of overlaps one at a time and then copies it, with 0 to 7 overlaps per move.
+ */
+bool FFrameAllocatorAllocationCountTest::RunTest(const FString& Parameters)
+{
+	using namespace FrameAllocatorTest;
+
+	constexpr int32 NumMoves = 1000;
+	constexpr int32 MaxOverlapsPerMove = 8;
+
+	NumHeapAllocations = 0;
+	for (int32 Move = 0; Move < NumMoves; ++Move)
+	{
+		TArray<FTestOverlap, TInlineAllocator<3, FCountingHeapAllocator>> Overlaps;
+		for (int32 Index = 0; Index < Move % MaxOverlapsPerMove; ++Index)
+		{
+			Overlaps.Add(FTestOverlap{ nullptr, Index, false });
+		}
+		const TArray<FTestOverlap, TInlineAllocator<3, FCountingHeapAllocator>> OverlapsCopy(Overlaps);
+	}
+	const int32 NumHeapAllocationsBefore = NumHeapAllocations;
+
+	int32 NumHeapAllocationsAfter = 0;
+	int32 NumFrameAllocationsAfter = 0;
+	FThread Thread(TEXT("FrameAllocatorCountTest"), [&]()
+	{
+		FFrameMemStack& Stack = FFrameMemStack::Get();
+		Stack.EndFrame();
+		for (int32 Move = 0; Move < NumMoves; ++Move)
+		{
+			TArray<FTestOverlap, TInlineAllocator<3, TFrameAllocator<>>> Overlaps;
+			for (int32 Index = 0; Index < Move % MaxOverlapsPerMove; ++Index)
+			{
+				Overlaps.Add(FTestOverlap{ nullptr, Index, false });
+			}
+			const TArray<FTestOverlap, TInlineAllocator<3, TFrameAllocator<>>> OverlapsCopy(Overlaps);
+		}
+		NumHeapAllocationsAfter = Stack.GetNumHeapFallbacks();
+		NumFrameAllocationsAfter = Stack.GetNumFrameAllocations();
+		Stack.EndFrame();
+	});
+	Thread.Join();
+
+	AddInfo(FString::Printf(TEXT("%d moves: %d heap allocations with TInlineAllocator<3>, %d heap and %d frame allocations with TInlineAllocator<3, TFrameAllocator<>>"),
+		NumMoves, NumHeapAllocationsBefore, NumHeapAllocationsAfter, NumFrameAllocationsAfter));
+	TestTrue(TEXT("Overlap lists that spill past the inline storage allocate from the heap by default"), NumHeapAllocationsBefore > 0);
+	TestEqual(TEXT("The frame allocator serves every spill without the heap"), NumHeapAllocationsAfter, 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
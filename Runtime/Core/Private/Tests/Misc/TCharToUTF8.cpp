@@ -2,6 +2,7 @@
 
 #include "CoreTypes.h"
 #include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -106,6 +107,176 @@ bool FTCharToUTF8Test::RunTest(const FString& Parameters)
 		TestEqual("IllegalSurrogatePair", TCHAR_TO_UTF8(EndWithIllegalSurrogatePair), "ab?");
 	}
 
+	{
+		// Invalid sequences must decode the same whether they start, end or interrupt the runs of ASCII chars and three octet sequences converted a block at a time
+		struct FInvalidSequence
+		{
+			const ANSICHAR* Utf8;
+			int32 NumBogusChars;
+		};
+
+		const FInvalidSequence InvalidSequences[] =
+		{
+			{ "\x80", 1 },                 // Lone continuation octet
+			{ "\xC0\xAF", 2 },             // Overlong two octet sequence
+			{ "\xE0\x80\x80", 3 },         // Overlong three octet sequence
+			{ "\xED\xA0\x80", 3 },         // Encoded high-surrogate
+			{ "\xEF\xBF\xBF", 3 },         // Illegal U+FFFF
+			{ "\xE4\xBD", 2 },             // Three octet sequence missing its last octet
+			{ "\xF4\x90\x80\x80", 4 },     // Codepoint above U+10FFFF
+			{ "\xF8\x88\x80\x80\x80", 1 }, // Five octet sequence
+		};
+
+		const ANSICHAR AsciiRun[] = "0123456789abcdefghijklmnopqrstuv";
+		const ANSICHAR CjkUtf8[] = "\xE4\xBD\xA0";
+		const TCHAR CjkChar = (TCHAR)0x4F60;
+
+		for (const FInvalidSequence& InvalidSequence : InvalidSequences)
+		{
+			for (int32 PrefixLen = 0; PrefixLen < 20; ++PrefixLen)
+			{
+				for (const bool bCjk : { false, true })
+				{
+					TArray<ANSICHAR> Utf8;
+					FString Expected;
+					for (int32 Index = 0; Index < PrefixLen; ++Index)
+					{
+						if (bCjk)
+						{
+							Utf8.Append(CjkUtf8, 3);
+							Expected.AppendChar(CjkChar);
+						}
+						else
+						{
+							Utf8.Add(AsciiRun[Index]);
+							Expected.AppendChar((TCHAR)AsciiRun[Index]);
+						}
+					}
+
+					Utf8.Append(InvalidSequence.Utf8, FCStringAnsi::Strlen(InvalidSequence.Utf8));
+					for (int32 Index = 0; Index < InvalidSequence.NumBogusChars; ++Index)
+					{
+						Expected.AppendChar(UNICODE_BOGUS_CHAR_CODEPOINT);
+					}
+
+					for (int32 Index = 0; Index < 20; ++Index)
+					{
+						if (bCjk)
+						{
+							Utf8.Append(CjkUtf8, 3);
+							Expected.AppendChar(CjkChar);
+						}
+						else
+						{
+							Utf8.Add(AsciiRun[Index]);
+							Expected.AppendChar((TCHAR)AsciiRun[Index]);
+						}
+					}
+
+					const FUTF8ToTCHAR ConvertedValue(Utf8.GetData(), Utf8.Num());
+					const FString Converted(ConvertedValue.Length(), ConvertedValue.Get());
+					if (!Converted.Equals(Expected, ESearchCase::CaseSensitive))
+					{
+						AddError(FString::Printf(TEXT("Invalid sequence of %d octets after %d %s chars decoded to '%s' instead of '%s'"),
+							FCStringAnsi::Strlen(InvalidSequence.Utf8), PrefixLen, bCjk ? TEXT("CJK") : TEXT("ASCII"), *Converted, *Expected));
+					}
+				}
+			}
+		}
+	}
+
+	{
+		// Unpaired surrogates must be replaced the same inside runs of ASCII chars converted a block at a time
+		for (int32 PrefixLen = 0; PrefixLen < 20; ++PrefixLen)
+		{
+			for (const TCHAR Surrogate : { (TCHAR)0xD800, (TCHAR)0xDC00 })
+			{
+				FString Source = FString(TEXT("0123456789abcdefghij")).Left(PrefixLen);
+				Source.AppendChar(Surrogate);
+				Source += TEXT("klmnopqrstuvwxyz0123456789");
+
+				FString Expected = Source;
+				Expected[PrefixLen] = UNICODE_BOGUS_CHAR_CODEPOINT;
+
+				const FTCHARToUTF8 ConvertedValue(*Source, Source.Len());
+				const bool bMatches = ConvertedValue.Length() == Expected.Len() && FCStringAnsi::Strncmp(ConvertedValue.Get(), TCHAR_TO_ANSI(*Expected), Expected.Len()) == 0;
+				TestTrue(FString::Printf(TEXT("Expected unpaired surrogate after %d ASCII chars to be replaced"), PrefixLen), bMatches);
+			}
+		}
+	}
+
+	{
+		// Long strings mixing every width of sequence round trip through the block conversions
+		FString Mixed;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			Mixed += TEXT("ASCII text long enough for whole blocks, ");
+			Mixed += UTF16_TO_TCHAR(u"\x4F60\x597D\xFF0C\x4E16\x754C\x3002\x65E5\x672C\x8A9E\x306E\x30C6\x30AD\x30B9\x30C8");
+			Mixed += UTF16_TO_TCHAR(u"\x05DF\x0416 \xD83D\xDE06");
+		}
+
+		const FTCHARToUTF8 Encoded(*Mixed, Mixed.Len());
+		const FUTF8ToTCHAR Decoded(Encoded.Get(), Encoded.Length());
+		TestTrue(TEXT("Expected mixed string to round trip"), FString(Decoded.Length(), Decoded.Get()).Equals(Mixed, ESearchCase::CaseSensitive));
+	}
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Measures the throughput of UTF-8 conversions on an ASCII-heavy corpus, like Json or logs, and a CJK-heavy one, like localization data.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTCharToUTF8PerfTest, "System.Core.Misc.TCharToUtf8Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FTCharToUTF8PerfTest::RunTest(const FString& Parameters)
+{
+	const int32 CorpusSize = 16 * 1024 * 1024;
+	const int32 NumIterations = 10;
+
+	auto MakeCorpus = [CorpusSize](const TCHAR* Line)
+	{
+		FString Corpus;
+		Corpus.Reserve(CorpusSize + 256);
+		while (Corpus.Len() < CorpusSize)
+		{
+			Corpus += Line;
+		}
+		return Corpus;
+	};
+
+	const FString AsciiCorpus = MakeCorpus(TEXT("{\"Event\":\"SessionStart\",\"UserId\":1234567,\"Platform\":\"Windows\",\"Message\":\"Loaded /Game/Maps/Entry in 1.25s\"}\n"));
+	const FString CjkCorpus = MakeCorpus(UTF16_TO_TCHAR(u"\x4F60\x597D\xFF0C\x4E16\x754C\x3002\x65E5\x672C\x8A9E\x306E\x30C6\x30AD\x30B9\x30C8\x3002 \xD55C\xAD6D\xC5B4 42\n"));
+
+	auto Benchmark = [this, NumIterations](const TCHAR* CorpusName, const FString& Corpus)
+	{
+		const FTCHARToUTF8 Utf8Corpus(*Corpus, Corpus.Len());
+		const double NumMegabytes = (double)Utf8Corpus.Length() * NumIterations / (1024.0 * 1024.0);
+
+		int32 Checksum = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			const FTCHARToUTF8 Encoded(*Corpus, Corpus.Len());
+			Checksum += Encoded.Length();
+		}
+		const double EncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			const FUTF8ToTCHAR Decoded(Utf8Corpus.Get(), Utf8Corpus.Length());
+			Checksum += Decoded.Length();
+		}
+		const double DecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TestEqual(FString::Printf(TEXT("%s corpus converted lengths"), CorpusName), Checksum, (Utf8Corpus.Length() + Corpus.Len()) * NumIterations);
+		AddInfo(FString::Printf(TEXT("%s corpus (%d bytes of UTF-8): TCHAR to UTF-8 %.1f MB/s, UTF-8 to TCHAR %.1f MB/s"),
+			CorpusName, Utf8Corpus.Length(), NumMegabytes / EncodeSeconds, NumMegabytes / DecodeSeconds));
+	};
+
+	Benchmark(TEXT("ASCII"), AsciiCorpus);
+	Benchmark(TEXT("CJK"), CjkCorpus);
+
 	return !HasAnyErrors();
 }
 
@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Set.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/NameTypes.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NameTest
+{
+	constexpr int32 NumNamesPerTask = 50000;
+	constexpr int32 NumSharedNames = 4096;
+	// Roughly one in five created names is new, the rest repeat names that already exist
+	constexpr int32 UniqueNameFrequency = 5;
+
+	/** Creates names the way loading does, mostly looking up existing names. Returns the number of mismatching lookups. */
+	static int32 CreateNames(int32 TaskIndex, const TArray<FString>& SharedStrings, const TArray<FName>& SharedNames)
+	{
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < NumNamesPerTask; ++Index)
+		{
+			if (Index % UniqueNameFrequency == 0)
+			{
+				FName Unique(*FString::Printf(TEXT("NameTest_Unique_%d_%d"), TaskIndex, Index));
+				NumMismatches += Unique.IsNone();
+			}
+			else
+			{
+				const int32 SharedIndex = (Index * 7919 + TaskIndex) % NumSharedNames;
+				NumMismatches += FName(*SharedStrings[SharedIndex]) != SharedNames[SharedIndex];
+			}
+		}
+		return NumMismatches;
+	}
+
+	/**
+	 * Compares FName creation throughput of a single thread with all worker threads creating names concurrently.
+	 */
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameCreationPerfTest, "System.Core.Name.MultithreadedCreationPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+	bool FNameCreationPerfTest::RunTest(const FString& Parameters)
+	{
+		TArray<FString> SharedStrings;
+		TArray<FName> SharedNames;
+		for (int32 Index = 0; Index < NumSharedNames; ++Index)
+		{
+			SharedStrings.Add(FString::Printf(TEXT("NameTest_Shared_%d"), Index));
+			SharedNames.Add(FName(*SharedStrings.Last()));
+		}
+
+		const int32 NumTasks = FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+
+		double StartTime = FPlatformTime::Seconds();
+		const int32 SingleThreadedMismatches = CreateNames(0, SharedStrings, SharedNames);
+		const double SingleThreadedTime = FPlatformTime::Seconds() - StartTime;
+
+		std::atomic<int32> MultiThreadedMismatches{0};
+		StartTime = FPlatformTime::Seconds();
+		ParallelFor(NumTasks, [&](int32 TaskIndex)
+		{
+			// Offset task indices to not reuse the unique names of the single threaded run
+			MultiThreadedMismatches += CreateNames(TaskIndex + 1, SharedStrings, SharedNames);
+		});
+		const double MultiThreadedTime = FPlatformTime::Seconds() - StartTime;
+
+		TestEqual(TEXT("Single threaded name creation should find existing names"), SingleThreadedMismatches, 0);
+		TestEqual(TEXT("Concurrent name creation should find existing names"), MultiThreadedMismatches.load(), 0);
+
+		const double SingleThreadedRate = NumNamesPerTask / FMath::Max(SingleThreadedTime, SMALL_NUMBER);
+		const double MultiThreadedRate = NumNamesPerTask * NumTasks / FMath::Max(MultiThreadedTime, SMALL_NUMBER);
+		AddInfo(FString::Printf(TEXT("FName creation: %.0f names/s on one thread, %.0f names/s on %d threads (%.2fx)"),
+			SingleThreadedRate, MultiThreadedRate, NumTasks, MultiThreadedRate / SingleThreadedRate));
+
+		return true;
+	}
+
+	/**
+	 * Checks that path-like names convert back to the exact strings they were created with, which matters
+	 * when WITH_COMPACT_NAME_STORAGE shares prefixes between names.
+	 */
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameCompactStorageTest, "System.Core.Name.CompactStorage", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+	bool FNameCompactStorageTest::RunTest(const FString& Parameters)
+	{
+		const TCHAR* Paths[] =
+		{
+			TEXT("/Game/NameTest/Props/Rock_01"),
+			TEXT("/Game/NameTest/Props/Rock_02"),
+			TEXT("/Game/NameTest/Props/Rock_02.Rock_02"),
+			TEXT("/game/nametest/props/Rock_03"),
+			TEXT("/Game/NameTest/Props/"),
+			TEXT("/Game/NameTest/Props/Rock_\u00DCnicode_01"),
+			TEXT("/Game/NameTest/Props/Rock_"),
+		};
+
+		for (const TCHAR* Path : Paths)
+		{
+			FName Name(Path);
+			TestTrue(FString::Printf(TEXT("%s should convert back to the same string"), Path), Name.ToString().Equals(Path, ESearchCase::CaseSensitive));
+			TestEqual(FString::Printf(TEXT("%s should have the same length"), Path), Name.GetStringLength(), FCString::Strlen(Path));
+			TestTrue(FString::Printf(TEXT("%s should equal its string"), Path), Name == Path);
+		}
+
+		TestTrue(TEXT("Names should compare case insensitively"), FName(TEXT("/GAME/NAMETEST/PROPS/ROCK_01")) == FName(Paths[0]));
+		TestTrue(TEXT("Names should compare alphabetically"), FName(Paths[0]).Compare(FName(Paths[1])) < 0);
+		TestTrue(TEXT("Names should compare alphabetically"), FName(Paths[3]).Compare(FName(Paths[1])) > 0);
+		TestTrue(TEXT("Names should compare alphabetically"), FName(Paths[6]).Compare(FName(Paths[0])) < 0);
+
+		// Replacing the case of a name changes its whole string, including the part shared with other names, which keep theirs
+		const FName Replaceable(TEXT("/Game/NameTest/Replace/Rock_01"));
+		const FName Sibling(TEXT("/Game/NameTest/Replace/Rock_02"));
+		const FName SharedPrefix(TEXT("/Game/NameTest/Replace/Rock_"));
+		const TCHAR* ReplacedPath = TEXT("/GAME/nametest/Replace/ROCK_01");
+		const FName Replaced(ReplacedPath, FNAME_Replace_Not_Safe_For_Threading);
+		TestTrue(TEXT("Replacing the case of a name should be exact where it differs before the last separator"), Replaceable.ToString().Equals(ReplacedPath, ESearchCase::CaseSensitive));
+		TestTrue(TEXT("A name with a replaced case should still equal its original"), Replaced == Replaceable);
+		TestTrue(TEXT("Replacing the case of a name should not change names sharing its prefix"), Sibling.ToString().Equals(TEXT("/Game/NameTest/Replace/Rock_02"), ESearchCase::CaseSensitive));
+		TestTrue(TEXT("Replacing the case of a name should not change its prefix"), SharedPrefix.ToString().Equals(TEXT("/Game/NameTest/Replace/Rock_"), ESearchCase::CaseSensitive));
+
+		return true;
+	}
+
+	/**
+	 * Reports name entry memory of a synthetic set of asset paths compared to storing every name as a full string.
+	 */
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameCompactStorageMemoryTest, "System.Core.Name.CompactStorageMemoryPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+	bool FNameCompactStorageMemoryTest::RunTest(const FString& Parameters)
+	{
+		const TCHAR* Folders[] = { TEXT("Props"), TEXT("Characters/Heroes"), TEXT("Environment/Foliage/Trees"), TEXT("Materials/Instances") };
+		const TCHAR* Prefixes[] = { TEXT("SM_Rock"), TEXT("SK_Hero"), TEXT("SM_Tree_Oak"), TEXT("MI_Ground") };
+		constexpr int32 NumSets = 64;
+		constexpr int32 NumAssetsPerSet = 250;
+
+		const int32 EntryMemoryBefore = FName::GetNameEntryMemorySize();
+
+		// Unique root so that the names don't exist yet
+		const FString Root = FString::Printf(TEXT("/Game/NameTest_%08x"), FPlatformTime::Cycles());
+		TSet<FName> Names;
+		int64 FullStringBytes = 0;
+		for (int32 FolderIndex = 0; FolderIndex < UE_ARRAY_COUNT(Folders); ++FolderIndex)
+		{
+			for (int32 SetIndex = 0; SetIndex < NumSets; ++SetIndex)
+			{
+				for (int32 AssetIndex = 0; AssetIndex < NumAssetsPerSet; ++AssetIndex)
+				{
+					const FString Package = FString::Printf(TEXT("%s/%s/Set_%02d/%s_%03d"), *Root, Folders[FolderIndex], SetIndex, Prefixes[FolderIndex], AssetIndex);
+					const FString Object = FString::Printf(TEXT("%s.%s_%03d"), *Package, Prefixes[FolderIndex], AssetIndex);
+					for (const FString* Path : { &Package, &Object })
+					{
+						bool bAlreadyInSet = false;
+						FName Name(**Path);
+						Names.Add(Name, &bAlreadyInSet);
+						if (!bAlreadyInSet)
+						{
+							FullStringBytes += FNameEntry::GetSize(Name.GetPlainNameString().Len(), true);
+						}
+						TestTrue(TEXT("Name should convert back to the same string"), Name.ToString().Equals(*Path, ESearchCase::CaseSensitive));
+					}
+				}
+			}
+		}
+
+		const int32 EntryMemoryAfter = FName::GetNameEntryMemorySize();
+		AddInfo(FString::Printf(TEXT("%d asset path names use %lldkB of name entries, %lldkB as full strings (compact name storage %s)"),
+			Names.Num(), int64(EntryMemoryAfter - EntryMemoryBefore) / 1024, FullStringBytes / 1024, WITH_COMPACT_NAME_STORAGE ? TEXT("enabled") : TEXT("disabled")));
+
+		return true;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
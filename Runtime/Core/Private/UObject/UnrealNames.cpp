@@ -27,6 +27,7 @@
 #include "Serialization/MemoryImage.h"
 #include "Hash/CityHash.h"
 #include "Templates/AlignmentTemplates.h"
+#include <atomic>
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
@@ -59,6 +60,13 @@ int32 FNameEntry::GetDataOffset()
 	return STRUCT_OFFSET(FNameEntry, AnsiName);
 }
 
+#if WITH_COMPACT_NAME_STORAGE
+int32 FNameEntry::GetPrefixedDataOffset()
+{
+	return GetDataOffset() + sizeof(FNameEntryId);
+}
+#endif
+
 /*-----------------------------------------------------------------------------
 	FName helpers. 
 -----------------------------------------------------------------------------*/
@@ -66,6 +74,10 @@ int32 FNameEntry::GetDataOffset()
 static bool operator==(FNameEntryHeader A, FNameEntryHeader B)
 {
 	static_assert(sizeof(FNameEntryHeader) == 2, "");
+#if WITH_COMPACT_NAME_STORAGE
+	// How an entry is stored doesn't affect the name it holds
+	A.bHasPrefix = B.bHasPrefix = 0;
+#endif
 	return (uint16&)A == (uint16&)B;
 }
 
@@ -158,7 +170,7 @@ FORCEINLINE bool Equals(FNameStringView A, FNameStringView B)
 }
 
 // Minimize stack lifetime of large decode buffers
-#ifdef WITH_CUSTOM_NAME_ENCODING
+#if defined(WITH_CUSTOM_NAME_ENCODING) || WITH_COMPACT_NAME_STORAGE
 #define OUTLINE_DECODE_BUFFER FORCENOINLINE
 #else
 #define OUTLINE_DECODE_BUFFER
@@ -263,6 +275,51 @@ private:
 	uint32 IdAndHash = 0;
 };
 
+static_assert(sizeof(std::atomic<FNameSlot>) == sizeof(FNameSlot), "Slots are zero-initialized with memset");
+
+/**
+ * Open addressing slot array of a name pool shard.
+ *
+ * Tables are immutable in size and published atomically, which lets lookups probe them without taking
+ * the shard lock. A grown table replaces the current one after being fully populated. Replaced tables
+ * are kept alive until the shard is destroyed since lock-free readers may still be probing them,
+ * which costs at most as much memory as the current table.
+ */
+struct FNameSlotTable
+{
+	uint32 CapacityMask;
+	FNameSlotTable* Previous;
+
+	uint32 Capacity() const { return CapacityMask + 1; }
+
+	std::atomic<FNameSlot>* GetSlots()
+	{
+		return reinterpret_cast<std::atomic<FNameSlot>*>(this + 1);
+	}
+
+	static FNameSlotTable* Allocate(uint32 Capacity, FNameSlotTable* Previous)
+	{
+		check(FMath::IsPowerOfTwo(Capacity));
+		const SIZE_T SlotBytes = Capacity * sizeof(FNameSlot);
+		FNameSlotTable* Table = (FNameSlotTable*)FMemory::Malloc(sizeof(FNameSlotTable) + SlotBytes, alignof(FNameSlotTable));
+		Table->CapacityMask = Capacity - 1;
+		Table->Previous = Previous;
+		memset(Table->GetSlots(), 0, SlotBytes);
+		return Table;
+	}
+
+	/** Frees Table and all tables it replaced */
+	static void FreeAll(FNameSlotTable* Table)
+	{
+		while (Table)
+		{
+			FNameSlotTable* Previous = Table->Previous;
+			FMemory::Free(Table);
+			Table = Previous;
+		}
+	}
+};
+
 /**
  * Thread-safe paged FNameEntry allocator
  */
@@ -339,6 +396,9 @@ public:
 #endif
 
 		Entry.Header = Header;
+#if WITH_COMPACT_NAME_STORAGE
+		Entry.Header.bHasPrefix = 0;
+#endif
 		
 		if (Name.bIsWide)
 		{
@@ -352,6 +412,31 @@ public:
 		return Handle;
 	}
 
+#if WITH_COMPACT_NAME_STORAGE
+	/** Creates an ansi entry that references PrefixId for the leading part of Name and only stores the remaining suffix */
+	template<class ScopeLock>
+	FNameEntryHandle CreatePrefixed(FNameStringView Name, FNameEntryId PrefixId, TOptional<FNameEntryId> ComparisonId, FNameEntryHeader Header)
+	{
+		check(Name.IsAnsi());
+		const uint32 PrefixLen = Resolve(PrefixId).GetNameLength();
+		check(PrefixLen < Name.Len);
+		const uint32 SuffixLen = Name.Len - PrefixLen;
+
+		FNameEntryHandle Handle = Allocate<ScopeLock>(FNameEntry::GetPrefixedDataOffset() + SuffixLen);
+		FNameEntry& Entry = Resolve(Handle);
+
+#if WITH_CASE_PRESERVING_NAME
+		Entry.ComparisonId = ComparisonId.IsSet() ? ComparisonId.GetValue() : FNameEntryId(Handle);
+#endif
+
+		Entry.Header = Header;
+		Entry.Header.bHasPrefix = 1;
+		Entry.StorePrefixedName(PrefixId, Name.Ansi + PrefixLen, SuffixLen);
+
+		return Handle;
+	}
+#endif
+
 	FNameEntry& Resolve(FNameEntryHandle Handle) const
 	{
 		// Lock not needed
@@ -398,7 +483,7 @@ private:
 			if (uint32 Len = Entry->Header.Len)
 			{
 				Out.Add(Entry);
-				It += FNameEntry::GetSize(Len, !Entry->IsWide());
+				It += Entry->GetSizeInBytes();
 			}
 			else // Null-terminator entry found
 			{
@@ -510,6 +595,9 @@ struct FNameHash
 		SlotProbeHash = (Hi & FNameSlot::ProbeHashMask) | IsNoneBit;
 		EntryProbeHeader.Len = Len;
 		EntryProbeHeader.bIsWide = sizeof(CharType) == sizeof(WIDECHAR);
+#if WITH_COMPACT_NAME_STORAGE
+		EntryProbeHeader.bHasPrefix = 0;
+#endif
 
 		// When we always use lowercase hashing, we can store parts of the hash in the entry
 		// to avoid copying and decoding entries needlessly. WITH_CUSTOM_NAME_ENCODING
@@ -615,6 +703,10 @@ struct FNameValue
 	FNameStringView Name;
 	FNameHash Hash;
 	TOptional<FNameEntryId> ComparisonId;
+#if WITH_COMPACT_NAME_STORAGE
+	/** Existing entry holding the leading part of Name, if Name should be stored compactly */
+	FNameEntryId PrefixId;
+#endif
 };
 
 using FNameComparisonValue = FNameValue<ENameCase::IgnoreCase>;
@@ -636,24 +728,21 @@ public:
 		LLM_SCOPE(ELLMTag::FName);
 		Entries = &InEntries;
 
-		Slots = (FNameSlot*)FMemory::Malloc(FNamePoolInitialSlotsPerShard * sizeof(FNameSlot), alignof(FNameSlot));
-		memset(Slots, 0, FNamePoolInitialSlotsPerShard * sizeof(FNameSlot));
-		CapacityMask = FNamePoolInitialSlotsPerShard - 1;
+		Table.store(FNameSlotTable::Allocate(FNamePoolInitialSlotsPerShard, nullptr), std::memory_order_release);
 	}
 
 	// This and ~FNamePool() is not called during normal shutdown
 	// but only via explicit FName::TearDown() call
 	~FNamePoolShardBase()
 	{
-		FMemory::Free(Slots);
+		FNameSlotTable::FreeAll(Table.load(std::memory_order_relaxed));
+		Table.store(nullptr, std::memory_order_relaxed);
 		UsedSlots = 0;
-		CapacityMask = 0;
-		Slots = nullptr;
 		NumCreatedEntries = 0;
 		NumCreatedWideEntries = 0;
 	}
 
-	uint32 Capacity() const	{ return CapacityMask + 1; }
+	uint32 Capacity() const	{ return Table.load(std::memory_order_acquire)->Capacity(); }
 
 	uint32 NumCreated() const { return NumCreatedEntries; }
 	uint32 NumCreatedWide() const { return NumCreatedWideEntries; }
@@ -665,10 +754,10 @@ public:
 protected:
 	enum { LoadFactorQuotient = 9, LoadFactorDivisor = 10 }; // I.e. realloc slots when 90% full
 
+	// Only taken by inserting threads, lookups probe the current table without locking
 	mutable FRWLock Lock;
+	std::atomic<FNameSlotTable*> Table{nullptr};
 	uint32 UsedSlots = 0;
-	uint32 CapacityMask = 0;
-	FNameSlot* Slots = nullptr;
 	FNameEntryAllocator* Entries = nullptr;
 	uint32 NumCreatedEntries = 0;
 	uint32 NumCreatedWideEntries = 0;
@@ -685,25 +774,39 @@ template<ENameCase Sensitivity>
 class FNamePoolShard : public FNamePoolShardBase
 {
 public:
+	/** Lock-free lookup. A name that is concurrently being inserted may or may not be found. */
 	FNameEntryId Find(const FNameValue<Sensitivity>& Value) const
 	{
-		FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
-
-		return Probe(Value).GetId();
+		FNameSlot Slot;
+		Probe(*Table.load(std::memory_order_acquire), Value, Slot);
+		return Slot.GetId();
 	}
 
 	template<class ScopeLock = FWriteScopeLock>
 	FORCEINLINE FNameEntryId Insert(const FNameValue<Sensitivity>& Value, bool& bCreatedNewEntry)
 	{
+		// Most names already exist, only lock when the optimistic lookup fails
+		if (FNameEntryId Existing = Find(Value))
+		{
+			return Existing;
+		}
+
 		ScopeLock _(Lock);
-		FNameSlot& Slot = Probe(Value);
+		FNameSlot ExistingSlot;
+		std::atomic<FNameSlot>& Slot = Probe(*Table.load(std::memory_order_relaxed), Value, ExistingSlot);
 
-		if (Slot.Used())
+		if (ExistingSlot.Used())
 		{
-			return Slot.GetId();
+			return ExistingSlot.GetId();
 		}
 
+#if WITH_COMPACT_NAME_STORAGE
+		FNameEntryId NewEntryId = Value.PrefixId
+			? Entries->CreatePrefixed<ScopeLock>(Value.Name, Value.PrefixId, Value.ComparisonId, Value.Hash.EntryProbeHeader)
+			: Entries->Create<ScopeLock>(Value.Name, Value.ComparisonId, Value.Hash.EntryProbeHeader);
+#else
 		FNameEntryId NewEntryId = Entries->Create<ScopeLock>(Value.Name, Value.ComparisonId, Value.Hash.EntryProbeHeader);
+#endif
 
 		ClaimSlot(Slot, FNameSlot(NewEntryId, Value.Hash.SlotProbeHash));
 
@@ -720,8 +823,9 @@ public:
 
 		FRWScopeLock _(Lock, FRWScopeLockType::SLT_Write);
 		 
-		FNameSlot& Slot = Probe(Hash.UnmaskedSlotIndex, [=](FNameSlot Old) { return Old == NewLookup; });
-		if (!Slot.Used())
+		FNameSlot ExistingSlot;
+		std::atomic<FNameSlot>& Slot = Probe(*Table.load(std::memory_order_relaxed), Hash.UnmaskedSlotIndex, [=](FNameSlot Old) { return Old == NewLookup; }, ExistingSlot);
+		if (!ExistingSlot.Used())
 		{
 			ClaimSlot(Slot, NewLookup);
 		}
@@ -739,9 +843,11 @@ public:
 	}
 
 private:
-	void ClaimSlot(FNameSlot& UnusedSlot, FNameSlot NewValue)
+	/** Called with the shard lock held */
+	void ClaimSlot(std::atomic<FNameSlot>& UnusedSlot, FNameSlot NewValue)
 	{
-		UnusedSlot = NewValue;
+		// Release the entry data written by the allocator to lock-free readers
+		UnusedSlot.store(NewValue, std::memory_order_release);
 
 		++UsedSlots;
 		if (UsedSlots * LoadFactorDivisor >= LoadFactorQuotient * Capacity())
@@ -755,55 +861,54 @@ private:
 		Grow(Capacity() * 2);
 	}
 
+	/** Called with the shard lock held. Readers keep probing the old table until the new one is published. */
 	void Grow(const uint32 NewCapacity)
 	{
 		LLM_SCOPE(ELLMTag::FName);
-		FNameSlot* const OldSlots = Slots;
-		const uint32 OldUsedSlots = UsedSlots;
-		const uint32 OldCapacity = Capacity();
+		FNameSlotTable* const OldTable = Table.load(std::memory_order_relaxed);
+		FNameSlotTable* const NewTable = FNameSlotTable::Allocate(NewCapacity, OldTable);
+		std::atomic<FNameSlot>* const OldSlots = OldTable->GetSlots();
+		uint32 NewUsedSlots = 0;
 
-		Slots = (FNameSlot*)FMemory::Malloc(NewCapacity * sizeof(FNameSlot), alignof(FNameSlot));
-		memset(Slots, 0, NewCapacity * sizeof(FNameSlot));
-		UsedSlots = 0;
-		CapacityMask = NewCapacity - 1;
-
-
-		for (uint32 OldIdx = 0; OldIdx < OldCapacity; ++OldIdx)
+		for (uint32 OldIdx = 0, OldCapacity = OldTable->Capacity(); OldIdx < OldCapacity; ++OldIdx)
 		{
-			const FNameSlot& OldSlot = OldSlots[OldIdx];
+			const FNameSlot OldSlot = OldSlots[OldIdx].load(std::memory_order_relaxed);
 			if (OldSlot.Used())
 			{
 				FNameHash Hash = Rehash(OldSlot.GetId());
-				FNameSlot& NewSlot = Probe(Hash.UnmaskedSlotIndex, [](FNameSlot Slot) { return false; });
-				NewSlot = OldSlot;
-				++UsedSlots;
+				FNameSlot Unused;
+				std::atomic<FNameSlot>& NewSlot = Probe(*NewTable, Hash.UnmaskedSlotIndex, [](FNameSlot Slot) { return false; }, Unused);
+				NewSlot.store(OldSlot, std::memory_order_relaxed);
+				++NewUsedSlots;
 			}
 		}
 
-		check(OldUsedSlots == UsedSlots);
+		check(NewUsedSlots == UsedSlots);
 
-		FMemory::Free(OldSlots);
+		Table.store(NewTable, std::memory_order_release);
 	}
 
 	/** Find slot containing value or the first free slot that should be used to store it  */
-	FORCEINLINE FNameSlot& Probe(const FNameValue<Sensitivity>& Value) const
+	FORCEINLINE std::atomic<FNameSlot>& Probe(FNameSlotTable& InTable, const FNameValue<Sensitivity>& Value, FNameSlot& OutSlot) const
 	{
-		return Probe(Value.Hash.UnmaskedSlotIndex, 
+		return Probe(InTable, Value.Hash.UnmaskedSlotIndex, 
 			[&](FNameSlot Slot)	{ return Slot.GetProbeHash() == Value.Hash.SlotProbeHash && 
-									EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value); });
+									EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value); }, OutSlot);
 	}
 
-	/** Find slot that fulfills predicate or the first free slot  */
+	/** Find slot that fulfills predicate or the first free slot, OutSlot receives the probed slot value */
 	template<class PredicateFn>
-	FORCEINLINE FNameSlot& Probe(uint32 UnmaskedSlotIndex, PredicateFn Predicate) const
+	FORCEINLINE static std::atomic<FNameSlot>& Probe(FNameSlotTable& InTable, uint32 UnmaskedSlotIndex, PredicateFn Predicate, FNameSlot& OutSlot)
 	{
-		const uint32 Mask = CapacityMask;
+		std::atomic<FNameSlot>* Slots = InTable.GetSlots();
+		const uint32 Mask = InTable.CapacityMask;
 		for (uint32 I = FNameHash::GetProbeStart(UnmaskedSlotIndex, Mask); true; I = (I + 1) & Mask)
 		{
-			FNameSlot& Slot = Slots[I];
-			if (!Slot.Used() || Predicate(Slot))
+			// Acquire pairs with ClaimSlot() so the entry can be resolved and compared without locking
+			OutSlot = Slots[I].load(std::memory_order_acquire);
+			if (!OutSlot.Used() || Predicate(OutSlot))
 			{
-				return Slot;
+				return Slots[I];
 			}
 		}
 	}
@@ -834,9 +939,15 @@ public:
 	bool			IsValid(FNameEntryHandle Handle) const;
 
 	void			BatchLock();
+	/** Batch stored names are never stored compactly since storing their prefixes would need the locked shards */
 	FNameEntryId	BatchStore(const FNameComparisonValue& ComparisonValue);
 	void			BatchUnlock();
 
+#if WITH_COMPACT_NAME_STORAGE
+	/** Returns an entry with exactly the characters of Prefix for a prefixed entry whose case is being replaced */
+	FNameEntryId	StoreReplacedPrefix(FNameStringView Prefix);
+#endif
+
 	/// Stats and debug related functions ///
 
 	uint32			NumEntries() const;
@@ -851,6 +962,10 @@ public:
 private:
 	enum { MaxENames = 512 };
 
+#if WITH_COMPACT_NAME_STORAGE
+	FNameEntryId	StorePrefix(FNameStringView Name);
+#endif
+
 	FNameEntryAllocator Entries;
 
 #if WITH_CASE_PRESERVING_NAME
@@ -957,7 +1072,17 @@ FNameEntryId FNamePool::Store(FNameStringView Name)
 
 	// Insert comparison name first since display value must contain comparison name
 	FNameComparisonValue ComparisonValue(Name);
+#if WITH_COMPACT_NAME_STORAGE
+	FNamePoolShard<ENameCase::IgnoreCase>& ComparisonShard = ComparisonShards[ComparisonValue.Hash.ShardIndex];
+	FNameEntryId ComparisonId = ComparisonShard.Find(ComparisonValue);
+	if (!ComparisonId)
+	{
+		ComparisonValue.PrefixId = StorePrefix(Name);
+		ComparisonId = ComparisonShard.Insert(ComparisonValue, bAdded);
+	}
+#else
 	FNameEntryId ComparisonId = ComparisonShards[ComparisonValue.Hash.ShardIndex].Insert(ComparisonValue, bAdded);
+#endif
 
 #if WITH_CASE_PRESERVING_NAME
 	// Check if ComparisonId can be used as DisplayId
@@ -969,6 +1094,9 @@ FNameEntryId FNamePool::Store(FNameStringView Name)
 	else
 	{
 		DisplayValue.ComparisonId = ComparisonId;
+#if WITH_COMPACT_NAME_STORAGE
+		DisplayValue.PrefixId = StorePrefix(Name);
+#endif
 		return DisplayShard.Insert(DisplayValue, bAdded);
 	}
 #else
@@ -976,6 +1104,61 @@ FNameEntryId FNamePool::Store(FNameStringView Name)
 #endif
 }
 
+#if WITH_COMPACT_NAME_STORAGE
+// Prefixes shorter than this save too little to be worth an extra entry
+static constexpr uint32 MinCompactNamePrefixLen = 8;
+
+static bool IsCompactNamePrefixSeparator(ANSICHAR Char)
+{
+	return Char == '/' || Char == '.' || Char == ':' || Char == '_';
+}
+
+/**
+ * Stores the leading part of a path-like name up to and including its last separator.
+ *
+ * The last character is never part of the prefix, so a prefix is itself split at its
+ * previous separator and "/Game/Props/Rock_01" shares "/Game/Props/Rock_" which shares "/Game/Props/".
+ *
+ * @return existing entry with exactly the same characters as the prefix, or an empty id if Name should be stored as is
+ */
+FNameEntryId FNamePool::StorePrefix(FNameStringView Name)
+{
+	if (Name.bIsWide || Name.Len <= MinCompactNamePrefixLen)
+	{
+		return FNameEntryId();
+	}
+
+	uint32 PrefixLen = Name.Len - 1;
+	while (PrefixLen >= MinCompactNamePrefixLen && !IsCompactNamePrefixSeparator(Name.Ansi[PrefixLen - 1]))
+	{
+		--PrefixLen;
+	}
+
+	if (PrefixLen < MinCompactNamePrefixLen)
+	{
+		return FNameEntryId();
+	}
+
+	FNameStringView Prefix(Name.Ansi, PrefixLen);
+	FNameEntryId PrefixId = Store(Prefix);
+
+	// Names must convert back to the exact string they were created with, but the existing prefix entry might differ in case
+	return EqualsSameDimensions<ENameCase::CaseSensitive>(Resolve(PrefixId), Prefix) ? PrefixId : FNameEntryId();
+}
+
+FNameEntryId FNamePool::StoreReplacedPrefix(FNameStringView Prefix)
+{
+	FNameEntryId PrefixId = Store(Prefix);
+	if (EqualsSameDimensions<ENameCase::CaseSensitive>(Resolve(PrefixId), Prefix))
+	{
+		return PrefixId;
+	}
+
+	// The replaced entry is already too small to hold its whole name, so the prefix is copied into an entry that name lookups never find
+	return Entries.Create<FWriteScopeLock>(Prefix, TOptional<FNameEntryId>(), Resolve(PrefixId).Header);
+}
+#endif
+
 void FNamePool::BatchLock()
 {
 	for (const FNamePoolShardBase& Shard : ComparisonShards)
@@ -1254,14 +1437,54 @@ void FNameEntry::StoreName(const WIDECHAR* InName, uint32 Len)
 	Encode(WideName, Len);
 }
 
+#if WITH_COMPACT_NAME_STORAGE
+FNameEntryId FNameEntry::GetPrefixId() const
+{
+	checkSlow(Header.bHasPrefix);
+	uint32 PrefixId;
+	FPlatformMemory::Memcpy(&PrefixId, AnsiName, sizeof(PrefixId));
+	return FNameEntryId::FromUnstableInt(PrefixId);
+}
+
+void FNameEntry::StorePrefixedName(FNameEntryId PrefixId, const ANSICHAR* Suffix, uint32 SuffixLen)
+{
+	checkSlow(Header.bHasPrefix);
+	const uint32 Id = PrefixId.ToUnstableInt();
+	FPlatformMemory::Memcpy(AnsiName, &Id, sizeof(Id));
+	ANSICHAR* StoredSuffix = AnsiName + sizeof(Id);
+	FPlatformMemory::Memcpy(StoredSuffix, Suffix, sizeof(ANSICHAR) * SuffixLen);
+	Encode(StoredSuffix, SuffixLen);
+}
+
+void FNameEntry::CopyPrefixedName(ANSICHAR* Out) const
+{
+	const FNameEntry& Prefix = GetNamePoolPostInit().Resolve(GetPrefixId());
+	const uint32 PrefixLen = Prefix.GetNameLength();
+	const uint32 SuffixLen = Header.Len - PrefixLen;
+	Prefix.CopyUnterminatedName(Out);
+	FPlatformMemory::Memcpy(Out + PrefixLen, AnsiName + sizeof(FNameEntryId), sizeof(ANSICHAR) * SuffixLen);
+	Decode(Out + PrefixLen, SuffixLen);
+}
+#endif
+
 void FNameEntry::CopyUnterminatedName(ANSICHAR* Out) const
 {
+#if WITH_COMPACT_NAME_STORAGE
+	if (Header.bHasPrefix)
+	{
+		CopyPrefixedName(Out);
+		return;
+	}
+#endif
 	FPlatformMemory::Memcpy(Out, AnsiName, sizeof(ANSICHAR) * Header.Len);
 	Decode(Out, Header.Len);
 }
 
 void FNameEntry::CopyUnterminatedName(WIDECHAR* Out) const
 {
+#if WITH_COMPACT_NAME_STORAGE
+	checkSlow(!Header.bHasPrefix);
+#endif
 	FPlatformMemory::Memcpy(Out, WideName, sizeof(WIDECHAR) * Header.Len);
 	Decode(Out, Header.Len);
 }
@@ -1282,6 +1505,13 @@ FORCEINLINE ANSICHAR const* FNameEntry::GetUnterminatedName(ANSICHAR(&OptionalDe
 	CopyUnterminatedName(OptionalDecodeBuffer);
 	return OptionalDecodeBuffer;
 #else
+#if WITH_COMPACT_NAME_STORAGE
+	if (Header.bHasPrefix)
+	{
+		CopyPrefixedName(OptionalDecodeBuffer);
+		return OptionalDecodeBuffer;
+	}
+#endif
 	return AnsiName;
 #endif
 }
@@ -1415,6 +1645,13 @@ int32 FNameEntry::GetSize(int32 Length, bool bIsPureAnsi)
 
 int32 FNameEntry::GetSizeInBytes() const
 {
+#if WITH_COMPACT_NAME_STORAGE
+	if (Header.bHasPrefix)
+	{
+		const int32 SuffixLen = GetNameLength() - GetNamePoolPostInit().Resolve(GetPrefixId()).GetNameLength();
+		return Align(GetPrefixedDataOffset() + SuffixLen, alignof(FNameEntry));
+	}
+#endif
 	return GetSize(GetNameLength(), !IsWide());
 }
 
@@ -1903,6 +2140,18 @@ struct FNameHelper
 		check(Existing.Header.bIsWide == Updated.bIsWide);
 		check(Existing.Header.Len == Updated.Len);
 
+#if WITH_COMPACT_NAME_STORAGE
+		if (Existing.Header.bHasPrefix)
+		{
+			// The shared prefix entry keeps its case for the other names using it, so the prefix of the updated name gets its own entry if it differs
+			FNamePool& Pool = GetNamePoolPostInit();
+			const uint32 PrefixLen = Pool.Resolve(Existing.GetPrefixId()).GetNameLength();
+			const FNameEntryId PrefixId = Pool.StoreReplacedPrefix(FNameStringView(Updated.Ansi, PrefixLen));
+			Existing.StorePrefixedName(PrefixId, Updated.Ansi + PrefixLen, Updated.Len - PrefixLen);
+			return;
+		}
+#endif
+
 		if (Updated.bIsWide)
 		{
 			Existing.StoreName(Updated.Wide, Updated.Len);
@@ -17,7 +17,9 @@
 #include "HAL/MallocJemalloc.h"
 #include "HAL/MallocBinned.h"
 #include "HAL/MallocBinned2.h"
+#include "HAL/MallocBinned3.h"
 #include "HAL/MallocReplayProxy.h"
+#include "HAL/MallocSamplingProfiler.h"
 #include "HAL/MallocStomp.h"
 #include "HAL/PlatformMallocCrash.h"
 
@@ -167,6 +169,14 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 					break;
 				}
 
+#if PLATFORM_64BITS
+				if (FCStringAnsi::Stricmp(Arg, "-binnedmalloc3") == 0)
+				{
+					AllocatorToUse = EMemoryAllocatorToUse::Binned3;
+					break;
+				}
+#endif // PLATFORM_64BITS
+
 				if (FCStringAnsi::Stricmp(Arg, "-fullcrashcallstack") == 0)
 				{
 					GFullCrashCallstack = true;
@@ -182,6 +192,11 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 					GKSMMergeAllPages = true;
 				}
 
+				if (FCStringAnsi::Stricmp(Arg, "-mallocsampling") == 0)
+				{
+					GMallocSamplingProfilerEnabled = true;
+				}
+
 				if (FCStringAnsi::Stricmp(Arg, "-noensuretiming") == 0)
 				{
 					GTimeEnsures = false;
@@ -267,6 +282,12 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 		Allocator = new FMallocBinned2();
 		break;
 
+#if PLATFORM_64BITS
+	case EMemoryAllocatorToUse::Binned3:
+		Allocator = new FMallocBinned3();
+		break;
+#endif // PLATFORM_64BITS
+
 	default:	// intentional fall-through
 	case EMemoryAllocatorToUse::Binned:
 		Allocator = new FMallocBinned(FPlatformMemory::GetConstants().BinnedPageSize & MAX_uint32, 0x100000000);
@@ -11,6 +11,8 @@
 #include "Math/UnrealMathUtility.h"
 #include "Templates/Function.h"
 #include "Templates/SharedPointer.h"
+#include "Templates/Atomic.h"
+#include "Containers/Array.h"
 #include "HAL/ThreadSafeCounter.h"
 #include "Stats/Stats.h"
 #include "Async/TaskGraphInterfaces.h"
@@ -313,6 +315,283 @@ namespace ParallelForImpl
 		Data->bExited = true;
 		// Data must live on until all of the tasks are cleared which might be long after this function exits
 	}
+
+	// struct to hold the working data of a range based parallel for; lifetime is controlled by a shared pointer like TParallelForData
+	// Every participant owns a slot with the part of the range it still has to do. It takes batches from the front of its slot
+	// and, once the slot is empty, steals the back half of the slot with the most work left. Work is only split when somebody asks for it.
+	template<typename FunctionType>
+	struct TParallelForRangeData
+	{
+		enum
+		{
+			// a participant takes 1/BatchDivisor of what is left in its slot at a time, so the tail of the slot stays available to thieves
+			BatchDivisor = 8
+		};
+
+		struct FRangeSlot
+		{
+			// [Begin, End) packed as Begin | (End << 32) so a slot can be claimed from and split with a single compare exchange
+			TAtomic<uint64> Range;
+			uint8 PadToAvoidContention[PLATFORM_CACHE_LINE_SIZE - sizeof(uint64)];
+		};
+
+		int32 Num;
+		int32 MinBatchSize;
+		int32 NumSlots;
+		FRangeSlot* Slots;
+		FunctionType Body;
+		FEvent* Event;
+		FThreadSafeCounter NumCompleted;
+		bool bExited;
+		bool bTriggered;
+
+		TParallelForRangeData(int32 InNum, int32 InNumSlots, int32 InMinBatchSize, FunctionType InBody)
+			: Num(InNum)
+			, MinBatchSize(InMinBatchSize)
+			, NumSlots(InNumSlots)
+			, Slots(new FRangeSlot[InNumSlots])
+			, Body(InBody)
+			, Event(FPlatformProcess::GetSynchEventFromPool(false))
+			, bExited(false)
+			, bTriggered(false)
+		{
+			check(Num > 0 && NumSlots > 0 && MinBatchSize > 0);
+			for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++)
+			{
+				const int32 Begin = int32(int64(Num) * SlotIndex / NumSlots);
+				const int32 End = int32(int64(Num) * (SlotIndex + 1) / NumSlots);
+				Slots[SlotIndex].Range.Store(PackRange(Begin, End), EMemoryOrder::Relaxed);
+			}
+		}
+		~TParallelForRangeData()
+		{
+			check(NumCompleted.GetValue() == Num);
+			check(bExited);
+			delete[] Slots;
+			FPlatformProcess::ReturnSynchEventToPool(Event);
+		}
+
+		static FORCEINLINE uint64 PackRange(int32 Begin, int32 End)
+		{
+			return uint64(uint32(Begin)) | (uint64(uint32(End)) << 32);
+		}
+		static FORCEINLINE int32 GetRangeBegin(uint64 Range)
+		{
+			return int32(uint32(Range));
+		}
+		static FORCEINLINE int32 GetRangeEnd(uint64 Range)
+		{
+			return int32(uint32(Range >> 32));
+		}
+
+		/** Claims the next batch from the front of a slot. @return false if the slot is empty. **/
+		bool ClaimBatch(int32 SlotIndex, int32& OutBegin, int32& OutEnd)
+		{
+			uint64 Range = Slots[SlotIndex].Range.Load(EMemoryOrder::Relaxed);
+			while (true)
+			{
+				const int32 Begin = GetRangeBegin(Range);
+				const int32 End = GetRangeEnd(Range);
+				if (Begin >= End)
+				{
+					return false;
+				}
+				const int32 BatchSize = FMath::Min(End - Begin, FMath::Max(MinBatchSize, (End - Begin) / BatchDivisor));
+				if (Slots[SlotIndex].Range.CompareExchange(Range, PackRange(Begin + BatchSize, End)))
+				{
+					OutBegin = Begin;
+					OutEnd = Begin + BatchSize;
+					return true;
+				}
+			}
+		}
+
+		/** 
+		 *	Moves the back half of the slot with the most work left into our own, empty, slot. Ranges too small to split are taken whole,
+		 *	so nobody ever has to wait for a participant that has not started yet.
+		 *	@return false if there was nothing left to steal.
+		**/
+		bool Steal(int32 SlotIndex)
+		{
+			while (true)
+			{
+				int32 Victim = INDEX_NONE;
+				int32 MostRemaining = 0;
+				uint64 VictimRange = 0;
+				for (int32 Offset = 1; Offset < NumSlots; Offset++)
+				{
+					const int32 Candidate = (SlotIndex + Offset) % NumSlots;
+					const uint64 Range = Slots[Candidate].Range.Load(EMemoryOrder::Relaxed);
+					const int32 Remaining = GetRangeEnd(Range) - GetRangeBegin(Range);
+					if (Remaining > MostRemaining)
+					{
+						Victim = Candidate;
+						MostRemaining = Remaining;
+						VictimRange = Range;
+					}
+				}
+				if (Victim == INDEX_NONE)
+				{
+					return false;
+				}
+				const int32 Begin = GetRangeBegin(VictimRange);
+				const int32 End = GetRangeEnd(VictimRange);
+				const int32 Split = MostRemaining >= 2 * MinBatchSize ? Begin + MostRemaining / 2 : Begin;
+				if (Slots[Victim].Range.CompareExchange(VictimRange, PackRange(Begin, Split)))
+				{
+					// nobody else writes to an empty slot, so a plain store is enough
+					Slots[SlotIndex].Range.Store(PackRange(Split, End));
+					return true;
+				}
+			}
+		}
+
+		bool Process(int32 SlotIndex, TSharedRef<TParallelForRangeData, ESPMode::ThreadSafe>& Data, ENamedThreads::Type InDesiredThread);
+	};
+
+	template<typename FunctionType>
+	class TParallelForRangeTask
+	{
+		TSharedRef<TParallelForRangeData<FunctionType>, ESPMode::ThreadSafe> Data;
+		ENamedThreads::Type DesiredThread;
+		int32 SlotIndex;
+	public:
+		TParallelForRangeTask(TSharedRef<TParallelForRangeData<FunctionType>, ESPMode::ThreadSafe>& InData, ENamedThreads::Type InDesiredThread, int32 InSlotIndex)
+			: Data(InData)
+			, DesiredThread(InDesiredThread)
+			, SlotIndex(InSlotIndex)
+		{
+		}
+		static FORCEINLINE TStatId GetStatId()
+		{
+			return GET_STATID(STAT_ParallelForTask);
+		}
+
+		FORCEINLINE ENamedThreads::Type GetDesiredThread()
+		{
+			return DesiredThread;
+		}
+
+		static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode()
+		{
+			return ESubsequentsMode::FireAndForget;
+		}
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			FMemMark Mark(FMemStack::Get());
+			if (Data->Process(SlotIndex, Data, DesiredThread))
+			{
+				checkSlow(!Data->bTriggered);
+				Data->bTriggered = true;
+				Data->Event->Trigger();
+			}
+		}
+	};
+
+	template<typename FunctionType>
+	inline bool TParallelForRangeData<FunctionType>::Process(int32 SlotIndex, TSharedRef<TParallelForRangeData<FunctionType>, ESPMode::ThreadSafe>& Data, ENamedThreads::Type InDesiredThread)
+	{
+		// helpers are started as a chain so the caller only pays for dispatching one task
+		if (SlotIndex > 0 && SlotIndex + 1 < NumSlots && NumCompleted.GetValue() < Num)
+		{
+			TGraphTask<TParallelForRangeTask<FunctionType>>::CreateTask().ConstructAndDispatchWhenReady(Data, InDesiredThread, SlotIndex + 1);
+		}
+		while (true)
+		{
+			int32 Begin, End;
+			while (ClaimBatch(SlotIndex, Begin, End))
+			{
+				Body(Begin, End);
+				checkSlow(!bExited);
+				const int32 BatchSize = End - Begin;
+				const int32 LocalNumCompleted = NumCompleted.Add(BatchSize) + BatchSize;
+				if (LocalNumCompleted == Num)
+				{
+					return true;
+				}
+				checkSlow(LocalNumCompleted < Num);
+			}
+			if (!Steal(SlotIndex))
+			{
+				return false;
+			}
+		}
+	}
+
+	/** @return the number of batches of at least MinBatchSize that Num can be run as in parallel, 1 if it should run on the calling thread. **/
+	inline int32 GetNumParallelBatches(int32 Num, int32 MinBatchSize, EParallelForFlags Flags)
+	{
+		const bool bIsMultithread = FApp::ShouldUseThreadingForPerformance() || FForkProcessHelper::IsForkedMultithreadInstance();
+		if (Num <= MinBatchSize || (Flags & EParallelForFlags::ForceSingleThread) != EParallelForFlags::None || !bIsMultithread)
+		{
+			return 1;
+		}
+		return FMath::DivideAndRoundUp(Num, FMath::Max(MinBatchSize, 1));
+	}
+
+	template<typename FunctionType>
+	inline void ParallelForRangeInternal(int32 Num, FunctionType Body, int32 MinBatchSize, EParallelForFlags Flags)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+		check(Num >= 0);
+		if (!Num)
+		{
+			return;
+		}
+
+		MinBatchSize = FMath::Max(MinBatchSize, 1);
+		const int32 NumBatches = GetNumParallelBatches(Num, MinBatchSize, Flags);
+		const int32 AnyThreadTasks = NumBatches > 1 ? FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), NumBatches - 1) : 0;
+		if (!AnyThreadTasks)
+		{
+			// no threads, just do it and return
+			Body(0, Num);
+			return;
+		}
+
+		const bool bPumpRenderingThread         = (Flags & EParallelForFlags::PumpRenderingThread) != EParallelForFlags::None;
+		const bool bBackgroundPriority          = (Flags & EParallelForFlags::BackgroundPriority) != EParallelForFlags::None;
+		const ENamedThreads::Type DesiredThread = bBackgroundPriority ? ENamedThreads::AnyBackgroundThreadNormalTask : ENamedThreads::AnyHiPriThreadHiPriTask;
+
+		TParallelForRangeData<FunctionType>* DataPtr = new TParallelForRangeData<FunctionType>(Num, AnyThreadTasks + 1, MinBatchSize, Body);
+		TSharedRef<TParallelForRangeData<FunctionType>, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
+		TGraphTask<TParallelForRangeTask<FunctionType>>::CreateTask().ConstructAndDispatchWhenReady(Data, DesiredThread, 1);
+		// this thread can help too and this is important to prevent deadlock on recursion
+		if (!Data->Process(0, Data, DesiredThread))
+		{
+			if (bPumpRenderingThread && IsInActualRenderingThread())
+			{
+				while (!Data->Event->Wait(1))
+				{
+					FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GetRenderThread_Local());
+				}
+			}
+			else
+			{
+				Data->Event->Wait();
+			}
+			check(Data->bTriggered);
+		}
+		else
+		{
+			check(!Data->bTriggered);
+		}
+		check(Data->NumCompleted.GetValue() == Data->Num);
+		Data->bExited = true;
+		// Data must live on until all of the tasks are cleared which might be long after this function exits
+	}
+
+	/** Splits Num into contiguous chunks for ParallelReduce and ParallelScan, a few per thread so the range parallel for can balance them. **/
+	inline int32 GetNumReduceChunks(int32 Num, int32 MinBatchSize, EParallelForFlags Flags)
+	{
+		const int32 NumBatches = GetNumParallelBatches(Num, FMath::Max(MinBatchSize, 1), Flags);
+		return NumBatches > 1 ? FMath::Min(NumBatches, 4 * (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1)) : 1;
+	}
+
+	inline int32 GetChunkBegin(int32 Num, int32 NumChunks, int32 ChunkIndex)
+	{
+		return int32(int64(Num) * ChunkIndex / NumChunks);
+	}
 }
 
 /** 
@@ -383,3 +662,105 @@ inline void ParallelForWithPreWork(int32 Num, TFunctionRef<void(int32)> Body, TF
 {
 	ParallelForImpl::ParallelForWithPreWorkInternal(Num, Body, CurrentThreadWorkToDoBeforeHelping, Flags);
 }
+
+/** 
+	*	Range based parallel for that uses the taskgraph
+	*	The range is split adaptively: every thread works through batches of its own part and only splits someone else's part when it runs out,
+	*	so it balances irregular workloads without a call per element.
+	*	@param Num; size of the range; Body is called with disjoint [Begin, End) ranges that together cover [0, Num)
+	*	@param Body; Function to call from multiple threads with the signature void(int32 Begin, int32 End)
+	*	@param MinBatchSize; Smallest range worth handing to Body, ranges are only split below this size to finish the last batch.
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed. Unbalanced is implied.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+template<typename FunctionType>
+inline void ParallelForRange(int32 Num, const FunctionType& Body, int32 MinBatchSize = 1, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	ParallelForImpl::ParallelForRangeInternal(Num, Body, MinBatchSize, Flags);
+}
+
+/** 
+	*	Parallel reduction over [0, Num)
+	*	@param Num; size of the range
+	*	@param Identity; Value that leaves any other value unchanged when reduced with it, also the result for an empty range
+	*	@param MapRange; Function with the signature ResultType(int32 Begin, int32 End) that reduces a contiguous range
+	*	@param Reduce; Associative function with the signature ResultType(const ResultType& A, const ResultType& B). Results are combined in index order, so it does not need to be commutative.
+	*	@param MinBatchSize; Smallest range worth handing to MapRange
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed.
+	*	@return the reduction of the whole range
+**/
+template<typename ResultType, typename MapRangeType, typename ReduceType>
+inline ResultType ParallelReduce(int32 Num, const ResultType& Identity, const MapRangeType& MapRange, const ReduceType& Reduce, int32 MinBatchSize = 1, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	const int32 NumChunks = ParallelForImpl::GetNumReduceChunks(Num, MinBatchSize, Flags);
+	if (NumChunks <= 1)
+	{
+		return Num ? Reduce(Identity, MapRange(0, Num)) : Identity;
+	}
+
+	TArray<ResultType, TInlineAllocator<64>> Partials;
+	Partials.Init(Identity, NumChunks);
+	ParallelForRange(NumChunks, [Num, NumChunks, &Partials, &MapRange](int32 BeginChunk, int32 EndChunk)
+	{
+		for (int32 ChunkIndex = BeginChunk; ChunkIndex < EndChunk; ChunkIndex++)
+		{
+			Partials[ChunkIndex] = MapRange(ParallelForImpl::GetChunkBegin(Num, NumChunks, ChunkIndex), ParallelForImpl::GetChunkBegin(Num, NumChunks, ChunkIndex + 1));
+		}
+	}, 1, Flags);
+
+	ResultType Result = Identity;
+	for (const ResultType& Partial : Partials)
+	{
+		Result = Reduce(Result, Partial);
+	}
+	return Result;
+}
+
+/** 
+	*	Parallel inclusive prefix scan over [0, Num), done in two passes over the range
+	*	@param Num; size of the range
+	*	@param Identity; Value that leaves any other value unchanged when combined with it, the prefix of the first element
+	*	@param ReduceRange; Function with the signature ResultType(int32 Begin, int32 End) that combines all elements of a contiguous range
+	*	@param ScanRange; Function with the signature void(int32 Begin, int32 End, const ResultType& Prefix) that scans a contiguous range, given the combination of all elements before Begin
+	*	@param Combine; Associative function with the signature ResultType(const ResultType& A, const ResultType& B)
+	*	@param MinBatchSize; Smallest range worth handing to ReduceRange or ScanRange
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed.
+**/
+template<typename ResultType, typename ReduceRangeType, typename ScanRangeType, typename CombineType>
+inline void ParallelScan(int32 Num, const ResultType& Identity, const ReduceRangeType& ReduceRange, const ScanRangeType& ScanRange, const CombineType& Combine, int32 MinBatchSize = 1, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	const int32 NumChunks = ParallelForImpl::GetNumReduceChunks(Num, MinBatchSize, Flags);
+	if (NumChunks <= 1)
+	{
+		if (Num)
+		{
+			ScanRange(0, Num, Identity);
+		}
+		return;
+	}
+
+	// first pass, reduce every chunk but the last, its total is not needed
+	TArray<ResultType, TInlineAllocator<64>> Prefixes;
+	Prefixes.Init(Identity, NumChunks);
+	ParallelForRange(NumChunks - 1, [Num, NumChunks, &Prefixes, &ReduceRange](int32 BeginChunk, int32 EndChunk)
+	{
+		for (int32 ChunkIndex = BeginChunk; ChunkIndex < EndChunk; ChunkIndex++)
+		{
+			Prefixes[ChunkIndex + 1] = ReduceRange(ParallelForImpl::GetChunkBegin(Num, NumChunks, ChunkIndex), ParallelForImpl::GetChunkBegin(Num, NumChunks, ChunkIndex + 1));
+		}
+	}, 1, Flags);
+
+	for (int32 ChunkIndex = 1; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		Prefixes[ChunkIndex] = Combine(Prefixes[ChunkIndex - 1], Prefixes[ChunkIndex]);
+	}
+
+	// second pass, scan every chunk starting from the total of the chunks before it
+	ParallelForRange(NumChunks, [Num, NumChunks, &Prefixes, &ScanRange](int32 BeginChunk, int32 EndChunk)
+	{
+		for (int32 ChunkIndex = BeginChunk; ChunkIndex < EndChunk; ChunkIndex++)
+		{
+			ScanRange(ParallelForImpl::GetChunkBegin(Num, NumChunks, ChunkIndex), ParallelForImpl::GetChunkBegin(Num, NumChunks, ChunkIndex + 1), Prefixes[ChunkIndex]);
+		}
+	}, 1, Flags);
+}
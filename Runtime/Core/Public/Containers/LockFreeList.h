@@ -770,6 +770,31 @@ public:
 		return nullptr;
 	}
 
+	/** Pops from the queue of one priority only, without stalling. Returns nullptr if that queue is empty. */
+	T* PopPriority(uint32 Priority)
+	{
+		checkLockFreePointerList(Priority < NumPriorities);
+
+		TDoublePtr LocalMasterState;
+		LocalMasterState.AtomicRead(MasterState);
+		T* Result = PriorityQueues[Priority].Pop();
+		if (Result)
+		{
+			while (true)
+			{
+				TDoublePtr NewMasterState;
+				NewMasterState.AdvanceCounterAndState(LocalMasterState, 1);
+				NewMasterState.SetPtr(LocalMasterState.GetPtr());
+				if (MasterState.InterlockedCompareExchange(NewMasterState, LocalMasterState))
+				{
+					break;
+				}
+				LocalMasterState.AtomicRead(MasterState);
+			}
+		}
+		return Result;
+	}
+
 private:
 
 	static int32 FindThreadToWake(TLinkPtr Ptr)
@@ -11,6 +11,25 @@
 #include "Containers/Array.h"
 #include "Misc/CString.h"
 
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	#include <emmintrin.h>
+	#define UE_STRINGCONV_SSE2 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_64BITS
+	#if PLATFORM_WINDOWS || PLATFORM_HOLOLENS
+		#include <arm64_neon.h>
+	#else
+		#include <arm_neon.h>
+	#endif
+	#define UE_STRINGCONV_NEON 1
+#endif
+
+#ifndef UE_STRINGCONV_SSE2
+	#define UE_STRINGCONV_SSE2 0
+#endif
+#ifndef UE_STRINGCONV_NEON
+	#define UE_STRINGCONV_NEON 0
+#endif
+
 #define DEFAULT_STRING_CONVERSION_SIZE 128u
 #define UNICODE_BOGUS_CHAR_CODEPOINT '?'
 static_assert(sizeof(UNICODE_BOGUS_CHAR_CODEPOINT) <= sizeof(ANSICHAR) && (UNICODE_BOGUS_CHAR_CODEPOINT) >= 32 && (UNICODE_BOGUS_CHAR_CODEPOINT) <= 127, "The Unicode Bogus character point is expected to fit in a single ANSICHAR here");
@@ -187,6 +206,215 @@ namespace UE4StringConv_Private
 	private:
 		int32 Counter;
 	};
+
+	/** Number of characters the block helpers below read or write at once */
+	constexpr const int32 CONVERT_BLOCK_SIZE = 16;
+
+	/** Are all of the CONVERT_BLOCK_SIZE chars at Source 7-bit ASCII? */
+	static FORCEINLINE bool IsAsciiBlock(const ANSICHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)Source)) == 0;
+#elif UE_STRINGCONV_NEON
+		return vmaxvq_u8(vld1q_u8((const uint8*)Source)) < 0x80;
+#else
+		uint8 Bits = 0;
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			Bits |= (uint8)Source[Index];
+		}
+		return Bits < 0x80;
+#endif
+	}
+
+	/** Are all of the CONVERT_BLOCK_SIZE chars at Source 7-bit ASCII? */
+	static FORCEINLINE bool IsAsciiBlock(const TCHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i* Registers = (const __m128i*)Source;
+		__m128i Bits = _mm_loadu_si128(Registers);
+		for (int32 Index = 1; Index < (int32)sizeof(TCHAR); ++Index)
+		{
+			Bits = _mm_or_si128(Bits, _mm_loadu_si128(Registers + Index));
+		}
+		const __m128i NonAsciiBits = sizeof(TCHAR) == 4 ? _mm_set1_epi32(~0x7F) : _mm_set1_epi16(~0x7F);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Bits, NonAsciiBits), _mm_setzero_si128())) == 0xFFFF;
+#elif UE_STRINGCONV_NEON
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		const uint32* Chars = (const uint32*)Source;
+		const uint32x4_t Bits = vorrq_u32(vorrq_u32(vld1q_u32(Chars), vld1q_u32(Chars + 4)), vorrq_u32(vld1q_u32(Chars + 8), vld1q_u32(Chars + 12)));
+		return vmaxvq_u32(Bits) < 0x80;
+	#else
+		const uint16* Chars = (const uint16*)Source;
+		return vmaxvq_u16(vorrq_u16(vld1q_u16(Chars), vld1q_u16(Chars + 8))) < 0x80;
+	#endif
+#else
+		uint32 Bits = 0;
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			Bits |= (uint32)Source[Index];
+		}
+		return Bits < 0x80;
+#endif
+	}
+
+	/** Zero-extends CONVERT_BLOCK_SIZE ASCII chars to TCHARs */
+	static FORCEINLINE void WidenAsciiBlock(TCHAR* Dest, const ANSICHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i Chars = _mm_loadu_si128((const __m128i*)Source);
+		const __m128i Low = _mm_unpacklo_epi8(Chars, Zero);
+		const __m128i High = _mm_unpackhi_epi8(Chars, Zero);
+		__m128i* Registers = (__m128i*)Dest;
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		_mm_storeu_si128(Registers,     _mm_unpacklo_epi16(Low, Zero));
+		_mm_storeu_si128(Registers + 1, _mm_unpackhi_epi16(Low, Zero));
+		_mm_storeu_si128(Registers + 2, _mm_unpacklo_epi16(High, Zero));
+		_mm_storeu_si128(Registers + 3, _mm_unpackhi_epi16(High, Zero));
+	#else
+		_mm_storeu_si128(Registers,     Low);
+		_mm_storeu_si128(Registers + 1, High);
+	#endif
+#elif UE_STRINGCONV_NEON
+		const uint8x16_t Chars = vld1q_u8((const uint8*)Source);
+		const uint16x8_t Low = vmovl_u8(vget_low_u8(Chars));
+		const uint16x8_t High = vmovl_u8(vget_high_u8(Chars));
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		uint32* Out = (uint32*)Dest;
+		vst1q_u32(Out,      vmovl_u16(vget_low_u16(Low)));
+		vst1q_u32(Out + 4,  vmovl_u16(vget_high_u16(Low)));
+		vst1q_u32(Out + 8,  vmovl_u16(vget_low_u16(High)));
+		vst1q_u32(Out + 12, vmovl_u16(vget_high_u16(High)));
+	#else
+		uint16* Out = (uint16*)Dest;
+		vst1q_u16(Out,     Low);
+		vst1q_u16(Out + 8, High);
+	#endif
+#else
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			Dest[Index] = (TCHAR)(uint8)Source[Index];
+		}
+#endif
+	}
+
+	/** Truncates CONVERT_BLOCK_SIZE TCHARs, which must be ASCII, to ANSICHARs */
+	static FORCEINLINE void NarrowAsciiBlock(ANSICHAR* Dest, const TCHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i* Registers = (const __m128i*)Source;
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		const __m128i Low = _mm_packs_epi32(_mm_loadu_si128(Registers), _mm_loadu_si128(Registers + 1));
+		const __m128i High = _mm_packs_epi32(_mm_loadu_si128(Registers + 2), _mm_loadu_si128(Registers + 3));
+		_mm_storeu_si128((__m128i*)Dest, _mm_packus_epi16(Low, High));
+	#else
+		_mm_storeu_si128((__m128i*)Dest, _mm_packus_epi16(_mm_loadu_si128(Registers), _mm_loadu_si128(Registers + 1)));
+	#endif
+#elif UE_STRINGCONV_NEON
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		const uint32* Chars = (const uint32*)Source;
+		const uint16x8_t Low = vcombine_u16(vmovn_u32(vld1q_u32(Chars)), vmovn_u32(vld1q_u32(Chars + 4)));
+		const uint16x8_t High = vcombine_u16(vmovn_u32(vld1q_u32(Chars + 8)), vmovn_u32(vld1q_u32(Chars + 12)));
+	#else
+		const uint16* Chars = (const uint16*)Source;
+		const uint16x8_t Low = vld1q_u16(Chars);
+		const uint16x8_t High = vld1q_u16(Chars + 8);
+	#endif
+		vst1q_u8((uint8*)Dest, vcombine_u8(vmovn_u16(Low), vmovn_u16(High)));
+#else
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			Dest[Index] = (ANSICHAR)Source[Index];
+		}
+#endif
+	}
+
+	/** Gets a bitmask of the CONVERT_BLOCK_SIZE bytes at Source which equal Value once masked with Mask, the first byte being the lowest bit */
+	static FORCEINLINE uint32 MatchBytesInBlock(const ANSICHAR* Source, const uint8 Mask, const uint8 Value)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i Chars = _mm_loadu_si128((const __m128i*)Source);
+		return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Chars, _mm_set1_epi8((char)Mask)), _mm_set1_epi8((char)Value)));
+#elif UE_STRINGCONV_NEON
+		static const uint8 BitWeights[CONVERT_BLOCK_SIZE] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t Chars = vld1q_u8((const uint8*)Source);
+		const uint8x16_t Matches = vandq_u8(vceqq_u8(vandq_u8(Chars, vdupq_n_u8(Mask)), vdupq_n_u8(Value)), vld1q_u8(BitWeights));
+		return (uint32)vaddv_u8(vget_low_u8(Matches)) | ((uint32)vaddv_u8(vget_high_u8(Matches)) << 8);
+#else
+		uint32 Result = 0;
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			Result |= ((uint8)Source[Index] & Mask) == Value ? (1u << Index) : 0u;
+		}
+		return Result;
+#endif
+	}
+
+	/** Maximum number of three octet sequences CountThreeOctetSequences can find in a block */
+	constexpr const int32 MAX_THREE_OCTET_SEQUENCES = CONVERT_BLOCK_SIZE / 3;
+
+	/**
+	 * Counts the leading three octet sequences of the block at Source, i.e. lead octets each followed by two continuation octets.
+	 * This is how most CJK text is encoded; the codepoints of the sequences still need to be range checked once decoded.
+	 */
+	static FORCEINLINE int32 CountThreeOctetSequences(const ANSICHAR* Source)
+	{
+		const uint32 LeadOctets = MatchBytesInBlock(Source, 0xF0, 0xE0);
+		const uint32 ContinuationOctets = MatchBytesInBlock(Source, 0xC0, 0x80);
+
+		int32 Count = 0;
+		for (; Count < MAX_THREE_OCTET_SEQUENCES; ++Count)
+		{
+			const uint32 Shift = Count * 3;
+			if (((LeadOctets >> Shift) & 7) != 1 || ((ContinuationOctets >> Shift) & 7) != 6)
+			{
+				break;
+			}
+		}
+		return Count;
+	}
+
+	/** Copies a block of ASCII chars, checked with IsAsciiBlock, to an output iterator */
+	template <typename DestBufferType>
+	static FORCEINLINE void CopyAsciiBlock(DestBufferType& Dest, const ANSICHAR* Source)
+	{
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			*(Dest++) = (TCHAR)(uint8)Source[Index];
+		}
+	}
+
+	template <typename DestBufferType>
+	static FORCEINLINE void CopyAsciiBlock(DestBufferType& Dest, const TCHAR* Source)
+	{
+		for (int32 Index = 0; Index < CONVERT_BLOCK_SIZE; ++Index)
+		{
+			*(Dest++) = (ANSICHAR)Source[Index];
+		}
+	}
+
+	static FORCEINLINE void CopyAsciiBlock(TCHAR*& Dest, const ANSICHAR* Source)
+	{
+		WidenAsciiBlock(Dest, Source);
+		Dest += CONVERT_BLOCK_SIZE;
+	}
+
+	static FORCEINLINE void CopyAsciiBlock(ANSICHAR*& Dest, const TCHAR* Source)
+	{
+		NarrowAsciiBlock(Dest, Source);
+		Dest += CONVERT_BLOCK_SIZE;
+	}
+
+	static FORCEINLINE void CopyAsciiBlock(FCountingOutputIterator& Dest, const ANSICHAR* Source)
+	{
+		Dest += CONVERT_BLOCK_SIZE;
+	}
+
+	static FORCEINLINE void CopyAsciiBlock(FCountingOutputIterator& Dest, const TCHAR* Source)
+	{
+		Dest += CONVERT_BLOCK_SIZE;
+	}
 }
 
 // This should be replaced with Platform stuff when FPlatformString starts to know about UTF-8.
@@ -298,6 +526,22 @@ private:
 #if PLATFORM_TCHAR_IS_4_BYTES
 		for (int32 i = 0; i < SourceLen; ++i)
 		{
+			// Fast path for runs of ASCII chars, a block at a time
+			if (static_cast<uint32>(Source[i]) < 0x80)
+			{
+				while (SourceLen - i >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && DestLen >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && UE4StringConv_Private::IsAsciiBlock(Source + i))
+				{
+					UE4StringConv_Private::CopyAsciiBlock(Dest, Source + i);
+					i += UE4StringConv_Private::CONVERT_BLOCK_SIZE;
+					DestLen -= UE4StringConv_Private::CONVERT_BLOCK_SIZE;
+				}
+
+				if (i == SourceLen)
+				{
+					break;
+				}
+			}
+
 			uint32 Codepoint = static_cast<uint32>(Source[i]);
 
 			if (!WriteCodepointToBuffer(Codepoint, Dest, DestLen))
@@ -311,6 +555,22 @@ private:
 
 		for (int32 i = 0; i < SourceLen; ++i)
 		{
+			// Fast path for runs of ASCII chars, a block at a time, which can't start between the halves of a surrogate pair
+			if (static_cast<uint32>(Source[i]) < 0x80 && HighSurrogate == MAX_uint32)
+			{
+				while (SourceLen - i >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && DestLen >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && UE4StringConv_Private::IsAsciiBlock(Source + i))
+				{
+					UE4StringConv_Private::CopyAsciiBlock(Dest, Source + i);
+					i += UE4StringConv_Private::CONVERT_BLOCK_SIZE;
+					DestLen -= UE4StringConv_Private::CONVERT_BLOCK_SIZE;
+				}
+
+				if (i == SourceLen)
+				{
+					break;
+				}
+			}
+
 			const bool bHighSurrogateIsSet = HighSurrogate != MAX_uint32;
 			uint32 Codepoint = static_cast<uint32>(Source[i]);
 
@@ -643,6 +903,29 @@ private:
 		return UNICODE_BOGUS_CHAR_CODEPOINT;  // catch everything else.
 	}
 
+	/**
+	 * Decodes three octet sequences found by CountThreeOctetSequences, stopping before the first one
+	 * whose codepoint is overlong, a surrogate or otherwise illegal.
+	 *
+	 * @return The number of codepoints written to ConvertedBuffer.
+	 */
+	template <typename DestBufferType>
+	static FORCEINLINE int32 ConvertThreeOctetSequences(DestBufferType& ConvertedBuffer, const ANSICHAR* Source, const int32 NumSequences)
+	{
+		for (int32 Index = 0; Index < NumSequences; ++Index, Source += 3)
+		{
+			const uint32 Codepoint = (((uint32)(uint8)Source[0] & 0x0F) << 12) | (((uint32)(uint8)Source[1] & 0x3F) << 6) | ((uint32)(uint8)Source[2] & 0x3F);
+			if (Codepoint < 0x800 || Codepoint > 0xFFFD || StringConv::IsHighSurrogate(Codepoint) || StringConv::IsLowSurrogate(Codepoint))
+			{
+				return Index;
+			}
+
+			*(ConvertedBuffer++) = (ToType)Codepoint;
+		}
+
+		return NumSequences;
+	}
+
 	/**
 	 * Read Source string, converting the data from UTF-8 into UTF-16, and placing these in the Destination
 	 */
@@ -651,32 +934,27 @@ private:
 	{
 		const ANSICHAR* SourceEnd = Source + SourceLen;
 
-		const uint64 ExtendedCharMask = 0x8080808080808080;
 		while (Source < SourceEnd && DestLen > 0)
 		{
-			// In case we're given an unaligned pointer, we'll
-			// fallback to the slow path until properly aligned.
-			if (IsAligned(Source, 8))
+			// Fast path for runs of ASCII chars, a block at a time
+			while (SourceEnd - Source >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && DestLen >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && UE4StringConv_Private::IsAsciiBlock(Source))
 			{
-				// Fast path for most common case
-				while (Source < SourceEnd - 8 && DestLen >= 8)
-				{
-					// Detect any extended characters 8 chars at a time
-					if ((*(const uint64*)Source) & ExtendedCharMask)
-					{
-						// Move to slow path since we got extended characters to process
-						break;
-					}
+				UE4StringConv_Private::CopyAsciiBlock(ConvertedBuffer, Source);
+				Source += UE4StringConv_Private::CONVERT_BLOCK_SIZE;
+				DestLen -= UE4StringConv_Private::CONVERT_BLOCK_SIZE;
+			}
 
-					// This should get unrolled on most compiler
-					// ROI of diminished return to vectorize this as we 
-					// would have to deal with alignment, endianness and
-					// rewrite the iterators to support bulk writes
-					for (int32 Index = 0; Index < 8; ++Index)
-					{
-						*(ConvertedBuffer++) = (ToType)(uint8)*(Source++);
-					}
-					DestLen -= 8;
+			// Fast path for runs of three octet sequences, a block at a time. Codepoints which would be bogus
+			// stop the run, to be handled by the slow path below.
+			while (SourceEnd - Source >= UE4StringConv_Private::CONVERT_BLOCK_SIZE && DestLen >= UE4StringConv_Private::MAX_THREE_OCTET_SEQUENCES)
+			{
+				const int32 NumSequences = UE4StringConv_Private::CountThreeOctetSequences(Source);
+				const int32 NumConverted = ConvertThreeOctetSequences(ConvertedBuffer, Source, NumSequences);
+				Source += NumConverted * 3;
+				DestLen -= NumConverted;
+				if (NumConverted < UE4StringConv_Private::MAX_THREE_OCTET_SEQUENCES)
+				{
+					break;
 				}
 			}
 
@@ -716,8 +994,8 @@ private:
 				*(ConvertedBuffer++) = (ToType)Codepoint;
 				--DestLen;
 
-				// Return to the fast path once aligned and back to simple ASCII chars
-				if (Codepoint < 128 && IsAligned(Source, 8))
+				// Return to the fast paths after an ASCII char or a three octet sequence
+				if (Codepoint < 128 || (Codepoint >= 0x800 && Codepoint < 0x10000))
 				{
 					break;
 				}
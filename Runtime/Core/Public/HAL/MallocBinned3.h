@@ -47,6 +47,23 @@
 #define DEFAULT_GMallocBinned3AllocExtra 32
 #define BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle 8
 
+// The global bundle recycler is split into this many arenas, picked by the CPU the calling thread runs on. Producer and consumer
+// threads on different cores then mostly touch their own arena and only steal from the others on a miss. The recycler capacity
+// (GMallocBinned3MaxBundlesBeforeRecycle bundles per pool) is divided between the arenas, so adding arenas does not cache more memory.
+#if !defined(BINNED3_RECYCLER_ARENA_COUNT)
+	#if PLATFORM_UNIX
+		#define BINNED3_RECYCLER_ARENA_COUNT 8
+	#else
+		#define BINNED3_RECYCLER_ARENA_COUNT 1
+	#endif
+#endif
+
+// When a thread cache overflows and the recycler is full, queue the bundle on a lock-free per-pool list instead of blocking on
+// the allocator mutex. Whoever holds the mutex next for that pool returns the queued blocks.
+#if !defined(BINNED3_DEFERRED_BUNDLE_FREES)
+	#define BINNED3_DEFERRED_BUNDLE_FREES PLATFORM_UNIX
+#endif
+
 #if !defined(AGGRESSIVE_MEMORY_SAVING)
 	#error "AGGRESSIVE_MEMORY_SAVING must be defined"
 #endif
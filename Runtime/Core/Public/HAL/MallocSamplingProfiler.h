@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/MemoryBase.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include <atomic>
+
+/**
+ * Allocator proxy that records the callstack of a size-weighted random subset of allocations.
+ *
+ * Each thread counts down an exponentially distributed number of bytes and samples the allocation that crosses zero, so on
+ * average one sample is taken every SampleInterval bytes and every live sample stands for an unbiased estimate of the bytes
+ * allocated from its callstack. The fast path only touches that thread local countdown (and one filter slot on free), which
+ * keeps the cost low enough to leave on in production. Live samples carry the active LLM tag and can be dumped to the log
+ * or exported as heap snapshots on the MemSampling trace channel to be diffed offline.
+ */
+class CORE_API FMallocSamplingProfiler final : public FMalloc
+{
+public:
+	static const int32 MaxCallstackDepth = 32;
+
+	/** Estimated live memory of one allocation site, aggregated from its samples. */
+	struct FSiteSummary
+	{
+		int32 CallstackIndex = INDEX_NONE;
+		int64 Tag = 0;
+		int64 EstimatedBytes = 0;
+		int32 NumSamples = 0;
+	};
+
+	FMallocSamplingProfiler(FMalloc* InMalloc, uint64 InSampleInterval);
+
+	// FMalloc interface.
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override;
+	virtual void Free(void* Ptr) override;
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return UsedMalloc->QuantizeSize(Count, Alignment);
+	}
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return UsedMalloc->GetAllocationSize(Original, SizeOut);
+	}
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		UsedMalloc->Trim(bTrimThreadCaches);
+	}
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+	virtual void InitializeStatsMetadata() override
+	{
+		UsedMalloc->InitializeStatsMetadata();
+	}
+	virtual void UpdateStats() override
+	{
+		UsedMalloc->UpdateStats();
+	}
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override;
+	virtual void DumpAllocatorStats(class FOutputDevice& Ar) override
+	{
+		UsedMalloc->DumpAllocatorStats(Ar);
+	}
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return true;
+	}
+	virtual bool ValidateHeap() override
+	{
+		return UsedMalloc->ValidateHeap();
+	}
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return UsedMalloc->GetDescriptiveName();
+	}
+
+	/**
+	 * Handles "MallocSampling Dump [Sites=N]" and "MallocSampling Snapshot", forwards anything else.
+	 */
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override;
+
+	/** Returns the live sites sorted by estimated bytes, largest first. */
+	void GetLiveSites(TArray<FSiteSummary>& OutSites);
+
+	/** Estimated bytes held by all live sampled allocation sites. */
+	int64 GetEstimatedLiveBytes();
+
+	/** Writes the largest live sites and their callstacks to the output device. */
+	void DumpLiveSites(FOutputDevice& Ar, int32 MaxSites);
+
+	/** Emits the live sites as a heap snapshot on the MemSampling trace channel. Returns the snapshot id. */
+	uint32 TraceSnapshot();
+
+	/** Copies the captured program counters of a callstack. */
+	void GetCallstack(int32 CallstackIndex, TArray<uint64>& OutFrames);
+
+	uint64 GetSampleInterval() const
+	{
+		return SampleInterval;
+	}
+
+	/** Wraps the allocator if GMallocSamplingProfilerEnabled was set before the allocator was created. */
+	static FMalloc* OverrideIfEnabled(FMalloc* InUsedAlloc);
+
+private:
+	struct FLiveSample
+	{
+		int64 EstimatedBytes;
+		int64 Tag;
+		int32 CallstackIndex;
+	};
+
+	struct FCallstack
+	{
+		uint32 Hash;
+		int32 FirstFrame;
+		int32 NumFrames;
+	};
+
+	/** Returns true when the allocation that just went through the countdown must be sampled. */
+	bool ShouldSample(SIZE_T Size);
+	FORCENOINLINE void RecordSample(void* Ptr, SIZE_T Size);
+	/** Forgets the sample of a pointer, optionally handing it back so it can be restored with RestoreSample. Returns false if it had none. */
+	FORCENOINLINE bool RemoveSample(void* Ptr, FLiveSample* OutSample = nullptr);
+	FORCENOINLINE void RestoreSample(void* Ptr, const FLiveSample& Sample);
+	int32 FindOrAddCallstack(const uint64* Frames, int32 NumFrames);
+
+	static uint32 FilterIndex(const void* Ptr);
+
+	/** Malloc we're based on, aka using under the hood */
+	FMalloc* UsedMalloc;
+	const uint64 SampleInterval;
+
+	/** Number of live samples per pointer hash bucket, so frees of unsampled pointers never take the lock. */
+	static const uint32 FilterBits = 16;
+	std::atomic<uint16> SampledFilter[1 << FilterBits];
+
+	FCriticalSection Mutex;
+	TMap<void*, FLiveSample> LiveSamples;
+	TMap<uint32, int32> CallstackHashToIndex;
+	TArray<FCallstack> Callstacks;
+	TArray<uint64> CallstackFrames;
+	std::atomic<uint32> NextSnapshotId;
+	std::atomic<int64> TotalSamples;
+};
+
+extern CORE_API FMallocSamplingProfiler* GMallocSamplingProfiler;
+extern CORE_API bool GMallocSamplingProfilerEnabled;
@@ -785,6 +785,9 @@ public:
 	CORE_API FIoStatus						Status() const;
 	CORE_API TIoStatusOr<FIoBuffer>			GetResult();
 
+	/** Completes the request with EIoErrorCode::Cancelled if it has not been resolved yet, reads already in flight still complete. */
+	CORE_API void							Cancel();
+
 private:
 	FIoRequestImpl* Impl = nullptr;
 
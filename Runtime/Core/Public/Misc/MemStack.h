@@ -12,6 +12,12 @@
 #include "HAL/ThreadSafeCounter.h"
 #include "Misc/NoopCounter.h"
 #include "Containers/LockFreeFixedSizeAllocator.h"
+#include <atomic>
+
+/** When enabled, containers using TFrameAllocator assert if they are used or destroyed after the frame they allocated in. */
+#ifndef UE_FRAME_ALLOCATOR_VALIDATION
+	#define UE_FRAME_ALLOCATOR_VALIDATION DO_CHECK
+#endif
 
 
 // Enums for specifying memory allocation type.
@@ -202,6 +208,61 @@ class CORE_API FMemStack : public TThreadSingleton<FMemStack>, public FMemStackB
 };
 
 
+/**
+ * Per-thread memory stack holding allocations that live until the end of the current frame.
+ * Nothing needs to be marked or popped: the whole stack is flushed by EndFrame(), which the engine loop calls for the game
+ * thread and the rendering thread. Threads that never end a frame (workers, commandlets that don't tick the engine loop, or
+ * the game thread before its first frame) and frames that go past memstack.FrameAllocator.MaxBytesPerFrame get no frame
+ * memory, TFrameAllocator falls back to the heap for them.
+ */
+class CORE_API FFrameMemStack : public TThreadSingleton<FFrameMemStack>, public FMemStackBase
+{
+public:
+	FFrameMemStack()
+		: FMemStackBase(0)
+		, FrameIndex(0)
+		, NumFrameAllocations(0)
+		, NumHeapFallbacks(0)
+		, NumFrameBytes(0)
+	{
+	}
+
+	/**
+	 * Allocates memory that stays valid until the next call to EndFrame() on this thread.
+	 * Returns nullptr if this thread doesn't end frames or the frame budget is used up, the caller must then use the heap.
+	 */
+	void* TryAllocFrameBytes(SIZE_T AllocSize, int32 Alignment);
+
+	/** Releases everything allocated during the frame and publishes the frame allocation stats. */
+	void EndFrame();
+
+	/** Number of frames ended on this stack, allocations are only valid while it has not changed. */
+	FORCEINLINE uint32 GetFrameIndex() const
+	{
+		return FrameIndex.load(std::memory_order_relaxed);
+	}
+
+	/** Number of allocations served during the current frame, each of which would otherwise have gone to the heap. */
+	FORCEINLINE int32 GetNumFrameAllocations() const
+	{
+		return NumFrameAllocations;
+	}
+
+	/** Number of allocations during the current frame that were sent to the heap instead. */
+	FORCEINLINE int32 GetNumHeapFallbacks() const
+	{
+		return NumHeapFallbacks;
+	}
+
+private:
+	/** Read from other threads when validating containers, written only by the owning thread. */
+	std::atomic<uint32> FrameIndex;
+	int32 NumFrameAllocations;
+	int32 NumHeapFallbacks;
+	SIZE_T NumFrameBytes;
+};
+
+
 /*-----------------------------------------------------------------------------
 	FMemStack templates.
 -----------------------------------------------------------------------------*/
@@ -386,6 +447,181 @@ struct TAllocatorTraits<TMemStackAllocator<Alignment>> : TAllocatorTraitsBase<TM
 };
 
 
+/**
+ * A container allocator that allocates from the frame memory stack of the current thread.
+ * Intended for temporaries that are built and consumed within one frame on the game or rendering thread; the memory is
+ * reclaimed in bulk at the end of the frame instead of going through the heap. Containers must be resized on the thread
+ * they first allocated on and must not be used after that thread's frame ended. When the frame stack can't serve an
+ * allocation (see FFrameMemStack) the container moves to the heap and stays there, freeing its memory like FHeapAllocator.
+ */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TFrameAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+
+		/** Default constructor. */
+		ForElementType()
+			: Data(nullptr)
+			, bOnFrameStack(false)
+#if UE_FRAME_ALLOCATOR_VALIDATION
+			, Stack(nullptr)
+			, FrameIndex(0)
+#endif
+		{}
+
+		~ForElementType()
+		{
+			if (Data && !bOnFrameStack)
+			{
+				FMemory::Free(Data);
+			}
+#if UE_FRAME_ALLOCATOR_VALIDATION
+			checkf(!bOnFrameStack || Stack->GetFrameIndex() == FrameIndex, TEXT("Container using TFrameAllocator outlived the frame it allocated in"));
+#endif
+		}
+
+		/**
+		 * Moves the state of another allocator into this one.
+		 * Assumes that the allocator is currently empty, i.e. memory may be allocated but any existing elements have already been destructed (if necessary).
+		 * @param Other - The allocator to move the state from.  This allocator should be left in a valid empty state.
+		 */
+		FORCEINLINE void MoveToEmpty(ForElementType& Other)
+		{
+			checkSlow(this != &Other);
+
+			if (Data && !bOnFrameStack)
+			{
+				FMemory::Free(Data);
+			}
+
+			Data                = Other.Data;
+			bOnFrameStack       = Other.bOnFrameStack;
+			Other.Data          = nullptr;
+			Other.bOnFrameStack = false;
+#if UE_FRAME_ALLOCATOR_VALIDATION
+			Stack      = Other.Stack;
+			FrameIndex = Other.FrameIndex;
+#endif
+		}
+
+		// FContainerAllocatorInterface
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+#if UE_FRAME_ALLOCATOR_VALIDATION
+			checkfSlow(!bOnFrameStack || Stack->GetFrameIndex() == FrameIndex, TEXT("Container using TFrameAllocator accessed after the frame it allocated in"));
+#endif
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			const SIZE_T NumBytes = NumElements * NumBytesPerElement;
+			const uint32 AllocationAlignment = FMath::Max(Alignment, (uint32)alignof(ElementType));
+
+			if (Data && !bOnFrameStack)
+			{
+				// Containers that fell back to the heap stay there, reallocating to zero bytes frees the memory.
+				Data = (ElementType*)FMemory::Realloc(Data, NumBytes, AllocationAlignment);
+				return;
+			}
+
+			FFrameMemStack& FrameStack = FFrameMemStack::Get();
+#if UE_FRAME_ALLOCATOR_VALIDATION
+			checkf(!Data || Stack == &FrameStack, TEXT("Container using TFrameAllocator resized on a different thread than the one it allocated on"));
+			checkf(!Data || Stack->GetFrameIndex() == FrameIndex, TEXT("Container using TFrameAllocator resized after the frame it allocated in"));
+#endif
+			void* OldData = Data;
+			Data = nullptr;
+			bOnFrameStack = false;
+			if (NumElements)
+			{
+				// Allocate memory from the frame stack, the old allocation is reclaimed with the rest of the frame.
+				Data = (ElementType*)FrameStack.TryAllocFrameBytes(NumBytes, AllocationAlignment);
+				if (Data)
+				{
+					bOnFrameStack = true;
+#if UE_FRAME_ALLOCATOR_VALIDATION
+					Stack = &FrameStack;
+					FrameIndex = FrameStack.GetFrameIndex();
+#endif
+				}
+				else
+				{
+					Data = (ElementType*)FMemory::Malloc(NumBytes, AllocationAlignment);
+				}
+
+				// If the container previously held elements, copy them into the new allocation.
+				if (OldData && PreviousNumElements)
+				{
+					const SizeType NumCopiedElements = FMath::Min(NumElements, PreviousNumElements);
+					FMemory::Memcpy(Data, OldData, NumCopiedElements * NumBytesPerElement);
+				}
+			}
+		}
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			// Shrinking would only allocate again from the stack, keep the memory we already have.
+			return bOnFrameStack ? NumAllocatedElements : DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		FORCEINLINE SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return !!Data;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+
+		/** A pointer to the container's elements. */
+		ElementType* Data;
+
+		/** Whether Data lives on the frame stack rather than the heap. */
+		bool bOnFrameStack;
+
+#if UE_FRAME_ALLOCATOR_VALIDATION
+		/** The frame stack Data was allocated from and the frame it was allocated in. */
+		const FFrameMemStack* Stack;
+		uint32 FrameIndex;
+#endif
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+template <uint32 Alignment>
+struct TAllocatorTraits<TFrameAllocator<Alignment>> : TAllocatorTraitsBase<TFrameAllocator<Alignment>>
+{
+	enum { SupportsMove    = true };
+	enum { IsZeroConstruct = true };
+};
+
+
 /**
  * FMemMark marks a top-of-stack position in the memory stack.
  * When the marker is constructed or initialized with a particular memory 
@@ -29,6 +29,16 @@
 	#define WITH_CASE_PRESERVING_NAME WITH_EDITORONLY_DATA
 #endif
 
+/**
+ * Do we want to store path-like names compactly?
+ * Ansi names such as "/Game/Props/Rock_01" are stored as the id of a shared prefix entry ("/Game/Props/Rock_")
+ * followed by the remaining suffix ("01") instead of the full string. This saves name memory for large amounts of
+ * asset paths at the cost of decoding the prefix whenever the string of a compact name is accessed.
+ */
+#ifndef WITH_COMPACT_NAME_STORAGE
+	#define WITH_COMPACT_NAME_STORAGE 0
+#endif
+
 class FText;
 
 /** Maximum size of name. */
@@ -164,10 +174,14 @@ enum EFindName
 struct FNameEntryHeader
 {
 	uint16 bIsWide : 1;
+#if WITH_COMPACT_NAME_STORAGE
+	/** Name data starts with the id of an entry holding the leading part of the name */
+	uint16 bHasPrefix : 1;
+#endif
 #if WITH_CASE_PRESERVING_NAME
-	uint16 Len : 15;
+	uint16 Len : 15 - WITH_COMPACT_NAME_STORAGE;
 #else
-	static constexpr uint32 ProbeHashBits = 5;
+	static constexpr uint32 ProbeHashBits = 5 - WITH_COMPACT_NAME_STORAGE;
 	uint16 LowercaseProbeHash : ProbeHashBits;
 	uint16 Len : 10;
 #endif
@@ -275,6 +289,13 @@ private:
 	void CopyAndConvertUnterminatedName(TCHAR* OutName) const;
 	const ANSICHAR* GetUnterminatedName(ANSICHAR(&OptionalDecodeBuffer)[NAME_SIZE]) const;
 	const WIDECHAR* GetUnterminatedName(WIDECHAR(&OptionalDecodeBuffer)[NAME_SIZE]) const;
+
+#if WITH_COMPACT_NAME_STORAGE
+	static int32 GetPrefixedDataOffset();
+	FNameEntryId GetPrefixId() const;
+	void StorePrefixedName(FNameEntryId PrefixId, const ANSICHAR* Suffix, uint32 SuffixLen);
+	void CopyPrefixedName(ANSICHAR* OutName) const;
+#endif
 };
 
 /**
@@ -33,6 +33,7 @@
 #include "HAL/ThreadHeartBeat.h"
 #include "HAL/ExceptionHandling.h"
 #include "Serialization/AsyncLoadingPrivate.h"
+#include "Serialization/AsyncLoadingRequestLatency.h"
 #include "UObject/UObjectHash.h"
 #include "Templates/UniquePtr.h"
 #include "Serialization/BufferReader.h"
@@ -4973,6 +4974,7 @@ void FAsyncLoadingThread::CancelAsyncLoadingInternal()
 #endif
 		PendingRequests.Empty();
 	}
+	FAsyncLoadingRequestLatency::Get().CancelRequests();
 
 	NotifyAsyncLoadingStateHasMaybeChanged();
 
@@ -6936,6 +6938,7 @@ int32 FAsyncLoadingThread::LoadPackage(const FString& InName, const FGuid* InGui
 		// this function, otherwise it would be added when the packages are being processed on the async thread).
 		RequestID = GPackageRequestID.Increment();
 		TRACE_LOADTIME_BEGIN_REQUEST(RequestID);
+		FAsyncLoadingRequestLatency::Get().BeginRequest(RequestID, InPackagePriority);
 		AddPendingRequest(RequestID);
 
 		// Allocate delegate on Game Thread, it is not safe to copy delegates by value on other threads
@@ -47,6 +47,8 @@
 #include "Serialization/LoadTimeTracePrivate.h"
 #include "ProfilingDebugging/CountersTrace.h"
 #include "Serialization/AsyncPackage.h"
+#include "Serialization/AsyncLoadingRequestLatency.h"
+#include "Serialization/AsyncLoadingPostLoadQueue.h"
 #include "Serialization/UnversionedPropertySerialization.h"
 #include "Serialization/Zenaphore.h"
 #include "UObject/GCObject.h"
@@ -247,6 +249,20 @@ static FAutoConsoleVariableRef CVar_VerbosePackageNames(
 	ECVF_Default);
 #endif
 
+static int32 GAsyncLoading2_PostLoadPriorityScheduling = 1;
+static FAutoConsoleVariableRef CVar_AsyncLoading2PostLoadPriorityScheduling(
+	TEXT("s.AsyncLoading2.PostLoadPriorityScheduling"),
+	GAsyncLoading2_PostLoadPriorityScheduling,
+	TEXT("1: game thread PostLoad runs the most urgent package first and switches packages between objects when a more urgent one is ready. 0: packages are PostLoaded in the order they finish loading."),
+	ECVF_Default);
+
+static float GAsyncLoading2_PostLoadDeadline = 2.0f;
+static FAutoConsoleVariableRef CVar_AsyncLoading2PostLoadDeadline(
+	TEXT("s.AsyncLoading2.PostLoadDeadline"),
+	GAsyncLoading2_PostLoadDeadline,
+	TEXT("Seconds after a package started loading past which its game thread PostLoad runs ahead of packages with a higher priority, so low priority requests are not starved."),
+	ECVF_Default);
+
 #define UE_ASYNC_PACKAGE_DEBUG(PackageDesc) \
 if (GAsyncLoading2_DebugPackageIds.Contains((PackageDesc).DiskPackageId)) \
 { \
@@ -1646,6 +1662,11 @@ public:
 		return !!bDone.Load();
 	}
 
+	FAsyncPackage2* GetPackage() const
+	{
+		return Package;
+	}
+
 private:
 	void ProcessDependencies(FAsyncLoadingThreadState2& ThreadState);
 	void Fire(FAsyncLoadingThreadState2* ThreadState = nullptr);
@@ -1707,6 +1728,7 @@ public:
 
 	bool PopAndExecute(FAsyncLoadingThreadState2& ThreadState);
 	void Push(FEventLoadNode2* Node);
+	FEventLoadNode2* Pop();
 
 private:
 	FZenaphore* Zenaphore = nullptr;
@@ -1715,6 +1737,37 @@ private:
 	TAtomic<FEventLoadNode2*> Entries[524288];
 };
 
+/**
+ * [GAME THREAD] Picks the order of the game thread PostLoad events queued in an FAsyncLoadEventQueue2.
+ * The package with the highest request priority runs first, and packages that started loading longer than
+ * s.AsyncLoading2.PostLoadDeadline ago run ahead of everything else, oldest first. PostLoad of a package yields
+ * between objects when a more urgent package is ready, and resumes where it stopped once it is picked again.
+ * With s.AsyncLoading2.PostLoadPriorityScheduling 0 the events run in queue order.
+ */
+class FAsyncLoadPostLoadScheduler2
+{
+public:
+	explicit FAsyncLoadPostLoadScheduler2(FAsyncLoadEventQueue2& InQueue)
+		: Queue(InQueue)
+	{
+	}
+
+	bool PopAndExecute(FAsyncLoadingThreadState2& ThreadState);
+
+	/** Called between objects by the event being executed, returns true when it should stop and let a more urgent package run */
+	bool ShouldYield(FAsyncLoadingThreadState2& ThreadState);
+
+private:
+	typedef TAsyncLoadPostLoadQueue<FEventLoadNode2*> FPostLoadQueue;
+
+	void GatherQueuedNodes();
+
+	FAsyncLoadEventQueue2& Queue;
+	FPostLoadQueue Waiting;
+	/** Entry of the node being executed, put back into Waiting if it does not complete */
+	FPostLoadQueue::FEntry ExecutingEntry { nullptr, 0, 0.0, 0 };
+};
+
 struct FAsyncLoadEventSpec
 {
 	typedef EAsyncPackageState::Type(*FAsyncLoadEventFunc)(FAsyncLoadingThreadState2&, FAsyncPackage2*, int32);
@@ -2265,6 +2318,8 @@ public:
 	FAsyncLoadEventGraphAllocator GraphAllocator;
 	FAsyncLoadEventQueue2 EventQueue;
 	FAsyncLoadEventQueue2 MainThreadEventQueue;
+	/** [GAME THREAD] Orders the PostLoad events pushed to MainThreadEventQueue */
+	FAsyncLoadPostLoadScheduler2 PostLoadScheduler { MainThreadEventQueue };
 	TArray<FAsyncLoadEventQueue2*> AltEventQueues;
 	TArray<FAsyncLoadEventSpec> EventSpecs;
 
@@ -2498,6 +2553,7 @@ public:
 		{
 			PendingRequests.Remove(ID);
 			TRACE_LOADTIME_END_REQUEST(ID);
+			FAsyncLoadingRequestLatency::Get().EndRequest(ID);
 		}
 	}
 
@@ -3061,37 +3117,91 @@ bool FAsyncLoadEventQueue2::PopAndExecute(FAsyncLoadingThreadState2& ThreadState
 		return true;
 	}
 
+	FEventLoadNode2* Node = Pop();
+	if (Node)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(Execute);
+		Node->Execute(ThreadState);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+FEventLoadNode2* FAsyncLoadEventQueue2::Pop()
+{
 	FEventLoadNode2* Node = nullptr;
+	uint64 LocalHead = Head.Load();
+	uint64 LocalTail = Tail.Load();
+	for (;;)
 	{
-		uint64 LocalHead = Head.Load();
-		uint64 LocalTail = Tail.Load();
-		for (;;)
+		if (LocalTail >= LocalHead)
 		{
-			if (LocalTail >= LocalHead)
-			{
-				break;
-			}
-			if (Tail.CompareExchange(LocalTail, LocalTail + 1))
+			break;
+		}
+		if (Tail.CompareExchange(LocalTail, LocalTail + 1))
+		{
+			while (!Node)
 			{
-				while (!Node)
-				{
-					Node = Entries[LocalTail % UE_ARRAY_COUNT(Entries)].Exchange(nullptr);
-				}
-				break;
+				Node = Entries[LocalTail % UE_ARRAY_COUNT(Entries)].Exchange(nullptr);
 			}
+			break;
 		}
 	}
+	return Node;
+}
 
-	if (Node)
+void FAsyncLoadPostLoadScheduler2::GatherQueuedNodes()
+{
+	while (FEventLoadNode2* Node = Queue.Pop())
 	{
-		//TRACE_CPUPROFILER_EVENT_SCOPE(Execute);
-		Node->Execute(ThreadState);
-		return true;
+		const FAsyncPackage2* Package = Node->GetPackage();
+		Waiting.Push(Node, Package->Desc.Priority, Package->GetLoadStartTime() + GAsyncLoading2_PostLoadDeadline);
 	}
-	else
+}
+
+bool FAsyncLoadPostLoadScheduler2::PopAndExecute(FAsyncLoadingThreadState2& ThreadState)
+{
+	if (ThreadState.CurrentEventNode || (!GAsyncLoading2_PostLoadPriorityScheduling && Waiting.IsEmpty()))
+	{
+		// Resuming an event that timed out on another queue, or flushing from within an event, is left to the queue, as is everything without scheduling
+		return Queue.PopAndExecute(ThreadState);
+	}
+
+	GatherQueuedNodes();
+	if (!Waiting.Pop(FPlatformTime::Seconds(), ExecutingEntry))
+	{
+		return false;
+	}
+
+	FEventLoadNode2* Node = ExecutingEntry.Node;
+	Waiting.BeginExecuting();
+	Node->Execute(ThreadState);
+	if (ThreadState.CurrentEventNode == Node)
+	{
+		// Timed out or yielded, the package resumes from its current export once its node is picked again
+		ThreadState.CurrentEventNode = nullptr;
+		Waiting.PushEntry(ExecutingEntry);
+	}
+	ExecutingEntry.Node = nullptr;
+	return true;
+}
+
+bool FAsyncLoadPostLoadScheduler2::ShouldYield(FAsyncLoadingThreadState2& ThreadState)
+{
+	if (!GAsyncLoading2_PostLoadPriorityScheduling || !ExecutingEntry.Node || ThreadState.CurrentEventNode != ExecutingEntry.Node)
 	{
 		return false;
 	}
+
+	// Runs between every two objects, so the queue and the clock are only looked at every few objects
+	return Waiting.ShouldYield(ExecutingEntry, [this]()
+	{
+		GatherQueuedNodes();
+		return FPlatformTime::Seconds();
+	});
 }
 
 FScopedAsyncPackageEvent2::FScopedAsyncPackageEvent2(FAsyncPackage2* InPackage)
@@ -4130,7 +4240,8 @@ EAsyncPackageState::Type FAsyncPackage2::Event_DeferredPostLoadExportBundle(FAsy
 		check(BundleEntry <= BundleEntryEnd);
 		while (BundleEntry < BundleEntryEnd)
 		{
-			if (ThreadState.IsTimeLimitExceeded(TEXT("Event_DeferredPostLoadExportBundle")))
+			if (ThreadState.IsTimeLimitExceeded(TEXT("Event_DeferredPostLoadExportBundle")) ||
+				Package->AsyncLoadingThread.PostLoadScheduler.ShouldYield(ThreadState))
 			{
 				LoadingState = EAsyncPackageState::TimeOut;
 				break;
@@ -4386,7 +4497,7 @@ EAsyncPackageState::Type FAsyncLoadingThread2::ProcessLoadedPackagesFromGameThre
 		}
 
 		bool bLocalDidSomething = false;
-		bLocalDidSomething |= MainThreadEventQueue.PopAndExecute(ThreadState);
+		bLocalDidSomething |= PostLoadScheduler.PopAndExecute(ThreadState);
 
 		bLocalDidSomething |= LoadedPackagesToProcess.Num() > 0;
 		for (int32 PackageIndex = 0; PackageIndex < LoadedPackagesToProcess.Num(); ++PackageIndex)
@@ -5724,6 +5835,7 @@ int32 FAsyncLoadingThread2::LoadPackage(const FString& InName, const FGuid* InGu
 		// this function, otherwise it would be added when the packages are being processed on the async thread).
 		RequestID = PackageRequestID.Increment();
 		TRACE_LOADTIME_BEGIN_REQUEST(RequestID);
+		FAsyncLoadingRequestLatency::Get().BeginRequest(RequestID, InPackagePriority);
 		AddPendingRequest(RequestID);
 
 		// Allocate delegate on Game Thread, it is not safe to copy delegates by value on other threads
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+
+/**
+ * Packages waiting for their game thread PostLoad, ordered by urgency. Entries past their deadline come first, oldest
+ * deadline first. The others follow by request priority, then deadline. Entries that are otherwise equally urgent keep
+ * the order they were added in.
+ *
+ * The overdue entries are always the ones with the smallest deadlines, so the most urgent entry is either the top of a
+ * deadline heap or the top of a priority heap. Both heaps index the same entries, an entry popped from one is dropped
+ * from the other when it reaches its top. Finding the most urgent entry is amortized O(1) and adding or removing one
+ * is O(log n).
+ */
+template <typename NodeType>
+class TAsyncLoadPostLoadQueue
+{
+public:
+	/** Number of ShouldYield calls between two looks at the waiting entries and the clock */
+	static constexpr int32 ObjectsPerYieldCheck = 8;
+
+	struct FEntry
+	{
+		NodeType Node;
+		int32 Priority;
+		double Deadline;
+		uint64 Sequence;
+	};
+
+	static bool IsMoreUrgent(const FEntry& A, const FEntry& B, double Now)
+	{
+		const bool bAIsOverdue = A.Deadline <= Now;
+		const bool bBIsOverdue = B.Deadline <= Now;
+		if (bAIsOverdue != bBIsOverdue)
+		{
+			return bAIsOverdue;
+		}
+		if (!bAIsOverdue && A.Priority != B.Priority)
+		{
+			return A.Priority > B.Priority;
+		}
+		if (A.Deadline != B.Deadline)
+		{
+			return A.Deadline < B.Deadline;
+		}
+		return A.Sequence < B.Sequence;
+	}
+
+	/** Adds a node that is ready for PostLoad */
+	void Push(NodeType Node, int32 Priority, double Deadline)
+	{
+		PushEntry(FEntry{ Node, Priority, Deadline, NextSequence++ });
+	}
+
+	/** Puts back an entry that was popped and did not complete, it keeps its place among equally urgent entries */
+	void PushEntry(const FEntry& Entry)
+	{
+		const FHeapItem Item{ Entries.Add(Entry), Entry.Priority, Entry.Deadline, Entry.Sequence };
+		ByPriority.HeapPush(Item, FMoreUrgentByPriority());
+		ByDeadline.HeapPush(Item, FMoreUrgentByDeadline());
+	}
+
+	/** Removes the most urgent entry at time Now, returns false if there is none */
+	bool Pop(double Now, FEntry& OutEntry)
+	{
+		const FHeapItem* Top = PeekItem(Now);
+		if (!Top)
+		{
+			return false;
+		}
+
+		const int32 Index = Top->Index;
+		OutEntry = Entries[Index];
+		Entries.RemoveAt(Index);
+		// The heap it was found in drops it right away, the other one once it reaches the top
+		RemoveStaleTops();
+		CompactIfMostlyStale();
+		return true;
+	}
+
+	/** True if a waiting entry is more urgent than Entry at time Now */
+	bool HasMoreUrgentThan(const FEntry& Entry, double Now)
+	{
+		const FHeapItem* Top = PeekItem(Now);
+		return Top && IsMoreUrgent(Entries[Top->Index], Entry, Now);
+	}
+
+	/**
+	 * Called between the objects of the executing entry, returns true when a waiting entry is more urgent. Only calls GetNow,
+	 * which may also push newly ready nodes, and looks at the waiting entries every ObjectsPerYieldCheck calls.
+	 * BeginExecuting restarts the count.
+	 */
+	template <typename GetNowType>
+	bool ShouldYield(const FEntry& Executing, GetNowType&& GetNow)
+	{
+		if (--CallsUntilYieldCheck > 0)
+		{
+			return false;
+		}
+		CallsUntilYieldCheck = ObjectsPerYieldCheck;
+		const double Now = GetNow();
+		return HasMoreUrgentThan(Executing, Now);
+	}
+
+	/** Called when an entry starts or resumes executing */
+	void BeginExecuting()
+	{
+		CallsUntilYieldCheck = ObjectsPerYieldCheck;
+	}
+
+	bool IsEmpty() const
+	{
+		return Entries.Num() == 0;
+	}
+
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+private:
+	/** Index of an entry in Entries with a copy of its ordering keys. Items of removed entries stay in the other heap until they reach its top */
+	struct FHeapItem
+	{
+		int32 Index;
+		int32 Priority;
+		double Deadline;
+		uint64 Sequence;
+	};
+
+	struct FMoreUrgentByPriority
+	{
+		bool operator()(const FHeapItem& A, const FHeapItem& B) const
+		{
+			if (A.Priority != B.Priority)
+			{
+				return A.Priority > B.Priority;
+			}
+			return A.Deadline != B.Deadline ? A.Deadline < B.Deadline : A.Sequence < B.Sequence;
+		}
+	};
+
+	struct FMoreUrgentByDeadline
+	{
+		bool operator()(const FHeapItem& A, const FHeapItem& B) const
+		{
+			return A.Deadline != B.Deadline ? A.Deadline < B.Deadline : A.Sequence < B.Sequence;
+		}
+	};
+
+	static bool IsLive(const TSparseArray<FEntry>& InEntries, const FHeapItem& Item)
+	{
+		return InEntries.IsAllocated(Item.Index) && InEntries[Item.Index].Sequence == Item.Sequence;
+	}
+
+	void RemoveStaleTops()
+	{
+		while (ByPriority.Num() > 0 && !IsLive(Entries, ByPriority.HeapTop()))
+		{
+			ByPriority.HeapPopDiscard(FMoreUrgentByPriority(), false);
+		}
+		while (ByDeadline.Num() > 0 && !IsLive(Entries, ByDeadline.HeapTop()))
+		{
+			ByDeadline.HeapPopDiscard(FMoreUrgentByDeadline(), false);
+		}
+	}
+
+	/** Rebuilds the heaps when removed entries that never reached the top make up most of them */
+	void CompactIfMostlyStale()
+	{
+		if (ByPriority.Num() + ByDeadline.Num() > 4 * Entries.Num() + 64)
+		{
+			ByPriority.Reset();
+			ByDeadline.Reset();
+			for (auto It = Entries.CreateConstIterator(); It; ++It)
+			{
+				ByPriority.Add(FHeapItem{ It.GetIndex(), It->Priority, It->Deadline, It->Sequence });
+			}
+			ByDeadline = ByPriority;
+			ByPriority.Heapify(FMoreUrgentByPriority());
+			ByDeadline.Heapify(FMoreUrgentByDeadline());
+		}
+	}
+
+	const FHeapItem* PeekItem(double Now)
+	{
+		if (Entries.Num() == 0)
+		{
+			return nullptr;
+		}
+		RemoveStaleTops();
+		const FHeapItem& OldestDeadline = ByDeadline.HeapTop();
+		return OldestDeadline.Deadline <= Now ? &OldestDeadline : &ByPriority.HeapTop();
+	}
+
+	TSparseArray<FEntry> Entries;
+	TArray<FHeapItem> ByPriority;
+	TArray<FHeapItem> ByDeadline;
+	uint64 NextSequence = 0;
+	int32 CallsUntilYieldCheck = ObjectsPerYieldCheck;
+};
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/AsyncLoadingRequestLatency.h"
+#include "Serialization/AsyncPackageLoader.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Requests"), STAT_AsyncLoadingPendingRequests, STATGROUP_AsyncLoadGameThread);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Request Latency (ms)"), STAT_AsyncLoadingLastRequestLatency, STATGROUP_AsyncLoadGameThread);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests Completed In 0-16 ms"), STAT_AsyncLoadingRequestLatency_0, STATGROUP_AsyncLoadGameThread);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests Completed In 16-33 ms"), STAT_AsyncLoadingRequestLatency_16, STATGROUP_AsyncLoadGameThread);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests Completed In 33-100 ms"), STAT_AsyncLoadingRequestLatency_33, STATGROUP_AsyncLoadGameThread);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests Completed In 100-500 ms"), STAT_AsyncLoadingRequestLatency_100, STATGROUP_AsyncLoadGameThread);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests Completed In 500-2000 ms"), STAT_AsyncLoadingRequestLatency_500, STATGROUP_AsyncLoadGameThread);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests Completed In 2000+ ms"), STAT_AsyncLoadingRequestLatency_2000, STATGROUP_AsyncLoadGameThread);
+
+TRACE_DECLARE_INT_COUNTER(AsyncLoadingPendingRequests, TEXT("AsyncLoading/PendingRequests"));
+TRACE_DECLARE_FLOAT_COUNTER(AsyncLoadingRequestLatency, TEXT("AsyncLoading/RequestLatencyMs"));
+TRACE_DECLARE_FLOAT_COUNTER(AsyncLoadingHighPriorityRequestLatency, TEXT("AsyncLoading/HighPriorityRequestLatencyMs"));
+
+static void DumpRequestLatency(const TArray<FString>& Args)
+{
+	const bool bReset = Args.Contains(TEXT("-reset"));
+	FAsyncLoadingRequestLatency::Get().DumpToLog(bReset);
+}
+
+static FAutoConsoleCommand CVar_DumpRequestLatencyCommand(
+	TEXT("s.AsyncLoading.DumpRequestLatency"),
+	TEXT("Prints the histograms of async loading request latency, from LoadPackageAsync to the completion callbacks. Usage: s.AsyncLoading.DumpRequestLatency [-reset]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(DumpRequestLatency));
+
+FAsyncLoadingRequestLatency& FAsyncLoadingRequestLatency::Get()
+{
+	static FAsyncLoadingRequestLatency Instance;
+	return Instance;
+}
+
+FAsyncLoadingRequestLatency::FAsyncLoadingRequestLatency()
+{
+	// Bins in milliseconds, matching the stats: within a frame at 60 and 30 Hz, then hitch sized buckets
+	HighPriorityHistogram.InitFromArray({ 0.0, 16.0, 33.0, 100.0, 500.0, 2000.0 });
+	NormalPriorityHistogram.InitFromArray({ 0.0, 16.0, 33.0, 100.0, 500.0, 2000.0 });
+}
+
+void FAsyncLoadingRequestLatency::BeginRequest(int32 RequestID, int32 Priority)
+{
+	FScopeLock Lock(&CriticalSection);
+	PendingRequests.Add(RequestID, FPendingRequest{ FPlatformTime::Seconds(), Priority });
+	INC_DWORD_STAT(STAT_AsyncLoadingPendingRequests);
+	TRACE_COUNTER_SET(AsyncLoadingPendingRequests, PendingRequests.Num());
+}
+
+void FAsyncLoadingRequestLatency::EndRequest(int32 RequestID)
+{
+	FScopeLock Lock(&CriticalSection);
+	FPendingRequest Request;
+	if (!PendingRequests.RemoveAndCopyValue(RequestID, Request))
+	{
+		// Requests that were not issued through LoadPackageAsync, such as imports, are not tracked
+		return;
+	}
+
+	const double LatencyMs = (FPlatformTime::Seconds() - Request.StartTime) * 1000.0;
+	if (Request.Priority > HighPriorityThreshold)
+	{
+		HighPriorityHistogram.AddMeasurement(LatencyMs);
+		TRACE_COUNTER_SET(AsyncLoadingHighPriorityRequestLatency, LatencyMs);
+	}
+	else
+	{
+		NormalPriorityHistogram.AddMeasurement(LatencyMs);
+		TRACE_COUNTER_SET(AsyncLoadingRequestLatency, LatencyMs);
+	}
+	TRACE_COUNTER_SET(AsyncLoadingPendingRequests, PendingRequests.Num());
+
+	DEC_DWORD_STAT(STAT_AsyncLoadingPendingRequests);
+	SET_FLOAT_STAT(STAT_AsyncLoadingLastRequestLatency, LatencyMs);
+	if (LatencyMs < 16.0)
+	{
+		INC_DWORD_STAT(STAT_AsyncLoadingRequestLatency_0);
+	}
+	else if (LatencyMs < 33.0)
+	{
+		INC_DWORD_STAT(STAT_AsyncLoadingRequestLatency_16);
+	}
+	else if (LatencyMs < 100.0)
+	{
+		INC_DWORD_STAT(STAT_AsyncLoadingRequestLatency_33);
+	}
+	else if (LatencyMs < 500.0)
+	{
+		INC_DWORD_STAT(STAT_AsyncLoadingRequestLatency_100);
+	}
+	else if (LatencyMs < 2000.0)
+	{
+		INC_DWORD_STAT(STAT_AsyncLoadingRequestLatency_500);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_AsyncLoadingRequestLatency_2000);
+	}
+}
+
+void FAsyncLoadingRequestLatency::CancelRequests()
+{
+	FScopeLock Lock(&CriticalSection);
+	PendingRequests.Empty();
+	SET_DWORD_STAT(STAT_AsyncLoadingPendingRequests, 0);
+	TRACE_COUNTER_SET(AsyncLoadingPendingRequests, 0);
+}
+
+void FAsyncLoadingRequestLatency::DumpToLog(bool bReset)
+{
+	FScopeLock Lock(&CriticalSection);
+	HighPriorityHistogram.DumpToLog(TEXT("AsyncLoading high priority request latency (ms)"));
+	NormalPriorityHistogram.DumpToLog(TEXT("AsyncLoading request latency (ms)"));
+	if (bReset)
+	{
+		HighPriorityHistogram.Reset();
+		NormalPriorityHistogram.Reset();
+	}
+}
+
+int32 FAsyncLoadingRequestLatency::GetNumPendingRequests() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return PendingRequests.Num();
+}
+
+FHistogram FAsyncLoadingRequestLatency::GetHistogram(bool bHighPriority) const
+{
+	FScopeLock Lock(&CriticalSection);
+	return bHighPriority ? HighPriorityHistogram : NormalPriorityHistogram;
+}
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ProfilingDebugging/Histogram.h"
+
+/**
+ * Tracks the latency of LoadPackageAsync requests, from the request to its completion callbacks.
+ * Latencies are gathered in histograms split by request priority, published as stats and trace counters,
+ * and can be dumped to the log with s.AsyncLoading.DumpRequestLatency.
+ */
+class FAsyncLoadingRequestLatency
+{
+public:
+	/** Requests with a priority above this are tracked in the high priority histogram */
+	static constexpr int32 HighPriorityThreshold = 0;
+
+	static FAsyncLoadingRequestLatency& Get();
+
+	/** [GAME THREAD] Called when a request is issued */
+	void BeginRequest(int32 RequestID, int32 Priority);
+
+	/** [ASYNC/GAME THREAD] Called once the completion callbacks of a request have been called */
+	void EndRequest(int32 RequestID);
+
+	/** [GAME THREAD] Forgets every pending request without recording its latency, called when async loading is canceled */
+	void CancelRequests();
+
+	/** Prints both histograms to the log, optionally resetting them afterwards */
+	void DumpToLog(bool bReset);
+
+	/** Returns the number of requests that have been issued but not completed */
+	int32 GetNumPendingRequests() const;
+
+	/** Returns a copy of the histogram of high or normal priority requests, in milliseconds */
+	FHistogram GetHistogram(bool bHighPriority) const;
+
+private:
+	FAsyncLoadingRequestLatency();
+
+	struct FPendingRequest
+	{
+		double StartTime;
+		int32 Priority;
+	};
+
+	mutable FCriticalSection CriticalSection;
+	TMap<int32, FPendingRequest> PendingRequests;
+	FHistogram HighPriorityHistogram;
+	FHistogram NormalPriorityHistogram;
+};
@@ -18,6 +18,7 @@
 #include "Misc/ConfigCacheIni.h"
 #include "HAL/LowLevelMemTracker.h"
 #include "Serialization/AsyncPackageLoader.h"
+#include "Serialization/AsyncLoadingRequestLatency.h"
 
 struct FPrecacheCallbackHandler;
 
@@ -562,6 +563,7 @@ public:
 		{
 			PendingRequests.Remove(ID);
 			TRACE_LOADTIME_END_REQUEST(ID);
+			FAsyncLoadingRequestLatency::Get().EndRequest(ID);
 		}		
 	}
 
@@ -892,6 +892,26 @@ bool FUntypedBulkData::NeedsOffsetFixup() const
 	return (BulkDataFlags & BULKDATA_NoOffsetFixUp) == 0;
 }
 
+FString FUntypedBulkData::GetStreamingFilename(int64& OutOffsetInFile) const
+{
+	// If we are loading from a .uexp file then we need to adjust the filename and offset stored by BulkData in order to use them
+	// to access the data in the .uexp file. To keep the method const (due to a large number of places calling this, assuming that
+	// it is const) we take a copy of these data values which if needed can be adjusted and use them instead.
+	FString AdjustedFilename = Filename;
+	OutOffsetInFile = BulkDataOffsetInFile;
+
+	// Fix up the Filename/Offset to work with streaming if EDL is enabled and the filename is still referencing a uasset or umap
+	if (GEventDrivenLoaderEnabled && (AdjustedFilename.EndsWith(TEXT(".uasset")) || AdjustedFilename.EndsWith(TEXT(".umap"))))
+	{
+		OutOffsetInFile -= IFileManager::Get().FileSize(*AdjustedFilename);
+		AdjustedFilename = FPaths::GetBaseFilename(AdjustedFilename, false) + BulkDataExt::Export;
+
+		UE_LOG(LogSerialization, Error, TEXT("Streaming from the .uexp file '%s' this MUST be in a ubulk instead for best performance."), *AdjustedFilename);
+	}
+
+	return AdjustedFilename;
+}
+
 void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx, bool bAttemptFileMapping, EFileRegionType FileRegionType)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FUntypedBulkData::Serialize"), STAT_UBD_Serialize, STATGROUP_Memory);
@@ -1667,20 +1687,8 @@ IBulkDataIORequest* FUntypedBulkData::CreateStreamingRequest(int64 OffsetInBulkD
 {
 	check(Filename.IsEmpty() == false);
 
-	// If we are loading from a .uexp file then we need to adjust the filename and offset stored by BulkData in order to use them
-	// to access the data in the .uexp file. To keep the method const (due to a large number of places calling this, assuming that
-	// it is const) we take a copy of these data values which if needed can be adjusted and use them instead.
-	FString AdjustedFilename = Filename; 
-	int64 AdjustedBulkDataOffsetInFile = BulkDataOffsetInFile;
-
-	// Fix up the Filename/Offset to work with streaming if EDL is enabled and the filename is still referencing a uasset or umap
-	if (GEventDrivenLoaderEnabled && (AdjustedFilename.EndsWith(TEXT(".uasset")) || AdjustedFilename.EndsWith(TEXT(".umap"))))
-	{
-		AdjustedBulkDataOffsetInFile -= IFileManager::Get().FileSize(*AdjustedFilename);
-		AdjustedFilename = FPaths::GetBaseFilename(AdjustedFilename, false) + BulkDataExt::Export;
-
-		UE_LOG(LogSerialization, Error, TEXT("Streaming from the .uexp file '%s' this MUST be in a ubulk instead for best performance."), *AdjustedFilename);
-	}
+	int64 AdjustedBulkDataOffsetInFile = 0;
+	const FString AdjustedFilename = GetStreamingFilename(AdjustedBulkDataOffsetInFile);
 
 	UE_CLOG(IsStoredCompressedOnDisk(), LogSerialization, Fatal, TEXT("Package level compression is no longer supported (%s)."), *AdjustedFilename);
 	UE_CLOG(GetBulkDataSize() <= 0, LogSerialization, Error, TEXT("(%s) has invalid bulk data size."), *AdjustedFilename);
@@ -1708,6 +1716,37 @@ IBulkDataIORequest* FUntypedBulkData::CreateStreamingRequest(int64 OffsetInBulkD
 	}
 }
 
+IBulkDataRangeRequest* FUntypedBulkData::CreateRangeRequest(int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority, FBulkDataRangeRequestCallBack* CompleteCallback, uint8* UserSuppliedMemory, bool bAllowMemoryMapping) const
+{
+	check(Filename.IsEmpty() == false);
+	checkf(OffsetInBulkData >= 0 && OffsetInBulkData + BytesToRead <= GetBulkDataSize(), TEXT("Attempting to read past the end of BulkData"));
+
+	int64 AdjustedBulkDataOffsetInFile = 0;
+	const FString AdjustedFilename = GetStreamingFilename(AdjustedBulkDataOffsetInFile);
+
+	UE_CLOG(IsStoredCompressedOnDisk(), LogSerialization, Fatal, TEXT("Package level compression is no longer supported (%s)."), *AdjustedFilename);
+
+	const int64 OffsetInFile = AdjustedBulkDataOffsetInFile + OffsetInBulkData;
+
+	FBulkDataRangeRequest* RangeRequest = new FBulkDataRangeRequest(CompleteCallback);
+
+	const bool bMapRange = UserSuppliedMemory == nullptr && FPlatformProperties::SupportsMemoryMappedFiles() && (bAllowMemoryMapping || (BulkDataFlags & BULKDATA_MemoryMappedPayload) != 0);
+	if (bMapRange && RangeRequest->MapRange(AdjustedFilename, OffsetInFile, BytesToRead))
+	{
+		return RangeRequest;
+	}
+
+	if (RangeRequest->ReadRange(AdjustedFilename, OffsetInFile, BytesToRead, Priority, UserSuppliedMemory))
+	{
+		return RangeRequest;
+	}
+	else
+	{
+		delete RangeRequest;
+		return nullptr;
+	}
+}
+
 #if USE_BULKDATA_STREAMING_TOKEN 
 
 FBulkDataStreamingToken FUntypedBulkData::CreateStreamingToken() const
@@ -1834,6 +1873,290 @@ void FBulkDataIORequest::Cancel()
 	ReadRequest->Cancel();
 }
 
+// Shared between all FBulkDataRangeRequest in the same way as the other BulkData requests share theirs
+static FCriticalSection FBulkDataRangeRequestEvent;
+
+FBulkDataRangeRequest::FBulkDataRangeRequest(FBulkDataRangeRequestCallBack* InCompleteCallback)
+{
+	if (InCompleteCallback != nullptr)
+	{
+		CompleteCallback = *InCompleteCallback;
+	}
+}
+
+FBulkDataRangeRequest::~FBulkDataRangeRequest()
+{
+	if (bIsIssued)
+	{
+		WaitCompletion(0.0f); // Wait for ever as we cannot leave outstanding requests
+	}
+
+	if (FileRequest != nullptr)
+	{
+		// Our callback is invoked before the file request itself is complete
+		FileRequest->WaitCompletion();
+		delete FileRequest;
+	}
+	delete FileHandle;
+
+	// Regions must be released before the handle they were mapped from
+	Result = FIoBuffer();
+	delete MappedRegion;
+	if (bOwnsMappedHandle)
+	{
+		delete MappedHandle;
+	}
+
+	// Make sure no other thread is waiting on this request
+	checkf(DoneEvent == nullptr, TEXT("A thread is still waiting on a FBulkDataRangeRequest that is being destroyed!"));
+}
+
+bool FBulkDataRangeRequest::MapRange(const FString& Filename, int64 OffsetInFile, int64 BytesToRead)
+{
+	checkf(!bIsIssued, TEXT("FBulkDataRangeRequest has already been issued"));
+
+	IMappedFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename);
+	if (Handle == nullptr)
+	{
+		return false;
+	}
+
+	IMappedFileRegion* Region = Handle->MapRegion(OffsetInFile, BytesToRead);
+	if (Region == nullptr || Region->GetMappedSize() != BytesToRead)
+	{
+		delete Region;
+		delete Handle;
+		return false;
+	}
+
+	MappedHandle = Handle;
+	MappedRegion = Region;
+	bOwnsMappedHandle = true;
+
+	bIsIssued = true;
+	CompleteMappedRequest(BytesToRead);
+
+	return true;
+}
+
+bool FBulkDataRangeRequest::MapRange(const FIoChunkId& ChunkId, int64 OffsetInChunk, int64 BytesToRead)
+{
+	checkf(!bIsIssued, TEXT("FBulkDataRangeRequest has already been issued"));
+
+	TIoStatusOr<FIoMappedRegion> Status = FBulkDataBase::GetIoDispatcher()->OpenMapped(ChunkId, FIoReadOptions(OffsetInChunk, BytesToRead));
+	if (!Status.IsOk())
+	{
+		return false;
+	}
+
+	// The handle belongs to the container, only the region is ours
+	FIoMappedRegion Region = Status.ConsumeValueOrDie();
+	if (Region.MappedFileRegion->GetMappedSize() != BytesToRead)
+	{
+		delete Region.MappedFileRegion;
+		return false;
+	}
+
+	MappedHandle = Region.MappedFileHandle;
+	MappedRegion = Region.MappedFileRegion;
+	bOwnsMappedHandle = false;
+
+	bIsIssued = true;
+	CompleteMappedRequest(BytesToRead);
+
+	return true;
+}
+
+bool FBulkDataRangeRequest::ReadRange(const FString& Filename, int64 OffsetInFile, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags, uint8* UserSuppliedMemory)
+{
+	checkf(!bIsIssued, TEXT("FBulkDataRangeRequest has already been issued"));
+
+	FileHandle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*Filename);
+	if (FileHandle == nullptr)
+	{
+		return false;
+	}
+
+	FAsyncFileCallBack AsyncFileCallBack = [this, BytesToRead, UserSuppliedMemory](bool bWasCancelled, IAsyncReadRequest* InRequest)
+	{
+		uint8* Memory = bWasCancelled ? nullptr : InRequest->GetReadResults();
+		if (Memory == nullptr)
+		{
+			CompleteRequest(bWasCancelled ? EIoErrorCode::Cancelled : EIoErrorCode::ReadError, FIoBuffer());
+		}
+		else if (Memory == UserSuppliedMemory)
+		{
+			CompleteRequest(EIoErrorCode::Ok, FIoBuffer(FIoBuffer::Wrap, Memory, BytesToRead));
+		}
+		else
+		{
+			CompleteRequest(EIoErrorCode::Ok, FIoBuffer(FIoBuffer::AssumeOwnership, Memory, BytesToRead));
+		}
+	};
+
+	// The callback can be invoked before ReadRequest returns, if the data is cached in the pak file system for example
+	bIsIssued = true;
+	FileRequest = FileHandle->ReadRequest(OffsetInFile, BytesToRead, PriorityAndFlags, &AsyncFileCallBack, UserSuppliedMemory);
+
+	if (FileRequest == nullptr)
+	{
+		bIsIssued = false;
+		return false;
+	}
+
+	return true;
+}
+
+void FBulkDataRangeRequest::ReadRange(const FIoChunkId& ChunkId, int64 OffsetInChunk, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags, uint8* UserSuppliedMemory)
+{
+	checkf(!bIsIssued, TEXT("FBulkDataRangeRequest has already been issued"));
+
+	// Without a target the IoDispatcher allocates a buffer that owns its memory, which can be returned as it is
+	FIoReadOptions Options(OffsetInChunk, BytesToRead);
+	if (UserSuppliedMemory != nullptr)
+	{
+		Options.SetTargetVa(UserSuppliedMemory);
+	}
+
+	auto OnRequestLoaded = [this](TIoStatusOr<FIoBuffer> ReadResult)
+	{
+		if (ReadResult.IsOk())
+		{
+			CompleteRequest(EIoErrorCode::Ok, ReadResult.ConsumeValueOrDie());
+		}
+		else
+		{
+			CompleteRequest(ReadResult.Status().GetErrorCode(), FIoBuffer());
+		}
+	};
+
+	const int32 IoDispatcherPriority = (PriorityAndFlags & AIOP_PRIORITY_MASK) >= AIOP_High ? IoDispatcherPriority_High : IoDispatcherPriority_Low;
+
+	bIsIssued = true;
+	FIoBatch IoBatch = FBulkDataBase::GetIoDispatcher()->NewBatch();
+	IoRequest = IoBatch.ReadWithCallback(ChunkId, Options, IoDispatcherPriority, OnRequestLoaded);
+	if (bIsCanceled)
+	{
+		// Canceled before it was issued, the IoDispatcher drops it without resolving it
+		IoRequest.Cancel();
+	}
+	IoBatch.Issue();
+}
+
+bool FBulkDataRangeRequest::PollCompletion() const
+{
+	return bIsCompleted;
+}
+
+bool FBulkDataRangeRequest::WaitCompletion(float TimeLimitSeconds)
+{
+	// Make sure no other thread is waiting on this request
+	checkf(DoneEvent == nullptr, TEXT("Multiple threads attempting to wait on the same FBulkDataRangeRequest"));
+
+	{
+		FScopeLock Lock(&FBulkDataRangeRequestEvent);
+		if (!bIsCompleted)
+		{
+			DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+		}
+	}
+
+	if (DoneEvent != nullptr)
+	{
+		uint32 TimeLimitMilliseconds = TimeLimitSeconds <= 0.0f ? MAX_uint32 : (uint32)(TimeLimitSeconds * 1000.0f);
+		DoneEvent->Wait(TimeLimitMilliseconds);
+
+		FScopeLock Lock(&FBulkDataRangeRequestEvent);
+		FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+		DoneEvent = nullptr;
+	}
+
+	return bIsCompleted;
+}
+
+TIoStatusOr<FIoBuffer> FBulkDataRangeRequest::GetResult()
+{
+	checkf(bDataIsReady, TEXT("Attempting to get the result of a FBulkDataRangeRequest that has not completed"));
+
+	if (ResultErrorCode == EIoErrorCode::Ok)
+	{
+		return Result;
+	}
+	else
+	{
+		return FIoStatus(ResultErrorCode);
+	}
+}
+
+bool FBulkDataRangeRequest::IsMemoryMapped() const
+{
+	return MappedRegion != nullptr;
+}
+
+void FBulkDataRangeRequest::Cancel()
+{
+	if (!bIsCanceled)
+	{
+		bIsCanceled = true;
+		FPlatformMisc::MemoryBarrier();
+
+		// Requests still queued in the IoDispatcher are dropped, reads already in flight complete and are discarded
+		IoRequest.Cancel();
+
+		if (FileRequest != nullptr)
+		{
+			FileRequest->Cancel();
+		}
+	}
+}
+
+void FBulkDataRangeRequest::CompleteMappedRequest(int64 BytesToRead)
+{
+	// Mapping reads nothing, so the range is paged in on a worker before the request completes. Otherwise whoever reads
+	// it first takes the page faults, which could be a thread with a deadline such as the audio renderer.
+	Async(EAsyncExecution::ThreadPool, [this, BytesToRead]()
+	{
+		if (!bIsCanceled)
+		{
+			// The region covers exactly the range. Platforms that map audio touch every page of it, see IMappedFileRegion::PreloadHint
+			MappedRegion->PreloadHint();
+		}
+
+		CompleteRequest(EIoErrorCode::Ok, FIoBuffer(FIoBuffer::Wrap, MappedRegion->GetMappedPtr(), BytesToRead));
+	});
+}
+
+void FBulkDataRangeRequest::CompleteRequest(EIoErrorCode ErrorCode, const FIoBuffer& Buffer)
+{
+	if (bIsCanceled)
+	{
+		ErrorCode = EIoErrorCode::Cancelled;
+	}
+
+	if (ErrorCode == EIoErrorCode::Ok)
+	{
+		Result = Buffer;
+	}
+	ResultErrorCode = ErrorCode;
+	bDataIsReady = true;
+
+	if (CompleteCallback)
+	{
+		// As with the other BulkData requests an IO error counts as the request being canceled
+		CompleteCallback(ErrorCode != EIoErrorCode::Ok, this);
+	}
+
+	{
+		FScopeLock Lock(&FBulkDataRangeRequestEvent);
+		bIsCompleted = true;
+
+		if (DoneEvent != nullptr)
+		{
+			DoneEvent->Trigger();
+		}
+	}
+}
+
 /**
  * Loads the bulk data if it is not already loaded.
  */
@@ -611,7 +611,12 @@ public:
 		{
 			bIsCanceled = true;
 			FPlatformMisc::MemoryBarrier();
-			// TODO: Send to IoDispatcher
+
+			// Requests that have not been resolved yet are dropped by the IoDispatcher
+			for (Request& Request : RequestArray)
+			{
+				Request.IoRequest.Cancel();
+			}
 		}
 	}
 
@@ -1278,6 +1283,51 @@ IBulkDataIORequest* FBulkDataBase::CreateStreamingRequestForRange(const BulkData
 	}
 }
 
+IBulkDataRangeRequest* FBulkDataBase::CreateRangeRequest(int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority, FBulkDataRangeRequestCallBack* CompleteCallback, uint8* UserSuppliedMemory, bool bAllowMemoryMapping) const
+{
+	checkf(OffsetInBulkData >= 0 && OffsetInBulkData + BytesToRead <= BulkDataSize, TEXT("Attempting to read past the end of BulkData"));
+
+	FBulkDataRangeRequest* RangeRequest = new FBulkDataRangeRequest(CompleteCallback);
+
+	const int64 OffsetInFile = BulkDataOffset + OffsetInBulkData;
+
+	if (IsUsingIODispatcher())
+	{
+		// Only the containers of memory mapped payloads are laid out to be mapped
+		if (UserSuppliedMemory == nullptr && IsFileMemoryMapped() && RangeRequest->MapRange(CreateChunkId(), OffsetInFile, BytesToRead))
+		{
+			return RangeRequest;
+		}
+
+		RangeRequest->ReadRange(CreateChunkId(), OffsetInFile, BytesToRead, Priority, UserSuppliedMemory);
+
+		return RangeRequest;
+	}
+	else
+	{
+		const FString AssetFilename = FileTokenSystem::GetFilename(Data.Token);
+		const FString Filename = ConvertFilenameFromFlags(AssetFilename);
+
+		UE_CLOG(IsStoredCompressedOnDisk(), LogSerialization, Fatal, TEXT("Package level compression is no longer supported (%s)."), *Filename);
+
+		const bool bMapRange = UserSuppliedMemory == nullptr && FPlatformProperties::SupportsMemoryMappedFiles() && (bAllowMemoryMapping || IsFileMemoryMapped());
+		if (bMapRange && RangeRequest->MapRange(Filename, OffsetInFile, BytesToRead))
+		{
+			return RangeRequest;
+		}
+
+		if (RangeRequest->ReadRange(Filename, OffsetInFile, BytesToRead, Priority, UserSuppliedMemory))
+		{
+			return RangeRequest;
+		}
+		else
+		{
+			delete RangeRequest;
+			return nullptr;
+		}
+	}
+}
+
 void FBulkDataBase::ForceBulkDataResident()
 {
 	// First wait for any async load requests to finish
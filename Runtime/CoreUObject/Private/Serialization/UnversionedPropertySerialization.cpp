@@ -3,6 +3,8 @@
 #include "Serialization/UnversionedPropertySerialization.h"
 #include "Serialization/UnversionedPropertySerializationTest.h"
 #include "Interfaces/ITargetPlatform.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ByteSwap.h"
 #include "Misc/ScopeRWLock.h"
 #include "UObject/UnrealType.h"
 
@@ -15,6 +17,17 @@
 #	define CACHE_UNVERSIONED_PROPERTY_SCHEMA (PLATFORM_CPU_X86_FAMILY && PLATFORM_64BITS)
 #endif
 
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+// The cached schema also records runs of integer-like values stored back to back in memory,
+// which are then saved and loaded with a single Serialize() call instead of one per value.
+static bool GUnversionedPropertyCopyRuns = true;
+static FAutoConsoleVariableRef CVarUnversionedPropertyCopyRuns(
+	TEXT("s.UnversionedPropertySerialization.CopyRuns"),
+	GUnversionedPropertyCopyRuns,
+	TEXT("Serialize runs of contiguous integer, float, enum and native bool properties with a single copy. The serialized data is the same either way."),
+	ECVF_Default);
+#endif
+
 // Helper to pass around appropriate default value types depending on CACHE_UNVERSIONED_PROPERTY_SCHEMA
 struct FDefaultStruct
 {
@@ -141,6 +154,37 @@ public:
 		return Property->Identical(GetValue(Data), GetDefaultValue(Defaults), PortFlags);
 	}
 
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+	// Values serialized as a single integer of their full size are saved as their raw bytes, modulo byte swapping
+	bool IsRawCopyable() const
+	{
+		return bSerializeAsInteger && GetSizeOf(IntType) == static_cast<uint32>(Property->ElementSize);
+	}
+
+	uint32 GetOffset() const
+	{
+		return Offset;
+	}
+
+	uint32 GetSize() const
+	{
+		return GetSizeOf(IntType);
+	}
+
+	void SwapBytes(uint8* Data) const
+	{
+		void* Value = GetValue(Data);
+		switch (IntType)
+		{
+			case EIntegerType::Uint8 : break;
+			case EIntegerType::Uint16: *reinterpret_cast<uint16*>(Value) = BYTESWAP_ORDER16(*reinterpret_cast<uint16*>(Value)); break;
+			case EIntegerType::Uint32: *reinterpret_cast<uint32*>(Value) = BYTESWAP_ORDER32(*reinterpret_cast<uint32*>(Value)); break;
+			case EIntegerType::Uint64: *reinterpret_cast<uint64*>(Value) = BYTESWAP_ORDER64(*reinterpret_cast<uint64*>(Value)); break;
+			default: UE_ASSUME(0);
+		}
+	}
+#endif
+
 private:
 	enum class EIntegerType : uint8 { Uint8, Uint16, Uint32, Uint64 };
 
@@ -279,6 +323,9 @@ private:
 struct FUnversionedStructSchema
 {
 	uint32 Num;
+	// Per serializer, the number of raw copyable values stored back to back in memory starting with it, 0 if it isn't raw copyable.
+	// Points past the end of Serializers in the same allocation.
+	const uint16* CopyRunNums;
 	FUnversionedPropertySerializer Serializers[0];
 
 	static FUnversionedStructSchema* Create(const UStruct* Struct)
@@ -295,11 +342,30 @@ struct FUnversionedStructSchema
 			}
 		}
 
-		uint32 Bytes = sizeof(FUnversionedStructSchema) + Serializers.Num() * sizeof(FUnversionedPropertySerializer);
+		uint32 Bytes = sizeof(FUnversionedStructSchema) + Serializers.Num() * (sizeof(FUnversionedPropertySerializer) + sizeof(uint16));
 		FUnversionedStructSchema* Schema = reinterpret_cast<FUnversionedStructSchema*>(FMemory::Malloc(Bytes, alignof(FUnversionedPropertySerializer)));
 		Schema->Num = Serializers.Num();
 		FMemory::Memcpy(Schema->Serializers, Serializers.GetData(), Serializers.Num() * sizeof(FUnversionedPropertySerializer));
 
+		uint16* CopyRunNums = reinterpret_cast<uint16*>(Schema->Serializers + Serializers.Num());
+		for (int32 Idx = Serializers.Num() - 1; Idx >= 0; --Idx)
+		{
+			const FUnversionedPropertySerializer& Serializer = Serializers[Idx];
+			if (!Serializer.IsRawCopyable())
+			{
+				CopyRunNums[Idx] = 0;
+			}
+			else if (Idx + 1 < Serializers.Num() && CopyRunNums[Idx + 1] > 0 && Serializer.GetOffset() + Serializer.GetSize() == Serializers[Idx + 1].GetOffset())
+			{
+				CopyRunNums[Idx] = static_cast<uint16>(FMath::Min<uint32>(CopyRunNums[Idx + 1] + 1u, MAX_uint16));
+			}
+			else
+			{
+				CopyRunNums[Idx] = 1;
+			}
+		}
+		Schema->CopyRunNums = CopyRunNums;
+
 		return Schema;
 	}
 };
@@ -395,6 +461,7 @@ struct FUnversionedSchemaRange
 		const FUnversionedStructSchema& Schema = GetOrCreateUnversionedSchema(Struct);
 		Begin = Schema.Serializers;
 		End = Schema.Serializers + Schema.Num;	
+		CopyRunNums = Schema.CopyRunNums;
 #else
 		Begin = FUnversionedSchemaIterator(Struct->PropertyLink);
 		// End is default-initialized
@@ -406,6 +473,9 @@ struct FUnversionedSchemaRange
 
 	FUnversionedSchemaIterator Begin;
 	FUnversionedSchemaIterator End;
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+	const uint16* CopyRunNums;
+#endif
 };
 
 // List of serialized property indices and which of them are non-zero.
@@ -566,6 +636,10 @@ public:
 	public:
 		FORCEINLINE FIterator(const FUnversionedHeader& Header, const FUnversionedSchemaRange& Schema)
 			: SchemaIt(Schema.Begin)
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+			, SchemaBegin(Schema.Begin)
+			, CopyRunNums(Schema.CopyRunNums)
+#endif
 			, ZeroMask(Header.ZeroMask)
 			, FragmentIt(Header.Fragments.GetData())
 			, bDone(!Header.HasValues())
@@ -615,8 +689,46 @@ public:
 			return !FragmentIt->bHasAnyZeroes || !ZeroMask[ZeroMaskIndex];
 		}
 
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+		// Number of raw copyable non-zero values stored back to back, starting with the current non-zero value, 0 if it isn't raw copyable
+		uint32 GetCopyRunNum() const
+		{
+			uint32 Num = FMath::Min<uint32>(CopyRunNums[SchemaIt - SchemaBegin], RemainingFragmentValues);
+			if (FragmentIt->bHasAnyZeroes)
+			{
+				for (uint32 Idx = 1; Idx < Num; ++Idx)
+				{
+					if (ZeroMask[ZeroMaskIndex + Idx])
+					{
+						return Idx;
+					}
+				}
+			}
+			return Num;
+		}
+
+		const FUnversionedPropertySerializer* GetSerializers() const
+		{
+			return SchemaIt;
+		}
+
+		// Moves past Num values of the current fragment
+		void Next(uint32 Num)
+		{
+			check(Num > 0 && Num <= RemainingFragmentValues);
+			SchemaIt += Num - 1;
+			RemainingFragmentValues -= Num - 1;
+			ZeroMaskIndex += FragmentIt->bHasAnyZeroes ? Num - 1 : 0;
+			Next();
+		}
+#endif
+
 	private:
 		FUnversionedSchemaIterator SchemaIt;
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+		FUnversionedSchemaIterator SchemaBegin;
+		const uint16* CopyRunNums;
+#endif
 		const FZeroMask& ZeroMask;
 		const FFragment* FragmentIt = nullptr;
 		bool bDone = false;
@@ -766,10 +878,72 @@ void DestroyUnversionedSchema(const UStruct* Struct)
 #endif
 }
 
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+
+// Serializes Num raw copyable values stored back to back in memory with a single call
+static void SerializeCopyRun(FStructuredArchive::FSlot Slot, uint8* Data, const FUnversionedPropertySerializer* Serializers, uint32 Num)
+{
+	const FUnversionedPropertySerializer& First = Serializers[0];
+	const FUnversionedPropertySerializer& Last = Serializers[Num - 1];
+	uint8* RunData = Data + First.GetOffset();
+	const uint32 RunSize = Last.GetOffset() + Last.GetSize() - First.GetOffset();
+
+	FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+	if (!UnderlyingArchive.IsByteSwapping())
+	{
+		Slot.Serialize(RunData, RunSize);
+	}
+	else if (UnderlyingArchive.IsLoading())
+	{
+		Slot.Serialize(RunData, RunSize);
+		for (uint32 Idx = 0; Idx < Num; ++Idx)
+		{
+			Serializers[Idx].SwapBytes(Data);
+		}
+	}
+	else
+	{
+		TArray<uint8, TInlineAllocator<256>> Swapped(RunData, RunSize);
+		uint8* SwappedData = Swapped.GetData() - First.GetOffset();
+		for (uint32 Idx = 0; Idx < Num; ++Idx)
+		{
+			Serializers[Idx].SwapBytes(SwappedData);
+		}
+		Slot.Serialize(Swapped.GetData(), RunSize);
+	}
+}
+
+#endif // CACHE_UNVERSIONED_PROPERTY_SCHEMA
+
+// Serializes the current non-zero value, or the run of raw copyable values it starts, and moves past them
+FORCEINLINE static void SerializeNonZeroValues(FUnversionedHeader::FIterator& It, FStructuredArchive::FStream ValueStream, uint8* Data, FDefaultStruct Defaults, bool bCopyRuns)
+{
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+	if (bCopyRuns)
+	{
+		const uint32 CopyRunNum = It.GetCopyRunNum();
+		if (CopyRunNum > 1)
+		{
+			SerializeCopyRun(ValueStream.EnterElement(), Data, It.GetSerializers(), CopyRunNum);
+			It.Next(CopyRunNum);
+			return;
+		}
+	}
+#endif
+
+	It.GetSerializer().Serialize(ValueStream.EnterElement(), Data, Defaults);
+	It.Next();
+}
+
 void SerializeUnversionedProperties(const UStruct* Struct, FStructuredArchive::FSlot Slot, uint8* Data, UStruct* DefaultsStruct, uint8* DefaultsData)
 {
 	FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
 	FStructuredArchive::FRecord StructRecord = Slot.EnterRecord();
+#if CACHE_UNVERSIONED_PROPERTY_SCHEMA
+	const bool bCopyRuns = GUnversionedPropertyCopyRuns && !UnderlyingArchive.IsTextFormat();
+#else
+	const bool bCopyRuns = false;
+#endif
 
 	if (UnderlyingArchive.IsLoading())
 	{
@@ -787,15 +961,16 @@ void SerializeUnversionedProperties(const UStruct* Struct, FStructuredArchive::F
 				FDefaultStruct Defaults(DefaultsData, DefaultsStruct);
 
 				FStructuredArchive::FStream ValueStream = StructRecord.EnterStream(SA_FIELD_NAME(TEXT("Values")));
-				for (FUnversionedHeader::FIterator It(Header, Schema); It; It.Next())
+				for (FUnversionedHeader::FIterator It(Header, Schema); It; )
 				{
 					if (It.IsNonZero())
 					{
-						It.GetSerializer().Serialize(ValueStream.EnterElement(), Data, Defaults);
+						SerializeNonZeroValues(It, ValueStream, Data, Defaults, bCopyRuns);
 					}
 					else
 					{
 						It.GetSerializer().LoadZero(Data);
+						It.Next();
 					}
 				}
 			}
@@ -841,11 +1016,15 @@ void SerializeUnversionedProperties(const UStruct* Struct, FStructuredArchive::F
 		if (Header.HasNonZeroValues())
 		{
 			FStructuredArchive::FStream ValueStream = StructRecord.EnterStream(SA_FIELD_NAME(TEXT("Values")));
-			for (FUnversionedHeader::FIterator It(Header, Schema); It; It.Next())
+			for (FUnversionedHeader::FIterator It(Header, Schema); It; )
 			{
 				if (It.IsNonZero())
 				{
-					It.GetSerializer().Serialize(ValueStream.EnterElement(), Data, Defaults);
+					SerializeNonZeroValues(It, ValueStream, Data, Defaults, bCopyRuns);
+				}
+				else
+				{
+					It.Next();
 				}
 			}
 		}
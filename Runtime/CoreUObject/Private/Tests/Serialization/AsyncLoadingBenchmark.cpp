@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AsyncLoadingBenchmark
+{
+	/**
+	 * Reads the packages of a load trace, one per line. Lines may be long package names or quoted filenames followed by an
+	 * open order, the format written by the file open order logs.
+	 */
+	static void ReadLoadTrace(const FString& TraceFilename, TArray<FString>& OutPackageNames)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *TraceFilename);
+
+		TSet<FString> SeenPackageNames;
+		for (FString& Line : Lines)
+		{
+			Line.TrimStartAndEndInline();
+			if (Line.StartsWith(TEXT("\"")))
+			{
+				const int32 EndQuoteIndex = Line.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1);
+				if (EndQuoteIndex == INDEX_NONE)
+				{
+					continue;
+				}
+				Line = Line.Mid(1, EndQuoteIndex - 1);
+			}
+			else
+			{
+				int32 SpaceIndex = INDEX_NONE;
+				if (Line.FindChar(TEXT(' '), SpaceIndex))
+				{
+					Line.LeftInline(SpaceIndex);
+				}
+			}
+
+			FString PackageName;
+			if (FPackageName::IsValidLongPackageName(Line))
+			{
+				PackageName = Line;
+			}
+			else if (!FPackageName::TryConvertFilenameToLongPackageName(Line, PackageName))
+			{
+				continue;
+			}
+
+			bool bAlreadySeen = false;
+			SeenPackageNames.Add(PackageName, &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				OutPackageNames.Add(MoveTemp(PackageName));
+			}
+		}
+	}
+}
+
+/**
+ * Loads every package of a load trace with LoadPackageAsync and reports the throughput in packages per second.
+ * The trace is given with -AsyncLoadingBenchmarkTrace=<file>.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLoadingBenchmarkTest, "System.CoreUObject.Serialization.AsyncLoadingBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FAsyncLoadingBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace AsyncLoadingBenchmark;
+
+	FString TraceFilename;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("-AsyncLoadingBenchmarkTrace="), TraceFilename))
+	{
+		AddWarning(TEXT("No load trace given, pass -AsyncLoadingBenchmarkTrace=<file> to run the benchmark"));
+		return true;
+	}
+
+	TArray<FString> PackageNames;
+	ReadLoadTrace(TraceFilename, PackageNames);
+
+	// Packages that are already in memory would be skipped by the loader and inflate the throughput
+	PackageNames.RemoveAll([](const FString& PackageName)
+	{
+		return FindObject<UPackage>(nullptr, *PackageName) != nullptr;
+	});
+	if (!TestTrue(FString::Printf(TEXT("The load trace %s lists packages that are not loaded yet"), *TraceFilename), PackageNames.Num() > 0))
+	{
+		return false;
+	}
+
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (const FString& PackageName : PackageNames)
+	{
+		LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda(
+			[&NumSucceeded, &NumFailed](const FName&, UPackage*, EAsyncLoadingResult::Type Result)
+			{
+				++(Result == EAsyncLoadingResult::Succeeded ? NumSucceeded : NumFailed);
+			}));
+	}
+	FlushAsyncLoading();
+	const double LoadTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Every requested package completed"), NumSucceeded + NumFailed, PackageNames.Num());
+	AddInfo(FString::Printf(TEXT("Loaded %d packages (%d failed) in %.3f s: %.1f packages/s, multithreaded loading: %s"),
+		NumSucceeded, NumFailed, LoadTime, NumSucceeded / FMath::Max(LoadTime, SMALL_NUMBER), IsAsyncLoadingMultithreaded() ? TEXT("true") : TEXT("false")));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
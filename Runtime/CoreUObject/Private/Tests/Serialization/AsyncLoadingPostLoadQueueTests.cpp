@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Serialization/AsyncLoadingPostLoadQueue.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AsyncLoadingPostLoadQueueTest
+{
+	typedef TAsyncLoadPostLoadQueue<int32> FQueue;
+
+	/** Pops every entry at time Now and returns their nodes in order */
+	static TArray<int32> PopAll(FQueue& Queue, double Now)
+	{
+		TArray<int32> Nodes;
+		FQueue::FEntry Entry;
+		while (Queue.Pop(Now, Entry))
+		{
+			Nodes.Add(Entry.Node);
+		}
+		return Nodes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLoadingPostLoadQueueOrderTest, "System.CoreUObject.Serialization.AsyncLoadingPostLoadQueue.Order", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FAsyncLoadingPostLoadQueueOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace AsyncLoadingPostLoadQueueTest;
+
+	// Before any deadline, higher priorities run first, then earlier deadlines, then the order the nodes were added in
+	{
+		FQueue Queue;
+		Queue.Push(0, 0, 10.0);
+		Queue.Push(1, 5, 12.0);
+		Queue.Push(2, 5, 11.0);
+		Queue.Push(3, 0, 10.0);
+		Queue.Push(4, 100, 20.0);
+		TestEqual(TEXT("Waiting entries are counted"), Queue.Num(), 5);
+		TestEqual(TEXT("Entries run by priority, deadline and arrival"), PopAll(Queue, 0.0), TArray<int32>({ 4, 2, 1, 0, 3 }));
+		TestTrue(TEXT("Popping every entry empties the queue"), Queue.IsEmpty());
+	}
+
+	// Overdue entries run ahead of every other one, oldest deadline first regardless of their priority
+	{
+		FQueue Queue;
+		Queue.Push(0, 100, 20.0);
+		Queue.Push(1, 0, 11.0);
+		Queue.Push(2, 1, 10.0);
+		Queue.Push(3, 50, 30.0);
+		TestEqual(TEXT("Overdue entries run first, oldest first"), PopAll(Queue, 15.0), TArray<int32>({ 2, 1, 0, 3 }));
+	}
+
+	// An entry that becomes overdue while waiting overtakes higher priorities
+	{
+		FQueue Queue;
+		Queue.Push(0, 0, 10.0);
+		Queue.Push(1, 100, 20.0);
+		FQueue::FEntry Entry;
+		TestTrue(TEXT("An entry is popped"), Queue.Pop(5.0, Entry));
+		TestEqual(TEXT("Before its deadline the low priority entry waits"), Entry.Node, 1);
+		Queue.Push(2, 100, 30.0);
+		TestTrue(TEXT("An entry is popped"), Queue.Pop(10.0, Entry));
+		TestEqual(TEXT("At its deadline the low priority entry runs"), Entry.Node, 0);
+	}
+
+	// Random pushes and pops match a linear scan for the most urgent entry
+	{
+		FQueue Queue;
+		TArray<FQueue::FEntry> Expected;
+		FRandomStream Random(0x5eed);
+		uint64 NextSequence = 0;
+		double Now = 0.0;
+		bool bMatches = true;
+		for (int32 Step = 0; Step < 20000 && bMatches; ++Step)
+		{
+			Now += Random.FRandRange(0.0f, 0.01f);
+			if (Random.FRand() < 0.55f)
+			{
+				const FQueue::FEntry Entry{ Step, Random.RandRange(0, 4), Now + Random.FRandRange(0.0f, 2.0f), NextSequence++ };
+				Queue.Push(Entry.Node, Entry.Priority, Entry.Deadline);
+				Expected.Add(Entry);
+			}
+			else if (Expected.Num() > 0)
+			{
+				int32 MostUrgent = 0;
+				for (int32 Index = 1; Index < Expected.Num(); ++Index)
+				{
+					if (FQueue::IsMoreUrgent(Expected[Index], Expected[MostUrgent], Now))
+					{
+						MostUrgent = Index;
+					}
+				}
+				FQueue::FEntry Entry;
+				bMatches = Queue.Pop(Now, Entry) && Entry.Node == Expected[MostUrgent].Node;
+				Expected.RemoveAtSwap(MostUrgent);
+
+				// Put some entries back as if they yielded
+				if (bMatches && Random.FRand() < 0.25f)
+				{
+					Queue.PushEntry(Entry);
+					Expected.Add(Entry);
+				}
+			}
+			bMatches = bMatches && Queue.Num() == Expected.Num();
+		}
+		TestTrue(TEXT("The heaps agree with a linear scan"), bMatches);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLoadingPostLoadQueueYieldTest, "System.CoreUObject.Serialization.AsyncLoadingPostLoadQueue.YieldAndResume", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FAsyncLoadingPostLoadQueueYieldTest::RunTest(const FString& Parameters)
+{
+	using namespace AsyncLoadingPostLoadQueueTest;
+
+	FQueue Queue;
+	Queue.Push(0, 0, 100.0);
+	Queue.Push(1, 0, 100.0);
+	FQueue::FEntry Executing;
+	TestTrue(TEXT("An entry is popped"), Queue.Pop(0.0, Executing));
+	TestEqual(TEXT("The first of equally urgent entries runs first"), Executing.Node, 0);
+	Queue.BeginExecuting();
+
+	// Equally urgent waiting entries do not interrupt, and the clock is only read every few objects
+	int32 NumClockReads = 0;
+	auto GetNow = [&NumClockReads]()
+	{
+		++NumClockReads;
+		return 0.0;
+	};
+	bool bYielded = false;
+	for (int32 Object = 0; Object < 4 * FQueue::ObjectsPerYieldCheck; ++Object)
+	{
+		bYielded |= Queue.ShouldYield(Executing, GetNow);
+	}
+	TestFalse(TEXT("Equally urgent entries do not interrupt"), bYielded);
+	TestEqual(TEXT("The clock is read once per check"), NumClockReads, 4);
+
+	// A more urgent entry interrupts at the next check
+	Queue.Push(2, 10, 100.0);
+	Queue.BeginExecuting();
+	int32 NumObjectsBeforeYield = 0;
+	while (!Queue.ShouldYield(Executing, GetNow) && NumObjectsBeforeYield < 2 * FQueue::ObjectsPerYieldCheck)
+	{
+		++NumObjectsBeforeYield;
+	}
+	TestEqual(TEXT("A more urgent entry interrupts within one check"), NumObjectsBeforeYield, FQueue::ObjectsPerYieldCheck - 1);
+
+	// The interrupted entry goes back, runs after the more urgent one and ahead of the equally urgent one that arrived after it
+	Queue.PushEntry(Executing);
+	TestEqual(TEXT("The interrupted entry resumes before later equally urgent entries"), PopAll(Queue, 0.0), TArray<int32>({ 2, 0, 1 }));
+
+	// An entry past its deadline interrupts a higher priority one
+	Queue.Push(3, 0, 5.0);
+	Queue.Push(4, 10, 100.0);
+	TestTrue(TEXT("An entry is popped"), Queue.Pop(0.0, Executing));
+	TestEqual(TEXT("The high priority entry runs first"), Executing.Node, 4);
+	Queue.BeginExecuting();
+	double Now = 0.0;
+	bYielded = false;
+	for (int32 Object = 0; Object < FQueue::ObjectsPerYieldCheck; ++Object)
+	{
+		bYielded |= Queue.ShouldYield(Executing, [&Now]() { return Now; });
+	}
+	TestFalse(TEXT("Before its deadline the low priority entry waits"), bYielded);
+	Now = 5.0;
+	for (int32 Object = 0; Object < FQueue::ObjectsPerYieldCheck; ++Object)
+	{
+		bYielded |= Queue.ShouldYield(Executing, [&Now]() { return Now; });
+	}
+	TestTrue(TEXT("At its deadline the low priority entry interrupts"), bYielded);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
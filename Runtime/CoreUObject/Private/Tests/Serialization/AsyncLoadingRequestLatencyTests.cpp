@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/AsyncLoadingRequestLatency.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Checks that request latencies land in the histogram of their priority, and that requests which were never begun are ignored.
+ * Uses request ids far below the ones handed out by the loaders so it can run while packages are loading.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLoadingRequestLatencyTest, "System.CoreUObject.Serialization.AsyncLoadingRequestLatency", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FAsyncLoadingRequestLatencyTest::RunTest(const FString& Parameters)
+{
+	FAsyncLoadingRequestLatency& Latency = FAsyncLoadingRequestLatency::Get();
+
+	const int32 FirstRequestID = MIN_int32 + 16;
+	const int32 NumHighPriorityRequests = 3;
+	const int32 NumNormalPriorityRequests = 5;
+
+	const int64 HighPriorityCountBefore = Latency.GetHistogram(true).GetNumMeasurements();
+	const int64 NormalPriorityCountBefore = Latency.GetHistogram(false).GetNumMeasurements();
+	const int32 PendingBefore = Latency.GetNumPendingRequests();
+
+	for (int32 Index = 0; Index < NumHighPriorityRequests + NumNormalPriorityRequests; ++Index)
+	{
+		const int32 Priority = Index < NumHighPriorityRequests ? FAsyncLoadingRequestLatency::HighPriorityThreshold + 1 : FAsyncLoadingRequestLatency::HighPriorityThreshold;
+		Latency.BeginRequest(FirstRequestID + Index, Priority);
+	}
+	TestEqual(TEXT("Begun requests are pending"), Latency.GetNumPendingRequests(), PendingBefore + NumHighPriorityRequests + NumNormalPriorityRequests);
+
+	for (int32 Index = 0; Index < NumHighPriorityRequests + NumNormalPriorityRequests; ++Index)
+	{
+		Latency.EndRequest(FirstRequestID + Index);
+	}
+	// Ending a request twice, or one that was never begun, records nothing
+	Latency.EndRequest(FirstRequestID);
+	Latency.EndRequest(FirstRequestID - 1);
+
+	TestEqual(TEXT("Ended requests are no longer pending"), Latency.GetNumPendingRequests(), PendingBefore);
+	TestEqual(TEXT("High priority latencies are recorded"), Latency.GetHistogram(true).GetNumMeasurements(), HighPriorityCountBefore + NumHighPriorityRequests);
+	TestEqual(TEXT("Normal priority latencies are recorded"), Latency.GetHistogram(false).GetNumMeasurements(), NormalPriorityCountBefore + NumNormalPriorityRequests);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
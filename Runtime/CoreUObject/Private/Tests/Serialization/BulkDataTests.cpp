@@ -1,6 +1,11 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
 #include "Serialization/BulkData.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -81,6 +86,416 @@ namespace BulkDataTest
 
 		return true;
 	}	
+
+	/** Writes a file of recognizable bytes for the range requests to read, returning an empty filename if it could not be written */
+	static FString CreateTestFile(TArray<uint8>& OutFileData)
+	{
+		OutFileData.SetNumUninitialized(256 * 1024);
+		for (int32 Index = 0; Index < OutFileData.Num(); ++Index)
+		{
+			OutFileData[Index] = (uint8)(Index * 31 + (Index >> 8));
+		}
+
+		const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("BulkDataRangeRequest"));
+		return FFileHelper::SaveArrayToFile(OutFileData, *Filename) ? Filename : FString();
+	}
+
+	static bool MatchesFile(const FIoBuffer& Buffer, const TArray<uint8>& FileData, int64 OffsetInFile, int64 Size)
+	{
+		return Buffer.DataSize() == Size && FMemory::Memcmp(Buffer.Data(), FileData.GetData() + OffsetInFile, Size) == 0;
+	}
+
+	/** Whether the platform file can map the file at all, regardless of whether the platform wants files to be mapped */
+	static bool CanMapFile(const FString& Filename)
+	{
+		TUniquePtr<IMappedFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+		return Handle.IsValid();
+	}
+
+	// Test the request behind IBulkDataRangeRequest on a file, see FBulkDataCreateRangeRequestTest for the BulkData objects making them.
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataTestRangeRequest, TEST_NAME_ROOT ".RangeRequest", TestFlags)
+	bool FBulkDataTestRangeRequest::RunTest(const FString& Parameters)
+	{
+		TArray<uint8> FileData;
+		const FString Filename = CreateTestFile(FileData);
+		if (Filename.IsEmpty())
+		{
+			AddError(TEXT("Failed to write the test file"));
+			return false;
+		}
+
+		const int64 RangeOffset = 64 * 1024 + 3;
+		const int64 RangeSize = 100 * 1024;
+
+		// Reading into memory allocated by the request, which the buffer owns and keeps alive after the request is deleted
+		{
+			bool bCallbackSucceeded = false;
+			FBulkDataRangeRequestCallBack Callback = [&bCallbackSucceeded](bool bWasCancelled, IBulkDataRangeRequest* Request)
+			{
+				bCallbackSucceeded = !bWasCancelled && Request->GetResult().IsOk();
+			};
+
+			FIoBuffer Buffer;
+			{
+				FBulkDataRangeRequest Request(&Callback);
+				TestTrue(TEXT("Reading a range of a file should issue a request"), Request.ReadRange(Filename, RangeOffset, RangeSize, AIOP_Normal, nullptr));
+				TestTrue(TEXT("Waiting on a range request without a time limit should complete it"), Request.WaitCompletion());
+				TestTrue(TEXT("The callback of a range request should be invoked with its result"), bCallbackSucceeded);
+				TestFalse(TEXT("A range that was read should not be memory mapped"), Request.IsMemoryMapped());
+
+				TIoStatusOr<FIoBuffer> Result = Request.GetResult();
+				TestTrue(TEXT("Reading a range of a file should succeed"), Result.IsOk());
+				if (Result.IsOk())
+				{
+					Buffer = Result.ConsumeValueOrDie();
+				}
+			}
+
+			TestTrue(TEXT("A range read into memory allocated by the request should be owned by its buffer"), Buffer.IsMemoryOwned());
+			TestTrue(TEXT("A range read into memory allocated by the request should match the file"), MatchesFile(Buffer, FileData, RangeOffset, RangeSize));
+		}
+
+		// Reading into memory supplied by the caller, which the buffer is a view of
+		{
+			TArray<uint8> UserMemory;
+			UserMemory.SetNumZeroed(RangeSize);
+
+			FBulkDataRangeRequest Request(nullptr);
+			TestTrue(TEXT("Reading a range of a file should issue a request"), Request.ReadRange(Filename, RangeOffset, RangeSize, AIOP_Normal, UserMemory.GetData()));
+			Request.WaitCompletion();
+
+			TIoStatusOr<FIoBuffer> Result = Request.GetResult();
+			TestTrue(TEXT("Reading a range of a file into supplied memory should succeed"), Result.IsOk());
+			if (Result.IsOk())
+			{
+				const FIoBuffer& Buffer = Result.ValueOrDie();
+				TestTrue(TEXT("A range read into supplied memory should be a view of it"), Buffer.Data() == UserMemory.GetData() && !Buffer.IsMemoryOwned());
+				TestTrue(TEXT("A range read into supplied memory should match the file"), MatchesFile(Buffer, FileData, RangeOffset, RangeSize));
+			}
+		}
+
+		// Mapping, which works wherever the platform file can map files even if the platform does not map them by default
+		{
+			const bool bCanMapFile = CanMapFile(Filename);
+
+			FBulkDataRangeRequest Request(nullptr);
+			const bool bMapped = Request.MapRange(Filename, RangeOffset, RangeSize);
+			TestEqual(TEXT("A range should be mapped exactly when the platform file can map the file"), bMapped, bCanMapFile);
+			if (bMapped)
+			{
+				TestTrue(TEXT("Waiting on a mapped range should complete it once it is paged in"), Request.WaitCompletion());
+				TestTrue(TEXT("A mapped range should be reported as memory mapped"), Request.IsMemoryMapped());
+
+				TIoStatusOr<FIoBuffer> Result = Request.GetResult();
+				TestTrue(TEXT("Mapping a range of a file should succeed"), Result.IsOk());
+				if (Result.IsOk())
+				{
+					const FIoBuffer& Buffer = Result.ValueOrDie();
+					TestFalse(TEXT("A mapped range should be a view of the mapping"), Buffer.IsMemoryOwned());
+					TestTrue(TEXT("A mapped range should match the file"), MatchesFile(Buffer, FileData, RangeOffset, RangeSize));
+				}
+			}
+			else
+			{
+				TestFalse(TEXT("A range that could not be mapped should not be issued"), Request.IsMemoryMapped());
+			}
+		}
+
+		// Canceling before the range is read or mapped, which always completes the request as canceled
+		for (int32 bMap = 0; bMap < 2; ++bMap)
+		{
+			bool bCallbackWasCancelled = false;
+			FBulkDataRangeRequestCallBack Callback = [&bCallbackWasCancelled](bool bWasCancelled, IBulkDataRangeRequest* Request)
+			{
+				bCallbackWasCancelled = bWasCancelled;
+			};
+
+			FBulkDataRangeRequest Request(&Callback);
+			Request.Cancel();
+			const bool bIssued = bMap ? Request.MapRange(Filename, RangeOffset, RangeSize) : Request.ReadRange(Filename, RangeOffset, RangeSize, AIOP_Normal, nullptr);
+			if (bIssued)
+			{
+				TestTrue(TEXT("Waiting on a canceled range request should complete it"), Request.WaitCompletion());
+				TestTrue(TEXT("The callback of a canceled range request should report the cancellation"), bCallbackWasCancelled);
+
+				TIoStatusOr<FIoBuffer> Result = Request.GetResult();
+				TestEqual(TEXT("A range request canceled before it was issued should complete as canceled"), Result.Status().GetErrorCode(), EIoErrorCode::Cancelled);
+			}
+			else
+			{
+				TestTrue(TEXT("Only mapping should fail to issue, where the platform file cannot map the file"), bMap && !CanMapFile(Filename));
+			}
+		}
+
+		IFileManager::Get().Delete(*Filename);
+
+		return true;
+	}
+
+	/**
+	 * Streams a file in chunks the way streamed audio does, keeping a window of chunks loaded while it plays, and returns the
+	 * peak number of heap bytes the loaded chunks held. Chunks that were mapped are views of the mapping and hold no heap memory.
+	 */
+	static int64 StreamChunks(FAutomationTestBase& Test, const FString& Filename, const TArray<uint8>& FileData, bool bMapChunks)
+	{
+		const int64 ChunkSize = 32 * 1024;
+		const int32 NumLoadedChunks = 3;
+
+		TArray<TUniquePtr<FBulkDataRangeRequest>> LoadedRequests;
+		TArray<FIoBuffer> LoadedChunks;
+		int64 HeapBytes = 0;
+		int64 PeakHeapBytes = 0;
+
+		for (int64 OffsetInFile = 0; OffsetInFile + ChunkSize <= FileData.Num(); OffsetInFile += ChunkSize)
+		{
+			if (LoadedChunks.Num() == NumLoadedChunks)
+			{
+				HeapBytes -= LoadedChunks[0].IsMemoryOwned() ? (int64)LoadedChunks[0].DataSize() : 0;
+				LoadedChunks.RemoveAt(0);
+				LoadedRequests.RemoveAt(0);
+			}
+
+			// Mapped requests own their mapping, so they are kept for as long as their chunk is loaded
+			TUniquePtr<FBulkDataRangeRequest> Request = MakeUnique<FBulkDataRangeRequest>(nullptr);
+			const bool bIssued = bMapChunks ? Request->MapRange(Filename, OffsetInFile, ChunkSize) : Request->ReadRange(Filename, OffsetInFile, ChunkSize, AIOP_Normal, nullptr);
+			if (!bIssued || !Request->WaitCompletion())
+			{
+				Test.AddError(FString::Printf(TEXT("Failed to %s the chunk at offset %lld"), bMapChunks ? TEXT("map") : TEXT("read"), OffsetInFile));
+				return -1;
+			}
+
+			TIoStatusOr<FIoBuffer> Result = Request->GetResult();
+			if (!Result.IsOk() || !MatchesFile(Result.ValueOrDie(), FileData, OffsetInFile, ChunkSize))
+			{
+				Test.AddError(FString::Printf(TEXT("The chunk at offset %lld does not match the file"), OffsetInFile));
+				return -1;
+			}
+
+			FIoBuffer& Chunk = LoadedChunks.Add_GetRef(Result.ConsumeValueOrDie());
+			LoadedRequests.Add(MoveTemp(Request));
+			HeapBytes += Chunk.IsMemoryOwned() ? (int64)Chunk.DataSize() : 0;
+			PeakHeapBytes = FMath::Max(PeakHeapBytes, HeapBytes);
+		}
+
+		return PeakHeapBytes;
+	}
+
+	// Compare the peak heap memory of streaming chunks that are read with streaming chunks that are mapped, as au.MemoryMapStreamedChunks does.
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataTestRangeRequestPeakMemory, TEST_NAME_ROOT ".RangeRequestPeakMemory", TestFlags)
+	bool FBulkDataTestRangeRequestPeakMemory::RunTest(const FString& Parameters)
+	{
+		TArray<uint8> FileData;
+		const FString Filename = CreateTestFile(FileData);
+		if (Filename.IsEmpty())
+		{
+			AddError(TEXT("Failed to write the test file"));
+			return false;
+		}
+
+		const int64 ReadPeakHeapBytes = StreamChunks(*this, Filename, FileData, false);
+		AddInfo(FString::Printf(TEXT("Peak heap memory of read chunks: %lld bytes"), ReadPeakHeapBytes));
+		TestTrue(TEXT("Chunks that are read should hold heap memory while they are loaded"), ReadPeakHeapBytes > 0);
+
+		if (CanMapFile(Filename))
+		{
+			const int64 MappedPeakHeapBytes = StreamChunks(*this, Filename, FileData, true);
+			AddInfo(FString::Printf(TEXT("Peak heap memory of mapped chunks: %lld bytes"), MappedPeakHeapBytes));
+			TestEqual(TEXT("Chunks that are mapped should not hold any heap memory while they are loaded"), MappedPeakHeapBytes, (int64)0);
+		}
+		else
+		{
+			AddInfo(TEXT("Skipped streaming mapped chunks as the platform file cannot map files"));
+		}
+
+		IFileManager::Get().Delete(*Filename);
+
+		return true;
+	}
+}
+
+// Defined in BulkData2.cpp, where FBulkDataBase::Serialize registers the file of the package being loaded
+namespace FileTokenSystem
+{
+	FBulkDataOrId::FileToken RegisterFileToken(const FName& PackageName, const FString& Filename);
+}
+
+/** Tests CreateRangeRequest of both BulkData systems, which it is a friend of so it can point them at a file without a package */
+class FBulkDataCreateRangeRequestTest : public FAutomationTestBase
+{
+public:
+	using FAutomationTestBase::FAutomationTestBase;
+
+	/** The BulkData of the legacy system, used in editor builds */
+	void TestUntypedBulkData();
+	/** The BulkData used in cooked builds, reading from loose or pak files */
+	void TestBulkDataBase();
+	/** The BulkData used in cooked builds, reading from IoStore containers */
+	void TestBulkDataBaseWithIoDispatcher();
+
+	bool CreateTestFile();
+	void DeleteTestFile();
+
+private:
+	void TestCreateRangeRequests(const TCHAR* What, TFunctionRef<IBulkDataRangeRequest* (int64, int64, FBulkDataRangeRequestCallBack*, uint8*, bool)> CreateRangeRequest);
+
+	TArray<uint8> FileData;
+	FString Filename;
+
+	static constexpr int64 PayloadOffset = 16 * 1024 + 5;
+	static constexpr int64 PayloadSize = 128 * 1024;
+};
+
+bool FBulkDataCreateRangeRequestTest::CreateTestFile()
+{
+	Filename = BulkDataTest::CreateTestFile(FileData);
+	if (Filename.IsEmpty())
+	{
+		AddError(TEXT("Failed to write the test file"));
+		return false;
+	}
+	return true;
+}
+
+void FBulkDataCreateRangeRequestTest::DeleteTestFile()
+{
+	IFileManager::Get().Delete(*Filename);
+	Filename.Empty();
+}
+
+void FBulkDataCreateRangeRequestTest::TestUntypedBulkData()
+{
+	FByteBulkDataOld BulkData;
+	FUntypedBulkData& UntypedBulkData = BulkData;
+	UntypedBulkData.Filename = Filename;
+	UntypedBulkData.BulkDataOffsetInFile = PayloadOffset;
+	UntypedBulkData.BulkDataSizeOnDisk = PayloadSize;
+	UntypedBulkData.ElementCount = PayloadSize / BulkData.GetElementSize();
+
+	TestCreateRangeRequests(TEXT("FUntypedBulkData"), [&BulkData](int64 Offset, int64 Size, FBulkDataRangeRequestCallBack* Callback, uint8* UserMemory, bool bAllowMemoryMapping)
+	{
+		return BulkData.CreateRangeRequest(Offset, Size, AIOP_Normal, Callback, UserMemory, bAllowMemoryMapping);
+	});
+}
+
+void FBulkDataCreateRangeRequestTest::TestBulkDataBase()
+{
+	FBulkDataBase BulkData;
+	BulkData.Data.Token = FileTokenSystem::RegisterFileToken(FName(TEXT("/Temp/BulkDataCreateRangeRequest")), Filename);
+	BulkData.BulkDataOffset = PayloadOffset;
+	BulkData.BulkDataSize = PayloadSize;
+
+	TestCreateRangeRequests(TEXT("FBulkDataBase"), [&BulkData](int64 Offset, int64 Size, FBulkDataRangeRequestCallBack* Callback, uint8* UserMemory, bool bAllowMemoryMapping)
+	{
+		return BulkData.CreateRangeRequest(Offset, Size, AIOP_Normal, Callback, UserMemory, bAllowMemoryMapping);
+	});
+}
+
+void FBulkDataCreateRangeRequestTest::TestBulkDataBaseWithIoDispatcher()
+{
+	if (FBulkDataBase::GetIoDispatcher() == nullptr)
+	{
+		AddInfo(TEXT("Skipped IoStore range requests as BulkData is not loaded with the IoDispatcher, see System.Core.IO.IoDispatcher.Cancel for its cancellation"));
+		return;
+	}
+
+	// A package id no container has a chunk for, so the request always fails the same way
+	FBulkDataBase BulkData;
+	BulkData.Data.PackageID = MAX_uint64 - 1;
+	BulkData.BulkDataOffset = 0;
+	BulkData.BulkDataSize = PayloadSize;
+	BulkData.SetRuntimeBulkDataFlags(BULKDATA_UsesIoDispatcher);
+
+	bool bCallbackWasCancelled = false;
+	FBulkDataRangeRequestCallBack Callback = [&bCallbackWasCancelled](bool bWasCancelled, IBulkDataRangeRequest* Request)
+	{
+		bCallbackWasCancelled = bWasCancelled;
+	};
+
+	TUniquePtr<IBulkDataRangeRequest> Request(BulkData.CreateRangeRequest(0, PayloadSize, AIOP_Normal, &Callback, nullptr, true));
+	if (TestNotNull(TEXT("FBulkDataBase: A range of an IoStore payload should always make a request"), Request.Get()))
+	{
+		Request->WaitCompletion();
+		TestFalse(TEXT("FBulkDataBase: Only IoStore payloads cooked to be memory mapped should be mapped"), Request->IsMemoryMapped());
+		TestTrue(TEXT("FBulkDataBase: The callback of a failed range request should report it as canceled"), bCallbackWasCancelled);
+		TestEqual(TEXT("FBulkDataBase: A range of a chunk that is not mounted should not be found"), Request->GetResult().Status().GetErrorCode(), EIoErrorCode::NotFound);
+	}
+}
+
+void FBulkDataCreateRangeRequestTest::TestCreateRangeRequests(const TCHAR* What, TFunctionRef<IBulkDataRangeRequest* (int64, int64, FBulkDataRangeRequestCallBack*, uint8*, bool)> CreateRangeRequest)
+{
+	const int64 RangeOffset = 4 * 1024 + 1;
+	const int64 RangeSize = 64 * 1024;
+
+	bool bCallbackSucceeded = false;
+	FBulkDataRangeRequestCallBack Callback = [&bCallbackSucceeded](bool bWasCancelled, IBulkDataRangeRequest* Request)
+	{
+		bCallbackSucceeded = !bWasCancelled && Request->GetResult().IsOk();
+	};
+
+	// Offsets are relative to the payload, whichever way the range ends up being loaded
+	{
+		TUniquePtr<IBulkDataRangeRequest> Request(CreateRangeRequest(RangeOffset, RangeSize, &Callback, nullptr, false));
+		if (!TestNotNull(FString::Printf(TEXT("%s: Reading a range should make a request"), What), Request.Get()))
+		{
+			return;
+		}
+		Request->WaitCompletion();
+		TestTrue(FString::Printf(TEXT("%s: The callback of a range request should be invoked with its result"), What), bCallbackSucceeded);
+		TestFalse(FString::Printf(TEXT("%s: A range that may not be mapped should be read"), What), Request->IsMemoryMapped());
+
+		TIoStatusOr<FIoBuffer> Result = Request->GetResult();
+		TestTrue(FString::Printf(TEXT("%s: A range read into memory allocated by the request should match the payload"), What), Result.IsOk() && BulkDataTest::MatchesFile(Result.ValueOrDie(), FileData, PayloadOffset + RangeOffset, RangeSize));
+	}
+
+	{
+		TArray<uint8> UserMemory;
+		UserMemory.SetNumZeroed(RangeSize);
+
+		TUniquePtr<IBulkDataRangeRequest> Request(CreateRangeRequest(RangeOffset, RangeSize, nullptr, UserMemory.GetData(), true));
+		if (!TestNotNull(FString::Printf(TEXT("%s: Reading a range into supplied memory should make a request"), What), Request.Get()))
+		{
+			return;
+		}
+		Request->WaitCompletion();
+		TestFalse(FString::Printf(TEXT("%s: A range read into supplied memory should never be mapped"), What), Request->IsMemoryMapped());
+
+		TIoStatusOr<FIoBuffer> Result = Request->GetResult();
+		TestTrue(FString::Printf(TEXT("%s: A range read into supplied memory should be a view of it"), What), Result.IsOk() && Result.ValueOrDie().Data() == UserMemory.GetData());
+		TestTrue(FString::Printf(TEXT("%s: A range read into supplied memory should match the payload"), What), BulkDataTest::MatchesFile(FIoBuffer(FIoBuffer::Wrap, UserMemory.GetData(), RangeSize), FileData, PayloadOffset + RangeOffset, RangeSize));
+	}
+
+	// Allowing mapping only maps on platforms that want files to be mapped, the range is read otherwise
+	{
+		const bool bExpectMapped = FPlatformProperties::SupportsMemoryMappedFiles() && BulkDataTest::CanMapFile(Filename);
+
+		TUniquePtr<IBulkDataRangeRequest> Request(CreateRangeRequest(RangeOffset, RangeSize, nullptr, nullptr, true));
+		if (!TestNotNull(FString::Printf(TEXT("%s: A range that may be mapped should make a request"), What), Request.Get()))
+		{
+			return;
+		}
+		Request->WaitCompletion();
+		TestEqual(FString::Printf(TEXT("%s: A range that may be mapped should be mapped exactly when the platform maps files"), What), Request->IsMemoryMapped(), bExpectMapped);
+
+		TIoStatusOr<FIoBuffer> Result = Request->GetResult();
+		TestTrue(FString::Printf(TEXT("%s: A range that may be mapped should match the payload"), What), Result.IsOk() && BulkDataTest::MatchesFile(Result.ValueOrDie(), FileData, PayloadOffset + RangeOffset, RangeSize));
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FBulkDataCreateRangeRequestTestRunner, FBulkDataCreateRangeRequestTest, TEST_NAME_ROOT ".CreateRangeRequest", BulkDataTest::TestFlags)
+bool FBulkDataCreateRangeRequestTestRunner::RunTest(const FString& Parameters)
+{
+	if (!CreateTestFile())
+	{
+		return false;
+	}
+
+	TestUntypedBulkData();
+	TestBulkDataBase();
+	TestBulkDataBaseWithIoDispatcher();
+
+	DeleteTestFile();
+
+	return !HasAnyErrors();
 }
 
 #endif // WITH_DEV_AUTOMATION_TESTS
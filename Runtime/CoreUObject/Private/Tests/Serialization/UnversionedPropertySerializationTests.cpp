@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/UnversionedPropertySerialization.h"
+#include "UObject/Class.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnversionedPropertySerializationTest
+{
+	static const int32 NumInstances = 100000;
+
+	/** Saves every instance through one unversioned structured archive */
+	template<typename T>
+	static void SaveInstances(UScriptStruct* Struct, TArray<T>& Instances, TArray<uint8>& OutData)
+	{
+		FMemoryWriter Writer(OutData);
+		Writer.SetUseUnversionedPropertySerialization(true);
+		FBinaryArchiveFormatter Formatter(Writer);
+		FStructuredArchive StructuredArchive(Formatter);
+		FStructuredArchive::FStream Stream = StructuredArchive.Open().EnterStream();
+		for (T& Instance : Instances)
+		{
+			Struct->SerializeTaggedProperties(Stream.EnterElement(), reinterpret_cast<uint8*>(&Instance), Struct, nullptr);
+		}
+	}
+
+	template<typename T>
+	static void LoadInstances(UScriptStruct* Struct, const TArray<uint8>& Data, TArray<T>& OutInstances)
+	{
+		FMemoryReader Reader(Data);
+		Reader.SetUseUnversionedPropertySerialization(true);
+		FBinaryArchiveFormatter Formatter(Reader);
+		FStructuredArchive StructuredArchive(Formatter);
+		FStructuredArchive::FStream Stream = StructuredArchive.Open().EnterStream();
+		for (T& Instance : OutInstances)
+		{
+			Struct->SerializeTaggedProperties(Stream.EnterElement(), reinterpret_cast<uint8*>(&Instance), Struct, nullptr);
+		}
+	}
+
+	/**
+	 * Round trips instances of a struct with and without copy runs.
+	 * Both paths must produce the same bytes and load the same values, and the time of each is reported.
+	 */
+	template<typename T>
+	static void TestStruct(FAutomationTestBase& Test, const TCHAR* Name, UScriptStruct* Struct, TFunctionRef<T(int32)> MakeInstance)
+	{
+		IConsoleVariable* CopyRunsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("s.UnversionedPropertySerialization.CopyRuns"));
+		const int32 PreviousCopyRuns = CopyRunsCVar ? CopyRunsCVar->GetInt() : 0;
+		const bool bCanLoad = CanUseUnversionedPropertySerialization(nullptr);
+
+		TArray<T> Instances;
+		Instances.Reserve(NumInstances);
+		for (int32 Index = 0; Index < NumInstances; ++Index)
+		{
+			Instances.Add(MakeInstance(Index));
+		}
+
+		double SaveTimes[2] = { 0.0, 0.0 };
+		double LoadTimes[2] = { 0.0, 0.0 };
+		TArray<uint8> Saved[2];
+		const int32 NumPaths = CopyRunsCVar ? 2 : 1;
+		for (int32 Path = 0; Path < NumPaths; ++Path)
+		{
+			if (CopyRunsCVar)
+			{
+				CopyRunsCVar->Set(Path == 0 ? 1 : 0, ECVF_SetByCode);
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			SaveInstances(Struct, Instances, Saved[Path]);
+			SaveTimes[Path] = FPlatformTime::Seconds() - StartTime;
+
+			if (bCanLoad)
+			{
+				TArray<T> Loaded;
+				Loaded.SetNumZeroed(NumInstances);
+				StartTime = FPlatformTime::Seconds();
+				LoadInstances(Struct, Saved[Path], Loaded);
+				LoadTimes[Path] = FPlatformTime::Seconds() - StartTime;
+
+				Test.TestTrue(FString::Printf(TEXT("%s instances load back identical"), Name), Loaded == Instances);
+			}
+		}
+
+		if (CopyRunsCVar)
+		{
+			CopyRunsCVar->Set(PreviousCopyRuns, ECVF_SetByCode);
+			Test.TestTrue(FString::Printf(TEXT("%s saves the same data with and without copy runs"), Name), Saved[0] == Saved[1]);
+			Test.AddInfo(FString::Printf(TEXT("%s: %d instances, %d bytes, save %.2f ms (%.2f ms without copy runs), load %.2f ms (%.2f ms without copy runs)"),
+				Name, NumInstances, Saved[0].Num(), SaveTimes[0] * 1000.0, SaveTimes[1] * 1000.0, LoadTimes[0] * 1000.0, LoadTimes[1] * 1000.0));
+		}
+		else
+		{
+			Test.AddInfo(FString::Printf(TEXT("%s: %d instances, %d bytes, save %.2f ms, load %.2f ms, the schema is not cached on this platform so there are no copy runs"),
+				Name, NumInstances, Saved[0].Num(), SaveTimes[0] * 1000.0, LoadTimes[0] * 1000.0));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnversionedPropertyCopyRunsTest, "System.CoreUObject.Serialization.UnversionedProperties.CopyRuns", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUnversionedPropertyCopyRunsTest::RunTest(const FString& Parameters)
+{
+	using namespace UnversionedPropertySerializationTest;
+
+	if (!CanUseUnversionedPropertySerialization(nullptr))
+	{
+		AddInfo(TEXT("Unversioned property serialization is not enabled for this platform, only saving is tested"));
+	}
+
+	// Every 7th instance has zeroes to exercise runs broken up by the zero mask
+	TestStruct<FLinearColor>(*this, TEXT("FLinearColor"), TBaseStructure<FLinearColor>::Get(), [](int32 Index)
+	{
+		return FLinearColor(float(Index + 1), Index % 7 == 0 ? 0.0f : 0.5f, float(Index % 13), 1.0f);
+	});
+	TestStruct<FGuid>(*this, TEXT("FGuid"), TBaseStructure<FGuid>::Get(), [](int32 Index)
+	{
+		return FGuid(uint32(Index + 1), Index % 7 == 0 ? 0u : uint32(Index * 31), uint32(Index % 13), ~uint32(Index));
+	});
+	TestStruct<FColor>(*this, TEXT("FColor"), TBaseStructure<FColor>::Get(), [](int32 Index)
+	{
+		return FColor(uint8(Index), Index % 7 == 0 ? uint8(0) : uint8(Index >> 8), uint8(Index % 13), 255);
+	});
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
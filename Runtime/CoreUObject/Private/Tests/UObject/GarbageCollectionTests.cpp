@@ -0,0 +1,261 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/FastReferenceCollector.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <atomic>
+
+/** Struct with object references only, scanned with GCRT_ArrayStructObjects when token stream fast paths are enabled */
+struct FGCTokenStreamBenchmarkStruct
+{
+	UObject* First = nullptr;
+	UObject* Second = nullptr;
+};
+
+/** Intrinsic class exercising the array token stream fast paths */
+class UGCTokenStreamBenchmarkObject : public UObject
+{
+	DECLARE_CLASS_INTRINSIC(UGCTokenStreamBenchmarkObject, UObject, CLASS_Transient, TEXT("/Script/CoreUObject"))
+
+public:
+	TArray<UObject*> Objects;
+	TArray<FGCTokenStreamBenchmarkStruct> Structs;
+};
+
+IMPLEMENT_CORE_INTRINSIC_CLASS(UGCTokenStreamBenchmarkObject, UObject,
+	{
+		Class->EmitObjectArrayReference(STRUCT_OFFSET(UGCTokenStreamBenchmarkObject, Objects), TEXT("Objects"));
+		const uint32 SkipIndexIndex = Class->EmitStructArrayBegin(STRUCT_OFFSET(UGCTokenStreamBenchmarkObject, Structs), TEXT("Structs"), sizeof(FGCTokenStreamBenchmarkStruct));
+		Class->EmitObjectReference(STRUCT_OFFSET(FGCTokenStreamBenchmarkStruct, First), TEXT("First"));
+		Class->EmitObjectReference(STRUCT_OFFSET(FGCTokenStreamBenchmarkStruct, Second), TEXT("Second"));
+		Class->EmitStructArrayEnd(SkipIndexIndex);
+	}
+);
+
+/** Intrinsic class opting into parallel BeginDestroy/FinishDestroy that records the order its destruction steps run in */
+class UGCParallelDestructionTestObject : public UObject
+{
+	DECLARE_CLASS_INTRINSIC(UGCParallelDestructionTestObject, UObject, CLASS_Transient, TEXT("/Script/CoreUObject"))
+
+public:
+	enum EDestroyStage : int32
+	{
+		Alive,
+		BeganDestroy,
+		FinishedDestroy,
+	};
+
+	static std::atomic<int32> NumBeginDestroyed;
+	static std::atomic<int32> NumFinishDestroyed;
+	static std::atomic<int32> NumDestructed;
+	static std::atomic<int32> NumOrderErrors;
+	static std::atomic<int32> NumDestroyedOffGameThread;
+
+	std::atomic<int32> DestroyStage { Alive };
+
+	virtual ~UGCParallelDestructionTestObject()
+	{
+		if (DestroyStage.load() != FinishedDestroy)
+		{
+			++NumOrderErrors;
+		}
+		++NumDestructed;
+	}
+
+	virtual bool IsBeginAndFinishDestroyThreadSafe() const override
+	{
+		return true;
+	}
+
+	virtual void BeginDestroy() override
+	{
+		int32 ExpectedStage = Alive;
+		if (!DestroyStage.compare_exchange_strong(ExpectedStage, BeganDestroy) || HasAnyFlags(RF_FinishDestroyed))
+		{
+			++NumOrderErrors;
+		}
+		if (!IsInGameThread())
+		{
+			++NumDestroyedOffGameThread;
+		}
+		++NumBeginDestroyed;
+		Super::BeginDestroy();
+	}
+
+	virtual void FinishDestroy() override
+	{
+		int32 ExpectedStage = BeganDestroy;
+		if (!DestroyStage.compare_exchange_strong(ExpectedStage, FinishedDestroy) || !HasAnyFlags(RF_BeginDestroyed))
+		{
+			++NumOrderErrors;
+		}
+		++NumFinishDestroyed;
+		Super::FinishDestroy();
+	}
+};
+
+std::atomic<int32> UGCParallelDestructionTestObject::NumBeginDestroyed { 0 };
+std::atomic<int32> UGCParallelDestructionTestObject::NumFinishDestroyed { 0 };
+std::atomic<int32> UGCParallelDestructionTestObject::NumDestructed { 0 };
+std::atomic<int32> UGCParallelDestructionTestObject::NumOrderErrors { 0 };
+std::atomic<int32> UGCParallelDestructionTestObject::NumDestroyedOffGameThread { 0 };
+
+IMPLEMENT_CORE_INTRINSIC_CLASS(UGCParallelDestructionTestObject, UObject,
+	{
+	}
+);
+
+namespace GarbageCollectionTest
+{
+	#define TEST_NAME_ROOT "System.CoreUObject.GarbageCollection"
+	constexpr const uint32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	/** Counts non-null references reported by the token stream */
+	class FCountingReferenceProcessor : public FSimpleReferenceProcessorBase
+	{
+	public:
+		int64 NumReferences = 0;
+
+		FORCEINLINE void HandleTokenStreamObjectReference(TArray<UObject*>& ObjectsToSerialize, UObject* ReferencingObject, UObject*& Object, const int32 TokenIndex, bool bAllowReferenceElimination)
+		{
+			if (Object)
+			{
+				++NumReferences;
+			}
+		}
+	};
+
+	/** Scans Holders a number of times and returns the time spent in seconds */
+	static double TimeReferenceCollection(const TArray<UObject*>& Holders, int32 NumIterations, int64& OutNumReferences)
+	{
+		typedef TDefaultReferenceCollector<FCountingReferenceProcessor> FCollector;
+
+		FCountingReferenceProcessor Processor;
+		TFastReferenceCollector<FCountingReferenceProcessor, FCollector, FGCArrayPool, EFastReferenceCollectorOptions::AutogenerateTokenStream> ReferenceCollector(Processor, FGCArrayPool::Get());
+		FGCArrayStruct ArrayStruct;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			ArrayStruct.ObjectsToSerialize = Holders;
+			ReferenceCollector.CollectReferences(ArrayStruct);
+		}
+		OutNumReferences = Processor.NumReferences;
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	// Compares reference collection over object and struct arrays with and without the token stream fast paths.
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGarbageCollectionTestTokenStreamFastPathsPerf, TEST_NAME_ROOT ".TokenStreamFastPathsPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+	bool FGarbageCollectionTestTokenStreamFastPathsPerf::RunTest(const FString& Parameters)
+	{
+		constexpr int32 NumHolders = 64;
+		constexpr int32 NumReferencesPerHolder = 4096;
+		constexpr int32 NumIterations = 20;
+
+		UObject* Referenced = NewObject<UObjectRedirector>(GetTransientPackage());
+		Referenced->AddToRoot();
+
+		TArray<UObject*> Holders;
+		for (int32 HolderIndex = 0; HolderIndex < NumHolders; ++HolderIndex)
+		{
+			UGCTokenStreamBenchmarkObject* Holder = NewObject<UGCTokenStreamBenchmarkObject>(GetTransientPackage());
+			Holder->AddToRoot();
+			Holder->Objects.SetNumZeroed(NumReferencesPerHolder);
+			Holder->Structs.SetNum(NumReferencesPerHolder);
+			// Leave most references null like sparsely filled arrays usually are
+			for (int32 Index = 0; Index < NumReferencesPerHolder; Index += 8)
+			{
+				Holder->Objects[Index] = Referenced;
+				Holder->Structs[Index].Second = Referenced;
+			}
+			Holders.Add(Holder);
+		}
+
+		const bool bPreviousFastPathsEnabled = GGCTokenStreamFastPathsEnabled;
+		int64 NumReferencesWithFastPaths = 0;
+		int64 NumReferencesWithoutFastPaths = 0;
+
+		GGCTokenStreamFastPathsEnabled = false;
+		const double TimeWithoutFastPaths = TimeReferenceCollection(Holders, NumIterations, NumReferencesWithoutFastPaths);
+		GGCTokenStreamFastPathsEnabled = true;
+		const double TimeWithFastPaths = TimeReferenceCollection(Holders, NumIterations, NumReferencesWithFastPaths);
+		GGCTokenStreamFastPathsEnabled = bPreviousFastPathsEnabled;
+
+		TestEqual(TEXT("Fast paths should report the same references"), NumReferencesWithFastPaths, NumReferencesWithoutFastPaths);
+		AddInfo(FString::Printf(TEXT("Token stream scanning: %.2fms without fast paths, %.2fms with fast paths (%.2fx)"),
+			TimeWithoutFastPaths * 1000.0, TimeWithFastPaths * 1000.0, TimeWithFastPaths > 0.0 ? TimeWithoutFastPaths / TimeWithFastPaths : 0.0));
+
+		for (UObject* Holder : Holders)
+		{
+			Holder->RemoveFromRoot();
+		}
+		Referenced->RemoveFromRoot();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		return true;
+	}
+
+	// Destroys opted-in objects from parallel batches mixed with objects that stay on the serial path and checks each one
+	// still runs BeginDestroy, FinishDestroy and its destructor exactly once and in that order.
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGarbageCollectionTestParallelDestruction, TEST_NAME_ROOT ".ParallelDestruction", TestFlags)
+	bool FGarbageCollectionTestParallelDestruction::RunTest(const FString& Parameters)
+	{
+		constexpr int32 NumObjects = 4096;
+
+		IConsoleVariable* ParallelDestructionVar = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.ParallelDestruction"));
+		IConsoleVariable* BatchSizeVar = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.ParallelDestructionBatchSize"));
+		if (!ParallelDestructionVar || !BatchSizeVar)
+		{
+			AddError(TEXT("Parallel destruction console variables are not registered"));
+			return false;
+		}
+		const int32 PreviousParallelDestruction = ParallelDestructionVar->GetInt();
+		const int32 PreviousBatchSize = BatchSizeVar->GetInt();
+
+		// Start from a clean slate so only the objects created below are unreachable
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		ParallelDestructionVar->Set(1, ECVF_SetByCode);
+		BatchSizeVar->Set(64, ECVF_SetByCode);
+
+		UGCParallelDestructionTestObject::NumBeginDestroyed = 0;
+		UGCParallelDestructionTestObject::NumFinishDestroyed = 0;
+		UGCParallelDestructionTestObject::NumDestructed = 0;
+		UGCParallelDestructionTestObject::NumOrderErrors = 0;
+		UGCParallelDestructionTestObject::NumDestroyedOffGameThread = 0;
+
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			NewObject<UGCParallelDestructionTestObject>(GetTransientPackage());
+			// Interleave objects that did not opt in so every batch has a serial remainder
+			if ((Index % 4) == 0)
+			{
+				NewObject<UObjectRedirector>(GetTransientPackage());
+			}
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		ParallelDestructionVar->Set(PreviousParallelDestruction, ECVF_SetByCode);
+		BatchSizeVar->Set(PreviousBatchSize, ECVF_SetByCode);
+
+		TestEqual(TEXT("Every object should have BeginDestroy called once"), UGCParallelDestructionTestObject::NumBeginDestroyed.load(), NumObjects);
+		TestEqual(TEXT("Every object should have FinishDestroy called once"), UGCParallelDestructionTestObject::NumFinishDestroyed.load(), NumObjects);
+		TestEqual(TEXT("Every object should be destructed"), UGCParallelDestructionTestObject::NumDestructed.load(), NumObjects);
+		TestEqual(TEXT("BeginDestroy, FinishDestroy and the destructor should run in order"), UGCParallelDestructionTestObject::NumOrderErrors.load(), 0);
+		// ParallelFor may run a batch on the game thread itself so this is only reported, not required
+		AddInfo(FString::Printf(TEXT("%d of %d objects had BeginDestroy routed from worker threads"), UGCParallelDestructionTestObject::NumDestroyedOffGameThread.load(), NumObjects));
+
+		return true;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UObjectHashTest
+{
+	#define TEST_NAME_ROOT "System.CoreUObject.UObjectHash"
+
+	constexpr int32 NumObjects = 4096;
+	constexpr int32 NumLookupsPerTask = 200000;
+	constexpr int32 OuterQueryInterval = 1000;
+
+	/**
+	 * Finds objects by name and outer and lists the outer's inners from NumTasks tasks at once.
+	 *
+	 * @return Number of seconds it took for all tasks to finish
+	 */
+	static double RunLookups(int32 NumTasks, UObject* Outer, const TArray<FName>& Names, FThreadSafeCounter& NumFailedLookups)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(NumTasks, [Outer, &Names, &NumFailedLookups](int32 TaskIndex)
+		{
+			TArray<UObject*> Inners;
+			uint32 NameIndex = TaskIndex * 7919;
+			for (int32 LookupIndex = 0; LookupIndex < NumLookupsPerTask; ++LookupIndex)
+			{
+				const FName Name = Names[NameIndex++ % Names.Num()];
+				UObject* Object = StaticFindObjectFast(UObjectRedirector::StaticClass(), Outer, Name);
+				if (!Object || Object->GetFName() != Name)
+				{
+					NumFailedLookups.Increment();
+				}
+
+				if (LookupIndex % OuterQueryInterval == 0)
+				{
+					Inners.Reset();
+					GetObjectsWithOuter(Outer, Inners, false);
+					if (Inners.Num() != Names.Num())
+					{
+						NumFailedLookups.Increment();
+					}
+				}
+			}
+		}, NumTasks == 1);
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	// Compares single threaded and multi threaded lookup throughput of the UObject hash tables.
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUObjectHashTestConcurrentLookupPerf, TEST_NAME_ROOT ".ConcurrentLookupPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+	bool FUObjectHashTestConcurrentLookupPerf::RunTest(const FString& Parameters)
+	{
+		UObjectRedirector* Outer = NewObject<UObjectRedirector>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UObjectRedirector::StaticClass(), TEXT("UObjectHashTestOuter")));
+		Outer->AddToRoot();
+
+		TArray<UObject*> Objects;
+		TArray<FName> Names;
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			UObject* Object = NewObject<UObjectRedirector>(Outer, FName(TEXT("UObjectHashTestObject"), Index + 1));
+			Object->AddToRoot();
+			Objects.Add(Object);
+			Names.Add(Object->GetFName());
+		}
+
+		const int32 NumTasks = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+		FThreadSafeCounter NumFailedLookups;
+
+		const double SingleThreadedTime = RunLookups(1, Outer, Names, NumFailedLookups);
+		const double MultiThreadedTime = RunLookups(NumTasks, Outer, Names, NumFailedLookups);
+
+		TestEqual(TEXT("All objects should be found while looking them up from multiple threads"), NumFailedLookups.GetValue(), 0);
+
+		const double SingleThreadedLookupsPerSecond = NumLookupsPerTask / SingleThreadedTime;
+		const double MultiThreadedLookupsPerSecond = (double)NumLookupsPerTask * NumTasks / MultiThreadedTime;
+		AddInfo(FString::Printf(TEXT("1 task: %.0f lookups/s, %d tasks: %.0f lookups/s (%.2fx)"),
+			SingleThreadedLookupsPerSecond, NumTasks, MultiThreadedLookupsPerSecond, MultiThreadedLookupsPerSecond / SingleThreadedLookupsPerSecond));
+
+		for (UObject* Object : Objects)
+		{
+			Object->RemoveFromRoot();
+		}
+		Outer->RemoveFromRoot();
+
+		return true;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
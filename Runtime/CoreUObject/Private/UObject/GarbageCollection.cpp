@@ -105,6 +105,28 @@ public:
 	}
 };
 
+/** Temporarily releases the UObject hash tables locked by FGCScopeLock so that worker threads can unhash objects */
+class FGCScopeUnlock
+{
+	/** Lock depth to restore */
+	int32 LockDepth;
+public:
+
+	FORCEINLINE FGCScopeUnlock()
+	{
+		int32 SuspendUObjectHashTablesLock();
+		LockDepth = SuspendUObjectHashTablesLock();
+	}
+	FORCEINLINE ~FGCScopeUnlock()
+	{
+		void ResumeUObjectHashTablesLock(int32 LockDepth);
+		ResumeUObjectHashTablesLock(LockDepth);
+	}
+};
+
+/** True on threads that currently destroy objects on behalf of a parallel destruction batch */
+static thread_local bool GIsInParallelDestructionTask = false;
+
 FGCCSyncObject::FGCCSyncObject()
 {
 	GCUnlockedEvent = FPlatformProcess::GetSynchEventFromPool(true);
@@ -189,6 +211,31 @@ static FAutoConsoleVariableRef CMultithreadedDestructionEnabled(
 	ECVF_Default
 );
 
+bool GGCTokenStreamFastPathsEnabled = true;
+static FAutoConsoleVariableRef CVarGCTokenStreamFastPaths(
+	TEXT("gc.TokenStreamFastPaths"),
+	GGCTokenStreamFastPathsEnabled,
+	TEXT("If true, reference collection checks arrays of object references in batches and handles arrays of structs that only contain object references without stepping into them."),
+	ECVF_Default
+);
+
+static int32 GParallelDestructionEnabled = 0;
+static FAutoConsoleVariableRef CVarParallelDestructionEnabled(
+	TEXT("gc.ParallelDestruction"),
+	GParallelDestructionEnabled,
+	TEXT("If true, BeginDestroy and FinishDestroy are routed to unreachable objects that return true from IsBeginAndFinishDestroyThreadSafe in parallel batches. ")
+	TEXT("When gc.MultithreadedDestructionEnabled is also set, objects that return true from IsDestructionThreadSafe are deleted in parallel batches too. All other objects are still destroyed on the game thread."),
+	ECVF_Default
+);
+
+static int32 GParallelDestructionBatchSize = 512;
+static FAutoConsoleVariableRef CVarParallelDestructionBatchSize(
+	TEXT("gc.ParallelDestructionBatchSize"),
+	GParallelDestructionBatchSize,
+	TEXT("Number of unreachable objects processed by each parallel destruction batch (see gc.ParallelDestruction)."),
+	ECVF_Default
+);
+
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 /** Map from a UClass' FName to the number of objects that were purged during the last purge phase of this class.	*/
 static TMap<const FName,uint32> GClassToPurgeCountMap;
@@ -307,6 +354,12 @@ class FAsyncPurge : public FRunnable
 
 		while (ObjCurrentPurgeObjectIndex < GUnreachableObjects.Num())
 		{
+			if (bMultithreaded && GParallelDestructionEnabled)
+			{
+				TickDestroyObjectsBatch(FMath::Max(GParallelDestructionBatchSize, 1));
+				continue;
+			}
+
 			FUObjectItem* ObjectItem = GUnreachableObjects[ObjCurrentPurgeObjectIndex];
 			check(ObjectItem->IsUnreachable());
 
@@ -341,6 +394,42 @@ class FAsyncPurge : public FRunnable
 		return bFinishedDestroyingObjects;
 	}
 
+	/**
+	 * [PURGE THREAD] Destroys the next batch of unreachable objects in parallel. Objects that need to be destroyed on the game thread
+	 * are only counted once the whole batch is done so that the game thread never looks at objects still being destroyed.
+	 */
+	void TickDestroyObjectsBatch(int32 BatchSize)
+	{
+		const int32 FirstObjectIndex = ObjCurrentPurgeObjectIndex;
+		const int32 NumObjects = FMath::Min(BatchSize, GUnreachableObjects.Num() - FirstObjectIndex);
+		FThreadSafeCounter NumGameThreadObjects;
+
+		ParallelFor(NumObjects, [FirstObjectIndex, &NumGameThreadObjects](int32 Index)
+		{
+			FUObjectItem* ObjectItem = GUnreachableObjects[FirstObjectIndex + Index];
+			check(ObjectItem->IsUnreachable());
+
+			UObject* Object = (UObject*)ObjectItem->Object;
+			check(Object->HasAllFlags(RF_FinishDestroyed | RF_BeginDestroyed));
+			if (Object->IsDestructionThreadSafe())
+			{
+				TGuardValue<bool> GuardIsInParallelDestructionTask(GIsInParallelDestructionTask, true);
+				Object->~UObject();
+				GUObjectAllocator.FreeUObject(Object);
+				GUnreachableObjects[FirstObjectIndex + Index] = nullptr;
+			}
+			else
+			{
+				NumGameThreadObjects.Increment();
+			}
+		});
+
+		FPlatformMisc::MemoryBarrier();
+		NumObjectsToDestroyOnGameThread += NumGameThreadObjects.GetValue();
+		ObjectsDestroyedSinceLastMarkPhase += NumObjects;
+		ObjCurrentPurgeObjectIndex += NumObjects;
+	}
+
 	/** [GAME THREAD] Destroys objects that are unreachable and couldn't be destroyed on the worker thread */
 	bool TickDestroyGameThreadObjects(bool bUseTimeLimit, float TimeLimit, double StartTime)
 	{
@@ -556,12 +645,12 @@ public:
 static FAsyncPurge* GAsyncPurge = nullptr;
 
 /**
-  * Returns true if this function is called from the async destruction thread.
+  * Returns true if this function is called from the async destruction thread or from a parallel destruction task.
   * It will also return true if we're running single-threaded and this function is called on the game thread
   */
 bool IsInGarbageCollectorThread()
 {
-	return GAsyncPurge ? GAsyncPurge->IsInAsyncPurgeThread() : IsInGameThread();
+	return GIsInParallelDestructionTask || (GAsyncPurge ? GAsyncPurge->IsInAsyncPurgeThread() : IsInGameThread());
 }
 
 /** Called on shutdown to free GC memory */
@@ -1378,6 +1467,66 @@ static bool ShouldForceSingleThreadedGC()
 	return bForceSingleThreadedGC;
 }
 
+/** Returns the number of unreachable objects processed by each parallel BeginDestroy/FinishDestroy batch or 0 if they should be routed serially */
+static int32 GetParallelDestructionBatchSize()
+{
+#if THREADSAFE_UOBJECTS && !PROFILE_GCConditionalBeginDestroy
+	if (GParallelDestructionEnabled && !ShouldForceSingleThreadedGC())
+	{
+		return FMath::Max(GParallelDestructionBatchSize, 1);
+	}
+#endif
+	return 0;
+}
+
+/**
+ * Routes BeginDestroy to a batch of unreachable objects. Objects with thread safe BeginDestroy are processed in parallel first,
+ * with the hash tables unlocked so that they can be unhashed from worker threads. All other objects are processed afterwards on the game thread.
+ */
+static void BeginDestroyUnreachableObjectsBatch(int32 FirstObjectIndex, int32 NumObjects)
+{
+	{
+		FGCScopeUnlock GCUnlock;
+		ParallelFor(NumObjects, [FirstObjectIndex](int32 Index)
+		{
+			UObject* Object = static_cast<UObject*>(GUnreachableObjects[FirstObjectIndex + Index]->Object);
+			if (Object->IsBeginAndFinishDestroyThreadSafe())
+			{
+				TGuardValue<bool> GuardIsInParallelDestructionTask(GIsInParallelDestructionTask, true);
+				Object->ConditionalBeginDestroy();
+			}
+		});
+	}
+
+	for (int32 ObjectIndex = FirstObjectIndex; ObjectIndex < FirstObjectIndex + NumObjects; ++ObjectIndex)
+	{
+		UObject* Object = static_cast<UObject*>(GUnreachableObjects[ObjectIndex]->Object);
+		if (!Object->HasAnyFlags(RF_BeginDestroyed))
+		{
+			FScopedCBDProfile Profile(Object);
+			Object->ConditionalBeginDestroy();
+		}
+	}
+}
+
+/**
+ * Routes FinishDestroy in parallel to objects of a batch of unreachable objects that have thread safe FinishDestroy and are ready for it.
+ * The remaining objects are left to the caller to process on the game thread.
+ */
+static void FinishDestroyUnreachableObjectsBatch(int32 FirstObjectIndex, int32 NumObjects)
+{
+	FGCScopeUnlock GCUnlock;
+	ParallelFor(NumObjects, [FirstObjectIndex](int32 Index)
+	{
+		UObject* Object = static_cast<UObject*>(GUnreachableObjects[FirstObjectIndex + Index]->Object);
+		if (Object->IsBeginAndFinishDestroyThreadSafe() && !Object->HasAnyFlags(RF_FinishDestroyed) && Object->IsReadyForFinishDestroy())
+		{
+			TGuardValue<bool> GuardIsInParallelDestructionTask(GIsInParallelDestructionTask, true);
+			Object->ConditionalFinishDestroy();
+		}
+	});
+}
+
 void AcquireGCLock()
 {
 	const double StartTime = FPlatformTime::Seconds();
@@ -1499,6 +1648,9 @@ void IncrementalPurgeGarbage(bool bUseTimeLimit, float TimeLimit)
 }
 
 #if UE_WITH_GC
+/** Time spent in IncrementalDestroyGarbage since the current purge started, for objects per ms stats */
+static double GIncrementalDestroyGarbageTime = 0.0;
+
 bool IncrementalDestroyGarbage(bool bUseTimeLimit, float TimeLimit)
 {
 	const bool bMultithreadedPurge = !ShouldForceSingleThreadedGC() && GMultithreadedDestructionEnabled;
@@ -1544,8 +1696,18 @@ bool IncrementalDestroyGarbage(bool bUseTimeLimit, float TimeLimit)
 			GObjCurrentPurgeObjectIndexNeedsReset = false;
 		}
 
+		const int32 ParallelBatchSize = GetParallelDestructionBatchSize();
+		int32 ParallelBatchEndIndex = 0;
+
 		while (GObjCurrentPurgeObjectIndex < GUnreachableObjects.Num())
 		{
+			if (ParallelBatchSize > 0 && GObjCurrentPurgeObjectIndex >= ParallelBatchEndIndex)
+			{
+				// Route FinishDestroy to thread safe objects of the next batch first, the rest is handled below
+				ParallelBatchEndIndex = FMath::Min(GObjCurrentPurgeObjectIndex + ParallelBatchSize, GUnreachableObjects.Num());
+				FinishDestroyUnreachableObjectsBatch(GObjCurrentPurgeObjectIndex, ParallelBatchEndIndex - GObjCurrentPurgeObjectIndex);
+			}
+
 			FUObjectItem* ObjectItem = GUnreachableObjects[GObjCurrentPurgeObjectIndex];
 			checkSlow(ObjectItem);
 
@@ -1554,11 +1716,15 @@ bool IncrementalDestroyGarbage(bool bUseTimeLimit, float TimeLimit)
 			check(ObjectItem->IsUnreachable());
 			{
 				UObject* Object = static_cast<UObject*>(ObjectItem->Object);
-				// Object should always have had BeginDestroy called on it and never already be destroyed
-				check( Object->HasAnyFlags( RF_BeginDestroyed ) && !Object->HasAnyFlags( RF_FinishDestroyed ) );
+				// Object should always have had BeginDestroy called on it and never already be destroyed, unless it opted into FinishDestroy from a parallel batch
+				check( Object->HasAnyFlags( RF_BeginDestroyed ) && (!Object->HasAnyFlags( RF_FinishDestroyed ) || (ParallelBatchSize > 0 && Object->IsBeginAndFinishDestroyThreadSafe())) );
 
+				if (Object->HasAnyFlags(RF_FinishDestroyed))
+				{
+					// FinishDestroy has already been routed to this object by FinishDestroyUnreachableObjectsBatch
+				}
 				// Only proceed with destroying the object if the asynchronous cleanup started by BeginDestroy has finished.
-				if(Object->IsReadyForFinishDestroy())
+				else if(Object->IsReadyForFinishDestroy())
 				{
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 					// Keep track of how many objects of a certain class we're purging.
@@ -1778,10 +1944,16 @@ bool IncrementalDestroyGarbage(bool bUseTimeLimit, float TimeLimit)
 
 			// Log status information.
 			const int32 PurgedObjectCountSinceLastMarkPhase = GAsyncPurge->GetObjectsDestroyedSinceLastMarkPhase();
-			UE_LOG(LogGarbage, Log, TEXT("GC purged %i objects (%i -> %i) in %.3fms"), PurgedObjectCountSinceLastMarkPhase, 
+			const double PurgeTimeMs = (GIncrementalDestroyGarbageTime + FPlatformTime::Seconds() - IncrementalDestroyGarbageStartTime) * 1000;
+			const float PurgedObjectsPerMs = PurgeTimeMs > 0.0 ? (float)(PurgedObjectCountSinceLastMarkPhase / PurgeTimeMs) : 0.0f;
+			UE_LOG(LogGarbage, Log, TEXT("GC purged %i objects (%i -> %i) in %.3fms (%.3fms in total, %.1f objects/ms)"), PurgedObjectCountSinceLastMarkPhase, 
 				GObjectCountDuringLastMarkPhase.GetValue(), 
 				GObjectCountDuringLastMarkPhase.GetValue() - PurgedObjectCountSinceLastMarkPhase,
-				(FPlatformTime::Seconds() - IncrementalDestroyGarbageStartTime) * 1000);
+				(FPlatformTime::Seconds() - IncrementalDestroyGarbageStartTime) * 1000,
+				PurgeTimeMs,
+				PurgedObjectsPerMs);
+			CSV_CUSTOM_STAT_GLOBAL(GCPurgedObjectsPerMs, PurgedObjectsPerMs, ECsvCustomStatOp::Set);
+			GIncrementalDestroyGarbageTime = 0.0;
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 			LogClassCountInfo( TEXT("objects of"), GClassToPurgeCountMap, 10, PurgedObjectCountSinceLastMarkPhase);
 #endif
@@ -1798,6 +1970,11 @@ bool IncrementalDestroyGarbage(bool bUseTimeLimit, float TimeLimit)
 			GUnreachableObjects.Num());
 	}
 
+	if (!bCompleted)
+	{
+		GIncrementalDestroyGarbageTime += FPlatformTime::Seconds() - IncrementalDestroyGarbageStartTime;
+	}
+
 	return bCompleted;
 }
 #endif // UE_WITH_GC
@@ -2078,6 +2255,9 @@ bool IsIncrementalUnhashPending()
 	return GUnrechableObjectIndex < GUnreachableObjects.Num();
 }
 
+/** Time spent in UnhashUnreachableObjects since unhashing of the current unreachable objects started, for objects per ms stats */
+static double GUnhashUnreachableObjectsTime = 0.0;
+
 bool UnhashUnreachableObjects(bool bUseTimeLimit, float TimeLimit)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UnhashUnreachableObjects"), STAT_UnhashUnreachableObjects, STATGROUP_GC);
@@ -2092,9 +2272,30 @@ bool UnhashUnreachableObjects(bool bUseTimeLimit, float TimeLimit)
 	int32 Items = 0;
 	int32 TimePollCounter = 0;
 	const bool bFirstIteration = (GUnrechableObjectIndex == 0);
+	const int32 ParallelBatchSize = GetParallelDestructionBatchSize();
+
+	if (bFirstIteration)
+	{
+		GUnhashUnreachableObjectsTime = 0.0;
+	}
 
 	while (GUnrechableObjectIndex < GUnreachableObjects.Num())
 	{
+		if (ParallelBatchSize > 0)
+		{
+			const int32 FirstObjectIndex = GUnrechableObjectIndex;
+			const int32 NumObjects = FMath::Min(ParallelBatchSize, GUnreachableObjects.Num() - FirstObjectIndex);
+			GUnrechableObjectIndex += NumObjects;
+			BeginDestroyUnreachableObjectsBatch(FirstObjectIndex, NumObjects);
+			Items += NumObjects;
+
+			if (bUseTimeLimit && ((FPlatformTime::Seconds() - StartTime) > TimeLimit))
+			{
+				break;
+			}
+			continue;
+		}
+
 		//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
 
 		FUObjectItem* ObjectItem = GUnreachableObjects[GUnrechableObjectIndex++];
@@ -2116,18 +2317,26 @@ bool UnhashUnreachableObjects(bool bUseTimeLimit, float TimeLimit)
 
 	const bool bTimeLimitReached = (GUnrechableObjectIndex < GUnreachableObjects.Num());
 
+	GUnhashUnreachableObjectsTime += FPlatformTime::Seconds() - StartTime;
+	const double UnhashTimeMs = GUnhashUnreachableObjectsTime * 1000;
+	const float UnhashedObjectsPerMs = UnhashTimeMs > 0.0 ? (float)(GUnrechableObjectIndex / UnhashTimeMs) : 0.0f;
+	if (!bTimeLimitReached)
+	{
+		CSV_CUSTOM_STAT_GLOBAL(GCUnhashedObjectsPerMs, UnhashedObjectsPerMs, ECsvCustomStatOp::Set);
+	}
+
 	if (!bUseTimeLimit)
 	{
-		UE_LOG(LogGarbage, Log, TEXT("%f ms for %sunhashing unreachable objects (%d objects unhashed)"),
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for %sunhashing unreachable objects (%d objects unhashed, %.1f objects/ms)"),
 		(FPlatformTime::Seconds() - StartTime) * 1000,
 		bUseTimeLimit ? TEXT("incrementally ") : TEXT(""),
 			Items,
-		GUnrechableObjectIndex, GUnreachableObjects.Num());
+			UnhashedObjectsPerMs);
 	}
 	else if (!bTimeLimitReached)
 	{
 		// When doing incremental unhashing log only the first and last iteration (this was the last one)
-		UE_LOG(LogGarbage, Log, TEXT("Finished unhashing unreachable objects (%d objects unhashed)."), GUnreachableObjects.Num());
+		UE_LOG(LogGarbage, Log, TEXT("Finished unhashing unreachable objects (%d objects unhashed, %.1f objects/ms)."), GUnreachableObjects.Num(), UnhashedObjectsPerMs);
 	}
 	else if (bFirstIteration)
 	{
@@ -2218,6 +2427,11 @@ bool UObject::IsDestructionThreadSafe() const
 	return false;
 }
 
+bool UObject::IsBeginAndFinishDestroyThreadSafe() const
+{
+	return false;
+}
+
 /*-----------------------------------------------------------------------------
 	Implementation of realtime garbage collection helper functions in 
 	FProperty, UClass, ...
@@ -2746,6 +2960,9 @@ void UClass::AssembleReferenceTokenStream(bool bForce)
 		static const FName EOSDebugName("EndOfStreamToken");
 		EmitObjectReference(0, EOSDebugName, GCRT_EndOfStream);
 
+		// Switch to the specialized tokens once the stream is complete, so that they're compiled only once per class
+		ReferenceTokenStream.Optimize();
+
 		// Shrink reference token stream to proper size.
 		ReferenceTokenStream.Shrink();
 
@@ -2807,6 +3024,7 @@ void FGCReferenceTokenStream::Fixup(void (*AddReferencedObjectsPtr)(UObject*, cl
 		{
 		case GCRT_ArrayStruct:
 		case GCRT_ArrayStructFreezable:
+		case GCRT_ArrayStructObjects:
 			{
 				// Skip stride and move to Skip Info
 				TokenIndex += 2;
@@ -2918,6 +3136,68 @@ void FGCReferenceTokenStream::Fixup(void (*AddReferencedObjectsPtr)(UObject*, cl
 	}
 }
 
+void FGCReferenceTokenStream::Optimize()
+{
+	for (uint32 TokenIndex = 0; TokenIndex < (uint32)Tokens.Num(); )
+	{
+		const uint32 ReferenceInfoIndex = TokenIndex++;
+		FGCReferenceInfo Token = Tokens[ReferenceInfoIndex];
+		// Skip additional data, tokens inside of arrays and other containers are visited like any other token
+		switch (Token.Type)
+		{
+		case GCRT_ArrayStruct:
+			{
+				// Skip stride
+				TokenIndex++;
+				const FGCSkipInfo SkipInfo = ReadSkipInfo(TokenIndex);
+
+				// Structs without nested containers that only contain object references can be processed without stepping into the array
+				bool bOnlyObjectReferences = SkipInfo.InnerReturnCount == 0;
+				for (uint32 InnerTokenIndex = TokenIndex; bOnlyObjectReferences && InnerTokenIndex < SkipInfo.SkipIndex; ++InnerTokenIndex)
+				{
+					const FGCReferenceInfo InnerToken = Tokens[InnerTokenIndex];
+					bOnlyObjectReferences = InnerToken.Type == GCRT_Object && (InnerToken.ReturnCount == 0 || InnerTokenIndex == SkipInfo.SkipIndex - 1);
+				}
+				if (bOnlyObjectReferences)
+				{
+					Token.Type = GCRT_ArrayStructObjects;
+					Tokens[ReferenceInfoIndex] = Token;
+				}
+			}
+			break;
+		case GCRT_ArrayStructFreezable:
+		case GCRT_ArrayStructObjects:
+			{
+				// Skip stride and skip info
+				TokenIndex += 2;
+			}
+			break;
+		case GCRT_FixedArray:
+			{
+				// Skip stride and count
+				TokenIndex += 2;
+			}
+			break;
+		case GCRT_AddStructReferencedObjects:
+		case GCRT_AddReferencedObjects:
+			{
+				// Skip pointer
+				TokenIndex += GNumTokensPerPointer;
+			}
+			break;
+		case GCRT_AddTMapReferencedObjects:
+		case GCRT_AddTSetReferencedObjects:
+			{
+				// Skip pointer, GCRT_EndOfPointer and skip info
+				TokenIndex += GNumTokensPerPointer + 2;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
 int32 FGCReferenceTokenStream::EmitReferenceInfo(FGCReferenceInfo ReferenceInfo, const FName& DebugName)
 {
 	int32 TokenIndex = Tokens.Add(ReferenceInfo);
@@ -73,6 +73,8 @@ static UPackage*			GObjTransientPkg								= NULL;
 	static TArray<UObject*,TInlineAllocator<16> >		DebugBeginDestroyed;
 	/** Used to verify that the Super::FinishDestroyed chain is intact.			*/
 	static TArray<UObject*,TInlineAllocator<16> >		DebugFinishDestroyed;
+	/** Guards the two arrays above, objects opted into parallel destruction are destroyed from worker threads. */
+	static FCriticalSection								DebugDestroyedCritical;
 #endif
 
 #if !UE_BUILD_SHIPPING
@@ -84,6 +86,7 @@ static UPackage*			GObjTransientPkg								= NULL;
 	/** Used for the "obj spikemark" and "obj spikemarkcheck" commands only			*/
 	static FUObjectAnnotationSparseBool DebugSpikeMarkAnnotation;
 	static TArray<FString>			DebugSpikeMarkNames;
+	static FCriticalSection			DebugSpikeMarkNamesCritical;
 #endif
 
 #if WITH_EDITOR
@@ -789,7 +792,10 @@ void UObject::BeginDestroy()
 
 	// ensure BeginDestroy has been routed back to UObject::BeginDestroy.
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-	DebugBeginDestroyed.RemoveSingle(this);
+	{
+		FScopeLock DebugDestroyedLock(&DebugDestroyedCritical);
+		DebugBeginDestroyed.RemoveSingle(this);
+	}
 #endif
 }
 
@@ -810,7 +816,10 @@ void UObject::FinishDestroy()
 	DestroyNonNativeProperties();
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-	DebugFinishDestroyed.RemoveSingle(this);
+	{
+		FScopeLock DebugDestroyedLock(&DebugDestroyedCritical);
+		DebugFinishDestroyed.RemoveSingle(this);
+	}
 #endif
 }
 
@@ -942,7 +951,9 @@ bool UObject::ConditionalBeginDestroy()
 	{
 		if(!DebugSpikeMarkAnnotation.Get(this))
 		{
-			DebugSpikeMarkNames.Add(GetFullName());
+			FString FullName = GetFullName();
+			FScopeLock DebugSpikeMarkNamesLock(&DebugSpikeMarkNamesCritical);
+			DebugSpikeMarkNames.Add(MoveTemp(FullName));
 		}
 	}
 #endif
@@ -952,8 +963,11 @@ bool UObject::ConditionalBeginDestroy()
 	{
 		SetFlags(RF_BeginDestroyed);
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-		checkSlow(!DebugBeginDestroyed.Contains(this));
-		DebugBeginDestroyed.Add(this);
+		{
+			FScopeLock DebugDestroyedLock(&DebugDestroyedCritical);
+			checkSlow(!DebugBeginDestroyed.Contains(this));
+			DebugBeginDestroyed.Add(this);
+		}
 #endif
 
 #if PROFILE_ConditionalBeginDestroy
@@ -993,7 +1007,12 @@ bool UObject::ConditionalBeginDestroy()
 
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-		if( DebugBeginDestroyed.Contains(this) )
+		bool bFailedToRouteBeginDestroy = false;
+		{
+			FScopeLock DebugDestroyedLock(&DebugDestroyedCritical);
+			bFailedToRouteBeginDestroy = DebugBeginDestroyed.Contains(this);
+		}
+		if( bFailedToRouteBeginDestroy )
 		{
 			// class might override BeginDestroy without calling Super::BeginDestroy();
 			UE_LOG(LogObj, Fatal, TEXT("%s failed to route BeginDestroy"), *GetFullName() );
@@ -1014,8 +1033,11 @@ bool UObject::ConditionalFinishDestroy()
 	{
 		SetFlags(RF_FinishDestroyed);
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-		checkSlow(!DebugFinishDestroyed.Contains(this));
-		DebugFinishDestroyed.Add(this);
+		{
+			FScopeLock DebugDestroyedLock(&DebugDestroyedCritical);
+			checkSlow(!DebugFinishDestroyed.Contains(this));
+			DebugFinishDestroyed.Add(this);
+		}
 #endif
 		FinishDestroy();
 
@@ -1023,7 +1045,12 @@ bool UObject::ConditionalFinishDestroy()
 		GUObjectArray.RemoveObjectFromDeleteListeners(this);
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-		if( DebugFinishDestroyed.Contains(this) )
+		bool bFailedToRouteFinishDestroy = false;
+		{
+			FScopeLock DebugDestroyedLock(&DebugDestroyedCritical);
+			bFailedToRouteFinishDestroy = DebugFinishDestroyed.Contains(this);
+		}
+		if( bFailedToRouteFinishDestroy )
 		{
 			UE_LOG(LogObj, Fatal, TEXT("%s failed to route FinishDestroy"), *GetFullName() );
 		}
@@ -273,16 +273,41 @@ struct FHashBucketIterator
 	}
 };
 
-class FUObjectHashTables
+/** Part of the name hash tables, guarded by its own lock so that lookups of unrelated names don't contend */
+struct FUObjectHashShard
 {
-	/** Critical section that guards against concurrent adds from multiple threads */
-	FCriticalSection CriticalSection;
-
-public:
+	/** Guards Hash and HashOuter of this shard */
+	FRWLock Lock;
 
 	/** Hash sets */
 	TMap<int32, FHashBucket> Hash;
 	TMultiMap<int32, class UObjectBase*> HashOuter;
+};
+
+enum class EHashTableLockType : uint8
+{
+	Read,
+	Write
+};
+
+class FUObjectHashTables
+{
+	/** Guards all maps except the name hash tables which are guarded by their shard's lock */
+	FRWLock RelationsLock;
+
+	/** Number of times the current thread has locked all tables, see LockAll */
+	static thread_local int32 ThreadLockAllDepth;
+	/** Number of times the current thread has write locked RelationsLock */
+	static thread_local int32 ThreadRelationsWriteDepth;
+
+public:
+
+	/** Number of shards the name hash tables are split into */
+	static constexpr int32 NumShardBits = 5;
+	static constexpr int32 NumShards = 1 << NumShardBits;
+
+	/** Name hash tables, sharded by hash */
+	FUObjectHashShard Shards[NumShards];
 
 	/** Map of object to their outers, used to avoid an object iterator to find such things. **/
 	TMap<UObjectBase*, FHashBucket> ObjectOuterMap;
@@ -303,12 +328,15 @@ public:
 	void ShrinkMaps()
 	{
 		double StartTime = FPlatformTime::Seconds();
-		Hash.Compact();
-		for (auto& Pair : Hash)
+		for (FUObjectHashShard& Shard : Shards)
 		{
-			Pair.Value.Compact();
+			Shard.Hash.Compact();
+			for (auto& Pair : Shard.Hash)
+			{
+				Pair.Value.Compact();
+			}
+			Shard.HashOuter.Compact();
 		}
-		HashOuter.Compact();
 		ObjectOuterMap.Compact();
 		for (auto& Pair : ObjectOuterMap)
 		{
@@ -333,27 +361,35 @@ public:
 		UE_LOG(LogUObjectHash, Log, TEXT("Compacting FUObjectHashTables data took %6.2fms"), 1000.0f * float(FPlatformTime::Seconds() - StartTime));
 	}
 
-	/** Checks if the Hash/Object pair exists in the FName hash table */
+	/** Returns the shard that holds entries for InHash */
+	FORCEINLINE FUObjectHashShard& GetShard(int32 InHash)
+	{
+		// Use the high bits of a multiplicative hash so that keys within one shard still spread over the TMap's buckets
+		return Shards[((uint32)InHash * 2654435761U) >> (32 - NumShardBits)];
+	}
+
+	/** Checks if the Hash/Object pair exists in the FName hash table. Assumes that the shard is already locked. */
 	FORCEINLINE bool PairExistsInHash(int32 InHash, UObjectBase* Object)
 	{
 		bool bResult = false;
-		FHashBucket* Bucket = Hash.Find(InHash);
+		FHashBucket* Bucket = GetShard(InHash).Hash.Find(InHash);
 		if (Bucket)
 		{
 			bResult = Bucket->Contains(Object);
 		}
 		return bResult;
 	}
-	/** Adds the Hash/Object pair to the FName hash table */
+	/** Adds the Hash/Object pair to the FName hash table. Assumes that the shard is already write locked. */
 	FORCEINLINE void AddToHash(int32 InHash, UObjectBase* Object)
 	{
-		FHashBucket& Bucket = Hash.FindOrAdd(InHash);
+		FHashBucket& Bucket = GetShard(InHash).Hash.FindOrAdd(InHash);
 		Bucket.Add(Object);
 	}
-	/** Removes the Hash/Object pair from the FName hash table */
+	/** Removes the Hash/Object pair from the FName hash table. Assumes that the shard is already write locked. */
 	FORCEINLINE int32 RemoveFromHash(int32 InHash, UObjectBase* Object)
 	{
 		int32 NumRemoved = 0;
+		TMap<int32, FHashBucket>& Hash = GetShard(InHash).Hash;
 		FHashBucket* Bucket = Hash.Find(InHash);
 		if (Bucket)
 		{
@@ -366,14 +402,131 @@ public:
 		return NumRemoved;
 	}
 
-	FORCEINLINE void Lock()
+	/**
+	 * Locks a shard of the name hash tables. Nothing is locked if the current thread has locked all tables.
+	 * Shard locks are never held while locking anything else.
+	 *
+	 * @return true if the lock has been acquired and needs to be released with UnlockShard
+	 */
+	static FORCEINLINE bool LockShard(FUObjectHashShard& Shard, EHashTableLockType LockType)
+	{
+		if (ThreadLockAllDepth)
+		{
+			return false;
+		}
+		if (LockType == EHashTableLockType::Write)
+		{
+			Shard.Lock.WriteLock();
+		}
+		else
+		{
+			Shard.Lock.ReadLock();
+		}
+		return true;
+	}
+	static FORCEINLINE void UnlockShard(FUObjectHashShard& Shard, EHashTableLockType LockType)
+	{
+		if (LockType == EHashTableLockType::Write)
+		{
+			Shard.Lock.WriteUnlock();
+		}
+		else
+		{
+			Shard.Lock.ReadUnlock();
+		}
+	}
+
+	/**
+	 * Locks the outer, class and package maps. Write locks can be acquired recursively and are also used by functions that
+	 * call back into user code which may create, rename or find objects. Read locks are never held while calling user code.
+	 *
+	 * @return true if the lock has been acquired and needs to be released with UnlockRelations
+	 */
+	FORCEINLINE bool LockRelations(EHashTableLockType LockType)
+	{
+		if (LockType == EHashTableLockType::Write)
+		{
+			if (ThreadRelationsWriteDepth++ == 0)
+			{
+				RelationsLock.WriteLock();
+			}
+			return true;
+		}
+		else if (ThreadRelationsWriteDepth == 0)
+		{
+			RelationsLock.ReadLock();
+			return true;
+		}
+		// Already write locked by this thread
+		return false;
+	}
+	FORCEINLINE void UnlockRelations(EHashTableLockType LockType)
+	{
+		if (LockType == EHashTableLockType::Write)
+		{
+			if (--ThreadRelationsWriteDepth == 0)
+			{
+				RelationsLock.WriteUnlock();
+			}
+		}
+		else
+		{
+			RelationsLock.ReadUnlock();
+		}
+	}
+
+	/** Write locks all tables and maps. Can be called recursively. */
+	void LockAll()
 	{
-		CriticalSection.Lock();
+		LockRelations(EHashTableLockType::Write);
+		if (ThreadLockAllDepth++ == 0)
+		{
+			for (FUObjectHashShard& Shard : Shards)
+			{
+				Shard.Lock.WriteLock();
+			}
+		}
 	}
 
-	FORCEINLINE void Unlock()
+	void UnlockAll()
+	{
+		if (--ThreadLockAllDepth == 0)
+		{
+			for (FUObjectHashShard& Shard : Shards)
+			{
+				Shard.Lock.WriteUnlock();
+			}
+		}
+		UnlockRelations(EHashTableLockType::Write);
+	}
+
+	/**
+	 * Temporarily releases all locks taken by LockAll on this thread so that other threads can use the tables.
+	 *
+	 * @return the lock depth to pass to ResumeLockAll
+	 */
+	int32 SuspendLockAll()
+	{
+		const int32 Depth = ThreadLockAllDepth;
+		if (Depth)
+		{
+			checkf(ThreadRelationsWriteDepth == Depth, TEXT("Hash tables can't be unlocked while they're being iterated over (%d, %d)"), ThreadRelationsWriteDepth, Depth);
+			ThreadLockAllDepth = 1;
+			ThreadRelationsWriteDepth = 1;
+			UnlockAll();
+		}
+		return Depth;
+	}
+
+	/** Re-acquires the locks released by SuspendLockAll */
+	void ResumeLockAll(int32 Depth)
 	{
-		CriticalSection.Unlock();
+		if (Depth)
+		{
+			LockAll();
+			ThreadLockAllDepth = Depth;
+			ThreadRelationsWriteDepth = Depth;
+		}
 	}
 
 	static FUObjectHashTables& Get()
@@ -382,7 +535,10 @@ public:
 		return Singleton;
 	}
 };
+thread_local int32 FUObjectHashTables::ThreadLockAllDepth = 0;
+thread_local int32 FUObjectHashTables::ThreadRelationsWriteDepth = 0;
 
+/** Write locks all hash tables and maps */
 class FHashTableLock
 {
 #if THREADSAFE_UOBJECTS
@@ -392,25 +548,71 @@ public:
 	FORCEINLINE FHashTableLock(FUObjectHashTables& InTables)
 	{
 #if THREADSAFE_UOBJECTS
-		if (!(IsGarbageCollecting() && IsInGameThread()))
-		{
-			Tables = &InTables;
-			InTables.Lock();
-		}
-		else
+		Tables = &InTables;
+		InTables.LockAll();
+#else
+		check(IsInGameThread());
+#endif
+	}
+	FORCEINLINE ~FHashTableLock()
+	{
+#if THREADSAFE_UOBJECTS
+		Tables->UnlockAll();
+#endif
+	}
+};
+
+/** Locks a shard of the name hash tables */
+class FHashShardLock
+{
+#if THREADSAFE_UOBJECTS
+	FUObjectHashShard* Shard;
+	EHashTableLockType LockType;
+#endif
+public:
+	FORCEINLINE FHashShardLock(FUObjectHashShard& InShard, EHashTableLockType InLockType)
+	{
+#if THREADSAFE_UOBJECTS
+		Shard = FUObjectHashTables::LockShard(InShard, InLockType) ? &InShard : nullptr;
+		LockType = InLockType;
+#else
+		check(IsInGameThread());
+#endif
+	}
+	FORCEINLINE ~FHashShardLock()
+	{
+#if THREADSAFE_UOBJECTS
+		if (Shard)
 		{
-			Tables = nullptr;
+			FUObjectHashTables::UnlockShard(*Shard, LockType);
 		}
+#endif
+	}
+};
+
+/** Locks the outer, class and package maps */
+class FHashRelationsLock
+{
+#if THREADSAFE_UOBJECTS
+	FUObjectHashTables* Tables;
+	EHashTableLockType LockType;
+#endif
+public:
+	FORCEINLINE FHashRelationsLock(FUObjectHashTables& InTables, EHashTableLockType InLockType)
+	{
+#if THREADSAFE_UOBJECTS
+		Tables = InTables.LockRelations(InLockType) ? &InTables : nullptr;
+		LockType = InLockType;
 #else
 		check(IsInGameThread());
 #endif
 	}
-	FORCEINLINE ~FHashTableLock()
+	FORCEINLINE ~FHashRelationsLock()
 	{
 #if THREADSAFE_UOBJECTS
 		if (Tables)
 		{
-			Tables->Unlock();
+			Tables->UnlockRelations(LockType);
 		}
 #endif
 	}
@@ -446,8 +648,9 @@ UObject* StaticFindObjectFastExplicitThreadSafe(FUObjectHashTables& ThreadHash,
 
 	// Find an object with the specified name and (optional) class, in any package; if bAnyPackage is false, only matches top-level packages
 	int32 Hash = GetObjectHash(ObjectName);
-	FHashTableLock HashLock(ThreadHash);
-	FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
+	FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+	FHashShardLock HashLock(Shard, EHashTableLockType::Read);
+	FHashBucket* Bucket = Shard.Hash.Find(Hash);
 	if (Bucket)
 	{
 		for (FHashBucketIterator It(*Bucket); It; ++It)
@@ -574,11 +777,10 @@ UObject* StaticFindObjectInPackageInternal(FUObjectHashTables& ThreadHash, const
 {
 	ExclusiveInternalFlags |= EInternalObjectFlags::Unreachable;
 	UObject* Result = nullptr;
+	FHashRelationsLock RelationsLock(ThreadHash, EHashTableLockType::Read);
 	if (FHashBucket* Inners = ThreadHash.PackageToObjectListMap.Find(ObjectPackage))
 	{
-#if !UE_BUILD_SHIPPING
-		Inners->Lock();
-#endif // !UE_BUILD_SHIPPING
+		// Buckets can't be modified while the maps are read locked, and the bucket's ReadOnlyLock counter is not safe to touch from concurrent readers
 		for (FHashBucketIterator It(*Inners); It; ++It)
 		{
 			UObject* Object = static_cast<UObject*>(*It);
@@ -603,9 +805,6 @@ UObject* StaticFindObjectInPackageInternal(FUObjectHashTables& ThreadHash, const
 				break;
 			}
 		}
-#if !UE_BUILD_SHIPPING
-		Inners->Unlock();
-#endif // !UE_BUILD_SHIPPING
 	}
 	return Result;
 }
@@ -619,38 +818,42 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 	if (ObjectPackage != nullptr)
 	{
 		int32 Hash = GetObjectOuterHash(ObjectName, (PTRINT)ObjectPackage);
-		FHashTableLock HashLock(ThreadHash);
-		for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(ThreadHash.HashOuter, Hash); HashIt; ++HashIt)
 		{
-			UObject *Object = (UObject *)HashIt.Value();
-			if
-				/* check that the name matches the name we're searching for */
-				((Object->GetFName() == ObjectName)
+			// The shard must be unlocked before looking up external packages
+			FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+			FHashShardLock HashLock(Shard, EHashTableLockType::Read);
+			for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(Shard.HashOuter, Hash); HashIt; ++HashIt)
+			{
+				UObject *Object = (UObject *)HashIt.Value();
+				if
+					/* check that the name matches the name we're searching for */
+					((Object->GetFName() == ObjectName)
 
-				/* Don't return objects that have any of the exclusive flags set */
-				&& !Object->HasAnyFlags(ExcludeFlags)
+					/* Don't return objects that have any of the exclusive flags set */
+					&& !Object->HasAnyFlags(ExcludeFlags)
 
-				/* check that the object has the correct Outer */
-				&& Object->GetOuter() == ObjectPackage
+					/* check that the object has the correct Outer */
+					&& Object->GetOuter() == ObjectPackage
 
-				/** If a class was specified, check that the object is of the correct class */
-				&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
-				
-				/** Include (or not) pending kill objects */
-				&& !Object->HasAnyInternalFlags(ExclusiveInternalFlags))
-			{
-				checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
-				if (Result)
-				{
-					UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
-				}
-				else
+					/** If a class was specified, check that the object is of the correct class */
+					&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
+					
+					/** Include (or not) pending kill objects */
+					&& !Object->HasAnyInternalFlags(ExclusiveInternalFlags))
 				{
-					Result = Object;
-				}
+					checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
+					if (Result)
+					{
+						UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
+					}
+					else
+					{
+						Result = Object;
+					}
 #if (UE_BUILD_SHIPPING || UE_BUILD_TEST)
-				break;
+					break;
 #endif
+				}
 			}
 		}
 
@@ -667,9 +870,10 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 		FObjectSearchPath SearchPath(ObjectName);
 
 		const int32 Hash = GetObjectHash(SearchPath.Inner);
-		FHashTableLock HashLock(ThreadHash);
+		FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+		FHashShardLock HashLock(Shard, EHashTableLockType::Read);
 
-		FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
+		FHashBucket* Bucket = Shard.Hash.Find(Hash);
 		if (Bucket)
 		{
 			for (FHashBucketIterator It(*Bucket); It; ++It)
@@ -727,7 +931,7 @@ UObject* StaticFindObjectFastInternal(const UClass* ObjectClass, const UObject*
 	return Result;
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static void AddToOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	FHashBucket& Bucket = ThreadHash.ObjectOuterMap.FindOrAdd(Object->GetOuter());
@@ -735,7 +939,7 @@ FORCEINLINE static void AddToOuterMap(FUObjectHashTables& ThreadHash, UObjectBas
 	Bucket.Add(Object);
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	{
@@ -760,7 +964,7 @@ FORCEINLINE static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBas
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static void AddToPackageMap(FUObjectHashTables& ThreadHash, UObjectBase* Object, UPackage* Package)
 {
 	check(Package != nullptr);
@@ -769,7 +973,7 @@ FORCEINLINE static void AddToPackageMap(FUObjectHashTables& ThreadHash, UObjectB
 	Bucket.Add(Object);
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static UPackage* AssignExternalPackageToObject(FUObjectHashTables& ThreadHash, UObjectBase* Object, UPackage* Package)
 {
 	UPackage*& ExternalPackageRef = ThreadHash.ObjectToPackageMap.FindOrAdd(Object);
@@ -779,7 +983,7 @@ FORCEINLINE static UPackage* AssignExternalPackageToObject(FUObjectHashTables& T
 }
 
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static void RemoveFromOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	FHashBucket& Bucket = ThreadHash.ObjectOuterMap.FindOrAdd(Object->GetOuter());
@@ -793,7 +997,7 @@ FORCEINLINE static void RemoveFromOuterMap(FUObjectHashTables& ThreadHash, UObje
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	UObjectBaseUtility* ObjectWithUtility = static_cast<UObjectBaseUtility*>(Object);
@@ -833,7 +1037,7 @@ FORCEINLINE static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObje
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static void RemoveFromPackageMap(FUObjectHashTables& ThreadHash, UObjectBase* Object, UPackage* Package)
 {
 	check(Package != nullptr);
@@ -848,7 +1052,7 @@ FORCEINLINE static void RemoveFromPackageMap(FUObjectHashTables& ThreadHash, UOb
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
+// Assumes that ThreadHash's relation maps are already write locked
 FORCEINLINE static UPackage* UnassignExternalPackageFromObject(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	UPackage* OldPackage = nullptr;
@@ -901,7 +1105,7 @@ void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Resu
 	}
 	int32 StartNum = Results.Num();
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashRelationsLock HashLock(ThreadHash, EHashTableLockType::Read);
 	FHashBucket* Inners = ThreadHash.ObjectOuterMap.Find(Outer);
 	if (Inners)
 	{
@@ -959,7 +1163,8 @@ void ForEachObjectWithOuter(const class UObjectBase* Outer, TFunctionRef<void(UO
 		ExclusionInternalFlags |= EInternalObjectFlags::AsyncLoading;
 	}
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	// Operation may create or rename objects
+	FHashRelationsLock HashLock(ThreadHash, EHashTableLockType::Write);
 	TArray<FHashBucket*, TInlineAllocator<1> > AllInners;
 
 	if (FHashBucket* Inners = ThreadHash.ObjectOuterMap.Find(Outer))
@@ -1011,7 +1216,7 @@ UObjectBase* FindObjectWithOuter(const class UObjectBase* Outer, const class UCl
 	else
 	{
 		FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
+		FHashRelationsLock HashLock(ThreadHash, EHashTableLockType::Read);
 		FHashBucket* Inners = ThreadHash.ObjectOuterMap.Find(Outer);
 		if (Inners)
 		{
@@ -1034,16 +1239,12 @@ UObjectBase* FindObjectWithOuter(const class UObjectBase* Outer, const class UCl
 	return Result;
 }
 
-void GetObjectsWithPackage(const class UPackage* Package, TArray<UObject *>& Results, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
-{
-	ForEachObjectWithPackage(Package, [&Results](UObject* Object)
-	{
-		Results.Add(Object);
-		return true;
-	}, bIncludeNestedObjects, ExclusionFlags, ExclusionInternalFlags);
-}
-
-void ForEachObjectWithPackage(const class UPackage* Package, TFunctionRef<bool(UObject*)> Operation, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+/**
+ * Calls Operation for all objects in Package. Operations that may call user code need the maps to be write locked because
+ * user code may create or rename objects.
+ */
+template <typename OperationType>
+static void ForEachObjectWithPackage_Implementation(FUObjectHashTables& ThreadHash, const class UPackage* Package, OperationType Operation, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags, EHashTableLockType LockType)
 {
 	check(Package != nullptr);
 
@@ -1053,8 +1254,7 @@ void ForEachObjectWithPackage(const class UPackage* Package, TFunctionRef<bool(U
 	{
 		ExclusionInternalFlags |= EInternalObjectFlags::AsyncLoading;
 	}
-	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashRelationsLock HashLock(ThreadHash, LockType);
 	TArray<FHashBucket*, TInlineAllocator<1> > AllInners;
 
 	// Add the object bucket that have this package as an external package
@@ -1071,7 +1271,12 @@ void ForEachObjectWithPackage(const class UPackage* Package, TFunctionRef<bool(U
 	{
 		FHashBucket* Inners = AllInners.Pop();
 #if !UE_BUILD_SHIPPING
-		Inners->Lock();
+		// Buckets can only be modified while iterating if the maps are write locked
+		const bool bLockBucket = LockType == EHashTableLockType::Write;
+		if (bLockBucket)
+		{
+			Inners->Lock();
+		}
 #endif // !UE_BUILD_SHIPPING
 		for (FHashBucketIterator It(*Inners); It; ++It)
 		{
@@ -1099,11 +1304,28 @@ void ForEachObjectWithPackage(const class UPackage* Package, TFunctionRef<bool(U
 			}
 		}
 #if !UE_BUILD_SHIPPING
-		Inners->Unlock();
+		if (bLockBucket)
+		{
+			Inners->Unlock();
+		}
 #endif // !UE_BUILD_SHIPPING
 	}
 }
 
+void GetObjectsWithPackage(const class UPackage* Package, TArray<UObject *>& Results, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+{
+	ForEachObjectWithPackage_Implementation(FUObjectHashTables::Get(), Package, [&Results](UObject* Object)
+	{
+		Results.Add(Object);
+		return true;
+	}, bIncludeNestedObjects, ExclusionFlags, ExclusionInternalFlags, EHashTableLockType::Read);
+}
+
+void ForEachObjectWithPackage(const class UPackage* Package, TFunctionRef<bool(UObject*)> Operation, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+{
+	ForEachObjectWithPackage_Implementation(FUObjectHashTables::Get(), Package, Operation, bIncludeNestedObjects, ExclusionFlags, ExclusionInternalFlags, EHashTableLockType::Write);
+}
+
 /** Helper function that returns all the children of the specified class recursively */
 template<typename ClassType, typename ArrayAllocator>
 static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, const UClass* ParentClass, TArray<ClassType, ArrayAllocator>& OutAllDerivedClass)
@@ -1137,20 +1359,6 @@ static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, co
 	}
 }
 
-void GetObjectsOfClass(const UClass* ClassToLookFor, TArray<UObject *>& Results, bool bIncludeDerivedClasses, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
-{
-	SCOPE_CYCLE_COUNTER(STAT_Hash_GetObjectsOfClass);
-
-	ForEachObjectOfClass(ClassToLookFor,
-		[&Results](UObject* Object)
-		{
-			Results.Add(Object);
-		}
-	, bIncludeDerivedClasses, ExclusionFlags, ExclusionInternalFlags);
-
-	check(Results.Num() <= GUObjectArray.GetObjectArrayNum()); // otherwise we have a cycle in the outer chain, which should not be possible
-}
-
 FORCEINLINE void ForEachObjectOfClasses_Implementation(FUObjectHashTables& ThreadHash, TArrayView<const UClass*> ClassesToLookFor, TFunctionRef<void(UObject*)> Operation, EObjectFlags ExcludeFlags /*= RF_ClassDefaultObject*/, EInternalObjectFlags ExclusionInternalFlags /*= EInternalObjectFlags::None*/)
 {
 	// We don't want to return any objects that are currently being background loaded unless we're using the object iterator during async loading.
@@ -1177,14 +1385,15 @@ FORCEINLINE void ForEachObjectOfClasses_Implementation(FUObjectHashTables& Threa
 	}
 }
 
-void ForEachObjectOfClass(const UClass* ClassToLookFor, TFunctionRef<void(UObject*)> Operation, bool bIncludeDerivedClasses, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+/** Operations that may call user code need the maps to be write locked because user code may create or rename objects */
+static FORCEINLINE void ForEachObjectOfClass_Implementation(const UClass* ClassToLookFor, TFunctionRef<void(UObject*)> Operation, bool bIncludeDerivedClasses, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags, EHashTableLockType LockType)
 {
 	// Most classes searched for have around 10 subclasses, some have hundreds
 	TArray<const UClass*, TInlineAllocator<16>> ClassesToSearch;
 	ClassesToSearch.Add(ClassToLookFor);
 
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashRelationsLock HashLock(ThreadHash, LockType);
 
 	if (bIncludeDerivedClasses)
 	{
@@ -1194,10 +1403,30 @@ void ForEachObjectOfClass(const UClass* ClassToLookFor, TFunctionRef<void(UObjec
 	ForEachObjectOfClasses_Implementation(ThreadHash, ClassesToSearch, Operation, ExclusionFlags, ExclusionInternalFlags);
 }
 
+void GetObjectsOfClass(const UClass* ClassToLookFor, TArray<UObject *>& Results, bool bIncludeDerivedClasses, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Hash_GetObjectsOfClass);
+
+	// Adding to Results doesn't touch the hash tables so concurrent calls only need to read lock them
+	ForEachObjectOfClass_Implementation(ClassToLookFor,
+		[&Results](UObject* Object)
+		{
+			Results.Add(Object);
+		}
+	, bIncludeDerivedClasses, ExclusionFlags, ExclusionInternalFlags, EHashTableLockType::Read);
+
+	check(Results.Num() <= GUObjectArray.GetObjectArrayNum()); // otherwise we have a cycle in the outer chain, which should not be possible
+}
+
+void ForEachObjectOfClass(const UClass* ClassToLookFor, TFunctionRef<void(UObject*)> Operation, bool bIncludeDerivedClasses, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+{
+	ForEachObjectOfClass_Implementation(ClassToLookFor, Operation, bIncludeDerivedClasses, ExclusionFlags, ExclusionInternalFlags, EHashTableLockType::Write);
+}
+
 void ForEachObjectOfClasses(TArrayView<const UClass*> ClassesToLookFor, TFunctionRef<void(UObject*)> Operation, EObjectFlags ExcludeFlags /*= RF_ClassDefaultObject*/, EInternalObjectFlags ExclusionInternalFlags /*= EInternalObjectFlags::None*/)
 {
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashRelationsLock HashLock(ThreadHash, EHashTableLockType::Write);
 
 	ForEachObjectOfClasses_Implementation(ThreadHash, ClassesToLookFor, Operation, ExcludeFlags, ExclusionInternalFlags);
 }
@@ -1205,7 +1434,7 @@ void ForEachObjectOfClasses(TArrayView<const UClass*> ClassesToLookFor, TFunctio
 void GetDerivedClasses(const UClass* ClassToLookFor, TArray<UClass*>& Results, bool bRecursive)
 {
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashRelationsLock HashLock(ThreadHash, EHashTableLockType::Read);
 
 	if (bRecursive)
 	{
@@ -1227,7 +1456,7 @@ bool ClassHasInstancesAsyncLoading(const UClass* ClassToLookFor)
 	ClassesToSearch.Add(ClassToLookFor);
 
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashRelationsLock HashLock(ThreadHash, EHashTableLockType::Read);
 
 	RecursivelyPopulateDerivedClasses(ThreadHash, ClassToLookFor, ClassesToSearch);
 
@@ -1265,21 +1494,30 @@ void HashObject(UObjectBase* Object)
 		int32 Hash = 0;
 
 		FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
+		const PTRINT Outer = (PTRINT)Object->GetOuter();
 
-		Hash = GetObjectHash(Name);				
-		checkSlow(!ThreadHash.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
-		ThreadHash.AddToHash(Hash, Object);
+		// Shards are locked one at a time, never together with the relation maps
+		Hash = GetObjectHash(Name);
+		{
+			FHashShardLock HashLock(ThreadHash.GetShard(Hash), EHashTableLockType::Write);
+			checkSlow(!ThreadHash.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
+			ThreadHash.AddToHash(Hash, Object);
+		}
 
-		if (PTRINT Outer = (PTRINT)Object->GetOuter())
+		if (Outer)
 		{
 			Hash = GetObjectOuterHash(Name, Outer);
-			checkSlow(!ThreadHash.HashOuter.FindPair(Hash, Object));  // if it already exists, something is wrong with the external code
-			ThreadHash.HashOuter.Add(Hash, Object);
+			FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+			FHashShardLock HashLock(Shard, EHashTableLockType::Write);
+			checkSlow(!Shard.HashOuter.FindPair(Hash, Object));  // if it already exists, something is wrong with the external code
+			Shard.HashOuter.Add(Hash, Object);
+		}
 
+		FHashRelationsLock RelationsLock(ThreadHash, EHashTableLockType::Write);
+		if (Outer)
+		{
 			AddToOuterMap(ThreadHash, Object);
 		}
-
 		AddToClassMap( ThreadHash, Object );
 	}
 }
@@ -1300,25 +1538,35 @@ void UnhashObject(UObjectBase* Object)
 		int32 NumRemoved = 0;
 
 		FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock LockHash(ThreadHash);
+		const PTRINT Outer = (PTRINT)Object->GetOuter();
 
 		Hash = GetObjectHash(Name);
-		NumRemoved = ThreadHash.RemoveFromHash(Hash, Object);
+		{
+			FHashShardLock LockHash(ThreadHash.GetShard(Hash), EHashTableLockType::Write);
+			NumRemoved = ThreadHash.RemoveFromHash(Hash, Object);
+		}
 
 		// must have existed, else something is wrong with the external code
 		UE_CLOG(NumRemoved != 1, LogUObjectHash, Fatal, TEXT("Internal Error: RemoveFromHash NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
 
-		if (PTRINT Outer = (PTRINT)Object->GetOuter())
+		if (Outer)
 		{
 			Hash = GetObjectOuterHash(Name, Outer);
-			NumRemoved = ThreadHash.HashOuter.RemoveSingle(Hash, Object);
+			{
+				FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+				FHashShardLock LockHash(Shard, EHashTableLockType::Write);
+				NumRemoved = Shard.HashOuter.RemoveSingle(Hash, Object);
+			}
 
 			// must have existed, else something is wrong with the external code
 			UE_CLOG(NumRemoved != 1, LogUObjectHash, Fatal, TEXT("Internal Error: Remove from HashOuter NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
+		}
 
+		FHashRelationsLock RelationsLock(ThreadHash, EHashTableLockType::Write);
+		if (Outer)
+		{
 			RemoveFromOuterMap(ThreadHash, Object);
 		}
-
 		RemoveFromClassMap( ThreadHash, Object );
 	}
 }
@@ -1328,7 +1576,7 @@ void HashObjectExternalPackage(UObjectBase* Object, UPackage* Package)
 	if (Package)
 	{
 		FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock LockHash(ThreadHash);
+		FHashRelationsLock LockHash(ThreadHash, EHashTableLockType::Write);
 		UPackage* OldPackage = AssignExternalPackageToObject(ThreadHash, Object, Package);
 		if (OldPackage != Package)
 		{
@@ -1348,7 +1596,7 @@ void HashObjectExternalPackage(UObjectBase* Object, UPackage* Package)
 void UnhashObjectExternalPackage(class UObjectBase* Object)
 {
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock LockHash(ThreadHash);
+	FHashRelationsLock LockHash(ThreadHash, EHashTableLockType::Write);
 	UPackage* Package = UnassignExternalPackageFromObject(ThreadHash, Object);
 	if (Package)
 	{
@@ -1359,7 +1607,7 @@ void UnhashObjectExternalPackage(class UObjectBase* Object)
 UPackage* GetObjectExternalPackageThreadSafe(const UObjectBase* Object)
 {
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock LockHash(ThreadHash);
+	FHashRelationsLock LockHash(ThreadHash, EHashTableLockType::Read);
 	return ThreadHash.ObjectToPackageMap.FindRef(Object);
 }
 
@@ -1375,7 +1623,7 @@ UPackage* GetObjectExternalPackageInternal(const UObjectBase* Object)
 void LockUObjectHashTables()
 {
 #if THREADSAFE_UOBJECTS
-	FUObjectHashTables::Get().Lock();
+	FUObjectHashTables::Get().LockAll();
 #else
 	check(IsInGameThread());
 #endif
@@ -1387,145 +1635,184 @@ void LockUObjectHashTables()
 void UnlockUObjectHashTables()
 {
 #if THREADSAFE_UOBJECTS
-	FUObjectHashTables::Get().Unlock();
+	FUObjectHashTables::Get().UnlockAll();
 #else
 	check(IsInGameThread());
 #endif
 }
 
-void LogHashStatisticsInternal(TMultiMap<int32, UObjectBase*>& Hash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
+/**
+ * Temporarily releases UObject hash tables lock held by this thread (e.g. to let worker threads unhash objects during GC)
+ *
+ * @return lock depth to pass to ResumeUObjectHashTablesLock
+ */
+int32 SuspendUObjectHashTablesLock()
 {
-	TArray<int32> HashBuckets;
-	// Get the set of keys in use, which is the number of hash buckets
-	int32 SlotsInUse = Hash.GetKeys(HashBuckets);
+#if THREADSAFE_UOBJECTS
+	return FUObjectHashTables::Get().SuspendLockAll();
+#else
+	check(IsInGameThread());
+	return 0;
+#endif
+}
+
+/**
+ * Re-acquires UObject hash tables lock released by SuspendUObjectHashTablesLock
+ */
+void ResumeUObjectHashTablesLock(int32 LockDepth)
+{
+#if THREADSAFE_UOBJECTS
+	FUObjectHashTables::Get().ResumeLockAll(LockDepth);
+#else
+	check(IsInGameThread());
+#endif
+}
 
+void LogHashOuterStatisticsInternal(FUObjectHashTables& HashTables, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
+{
+	int32 SlotsInUse = 0;
 	int32 TotalCollisions = 0;
 	int32 MinCollisions = MAX_int32;
 	int32 MaxCollisions = 0;
 	int32 MaxBin = 0;
+	FUObjectHashShard* MaxBinShard = nullptr;
+	uint32 HashtableAllocatedSize = 0;
 
-	// Dump how many slots are in use
-	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
-
-	// Work through each slot and figure out how many collisions
-	for (auto HashBucket : HashBuckets)
+	for (FUObjectHashShard& Shard : HashTables.Shards)
 	{
-		int32 Collisions = 0;
+		TArray<int32> HashBuckets;
+		// Get the set of keys in use, which is the number of hash buckets
+		SlotsInUse += Shard.HashOuter.GetKeys(HashBuckets);
 
-		for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Hash, HashBucket); HashIt; ++HashIt)
+		// Work through each slot and figure out how many collisions
+		for (auto HashBucket : HashBuckets)
 		{
-			// There's one collision per object in a given bucket
-			Collisions++;
-		}
+			int32 Collisions = 0;
 
-		// Keep the global stats
-		TotalCollisions += Collisions;
-		if (Collisions > MaxCollisions)
-		{
-			MaxBin = HashBucket;
-		}
-		MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
-		MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
+			for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Shard.HashOuter, HashBucket); HashIt; ++HashIt)
+			{
+				// There's one collision per object in a given bucket
+				Collisions++;
+			}
 
-		if (bShowHashBucketCollisionInfo)
-		{
-			// Now log the output
-			Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashBucket, Collisions);
+			// Keep the global stats
+			TotalCollisions += Collisions;
+			if (Collisions > MaxCollisions)
+			{
+				MaxBin = HashBucket;
+				MaxBinShard = &Shard;
+			}
+			MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
+			MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
+
+			if (bShowHashBucketCollisionInfo)
+			{
+				// Now log the output
+				Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashBucket, Collisions);
+			}
 		}
+
+		HashtableAllocatedSize += Shard.HashOuter.GetAllocatedSize();
 	}
+
+	// Dump how many slots are in use
+	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
 	Ar.Logf(TEXT(""));
 
 	// Dump the first 30 objects in the worst bin for inspection
 	Ar.Logf(TEXT("Worst hash bucket contains:"));
-	int32 Count = 0;
-	for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Hash, MaxBin); HashIt && Count < 30; ++HashIt)
+	if (MaxBinShard)
 	{
-		UObject* Object = (UObject*)HashIt.Value();
-		Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
-		Count++;
+		int32 Count = 0;
+		for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(MaxBinShard->HashOuter, MaxBin); HashIt && Count < 30; ++HashIt)
+		{
+			UObject* Object = (UObject*)HashIt.Value();
+			Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
+			Count++;
+		}
 	}
 	Ar.Logf(TEXT(""));
 
 	// Now dump how efficient the hash is
 	Ar.Logf(TEXT("Collision Stats: Best Case (%d), Average Case (%d), Worst Case (%d)"),
 		MinCollisions,
-		FMath::FloorToInt(((float)TotalCollisions / (float)SlotsInUse)),
+		FMath::FloorToInt(((float)TotalCollisions / (float)FMath::Max(SlotsInUse, 1))),
 		MaxCollisions);
 
 	// Calculate Hashtable size
-	const uint32 HashtableAllocatedSize = Hash.GetAllocatedSize();
 	Ar.Logf(TEXT("Total memory allocated for Object Outer Hash: %u bytes."), HashtableAllocatedSize);
 }
 
-void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
+void LogHashStatisticsInternal(FUObjectHashTables& HashTables, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
 {
-	TArray<int32> HashBuckets;
-	// Get the set of keys in use, which is the number of hash buckets
-	int32 SlotsInUse = Hash.Num();
-
+	int32 SlotsInUse = 0;
 	int32 TotalCollisions = 0;
 	int32 MinCollisions = MAX_int32;
 	int32 MaxCollisions = 0;
-	int32 MaxBin = 0;
+	FHashBucket* WorstBucket = nullptr;
 	int32 NumBucketsWithMoreThanOneItem = 0;
+	uint32 HashtableAllocatedSize = 0;
 
-	// Dump how many slots are in use
-	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
-
-	// Work through each slot and figure out how many collisions
-	for (auto& HashPair : Hash)
+	for (FUObjectHashShard& Shard : HashTables.Shards)
 	{
-		int32 Collisions = HashPair.Value.Num();
-		check(Collisions >= 0);
-		if (Collisions > 1)
-		{
-			NumBucketsWithMoreThanOneItem++;
-		}
+		SlotsInUse += Shard.Hash.Num();
 
-		// Keep the global stats
-		TotalCollisions += Collisions;
-		if (Collisions > MaxCollisions)
+		// Work through each slot and figure out how many collisions
+		for (auto& HashPair : Shard.Hash)
 		{
-			MaxBin = HashPair.Key;
-		}
-		MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
-		MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
+			int32 Collisions = HashPair.Value.Num();
+			check(Collisions >= 0);
+			if (Collisions > 1)
+			{
+				NumBucketsWithMoreThanOneItem++;
+			}
 
-		if (bShowHashBucketCollisionInfo)
-		{
-			// Now log the output
-			Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashPair.Key, Collisions);
+			// Keep the global stats
+			TotalCollisions += Collisions;
+			if (Collisions > MaxCollisions)
+			{
+				WorstBucket = &HashPair.Value;
+			}
+			MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
+			MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
+
+			if (bShowHashBucketCollisionInfo)
+			{
+				// Now log the output
+				Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashPair.Key, Collisions);
+			}
+
+			// Calculate the size of a all Allocations inside of the buckets (TSet Items)
+			HashtableAllocatedSize += HashPair.Value.GetItemsSize();
 		}
+
+		HashtableAllocatedSize += Shard.Hash.GetAllocatedSize();
 	}
+
+	// Dump how many slots are in use
+	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
 	Ar.Logf(TEXT(""));
 
 	// Dump the first 30 objects in the worst bin for inspection
 	Ar.Logf(TEXT("Worst hash bucket contains:"));
-	int32 Count = 0;
-	FHashBucket& WorstBucket = Hash.FindChecked(MaxBin);
-	for (FHashBucketIterator It(WorstBucket); It; ++It)
+	if (WorstBucket)
 	{
-		UObject* Object = (UObject*)*It;
-		Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
-		Count++;
+		for (FHashBucketIterator It(*WorstBucket); It; ++It)
+		{
+			UObject* Object = (UObject*)*It;
+			Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
+		}
 	}
 	Ar.Logf(TEXT(""));
 
 	// Now dump how efficient the hash is
 	Ar.Logf(TEXT("Collision Stats: Best Case (%d), Average Case (%d), Worst Case (%d), Number of buckets with more than one item (%d/%d)"),
 		MinCollisions,
-		FMath::FloorToInt(((float)TotalCollisions / (float)SlotsInUse)),
+		FMath::FloorToInt(((float)TotalCollisions / (float)FMath::Max(SlotsInUse, 1))),
 		MaxCollisions,
 		NumBucketsWithMoreThanOneItem,
 		SlotsInUse);
 
-	// Calculate Hashtable size
-	uint32 HashtableAllocatedSize = Hash.GetAllocatedSize();
-	// Calculate the size of a all Allocations inside of the buckets (TSet Items)
-	for (auto& Pair : Hash)
-	{
-		HashtableAllocatedSize += Pair.Value.GetItemsSize();
-	}
 	Ar.Logf(TEXT("Total memory allocated for and by Object Hash: %u bytes."), HashtableAllocatedSize);
 }
 
@@ -1535,7 +1822,7 @@ void LogHashStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisionInf
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
 	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().Hash, Ar, bShowHashBucketCollisionInfo);
+	LogHashStatisticsInternal(FUObjectHashTables::Get(), Ar, bShowHashBucketCollisionInfo);
 	Ar.Logf(TEXT(""));
 }
 
@@ -1545,7 +1832,7 @@ void LogHashOuterStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisi
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
 	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().HashOuter, Ar, bShowHashBucketCollisionInfo);
+	LogHashOuterStatisticsInternal(FUObjectHashTables::Get(), Ar, bShowHashBucketCollisionInfo);
 	Ar.Logf(TEXT(""));
 
 	uint32 HashOuterMapSize = 0;
@@ -1568,10 +1855,14 @@ void LogHashMemoryOverheadStatistics(FOutputDevice& Ar, const bool bShowIndividu
 	int64 TotalSize = 0;
 	
 	{
-		int64 Size = HashTables.Hash.GetAllocatedSize();
-		for (const TPair<int32, FHashBucket>& Pair : HashTables.Hash)
+		int64 Size = 0;
+		for (const FUObjectHashShard& Shard : HashTables.Shards)
 		{
-			Size += Pair.Value.GetItemsSize();
+			Size += Shard.Hash.GetAllocatedSize();
+			for (const TPair<int32, FHashBucket>& Pair : Shard.Hash)
+			{
+				Size += Pair.Value.GetItemsSize();
+			}
 		}
 		if (bShowIndividualStats)
 		{
@@ -1581,7 +1872,11 @@ void LogHashMemoryOverheadStatistics(FOutputDevice& Ar, const bool bShowIndividu
 	}
 
 	{
-		int64 Size = HashTables.HashOuter.GetAllocatedSize();
+		int64 Size = 0;
+		for (const FUObjectHashShard& Shard : HashTables.Shards)
+		{
+			Size += Shard.HashOuter.GetAllocatedSize();
+		}
 		if (bShowIndividualStats)
 		{
 			Ar.Logf(TEXT("Memory used by UObject Outer Hash: %lld bytes."), Size);
@@ -112,6 +112,71 @@ private:
 	int64 Size;
 };
 
+/**
+ * Implements IBulkDataRangeRequest for both BulkData systems. A range is either mapped, or read through the IoDispatcher
+ * or an async file handle. A mapped range does not complete when it is mapped but once a thread pool worker has paged it
+ * in, so like a read its callback usually runs on another thread after MapRange has returned.
+ */
+class FBulkDataRangeRequest : public IBulkDataRangeRequest
+{
+public:
+	FBulkDataRangeRequest(FBulkDataRangeRequestCallBack* InCompleteCallback);
+
+	virtual ~FBulkDataRangeRequest();
+
+	/**
+	 * Maps a range of a file, returning false without completing the request if the platform file cannot map it. Whether
+	 * the platform should map files is up to the caller. The request completes once a worker has paged the range in.
+	 */
+	bool MapRange(const FString& Filename, int64 OffsetInFile, int64 BytesToRead);
+	/** Maps a range of an IoStore chunk of memory mapped payloads, completing like the file overload */
+	bool MapRange(const FIoChunkId& ChunkId, int64 OffsetInChunk, int64 BytesToRead);
+
+	/** Reads a range of a file, returning false if the read could not be made */
+	bool ReadRange(const FString& Filename, int64 OffsetInFile, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags, uint8* UserSuppliedMemory);
+	/** Reads a range of an IoStore chunk */
+	void ReadRange(const FIoChunkId& ChunkId, int64 OffsetInChunk, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags, uint8* UserSuppliedMemory);
+
+	virtual bool PollCompletion() const override;
+	virtual bool WaitCompletion(float TimeLimitSeconds = 0.0f) override;
+
+	virtual TIoStatusOr<FIoBuffer> GetResult() override;
+	virtual bool IsMemoryMapped() const override;
+
+	virtual void Cancel() override;
+
+private:
+	void CompleteMappedRequest(int64 BytesToRead);
+	void CompleteRequest(EIoErrorCode ErrorCode, const FIoBuffer& Buffer);
+
+	FBulkDataRangeRequestCallBack CompleteCallback;
+
+	/** Only set when the range is read through the IoDispatcher */
+	FIoRequest IoRequest;
+
+	/** Only set when the range is read from a file */
+	IAsyncReadFileHandle* FileHandle = nullptr;
+	IAsyncReadRequest* FileRequest = nullptr;
+
+	/** Only set when the range is mapped, the handle is not owned when it comes from the IoDispatcher */
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+	bool bOwnsMappedHandle = false;
+
+	FIoBuffer Result;
+	EIoErrorCode ResultErrorCode = EIoErrorCode::Unknown;
+
+	/** Set once a mapping or a read has been made, after which the request always completes */
+	bool bIsIssued = false;
+	/** Set before the callback is invoked, so the result can be read from it */
+	bool bDataIsReady = false;
+	bool bIsCompleted = false;
+	bool bIsCanceled = false;
+
+	/** Only actually gets created if WaitCompletion is called. */
+	FEvent* DoneEvent = nullptr;
+};
+
 #if USE_BULKDATA_STREAMING_TOKEN 
 /**
  * Some areas of code currently find FUntypedBulkData too bloated for use so were storing smaller parts of it
@@ -288,6 +353,7 @@ private:
 
 public:
 	friend class FLinkerLoad;
+	friend class FBulkDataCreateRangeRequestTest;
 	using BulkDataRangeArray = TArray<FBulkDataStreamingToken*, TInlineAllocator<8>>;
 
 	/*-----------------------------------------------------------------------------
@@ -668,6 +734,19 @@ public:
 	 */
 	IBulkDataIORequest* CreateStreamingRequest(int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* CompleteCallback, uint8* UserSuppliedMemory) const;
 
+	/**
+	 * Create a request for a range of the bulk data, which is read into memory or mapped. See IBulkDataRangeRequest for details.
+	 *
+	 * @param OffsetInBulkData		Offset into the bulk data to start reading from.
+	 * @param BytesToRead			The number of bytes to read, the range must be fully contained in the bulk data.
+	 * @param Priority				Priority and flags of the request.
+	 * @param CompleteCallback		Called from an arbitrary thread when the request is complete, a mapped range completes once it has been paged in. Can be nullptr. It will always be called.
+	 * @param UserSuppliedMemory	A pointer to memory for the range to be read into, in which case the range is never mapped. If the pointer is null then the memory is allocated or mapped instead.
+	 * @param bAllowMemoryMapping	Whether the range should be mapped rather than read when the platform supports it, falling back to reading if it cannot be mapped.
+	 * @return						A request for the range. This is owned by the caller and must be deleted by the caller.
+	 */
+	IBulkDataRangeRequest* CreateRangeRequest(int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority, FBulkDataRangeRequestCallBack* CompleteCallback, uint8* UserSuppliedMemory = nullptr, bool bAllowMemoryMapping = false) const;
+
 #if USE_BULKDATA_STREAMING_TOKEN 
 
 	/**
@@ -788,6 +867,9 @@ private:
 	/** Returns if the offset needs fixing when serialized */
 	bool NeedsOffsetFixup() const;
 
+	/** Returns the file to stream the bulk data from and its offset in that file, adjusted if the bulk data still references a uasset or umap */
+	FString GetStreamingFilename(int64& OutOffsetInFile) const;
+
 	/*-----------------------------------------------------------------------------
 		Member variables.
 	-----------------------------------------------------------------------------*/
@@ -41,6 +41,34 @@ public:
 	virtual void Cancel() = 0;
 };
 
+/**
+ * Represents a request for a range of a BulkData payload, see FBulkDataBase::CreateRangeRequest.
+ *
+ * Unlike IBulkDataIORequest the result is a FIoBuffer, which either owns the memory the range was read into or
+ * is a view of the memory supplied by the caller or of a memory mapping of the payload. A mapping is owned by
+ * the request so its views are only valid until the request is deleted.
+ */
+class COREUOBJECT_API IBulkDataRangeRequest
+{
+public:
+	virtual ~IBulkDataRangeRequest() {}
+
+	virtual bool PollCompletion() const = 0;
+	virtual bool WaitCompletion(float TimeLimitSeconds = 0.0f) = 0;
+
+	/**
+	 * Returns the range once the request has completed, or why it failed (EIoErrorCode::Cancelled if it was canceled).
+	 * Memory owned by the buffer can be taken with FIoBuffer::Release, otherwise it is freed with the last copy of the buffer.
+	 */
+	virtual TIoStatusOr<FIoBuffer> GetResult() = 0;
+
+	/** Returns true if the range is a view of a memory mapping rather than memory it was read into */
+	virtual bool IsMemoryMapped() const = 0;
+
+	/** Cancels the request, which still has to complete before it can be deleted */
+	virtual void Cancel() = 0;
+};
+
 struct FBulkDataOrId
 {
 	using FileToken = uint64;
@@ -99,6 +127,11 @@ DECLARE_INTRINSIC_TYPE_LAYOUT(FBulkDataAllocation);
  */
 typedef TFunction<void(bool bWasCancelled, IBulkDataIORequest*)> FBulkDataIORequestCallBack;
 
+/**
+ * Callback to use when making range requests
+ */
+typedef TFunction<void(bool bWasCancelled, IBulkDataRangeRequest*)> FBulkDataRangeRequestCallBack;
+
 /**
  * @documentation @todo documentation
  */
@@ -193,6 +226,24 @@ public:
 
 	static IBulkDataIORequest* CreateStreamingRequestForRange(const BulkDataRangeArray& RangeArray, EAsyncIOPriorityAndFlags Priority, FBulkDataIORequestCallBack* CompleteCallback);
 
+	/**
+	 * Creates a request for a range of the payload, which can be used to stream large payloads in chunks.
+	 *
+	 * Payloads cooked to be memory mapped are always mapped rather than read, unless memory is supplied. Payloads in
+	 * loose or pak files can also be mapped when the platform supports it, IoStore containers only map memory mapped
+	 * payloads. The range is read instead whenever mapping fails. A mapped range completes once a worker has paged it in.
+	 * The callback can be invoked before this returns.
+	 *
+	 * @param OffsetInBulkData Offset of the range from the start of the payload
+	 * @param BytesToRead Size of the range
+	 * @param Priority Priority and flags of the read
+	 * @param CompleteCallback Optional callback invoked once the request has completed
+	 * @param UserSuppliedMemory Optional memory to read the range into, it must be at least BytesToRead in size
+	 * @param bAllowMemoryMapping Whether ranges of payloads that were not cooked to be memory mapped can be mapped
+	 * @return The request, which must be deleted by the caller, or nullptr if the request could not be made
+	 */
+	IBulkDataRangeRequest* CreateRangeRequest(int64 OffsetInBulkData, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority, FBulkDataRangeRequestCallBack* CompleteCallback, uint8* UserSuppliedMemory = nullptr, bool bAllowMemoryMapping = false) const;
+
 	void RemoveBulkData();
 
 	/**
@@ -226,6 +277,7 @@ public:
 
 private:
 	friend FBulkDataAllocation;
+	friend class FBulkDataCreateRangeRequestTest;
 
 	FIoChunkId CreateChunkId() const;
 
@@ -598,6 +598,63 @@ private:
 		ReferenceProcessor.HandleTokenStreamObjectReference(NewObjectsToSerialize, CurrentObject, WeakObject, ReferenceTokenStreamIndex, true);
 	}
 
+	/**
+	 * Handles a contiguous array of object references. Pointers are checked in batches so that null references are skipped
+	 * cheaply and the referenced objects of a batch are prefetched before they're processed.
+	 */
+	FORCEINLINE void HandleObjectReferenceArray(UObject** Objects, int32 NumObjects, TArray<UObject*>& NewObjectsToSerialize, UObject* CurrentObject, int32 ReferenceTokenStreamIndex)
+	{
+		constexpr int32 BatchSize = 4;
+		int32 ObjectIndex = 0;
+		if (GGCTokenStreamFastPathsEnabled)
+		{
+			for (; ObjectIndex + BatchSize <= NumObjects; ObjectIndex += BatchSize)
+			{
+				UObject** Batch = Objects + ObjectIndex;
+				if (((UPTRINT)Batch[0] | (UPTRINT)Batch[1] | (UPTRINT)Batch[2] | (UPTRINT)Batch[3]) == 0)
+				{
+					continue;
+				}
+				for (int32 BatchIndex = 0; BatchIndex < BatchSize; ++BatchIndex)
+				{
+					FPlatformMisc::Prefetch(Batch[BatchIndex]);
+				}
+				for (int32 BatchIndex = 0; BatchIndex < BatchSize; ++BatchIndex)
+				{
+					if (Batch[BatchIndex])
+					{
+						ReferenceProcessor.HandleTokenStreamObjectReference(NewObjectsToSerialize, CurrentObject, Batch[BatchIndex], ReferenceTokenStreamIndex, true);
+					}
+				}
+			}
+		}
+		for (; ObjectIndex < NumObjects; ++ObjectIndex)
+		{
+			ReferenceProcessor.HandleTokenStreamObjectReference(NewObjectsToSerialize, CurrentObject, Objects[ObjectIndex], ReferenceTokenStreamIndex, true);
+		}
+	}
+
+	/**
+	 * Handles an array of structs that only contain object references (GCRT_ArrayStructObjects).
+	 *
+	 * @param FirstTokenIndex Index of the first object reference token of the struct
+	 * @param EndTokenIndex Index of the first token after the struct's tokens
+	 */
+	FORCEINLINE void HandleObjectOnlyStructArray(uint8* Data, int32 Num, uint32 Stride, FGCReferenceTokenStream* TokenStream, uint32 FirstTokenIndex, uint32 EndTokenIndex, TArray<UObject*>& NewObjectsToSerialize, UObject* CurrentObject)
+	{
+		for (int32 ElementIndex = 0; ElementIndex < Num; ++ElementIndex, Data += Stride)
+		{
+			for (uint32 TokenIndex = FirstTokenIndex; TokenIndex < EndTokenIndex; ++TokenIndex)
+			{
+				UObject*& Object = *(UObject**)(Data + TokenStream->AccessReferenceInfo(TokenIndex).Offset);
+				if (Object)
+				{
+					ReferenceProcessor.HandleTokenStreamObjectReference(NewObjectsToSerialize, CurrentObject, Object, TokenIndex, true);
+				}
+			}
+		}
+	}
+
 	/**
 	 * Traverses UObject token stream to find existing references
 	 *
@@ -756,10 +813,7 @@ private:
 						// We're dealing with an array of object references.
 						TArray<UObject*>& ObjectArray = *((TArray<UObject*>*)(StackEntryData + ReferenceInfo.Offset));
 						TokenReturnCount = ReferenceInfo.ReturnCount;
-						for (int32 ObjectIndex = 0, ObjectNum = ObjectArray.Num(); ObjectIndex < ObjectNum; ++ObjectIndex)
-						{
-							ReferenceProcessor.HandleTokenStreamObjectReference(NewObjectsToSerialize, CurrentObject, ObjectArray[ObjectIndex], ReferenceTokenStreamIndex, true);
-						}
+						HandleObjectReferenceArray(ObjectArray.GetData(), ObjectArray.Num(), NewObjectsToSerialize, CurrentObject, ReferenceTokenStreamIndex);
 					}
 					break;
 					case GCRT_ArrayObjectFreezable:
@@ -767,12 +821,24 @@ private:
 						// We're dealing with an array of object references.
 						TArray<UObject*, FMemoryImageAllocator>& ObjectArray = *((TArray<UObject*, FMemoryImageAllocator>*)(StackEntryData + ReferenceInfo.Offset));
 						TokenReturnCount = ReferenceInfo.ReturnCount;
-						for (int32 ObjectIndex = 0, ObjectNum = ObjectArray.Num(); ObjectIndex < ObjectNum; ++ObjectIndex)
-						{
-							ReferenceProcessor.HandleTokenStreamObjectReference(NewObjectsToSerialize, CurrentObject, ObjectArray[ObjectIndex], ReferenceTokenStreamIndex, true);
-						}
+						HandleObjectReferenceArray(ObjectArray.GetData(), ObjectArray.Num(), NewObjectsToSerialize, CurrentObject, ReferenceTokenStreamIndex);
 					}
 					break;
+					case GCRT_ArrayStructObjects:
+					if (GGCTokenStreamFastPathsEnabled)
+					{
+						// We're dealing with a dynamic array of structs that only contain object references. Handle all of them here instead of stepping into the array.
+						const FScriptArray& Array = *((FScriptArray*)(StackEntryData + ReferenceInfo.Offset));
+						const uint32 Stride = TokenStream->ReadStride(TokenStreamIndex);
+						const FGCSkipInfo SkipInfo = TokenStream->ReadSkipInfo(TokenStreamIndex);
+						HandleObjectOnlyStructArray((uint8*)Array.GetData(), Array.Num(), Stride, TokenStream, TokenStreamIndex, SkipInfo.SkipIndex, NewObjectsToSerialize, CurrentObject);
+
+						// Continue after the array like when skipping an empty array, minus the return from the array's stack entry which hasn't been pushed
+						TokenStreamIndex = SkipInfo.SkipIndex;
+						TokenReturnCount = TokenStream->GetSkipReturnCount(SkipInfo) - 1;
+						break;
+					}
+					// Intentional fall-through when fast paths are disabled, the token layout is the same as GCRT_ArrayStruct
 					case GCRT_ArrayStruct:
 					{
 						// We're dealing with a dynamic array of structs.
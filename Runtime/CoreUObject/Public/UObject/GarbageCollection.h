@@ -73,6 +73,7 @@ enum EGCReferenceType
 	GCRT_ArrayDelegate,
 	GCRT_MulticastDelegate,
 	GCRT_ArrayMulticastDelegate,
+	GCRT_ArrayStructObjects,			// GCRT_ArrayStruct whose structs only contain object references, see FGCReferenceTokenStream::Optimize
 };
 
 /** 
@@ -307,6 +308,12 @@ struct FGCReferenceTokenStream
 	 */
 	void Fixup(void (*AddReferencedObjectsPtr)(UObject*, class FReferenceCollector&), bool bKeepOuterToken, bool bKeepClassToken);
 
+	/**
+	 * Replaces tokens that have a faster specialized version in TFastReferenceCollector, e.g. arrays of structs that only contain
+	 * object references. Doesn't change the stream layout so it can be called again after more tokens have been emitted.
+	 */
+	void Optimize();
+
 	/**
 	 * Reads count and advances stream.
 	 *
@@ -525,4 +532,7 @@ extern COREUOBJECT_API FThreadSafeBool GIsGarbageCollecting;
 FORCEINLINE bool IsGarbageCollecting()
 {
 	return GIsGarbageCollecting;
-}
\ No newline at end of file
+}
+
+/** True if TFastReferenceCollector uses the specialized paths for object arrays and optimized token stream tokens (gc.TokenStreamFastPaths) */
+extern COREUOBJECT_API bool GGCTokenStreamFastPathsEnabled;
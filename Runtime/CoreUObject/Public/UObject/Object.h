@@ -485,6 +485,15 @@ public:
 	*/
 	virtual bool IsDestructionThreadSafe() const;
 
+	/**
+	* Called during garbage collection to determine if BeginDestroy, IsReadyForFinishDestroy and FinishDestroy can be called on
+	* worker threads, in parallel with other objects that return true. They must not touch state shared with other objects without
+	* synchronization. Only used when gc.ParallelDestruction is enabled.
+	*
+	* @return	true if this object's BeginDestroy and FinishDestroy are thread safe
+	*/
+	virtual bool IsBeginAndFinishDestroyThreadSafe() const;
+
 	/**
 	* Called during cooking. Must return all objects that will be Preload()ed when this is serialized at load time. Only used by the EDL.
 	*
@@ -35,6 +35,15 @@ FAutoConsoleVariableRef CVarMaxConcurrentStreams(
 	TEXT("0: Not Overridden, >0 Overridden"),
 	ECVF_Default);
 
+static int32 MemoryMapStreamedChunksCvar = 1;
+FAutoConsoleVariableRef CVarMemoryMapStreamedChunks(
+	TEXT("au.MemoryMapStreamedChunks"),
+	MemoryMapStreamedChunksCvar,
+	TEXT("Maps streamed chunks instead of reading them into memory, only on platforms that support memory mapped audio (IOS).\n")
+	TEXT("A mapped chunk completes once a worker has paged it in. It holds no heap memory, so it is not counted in STAT_AudioMemory.\n")
+	TEXT("0: Disabled, 1: Enabled"),
+	ECVF_Default);
+
 
 /*------------------------------------------------------------------------------
 	Streaming chunks from the derived data cache.
@@ -211,7 +220,8 @@ bool FStreamingWaveData::UpdateStreamingStatus()
 			// could maybe iterate over the things we know are done, but I couldn't tell if that was IndicesToLoad or not.
 			for (FLoadedAudioChunk& LoadedChunk : LoadedChunks)
 			{
-				if (LoadedChunk.IORequest != nullptr)
+				// Requests of mapped chunks own the mapping so they are kept until the chunk is freed
+				if (LoadedChunk.IORequest != nullptr && !LoadedChunk.bMemoryMapped)
 				{
 					LoadedChunk.IORequest->WaitCompletion();
 
@@ -355,15 +365,18 @@ void FStreamingWaveData::BeginPendingRequests(const TArray<uint32>& IndicesToLoa
 				check(!ChunkStorage->Data); // Make sure we do not already have data
 				check(Chunk.BulkData.GetBulkDataSize() == ChunkStorage->DataSize); // Make sure that the bulkdata size matches
 				
-				FBulkDataIORequestCallBack AsyncFileCallBack =
-					[this, LoadedChunkStorageIndex](bool bWasCancelled, IBulkDataIORequest* Req)
+				FBulkDataRangeRequestCallBack AsyncFileCallBack =
+					[this, LoadedChunkStorageIndex](bool bWasCancelled, IBulkDataRangeRequest* Req)
 				{
 					AudioStreamingManager->OnAsyncFileCallback(this, LoadedChunkStorageIndex, Req);
 
 					PendingChunkChangeRequestStatus.Decrement();
 				};
 
-				ChunkStorage->IORequest = Chunk.BulkData.CreateStreamingRequest(AsyncIOPriority, &AsyncFileCallBack, nullptr);
+				// A mapped chunk can be paged out by the OS instead of holding a copy of it for as long as it is loaded
+				const bool bAllowMemoryMapping = MemoryMapStreamedChunksCvar != 0 && FPlatformProperties::SupportsMemoryMappedAudio();
+
+				ChunkStorage->IORequest = Chunk.BulkData.CreateRangeRequest(0, ChunkSize, AsyncIOPriority, &AsyncFileCallBack, nullptr, bAllowMemoryMapping);
 
 				if (!ChunkStorage->IORequest)
 				{
@@ -372,6 +385,11 @@ void FStreamingWaveData::BeginPendingRequests(const TArray<uint32>& IndicesToLoa
 					// we failed for some reason; file not found I guess.
 					PendingChunkChangeRequestStatus.Decrement();
 				}
+				else
+				{
+					// Known before the request completes, mapped requests complete on a worker once the chunk is paged in
+					ChunkStorage->bMemoryMapped = ChunkStorage->IORequest->IsMemoryMapped();
+				}
 			}
 		}
 
@@ -397,8 +415,12 @@ bool FStreamingWaveData::BlockTillAllRequestsFinished(float TimeLimit)
 			{
 				LoadedChunk.IORequest->WaitCompletion();
 
-				delete LoadedChunk.IORequest;
-				LoadedChunk.IORequest = nullptr;
+				// Requests of mapped chunks own the mapping so they are kept until the chunk is freed
+				if (!LoadedChunk.bMemoryMapped)
+				{
+					delete LoadedChunk.IORequest;
+					LoadedChunk.IORequest = nullptr;
+				}
 			}
 		}
 	}
@@ -407,7 +429,7 @@ bool FStreamingWaveData::BlockTillAllRequestsFinished(float TimeLimit)
 		double EndTime = FPlatformTime::Seconds() + TimeLimit;
 		for (FLoadedAudioChunk& LoadedChunk : LoadedChunks)
 		{
-			if (LoadedChunk.IORequest)
+			if (LoadedChunk.IORequest && !LoadedChunk.IORequest->PollCompletion())
 			{
 				float ThisTimeLimit = EndTime - FPlatformTime::Seconds();
 				if (ThisTimeLimit < .001f || // one ms is the granularity of the platform event system
@@ -415,6 +437,9 @@ bool FStreamingWaveData::BlockTillAllRequestsFinished(float TimeLimit)
 				{
 					return false;
 				}
+			}
+			if (LoadedChunk.IORequest && !LoadedChunk.bMemoryMapped)
+			{
 				delete LoadedChunk.IORequest;
 				LoadedChunk.IORequest = nullptr;
 			}
@@ -466,7 +491,8 @@ void FStreamingWaveData::FreeLoadedChunk(FLoadedAudioChunk& LoadedChunk)
 		AudioStreamingManager->ProcessPendingAsyncFileResults();
 	}
 
-	if (LoadedChunk.Data != NULL)
+	// The mapping of a mapped chunk went away with its request
+	if (LoadedChunk.Data != NULL && !LoadedChunk.bMemoryMapped)
 	{
 		FMemory::Free(LoadedChunk.Data);
 
@@ -477,6 +503,7 @@ void FStreamingWaveData::FreeLoadedChunk(FLoadedAudioChunk& LoadedChunk)
 	LoadedChunk.AudioDataSize = 0;
 	LoadedChunk.DataSize = 0;
 	LoadedChunk.Index = 0;
+	LoadedChunk.bMemoryMapped = false;
 }
 
 ////////////////////////////
@@ -491,12 +518,16 @@ FLegacyAudioStreamingManager::~FLegacyAudioStreamingManager()
 {
 }
 
-void FLegacyAudioStreamingManager::OnAsyncFileCallback(FStreamingWaveData* StreamingWaveData, int32 LoadedAudioChunkIndex, IBulkDataIORequest* ReadRequest)
+void FLegacyAudioStreamingManager::OnAsyncFileCallback(FStreamingWaveData* StreamingWaveData, int32 LoadedAudioChunkIndex, IBulkDataRangeRequest* ReadRequest)
 {
 	// Check to see if we successfully managed to load anything
-	uint8* Mem = ReadRequest->GetReadResults();
-	if (Mem)
+	TIoStatusOr<FIoBuffer> Result = ReadRequest->GetResult();
+	if (Result.IsOk())
 	{
+		// Take the memory the chunk was read into, a view of a mapping stays owned by the request
+		FIoBuffer Buffer = Result.ConsumeValueOrDie();
+		uint8* Mem = Buffer.IsMemoryOwned() ? Buffer.Release().ConsumeValueOrDie() : Buffer.Data();
+
 		// Create a new chunk load result object. Will be deleted on audio thread when TQueue is pumped.
 		FASyncAudioChunkLoadResult* NewAudioChunkLoadResult = new FASyncAudioChunkLoadResult();
 
@@ -542,9 +573,12 @@ void FLegacyAudioStreamingManager::ProcessPendingAsyncFileResults()
 
 		ChunkStorage->Data = AudioChunkLoadResult->DataResults;
 
-		DEC_MEMORY_STAT_BY(STAT_AsyncFileMemory, ChunkStorage->DataSize);
-		INC_DWORD_STAT_BY(STAT_AudioMemorySize, ChunkStorage->DataSize);
-		INC_DWORD_STAT_BY(STAT_AudioMemory, ChunkStorage->DataSize);
+		if (!ChunkStorage->bMemoryMapped)
+		{
+			DEC_MEMORY_STAT_BY(STAT_AsyncFileMemory, ChunkStorage->DataSize);
+			INC_DWORD_STAT_BY(STAT_AudioMemorySize, ChunkStorage->DataSize);
+			INC_DWORD_STAT_BY(STAT_AudioMemory, ChunkStorage->DataSize);
+		}
 
 		// Cleanup the chunk load results
 		delete AudioChunkLoadResult;
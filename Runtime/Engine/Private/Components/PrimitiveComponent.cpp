@@ -31,6 +31,7 @@
 #include "Streaming/TextureStreamingHelpers.h"
 #include "PrimitiveSceneProxy.h"
 #include "Algo/Copy.h"
+#include "Misc/MemStack.h"
 #include "UObject/RenderingObjectVersion.h"
 #include "UObject/FortniteMainBranchObjectVersion.h"
 #include "EngineModule.h"
@@ -56,7 +57,9 @@ namespace PrimitiveComponentStatics
 	static const FText MobilityWarnText = LOCTEXT("InvalidMove", "move");
 }
 
-typedef TArray<const FOverlapInfo*, TInlineAllocator<8>> TInlineOverlapPointerArray;
+typedef TArray<const FOverlapInfo*, TInlineAllocator<8, TFrameAllocator<>>> TInlineOverlapPointerArray;
+// Overlap temporaries rebuilt on every move; anything that spills past the inline storage goes to the frame allocator.
+typedef TArray<FOverlapInfo, TInlineAllocator<3, TFrameAllocator<>>> TFrameOverlapInfoArray;
 
 DEFINE_LOG_CATEGORY_STATIC(LogPrimitiveComponent, Log, All);
 
@@ -2134,7 +2137,7 @@ bool UPrimitiveComponent::MoveComponentImpl( const FVector& Delta, const FQuat&
 	bool bMoved = false;
 	bool bIncludesOverlapsAtEnd = false;
 	bool bRotationOnly = false;
-	TInlineOverlapInfoArray PendingOverlaps;
+	TFrameOverlapInfoArray PendingOverlaps;
 	AActor* const Actor = GetOwner();
 
 	if ( !bSweep )
@@ -2342,7 +2345,7 @@ bool UPrimitiveComponent::MoveComponentImpl( const FVector& Delta, const FQuat&
 		{
 			if (bIncludesOverlapsAtEnd)
 			{
-				TInlineOverlapInfoArray OverlapsAtEndLocation;
+				TFrameOverlapInfoArray OverlapsAtEndLocation;
 				bool bHasEndOverlaps = false;
 				if (bRotationOnly)
 				{
@@ -3177,7 +3180,7 @@ bool UPrimitiveComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPending
 			}
 
 			// now generate full list of new touches, so we can compare to existing list and determine what changed
-			TInlineOverlapInfoArray OverlapMultiResult;
+			TFrameOverlapInfoArray OverlapMultiResult;
 			TInlineOverlapPointerArray NewOverlappingComponentPtrs;
 
 			// If pending kill, we should not generate any new overlaps. Also not if overlaps were just disabled during BeginComponentOverlap.
@@ -3268,7 +3271,7 @@ bool UPrimitiveComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPending
 				if (NumOldOverlaps > 0)
 				{
 					// Now we have to make a copy of the overlaps because we can't keep pointers to them, that list is about to be manipulated in EndComponentOverlap().
-					TInlineOverlapInfoArray OldOverlappingComponents;
+					TFrameOverlapInfoArray OldOverlappingComponents;
 					OldOverlappingComponents.SetNumUninitialized(NumOldOverlaps);
 					for (int32 i=0; i < NumOldOverlaps; i++)
 					{
@@ -3378,7 +3381,7 @@ void UPrimitiveComponent::ClearComponentOverlaps(bool bDoNotifies, bool bSkipNot
 	if (OverlappingComponents.Num() > 0)
 	{
 		// Make a copy since EndComponentOverlap will remove items from OverlappingComponents.
-		const TInlineOverlapInfoArray OverlapsCopy(OverlappingComponents);
+		const TFrameOverlapInfoArray OverlapsCopy(OverlappingComponents);
 		for (const FOverlapInfo& OtherOverlap : OverlapsCopy)
 		{
 			EndComponentOverlap(OtherOverlap, bDoNotifies, bSkipNotifySelf);
@@ -34,6 +34,7 @@
 #include "Interfaces/ITargetPlatform.h"
 #include "DeviceProfiles/DeviceProfile.h"
 #include "Net/Core/PushModel/PushModel.h"
+#include "Misc/MemStack.h"
 
 #if WITH_EDITOR
 #include "Settings/LevelEditorViewportSettings.h"	// For legacy post edit move behavior
@@ -51,6 +52,9 @@ namespace SceneComponentStatics
 
 DEFINE_LOG_CATEGORY_STATIC(LogSceneComponent, Log, All);
 
+// End overlaps gathered while a scoped movement update is applied; spills past the inline storage go to the frame allocator.
+typedef TArray<FOverlapInfo, TInlineAllocator<3, TFrameAllocator<>>> TFrameOverlapInfoArray;
+
 DECLARE_CYCLE_STAT(TEXT("UpdateComponentToWorld"), STAT_UpdateComponentToWorld, STATGROUP_Component);
 DECLARE_CYCLE_STAT(TEXT("UpdateChildTransforms"), STAT_UpdateChildTransforms, STATGROUP_Component);
 DECLARE_CYCLE_STAT(TEXT("Component CalcBounds"), STAT_ComponentCalcBounds, STATGROUP_Component);
@@ -852,7 +856,7 @@ void USceneComponent::EndScopedMovementUpdate(class FScopedMovementUpdate& Compl
 				if (PrimitiveThis)
 				{
 					// NOTE: UpdateOverlaps filters events to only consider overlaps where bGenerateOverlapEvents is true for both components, so it's ok if we queued up other overlaps.
-					TInlineOverlapInfoArray EndOverlaps;
+					TFrameOverlapInfoArray EndOverlaps;
 					const TOverlapArrayView PendingOverlaps(CurrentScopedUpdate->GetPendingOverlaps());
 					const TOptional<TOverlapArrayView> EndOverlapsOptional = CurrentScopedUpdate->GetOverlapsAtEnd(*PrimitiveThis, EndOverlaps, bTransformChanged);
 					UpdateOverlaps(&PendingOverlaps, true, EndOverlapsOptional.IsSet() ? &(EndOverlapsOptional.GetValue()) : nullptr);
@@ -1428,7 +1428,7 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 	{
 		// Build a list of levels from the collection that are also in the world's Levels array.
 		// Collections may contain levels that aren't loaded in the world at the moment.
-		TArray<ULevel*> LevelsToTick;
+		TArray<ULevel*, TFrameAllocator<>> LevelsToTick;
 		for (ULevel* CollectionLevel : LevelCollections[i].GetLevels())
 		{
 			if (Levels.Contains(CollectionLevel))
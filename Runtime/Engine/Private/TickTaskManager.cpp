@@ -1463,7 +1463,7 @@ public:
 	 * @param TickType - type of tick (viewports only, time only, etc)
 	 * @param LevelsToTick - the levels to tick, may be a subset of InWorld->Levels
 	 */
-	virtual void StartFrame(UWorld* InWorld, float InDeltaSeconds, ELevelTick InTickType, const TArray<ULevel*>& LevelsToTick) override
+	virtual void StartFrame(UWorld* InWorld, float InDeltaSeconds, ELevelTick InTickType, TConstArrayView<ULevel*> LevelsToTick) override
 	{
 		SCOPE_CYCLE_COUNTER(STAT_QueueTicks);
 		CSV_SCOPED_TIMING_STAT_EXCLUSIVE(QueueTicks);
@@ -1548,7 +1548,7 @@ public:
 	 * @param DeltaSeconds - time in seconds since last tick
 	 * @param TickType - type of tick (viewports only, time only, etc)
 	 */
-	virtual void RunPauseFrame(UWorld* InWorld, float InDeltaSeconds, ELevelTick InTickType, const TArray<ULevel*>& LevelsToTick) override
+	virtual void RunPauseFrame(UWorld* InWorld, float InDeltaSeconds, ELevelTick InTickType, TConstArrayView<ULevel*> LevelsToTick) override
 	{
 		bTickNewlySpawned = true; // we don't support new spawns, but lets at least catch them.
 		Context.TickGroup = ETickingGroup(0); // reset this to the start tick group
@@ -1658,7 +1658,7 @@ private:
 	}
 
 	/** Fill the level list **/
-	void FillLevelList(const TArray<ULevel*>& Levels)
+	void FillLevelList(TConstArrayView<ULevel*> Levels)
 	{
 		check(!LevelList.Num());
 		if (!Context.World->GetActiveLevelCollection() || Context.World->GetActiveLevelCollection()->GetType() == ELevelCollectionType::DynamicSourceLevels)
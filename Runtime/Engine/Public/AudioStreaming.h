@@ -102,10 +102,12 @@ struct FWaveRequest
 struct FLoadedAudioChunk
 {
 	uint8*	Data;
-	class IBulkDataIORequest* IORequest;
+	class IBulkDataRangeRequest* IORequest;
 	int32	DataSize;
 	int32	AudioDataSize;
 	uint32	Index;
+	/** True if Data is a view of a memory mapping owned by IORequest, which is then kept until the chunk is freed */
+	bool	bMemoryMapped;
 
 	FLoadedAudioChunk()
 		: Data(nullptr)
@@ -113,6 +115,7 @@ struct FLoadedAudioChunk
 		, DataSize(0)
 		, AudioDataSize(0)
 		, Index(0)
+		, bMemoryMapped(false)
 	{
 	}
 
@@ -282,7 +285,7 @@ struct FLegacyAudioStreamingManager : public IAudioStreamingManager
 	// End IAudioStreamingManager interface
 
 	/** Called when an async callback is made on an async loading audio chunk request. */
-	void OnAsyncFileCallback(FStreamingWaveData* StreamingWaveData, int32 LoadedAudioChunkIndex, IBulkDataIORequest* ReadRequest);
+	void OnAsyncFileCallback(FStreamingWaveData* StreamingWaveData, int32 LoadedAudioChunkIndex, IBulkDataRangeRequest* ReadRequest);
 
 	/** Processes pending async file IO results. */
 	void ProcessPendingAsyncFileResults();
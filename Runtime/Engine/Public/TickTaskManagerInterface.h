@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
 #include "Stats/Stats.h"
 #include "Engine/EngineBaseTypes.h"
 
@@ -35,7 +36,7 @@ public:
 	 * @param DeltaSeconds - time in seconds since last tick
 	 * @param TickType - type of tick (viewports only, time only, etc)
 	 */
-	virtual void StartFrame(UWorld* InWorld, float DeltaSeconds, ELevelTick TickType, const TArray<ULevel*>& LevelsToTick) = 0;
+	virtual void StartFrame(UWorld* InWorld, float DeltaSeconds, ELevelTick TickType, TConstArrayView<ULevel*> LevelsToTick) = 0;
 
 	/**
 	 * Run all of the ticks for a pause frame synchronously on the game thread.
@@ -44,7 +45,7 @@ public:
 	 * @param DeltaSeconds - time in seconds since last tick
 	 * @param TickType - type of tick (viewports only, time only, etc)
 	 */
-	virtual void RunPauseFrame(UWorld* InWorld, float DeltaSeconds, ELevelTick TickType, const TArray<ULevel*>& LevelsToTick) = 0;
+	virtual void RunPauseFrame(UWorld* InWorld, float DeltaSeconds, ELevelTick TickType, TConstArrayView<ULevel*> LevelsToTick) = 0;
 
 	/**
 		* Run a tick group, ticking all actors and components
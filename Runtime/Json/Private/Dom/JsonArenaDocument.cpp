@@ -0,0 +1,344 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Dom/JsonArenaDocument.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonSaxReader.h"
+
+namespace JsonArenaDocumentPrivate
+{
+	template<typename T>
+	const T* CopyToArena(FMemStackBase& Arena, const T* Items, int32 Count)
+	{
+		if (Count == 0)
+		{
+			return nullptr;
+		}
+
+		T* Result = (T*)Arena.Alloc(Count * sizeof(T), alignof(T));
+		FMemory::Memcpy(Result, Items, Count * sizeof(T));
+		return Result;
+	}
+
+	template<typename T>
+	bool TryConvertNumber(const FJsonArenaValue& Value, T& OutNumber, double Min, double Max)
+	{
+		double Double;
+		if (Value.TryGetNumber(Double) && Double >= Min && Double < Max)
+		{
+			OutNumber = static_cast<T>(FMath::RoundHalfFromZero(Double));
+			return true;
+		}
+
+		return false;
+	}
+
+	/** Interns the identifier of the last value read, which is ASCII for nearly every document, and keeps its unescaped text */
+	bool MakeFieldName(const FJsonSaxReader& Reader, FMemStackBase& Arena, FName& OutName, FAnsiStringView& OutKey)
+	{
+		FAnsiStringView Identifier = Reader.GetIdentifier();
+		if (Identifier.Len() >= NAME_SIZE)
+		{
+			return false;
+		}
+
+		if (Reader.IdentifierHasEscapes())
+		{
+			ANSICHAR* Unescaped = (ANSICHAR*)Arena.Alloc(Identifier.Len(), 1);
+			const int32 UnescapedLen = FJsonSaxReader::UnescapeString(Identifier, Unescaped);
+			Identifier = FAnsiStringView(Unescaped, UnescapedLen);
+		}
+		OutKey = Identifier;
+
+		for (ANSICHAR Char : Identifier)
+		{
+			if ((uint8)Char >= 0x80)
+			{
+				FUTF8ToTCHAR Converted(Identifier.GetData(), Identifier.Len());
+				OutName = FName(Converted.Length(), Converted.Get());
+				return true;
+			}
+		}
+
+		OutName = FName(Identifier.Len(), Identifier.GetData());
+		return true;
+	}
+}
+
+
+/* FJsonArenaValue interface
+ *****************************************************************************/
+
+const FJsonArenaValue* FJsonArenaValue::FindField(FName Name) const
+{
+	TArrayView<const FJsonArenaField> ObjectFields = GetFields();
+	for (int32 Index = ObjectFields.Num() - 1; Index >= 0; --Index)
+	{
+		if (ObjectFields[Index].Name == Name)
+		{
+			return &ObjectFields[Index].Value;
+		}
+	}
+
+	return nullptr;
+}
+
+
+const FJsonArenaValue* FJsonArenaValue::FindField(FName Name, EJson FieldType) const
+{
+	const FJsonArenaValue* Field = FindField(Name);
+	return (Field != nullptr && Field->Type == FieldType) ? Field : nullptr;
+}
+
+
+bool FJsonArenaValue::TryGetNumber(double& OutNumber) const
+{
+	if (Type == EJson::Number)
+	{
+		OutNumber = Number;
+		return true;
+	}
+
+	return false;
+}
+
+
+bool FJsonArenaValue::TryGetNumber(int32& OutNumber) const
+{
+	return JsonArenaDocumentPrivate::TryConvertNumber(*this, OutNumber, (double)MIN_int32, (double)MAX_int32 + 1.0);
+}
+
+
+bool FJsonArenaValue::TryGetNumber(int64& OutNumber) const
+{
+	// 2^63 is exactly representable as a double, unlike MAX_int64
+	return JsonArenaDocumentPrivate::TryConvertNumber(*this, OutNumber, -9223372036854775808.0, 9223372036854775808.0);
+}
+
+
+bool FJsonArenaValue::TryGetString(FString& OutString) const
+{
+	if (Type == EJson::String)
+	{
+		FUTF8ToTCHAR Converted(String, Num);
+		OutString = FString(Converted.Length(), Converted.Get());
+		return true;
+	}
+
+	return false;
+}
+
+
+bool FJsonArenaValue::TryGetBool(bool& OutBool) const
+{
+	if (Type == EJson::Boolean)
+	{
+		OutBool = Bool;
+		return true;
+	}
+
+	return false;
+}
+
+
+TSharedPtr<FJsonValue> FJsonArenaValue::ToJsonValue() const
+{
+	switch (Type)
+	{
+	case EJson::String:
+		{
+			FString StringValue;
+			TryGetString(StringValue);
+			return MakeShared<FJsonValueString>(StringValue);
+		}
+
+	case EJson::Number:
+		return MakeShared<FJsonValueNumber>(Number);
+
+	case EJson::Boolean:
+		return MakeShared<FJsonValueBoolean>(Bool);
+
+	case EJson::Array:
+		{
+			TArray<TSharedPtr<FJsonValue>> Values;
+			Values.Reserve(Num);
+			for (const FJsonArenaValue& Element : GetArray())
+			{
+				Values.Add(Element.ToJsonValue());
+			}
+			return MakeShared<FJsonValueArray>(Values);
+		}
+
+	case EJson::Object:
+		{
+			TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->Values.Reserve(Num);
+			for (const FJsonArenaField& Field : GetFields())
+			{
+				// The FName may be cased like another use of the same name, the key keeps the document's casing
+				const FAnsiStringView Key = Field.GetKey();
+				FUTF8ToTCHAR ConvertedKey(Key.GetData(), Key.Len());
+				Object->Values.Add(FString(ConvertedKey.Length(), ConvertedKey.Get()), Field.Value.ToJsonValue());
+			}
+			return MakeShared<FJsonValueObject>(Object);
+		}
+
+	default:
+		return MakeShared<FJsonValueNull>();
+	}
+}
+
+
+/* FJsonArenaDocument interface
+ *****************************************************************************/
+
+FJsonArenaDocument::FJsonArenaDocument()
+	: Arena(0)
+{ }
+
+
+bool FJsonArenaDocument::Parse(FAnsiStringView Json)
+{
+	using namespace JsonArenaDocumentPrivate;
+
+	Arena.Flush();
+	Root = FJsonArenaValue();
+	ErrorMessage.Empty();
+
+	struct FOpenScope
+	{
+		/** Index of the first pending element or field of this scope */
+		int32 First;
+
+		/** Name of this scope in its parent object */
+		FName Name;
+		FAnsiStringView Key;
+
+		bool bObject;
+	};
+
+	// Elements and fields of the open scopes are gathered here, and copied to the arena in one block once their scope closes
+	TArray<FOpenScope, TInlineAllocator<32>> OpenScopes;
+	TArray<FJsonArenaValue> PendingElements;
+	TArray<FJsonArenaField> PendingFields;
+
+	FJsonSaxReader Reader(Json);
+	EJsonNotation Notation;
+	while (Reader.ReadNext(Notation))
+	{
+		FName Name;
+		FAnsiStringView Key;
+		if (OpenScopes.Num() > 0 && OpenScopes.Last().bObject && Notation != EJsonNotation::ObjectEnd && Notation != EJsonNotation::ArrayEnd && Notation != EJsonNotation::Error)
+		{
+			if (!MakeFieldName(Reader, Arena, Name, Key))
+			{
+				ErrorMessage = FString::Printf(TEXT("Field name is longer than %d characters. Line: %u Ch: %u"), NAME_SIZE - 1, Reader.GetLineNumber(), Reader.GetCharacterNumber());
+				break;
+			}
+		}
+
+		FJsonArenaValue Value;
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+		case EJsonNotation::ArrayStart:
+			{
+				const bool bObject = Notation == EJsonNotation::ObjectStart;
+				OpenScopes.Add(FOpenScope{ bObject ? PendingFields.Num() : PendingElements.Num(), Name, Key, bObject });
+			}
+			continue;
+
+		case EJsonNotation::ObjectEnd:
+			{
+				const FOpenScope Scope = OpenScopes.Pop(false);
+				Value.Type = EJson::Object;
+				Value.Num = PendingFields.Num() - Scope.First;
+				Value.Fields = CopyToArena(Arena, PendingFields.GetData() + Scope.First, Value.Num);
+				PendingFields.SetNum(Scope.First, false);
+				Name = Scope.Name;
+				Key = Scope.Key;
+			}
+			break;
+
+		case EJsonNotation::ArrayEnd:
+			{
+				const FOpenScope Scope = OpenScopes.Pop(false);
+				Value.Type = EJson::Array;
+				Value.Num = PendingElements.Num() - Scope.First;
+				Value.Array = CopyToArena(Arena, PendingElements.GetData() + Scope.First, Value.Num);
+				PendingElements.SetNum(Scope.First, false);
+				Name = Scope.Name;
+				Key = Scope.Key;
+			}
+			break;
+
+		case EJsonNotation::String:
+			{
+				FAnsiStringView StringView = Reader.GetValueAsStringView();
+				Value.Type = EJson::String;
+				if (Reader.HasEscapes())
+				{
+					ANSICHAR* Unescaped = (ANSICHAR*)Arena.Alloc(StringView.Len(), 1);
+					Value.Num = FJsonSaxReader::UnescapeString(StringView, Unescaped);
+					Value.String = Unescaped;
+				}
+				else
+				{
+					Value.Num = StringView.Len();
+					Value.String = StringView.GetData();
+				}
+			}
+			break;
+
+		case EJsonNotation::Number:
+			Value.Type = EJson::Number;
+			Value.Number = Reader.GetValueAsNumber();
+			break;
+
+		case EJsonNotation::Boolean:
+			Value.Type = EJson::Boolean;
+			Value.Bool = Reader.GetValueAsBoolean();
+			break;
+
+		case EJsonNotation::Null:
+			break;
+
+		default:
+			ErrorMessage = Reader.GetErrorMessage();
+			break;
+		}
+
+		if (!ErrorMessage.IsEmpty())
+		{
+			break;
+		}
+
+		if (OpenScopes.Num() == 0)
+		{
+			Root = Value;
+		}
+		else if (OpenScopes.Last().bObject)
+		{
+			PendingFields.Add(FJsonArenaField{ Name, Value, Key.GetData(), Key.Len() });
+		}
+		else
+		{
+			PendingElements.Add(Value);
+		}
+	}
+
+	if (!ErrorMessage.IsEmpty())
+	{
+		Root = FJsonArenaValue();
+		Arena.Flush();
+		return false;
+	}
+
+	return true;
+}
+
+
+int32 FJsonArenaDocument::GetAllocatedSize() const
+{
+	return Arena.GetByteCount();
+}
@@ -0,0 +1,808 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/JsonSaxReader.h"
+#include "Misc/Parse.h"
+
+namespace JsonSaxReaderPrivate
+{
+	/** Whether any byte of Word equals Byte, see "Determine if a word has a byte equal to n" in Bit Twiddling Hacks */
+	FORCEINLINE bool HasByte(uint64 Word, uint8 Byte)
+	{
+		const uint64 Xor = Word ^ (0x0101010101010101ull * Byte);
+		return ((Xor - 0x0101010101010101ull) & ~Xor & 0x8080808080808080ull) != 0;
+	}
+
+	FORCEINLINE bool IsDigit(ANSICHAR Char)
+	{
+		return Char >= '0' && Char <= '9';
+	}
+
+	FORCEINLINE bool IsJsonNumber(ANSICHAR Char)
+	{
+		return IsDigit(Char) || Char == '-' || Char == '.' || Char == '+' || Char == 'e' || Char == 'E';
+	}
+
+	FORCEINLINE bool IsAlpha(ANSICHAR Char)
+	{
+		return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z');
+	}
+
+	/** Reads the four hex digits of a unicode escape sequence, which were validated by the reader */
+	FORCEINLINE uint32 ParseHex4(const ANSICHAR* Digits)
+	{
+		uint32 Result = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Result = (Result << 4) | (uint32)FParse::HexDigit(Digits[Index]);
+		}
+		return Result;
+	}
+
+	FORCEINLINE ANSICHAR* WriteUTF8(ANSICHAR* Dest, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			*Dest++ = (ANSICHAR)CodePoint;
+		}
+		else if (CodePoint < 0x800)
+		{
+			*Dest++ = (ANSICHAR)(0xC0 | (CodePoint >> 6));
+			*Dest++ = (ANSICHAR)(0x80 | (CodePoint & 0x3F));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			*Dest++ = (ANSICHAR)(0xE0 | (CodePoint >> 12));
+			*Dest++ = (ANSICHAR)(0x80 | ((CodePoint >> 6) & 0x3F));
+			*Dest++ = (ANSICHAR)(0x80 | (CodePoint & 0x3F));
+		}
+		else
+		{
+			*Dest++ = (ANSICHAR)(0xF0 | (CodePoint >> 18));
+			*Dest++ = (ANSICHAR)(0x80 | ((CodePoint >> 12) & 0x3F));
+			*Dest++ = (ANSICHAR)(0x80 | ((CodePoint >> 6) & 0x3F));
+			*Dest++ = (ANSICHAR)(0x80 | (CodePoint & 0x3F));
+		}
+		return Dest;
+	}
+
+	EJsonNotation TokenToNotation(EJsonToken Token)
+	{
+		switch (Token)
+		{
+		case EJsonToken::CurlyOpen:		return EJsonNotation::ObjectStart;
+		case EJsonToken::CurlyClose:	return EJsonNotation::ObjectEnd;
+		case EJsonToken::SquareOpen:	return EJsonNotation::ArrayStart;
+		case EJsonToken::SquareClose:	return EJsonNotation::ArrayEnd;
+		case EJsonToken::String:		return EJsonNotation::String;
+		case EJsonToken::Number:		return EJsonNotation::Number;
+		case EJsonToken::True:			return EJsonNotation::Boolean;
+		case EJsonToken::False:			return EJsonNotation::Boolean;
+		case EJsonToken::Null:			return EJsonNotation::Null;
+		default:						return EJsonNotation::Error;
+		}
+	}
+}
+
+
+FJsonSaxReader::FJsonSaxReader(FAnsiStringView Json)
+	: ParseState()
+	, CurrentToken(EJsonToken::None)
+	, Data(Json.GetData())
+	, Num(Json.Len())
+	, Pos(0)
+	, Identifier()
+	, Value()
+	, ErrorMessage()
+	, bIdentifierHasEscapes(false)
+	, bValueHasEscapes(false)
+	, FinishedReadingRootObject(false)
+{
+	// Buffers converted from strings often keep their null terminator
+	while (Num > 0 && Data[Num - 1] == '\0')
+	{
+		--Num;
+	}
+
+	if (Num >= 3 && (uint8)Data[0] == 0xEF && (uint8)Data[1] == 0xBB && (uint8)Data[2] == 0xBF)
+	{
+		Pos = 3;
+	}
+}
+
+
+bool FJsonSaxReader::ReadNext(EJsonNotation& Notation)
+{
+	if (!ErrorMessage.IsEmpty())
+	{
+		Notation = EJsonNotation::Error;
+		return false;
+	}
+
+	const bool AtEndOfStream = Pos >= Num;
+
+	if (AtEndOfStream && !FinishedReadingRootObject)
+	{
+		Notation = EJsonNotation::Error;
+		SetErrorMessage(TEXT("Improperly formatted."));
+		return true;
+	}
+
+	if (FinishedReadingRootObject && !AtEndOfStream)
+	{
+		Notation = EJsonNotation::Error;
+		SetErrorMessage(TEXT("Unexpected additional input found."));
+		return true;
+	}
+
+	if (AtEndOfStream)
+	{
+		return false;
+	}
+
+	Identifier.Reset();
+	bIdentifierHasEscapes = false;
+
+	bool ReadWasSuccess = false;
+	switch (ParseState.Num() > 0 ? ParseState.Top() : EJson::None)
+	{
+	case EJson::Array:
+		ReadWasSuccess = ReadNextArrayValue();
+		break;
+
+	case EJson::Object:
+		ReadWasSuccess = ReadNextObjectValue();
+		break;
+
+	default:
+		ReadWasSuccess = ReadStart();
+		break;
+	}
+
+	Notation = JsonSaxReaderPrivate::TokenToNotation(CurrentToken);
+	FinishedReadingRootObject = ParseState.Num() == 0;
+
+	if (!ReadWasSuccess || (Notation == EJsonNotation::Error))
+	{
+		Notation = EJsonNotation::Error;
+
+		if (ErrorMessage.IsEmpty())
+		{
+			SetErrorMessage(TEXT("Unknown Error Occurred"));
+		}
+
+		return true;
+	}
+
+	if (FinishedReadingRootObject)
+	{
+		SkipWhiteSpace();
+	}
+
+	return true;
+}
+
+
+bool FJsonSaxReader::SkipObject()
+{
+	return SkipToMatching(EJsonToken::CurlyClose);
+}
+
+
+bool FJsonSaxReader::SkipArray()
+{
+	return SkipToMatching(EJsonToken::SquareClose);
+}
+
+
+FString FJsonSaxReader::GetValueAsString() const
+{
+	check(CurrentToken == EJsonToken::String);
+	return DecodeString(Value, bValueHasEscapes);
+}
+
+
+double FJsonSaxReader::GetValueAsNumber() const
+{
+	check(CurrentToken == EJsonToken::Number);
+	return ParseNumber(Value);
+}
+
+
+FString FJsonSaxReader::GetIdentifierAsString() const
+{
+	return DecodeString(Identifier, bIdentifierHasEscapes);
+}
+
+
+uint32 FJsonSaxReader::GetLineNumber() const
+{
+	uint32 LineNumber = 1;
+	for (int32 Index = 0; Index < Pos; ++Index)
+	{
+		LineNumber += Data[Index] == '\n';
+	}
+	return LineNumber;
+}
+
+
+uint32 FJsonSaxReader::GetCharacterNumber() const
+{
+	int32 LineStart = Pos;
+	while (LineStart > 0 && Data[LineStart - 1] != '\n')
+	{
+		--LineStart;
+	}
+	return (uint32)(Pos - LineStart);
+}
+
+
+int32 FJsonSaxReader::UnescapeString(FAnsiStringView Escaped, ANSICHAR* Out)
+{
+	using namespace JsonSaxReaderPrivate;
+
+	const ANSICHAR* Src = Escaped.GetData();
+	const ANSICHAR* End = Src + Escaped.Len();
+	ANSICHAR* Dest = Out;
+
+	while (Src < End)
+	{
+		if (*Src != '\\')
+		{
+			*Dest++ = *Src++;
+			continue;
+		}
+
+		++Src;
+		switch (*Src++)
+		{
+		case 'b': *Dest++ = '\b'; break;
+		case 'f': *Dest++ = '\f'; break;
+		case 'n': *Dest++ = '\n'; break;
+		case 'r': *Dest++ = '\r'; break;
+		case 't': *Dest++ = '\t'; break;
+		case 'u':
+			{
+				uint32 CodePoint = ParseHex4(Src);
+				Src += 4;
+
+				// Combine surrogate pairs, lone surrogates are kept as they are
+				if (CodePoint >= 0xD800 && CodePoint < 0xDC00 && End - Src >= 6 && Src[0] == '\\' && Src[1] == 'u')
+				{
+					const uint32 LowSurrogate = ParseHex4(Src + 2);
+					if (LowSurrogate >= 0xDC00 && LowSurrogate < 0xE000)
+					{
+						CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+						Src += 6;
+					}
+				}
+
+				Dest = WriteUTF8(Dest, CodePoint);
+			}
+			break;
+
+		default:
+			// '"', '\\' and '/' stand for themselves
+			*Dest++ = Src[-1];
+			break;
+		}
+	}
+
+	return (int32)(Dest - Out);
+}
+
+
+FString FJsonSaxReader::DecodeString(FAnsiStringView Raw, bool bHasEscapes)
+{
+	if (!bHasEscapes)
+	{
+		FUTF8ToTCHAR Converted(Raw.GetData(), Raw.Len());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	TArray<ANSICHAR, TInlineAllocator<256>> Unescaped;
+	Unescaped.SetNumUninitialized(Raw.Len());
+	const int32 UnescapedLen = UnescapeString(Raw, Unescaped.GetData());
+
+	FUTF8ToTCHAR Converted(Unescaped.GetData(), UnescapedLen);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+
+double FJsonSaxReader::ParseNumber(FAnsiStringView Number)
+{
+	using namespace JsonSaxReaderPrivate;
+
+	const ANSICHAR* Chars = Number.GetData();
+	const int32 Len = Number.Len();
+
+	// Integers that fit in the mantissa are converted exactly without going through the C runtime
+	const bool bNegative = Len > 0 && Chars[0] == '-';
+	if (Len - (int32)bNegative <= 15)
+	{
+		int64 Integer = 0;
+		int32 Index = (int32)bNegative;
+		for (; Index < Len && IsDigit(Chars[Index]); ++Index)
+		{
+			Integer = Integer * 10 + (Chars[Index] - '0');
+		}
+
+		// Negative zero goes through the C runtime to keep its sign
+		if (Index == Len && (Integer != 0 || !bNegative))
+		{
+			return (double)(bNegative ? -Integer : Integer);
+		}
+	}
+
+	TArray<ANSICHAR, TInlineAllocator<64>> Terminated;
+	Terminated.SetNumUninitialized(Len + 1);
+	FMemory::Memcpy(Terminated.GetData(), Chars, Len);
+	Terminated[Len] = '\0';
+
+	return FCStringAnsi::Atod(Terminated.GetData());
+}
+
+
+bool FJsonSaxReader::ReadStart()
+{
+	CurrentToken = EJsonToken::None;
+
+	if (!NextToken(CurrentToken))
+	{
+		return false;
+	}
+
+	if ((CurrentToken != EJsonToken::CurlyOpen) && (CurrentToken != EJsonToken::SquareOpen))
+	{
+		SetErrorMessage(TEXT("Open Curly or Square Brace token expected, but not found."));
+		return false;
+	}
+
+	return true;
+}
+
+
+bool FJsonSaxReader::ReadNextObjectValue()
+{
+	const bool bCommaPrepend = CurrentToken != EJsonToken::CurlyOpen;
+
+	if (!NextToken(CurrentToken))
+	{
+		return false;
+	}
+
+	if (CurrentToken == EJsonToken::CurlyClose)
+	{
+		return true;
+	}
+
+	if (bCommaPrepend)
+	{
+		if (CurrentToken != EJsonToken::Comma)
+		{
+			SetErrorMessage(TEXT("Comma token expected, but not found."));
+			return false;
+		}
+
+		if (!NextToken(CurrentToken))
+		{
+			return false;
+		}
+	}
+
+	if (CurrentToken != EJsonToken::String)
+	{
+		SetErrorMessage(TEXT("String token expected, but not found."));
+		return false;
+	}
+
+	Identifier = Value;
+	bIdentifierHasEscapes = bValueHasEscapes;
+
+	if (!NextToken(CurrentToken))
+	{
+		return false;
+	}
+
+	if (CurrentToken != EJsonToken::Colon)
+	{
+		SetErrorMessage(TEXT("Colon token expected, but not found."));
+		return false;
+	}
+
+	return NextToken(CurrentToken);
+}
+
+
+bool FJsonSaxReader::ReadNextArrayValue()
+{
+	const bool bCommaPrepend = CurrentToken != EJsonToken::SquareOpen;
+
+	if (!NextToken(CurrentToken))
+	{
+		return false;
+	}
+
+	if (CurrentToken == EJsonToken::SquareClose)
+	{
+		return true;
+	}
+
+	if (bCommaPrepend)
+	{
+		if (CurrentToken != EJsonToken::Comma)
+		{
+			SetErrorMessage(TEXT("Comma token expected, but not found."));
+			return false;
+		}
+
+		return NextToken(CurrentToken);
+	}
+
+	return true;
+}
+
+
+bool FJsonSaxReader::NextToken(EJsonToken& OutToken)
+{
+	SkipWhiteSpace();
+
+	if (Pos >= Num)
+	{
+		SetErrorMessage(TEXT("Invalid Json Token."));
+		return false;
+	}
+
+	switch (Data[Pos])
+	{
+	case '{':
+		++Pos;
+		OutToken = EJsonToken::CurlyOpen;
+		ParseState.Push(EJson::Object);
+		return true;
+
+	case '[':
+		++Pos;
+		OutToken = EJsonToken::SquareOpen;
+		ParseState.Push(EJson::Array);
+		return true;
+
+	case '}':
+	case ']':
+		{
+			const bool bObject = Data[Pos] == '}';
+			OutToken = bObject ? EJsonToken::CurlyClose : EJsonToken::SquareClose;
+			if (ParseState.Num() == 0 || ParseState.Top() != (bObject ? EJson::Object : EJson::Array))
+			{
+				SetErrorMessage(TEXT("Unknown state reached while parsing Json token."));
+				return false;
+			}
+			++Pos;
+			ParseState.Pop(false);
+			return true;
+		}
+
+	case ':':
+		++Pos;
+		OutToken = EJsonToken::Colon;
+		return true;
+
+	case ',':
+		++Pos;
+		OutToken = EJsonToken::Comma;
+		return true;
+
+	case '\"':
+		++Pos;
+		if (!ParseStringToken(Value, bValueHasEscapes))
+		{
+			return false;
+		}
+		OutToken = EJsonToken::String;
+		return true;
+
+	case '-': case '+': case '.':
+	case '0': case '1': case '2': case '3': case '4':
+	case '5': case '6': case '7': case '8': case '9':
+		if (!ParseNumberToken())
+		{
+			return false;
+		}
+		OutToken = EJsonToken::Number;
+		return true;
+
+	default:
+		return ParseLiteralToken(OutToken);
+	}
+}
+
+
+bool FJsonSaxReader::ParseStringToken(FAnsiStringView& OutString, bool& bOutHasEscapes)
+{
+	using namespace JsonSaxReaderPrivate;
+
+	const int32 Start = Pos;
+	bool bHasEscapes = false;
+
+	while (true)
+	{
+		// Most strings have no escapes, so skip eight bytes at a time until a quote or a backslash shows up
+		while (Pos + 8 <= Num)
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, Data + Pos, sizeof(Word));
+			if (HasByte(Word, '\"') || HasByte(Word, '\\'))
+			{
+				break;
+			}
+			Pos += 8;
+		}
+
+		if (Pos >= Num)
+		{
+			break;
+		}
+
+		const ANSICHAR Char = Data[Pos];
+
+		if (Char == '\"')
+		{
+			OutString = FAnsiStringView(Data + Start, Pos - Start);
+			bOutHasEscapes = bHasEscapes;
+			++Pos;
+			return true;
+		}
+
+		if (Char != '\\')
+		{
+			++Pos;
+			continue;
+		}
+
+		bHasEscapes = true;
+
+		if (Pos + 1 >= Num)
+		{
+			break;
+		}
+
+		switch (Data[Pos + 1])
+		{
+		case '\"': case '\\': case '/':
+		case 'b': case 'f': case 'n': case 'r': case 't':
+			Pos += 2;
+			break;
+
+		case 'u':
+			// 4 hex digits, like \uAB23, which is a 16 bit number that we would usually see as 0xAB23
+			if (Pos + 6 > Num)
+			{
+				Pos = Num;
+				break;
+			}
+			for (int32 Index = 2; Index < 6; ++Index)
+			{
+				if (!FCharAnsi::IsHexDigit(Data[Pos + Index]))
+				{
+					Pos += Index;
+					SetErrorMessage(TEXT("Invalid Hexadecimal digit parsed."));
+					return false;
+				}
+			}
+			Pos += 6;
+			break;
+
+		default:
+			++Pos;
+			SetErrorMessage(TEXT("Bad Json escaped char."));
+			return false;
+		}
+	}
+
+	SetErrorMessage(TEXT("String Token Abruptly Ended."));
+	return false;
+}
+
+
+bool FJsonSaxReader::ParseNumberToken()
+{
+	using namespace JsonSaxReaderPrivate;
+
+	const int32 Start = Pos;
+	int32 State = 0;
+	bool Error = false;
+
+	// Only checks that the number is EXACTLY to specification, it is converted on demand by ParseNumber().
+	// This is the same finite state automata as TJsonReader.
+	while (Pos < Num && IsJsonNumber(Data[Pos]))
+	{
+		const ANSICHAR Char = Data[Pos];
+
+		switch (State)
+		{
+		case 0:
+			if (Char == '-') { State = 1; }
+			else if (Char == '0') { State = 2; }
+			else if (IsDigit(Char)) { State = 3; }
+			else { Error = true; }
+			break;
+
+		case 1:
+			if (Char == '0') { State = 2; }
+			else if (IsDigit(Char)) { State = 3; }
+			else { Error = true; }
+			break;
+
+		case 2:
+			if (Char == '.') { State = 4; }
+			else if (Char == 'e' || Char == 'E') { State = 5; }
+			else { Error = true; }
+			break;
+
+		case 3:
+			if (IsDigit(Char)) { State = 3; }
+			else if (Char == '.') { State = 4; }
+			else if (Char == 'e' || Char == 'E') { State = 5; }
+			else { Error = true; }
+			break;
+
+		case 4:
+			if (IsDigit(Char)) { State = 6; }
+			else { Error = true; }
+			break;
+
+		case 5:
+			if (Char == '-' || Char == '+') { State = 7; }
+			else if (IsDigit(Char)) { State = 8; }
+			else { Error = true; }
+			break;
+
+		case 6:
+			if (IsDigit(Char)) { State = 6; }
+			else if (Char == 'e' || Char == 'E') { State = 5; }
+			else { Error = true; }
+			break;
+
+		case 7:
+		case 8:
+			if (IsDigit(Char)) { State = 8; }
+			else { Error = true; }
+			break;
+		}
+
+		if (Error)
+		{
+			break;
+		}
+
+		++Pos;
+	}
+
+	if (!Error && ((State == 2) || (State == 3) || (State == 6) || (State == 8)))
+	{
+		Value = FAnsiStringView(Data + Start, Pos - Start);
+		return true;
+	}
+
+	SetErrorMessage(TEXT("Poorly formed Json Number Token."));
+	return false;
+}
+
+
+bool FJsonSaxReader::ParseLiteralToken(EJsonToken& OutToken)
+{
+	const int32 Start = Pos;
+	while (Pos < Num && JsonSaxReaderPrivate::IsAlpha(Data[Pos]))
+	{
+		++Pos;
+	}
+
+	// Literals are case insensitive, like in TJsonReader
+	const ANSICHAR* Literal = Data + Start;
+	switch (Pos - Start)
+	{
+	case 4:
+		if (FCStringAnsi::Strnicmp(Literal, "true", 4) == 0)
+		{
+			OutToken = EJsonToken::True;
+			return true;
+		}
+		if (FCStringAnsi::Strnicmp(Literal, "null", 4) == 0)
+		{
+			OutToken = EJsonToken::Null;
+			return true;
+		}
+		break;
+
+	case 5:
+		if (FCStringAnsi::Strnicmp(Literal, "false", 5) == 0)
+		{
+			OutToken = EJsonToken::False;
+			return true;
+		}
+		break;
+
+	case 0:
+		SetErrorMessage(TEXT("Invalid Json Token."));
+		return false;
+	}
+
+	SetErrorMessage(TEXT("Invalid Json Token. Check that your member names have quotes around them!"));
+	return false;
+}
+
+
+bool FJsonSaxReader::SkipToMatching(EJsonToken CloseToken)
+{
+	if (!ErrorMessage.IsEmpty() || ParseState.Num() == 0 || ParseState.Top() != (CloseToken == EJsonToken::CurlyClose ? EJson::Object : EJson::Array))
+	{
+		return false;
+	}
+
+	// Scan for the closing brace without tokenizing the values in between
+	int32 ScopeCount = 0;
+	while (Pos < Num)
+	{
+		const ANSICHAR Char = Data[Pos++];
+		switch (Char)
+		{
+		case '\"':
+			{
+				FAnsiStringView SkippedString;
+				bool bSkippedHasEscapes;
+				if (!ParseStringToken(SkippedString, bSkippedHasEscapes))
+				{
+					return false;
+				}
+			}
+			break;
+
+		case '{':
+		case '[':
+			++ScopeCount;
+			break;
+
+		case '}':
+		case ']':
+			if (ScopeCount > 0)
+			{
+				--ScopeCount;
+				break;
+			}
+
+			if (Char != (CloseToken == EJsonToken::CurlyClose ? '}' : ']'))
+			{
+				SetErrorMessage(TEXT("Unknown state reached while parsing Json token."));
+				return false;
+			}
+
+			ParseState.Pop(false);
+			CurrentToken = CloseToken;
+			Identifier.Reset();
+			bIdentifierHasEscapes = false;
+			FinishedReadingRootObject = ParseState.Num() == 0;
+			if (FinishedReadingRootObject)
+			{
+				SkipWhiteSpace();
+			}
+			return true;
+		}
+	}
+
+	SetErrorMessage(TEXT("Improperly formatted."));
+	return false;
+}
+
+
+void FJsonSaxReader::SkipWhiteSpace()
+{
+	while (Pos < Num && IsWhitespace(Data[Pos]))
+	{
+		++Pos;
+	}
+}
+
+
+void FJsonSaxReader::SetErrorMessage(const TCHAR* Message)
+{
+	ErrorMessage = FString::Printf(TEXT("%s Line: %u Ch: %u"), Message, GetLineNumber(), GetCharacterNumber());
+}
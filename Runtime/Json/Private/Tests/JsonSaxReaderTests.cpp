@@ -0,0 +1,307 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Dom/JsonArenaDocument.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSaxReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonSaxReaderTest
+{
+	/** Checks that FJsonSaxReader reads the same notations, identifiers and values as TJsonReader */
+	void CompareReaders(FAutomationTestBase& Test, const TCHAR* Json)
+	{
+		FTCHARToUTF8 Utf8Json(Json);
+		FJsonSaxReader SaxReader(FAnsiStringView(Utf8Json.Get(), Utf8Json.Length()));
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Json));
+
+		while (true)
+		{
+			EJsonNotation Notation = EJsonNotation::Error;
+			EJsonNotation SaxNotation = EJsonNotation::Error;
+			const bool bRead = Reader->ReadNext(Notation);
+			const bool bSaxRead = SaxReader.ReadNext(SaxNotation);
+
+			if (bRead != bSaxRead || Notation != SaxNotation)
+			{
+				Test.AddError(FString::Printf(TEXT("FJsonSaxReader reads %d (%s) instead of %d (%s) in %s"), (int32)SaxNotation, *SaxReader.GetErrorMessage(), (int32)Notation, *Reader->GetErrorMessage(), Json));
+				return;
+			}
+
+			if (!bRead || Notation == EJsonNotation::Error)
+			{
+				return;
+			}
+
+			Test.TestTrue(FString::Printf(TEXT("Identifier %s in %s"), *Reader->GetIdentifier(), Json), Reader->GetIdentifier().Equals(SaxReader.GetIdentifierAsString(), ESearchCase::CaseSensitive));
+
+			switch (Notation)
+			{
+			case EJsonNotation::String:
+				Test.TestTrue(FString::Printf(TEXT("String %s in %s"), *Reader->GetValueAsString(), Json), Reader->GetValueAsString().Equals(SaxReader.GetValueAsString(), ESearchCase::CaseSensitive));
+				break;
+
+			case EJsonNotation::Number:
+				Test.TestEqual(FString::Printf(TEXT("Number in %s"), Json), SaxReader.GetValueAsNumber(), Reader->GetValueAsNumber());
+				break;
+
+			case EJsonNotation::Boolean:
+				Test.TestEqual(FString::Printf(TEXT("Boolean in %s"), Json), SaxReader.GetValueAsBoolean(), Reader->GetValueAsBoolean());
+				break;
+			}
+		}
+	}
+
+	/** Checks that the arena document holds the same values as the shared pointer DOM */
+	void CompareDocuments(FAutomationTestBase& Test, const TCHAR* Json)
+	{
+		TSharedPtr<FJsonValue> Value;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Json));
+		const bool bDeserialized = FJsonSerializer::Deserialize(Reader, Value);
+
+		FTCHARToUTF8 Utf8Json(Json);
+		FJsonArenaDocument Document;
+		const bool bParsed = Document.Parse(FAnsiStringView(Utf8Json.Get(), Utf8Json.Length()));
+
+		if (Test.TestEqual(FString::Printf(TEXT("Arena document parses %s"), Json), bParsed, bDeserialized) && bParsed)
+		{
+			Test.TestTrue(FString::Printf(TEXT("Arena document matches the DOM for %s"), Json), *Document.GetRoot().ToJsonValue() == *Value);
+		}
+	}
+
+	/** Generates an array of telemetry like events, the kind of payload the readers are benchmarked with */
+	void GenerateBenchmarkJson(int32 NumEvents, TArray<ANSICHAR>& OutJson)
+	{
+		FString Json;
+		Json.Reserve(NumEvents * 400);
+		Json += TEXT("[\n");
+		for (int32 Index = 0; Index < NumEvents; ++Index)
+		{
+			Json += FString::Printf(
+				TEXT("\t{\"EventName\":\"Session.Frame\",\"Timestamp\":%d.%03d,\"SessionId\":\"%s\",\"Attributes\":")
+				TEXT("{\"Platform\":\"Windows\",\"Map\":\"/Game/Maps/Level_%02d\",\"FrameTimeMs\":%.3f,\"bIsServer\":%s,")
+				TEXT("\"Message\":\"Frame \\\"%d\\\" of \\u00e9t\\u00e9\",\"Tags\":[\"gameplay\",\"perf\",%d,null]}}%s\n"),
+				1600000000 + Index, Index % 1000, *FGuid(Index, Index * 7, Index * 13, Index * 31).ToString(), Index % 32, 16.6 + (Index % 17) * 0.25,
+				(Index % 5 == 0) ? TEXT("true") : TEXT("false"), Index, Index, Index + 1 < NumEvents ? TEXT(",") : TEXT(""));
+		}
+		Json += TEXT("]\n");
+
+		FTCHARToUTF8 Utf8Json(*Json);
+		OutJson = TArray<ANSICHAR>(Utf8Json.Get(), Utf8Json.Length());
+	}
+}
+
+
+/**
+ * Checks FJsonSaxReader and FJsonArenaDocument against TJsonReader and the shared pointer DOM.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJsonSaxReaderTest, "System.Engine.FileSystem.JSON.SaxReader", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FJsonSaxReaderTest::RunTest(const FString& Parameters)
+{
+	using namespace JsonSaxReaderTest;
+
+	const TCHAR* ValidDocuments[] =
+	{
+		TEXT("{}"),
+		TEXT("[]"),
+		TEXT("  { \"Value\" : \"Some String\" }  "),
+		TEXT("[{\"Value\":\"Some String1\"},{\"Value\":\"Some String2\"}]"),
+		TEXT("{\"a\":[1,-2.5,3e10,0,-0,1.25E-3,123456789012345678901234567890],\"b\":{\"c\":true,\"d\":false,\"e\":null},\"f\":[],\"g\":{}}"),
+		TEXT("[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"\\u00e9\\u4e2d\\uD83D\\uDE00\",\"caf\\u00e9 \u00e9\"]"),
+		TEXT("{\"na\\\"me\":1,\"\u00e9t\u00e9\":2,\"Dup\":1,\"Dup\":[2]}"),
+		TEXT("[True,FALSE,Null]"),
+		TEXT("[1,]"),
+	};
+
+	const TCHAR* InvalidDocuments[] =
+	{
+		TEXT(""),
+		TEXT("   "),
+		TEXT("1"),
+		TEXT("{\"a\":}"),
+		TEXT("{\"a\" 1}"),
+		TEXT("[1 2]"),
+		TEXT("{\"a\":1}x"),
+		TEXT("[01]"),
+		TEXT("[\"abc"),
+		TEXT("{a:1}"),
+		TEXT("[\"\\x\"]"),
+		TEXT("[\"\\u12G4\"]"),
+		TEXT("[tru]"),
+		TEXT("[1.]"),
+	};
+
+	for (const TCHAR* Json : ValidDocuments)
+	{
+		CompareReaders(*this, Json);
+		CompareDocuments(*this, Json);
+	}
+
+	for (const TCHAR* Json : InvalidDocuments)
+	{
+		CompareReaders(*this, Json);
+
+		FTCHARToUTF8 Utf8Json(Json);
+		FJsonArenaDocument Document;
+		TestFalse(FString::Printf(TEXT("Arena document rejects %s"), Json), Document.Parse(FAnsiStringView(Utf8Json.Get(), Utf8Json.Length())));
+		TestTrue(FString::Printf(TEXT("Arena document has a null root after failing to parse %s"), Json), Document.GetRoot().IsNull());
+		TestFalse(FString::Printf(TEXT("Arena document has an error message after failing to parse %s"), Json), Document.GetErrorMessage().IsEmpty());
+	}
+
+	// Unlike TJsonReader, which closes any scope with either brace, mismatched braces are an error
+	{
+		FJsonArenaDocument Document;
+		TestFalse(TEXT("Arena document rejects mismatched braces"), Document.Parse("{\"a\":[1}]}"));
+	}
+
+	// Skipping
+	{
+		FAnsiStringView Json("{\"a\":{\"x\":[1,{\"y\":\"}]\\\"\"}]},\"b\":[[],{}],\"c\":2}");
+		FJsonSaxReader Reader(Json);
+		EJsonNotation Notation;
+
+		TestTrue(TEXT("Skip: root"), Reader.ReadNext(Notation) && Notation == EJsonNotation::ObjectStart);
+		TestTrue(TEXT("Skip: object start"), Reader.ReadNext(Notation) && Notation == EJsonNotation::ObjectStart && Reader.GetIdentifier() == "a");
+		TestTrue(TEXT("Skip: object"), Reader.SkipObject());
+		TestTrue(TEXT("Skip: array start"), Reader.ReadNext(Notation) && Notation == EJsonNotation::ArrayStart && Reader.GetIdentifier() == "b");
+		TestTrue(TEXT("Skip: array"), Reader.SkipArray());
+		TestTrue(TEXT("Skip: value after skipped scopes"), Reader.ReadNext(Notation) && Notation == EJsonNotation::Number && Reader.GetIdentifier() == "c" && Reader.GetValueAsNumber() == 2.0);
+		TestTrue(TEXT("Skip: root end"), Reader.ReadNext(Notation) && Notation == EJsonNotation::ObjectEnd);
+		TestFalse(TEXT("Skip: end of input"), Reader.ReadNext(Notation));
+		TestTrue(TEXT("Skip: no error"), Reader.GetErrorMessage().IsEmpty());
+	}
+
+	// Arena document accessors
+	{
+		FAnsiStringView Json("\xEF\xBB\xBF{\"Name\":\"caf\\u00e9\",\"Count\":3000000000,\"Nested\":{\"bEnabled\":true},\"Items\":[1,\"two\",null]}");
+		FJsonArenaDocument Document;
+		TestTrue(TEXT("Arena document parses a document with a byte order mark"), Document.Parse(Json));
+
+		const FJsonArenaValue& Root = Document.GetRoot();
+		TestEqual(TEXT("Root is an object"), Root.GetType(), EJson::Object);
+		TestEqual(TEXT("Fields are kept in document order"), Root.GetFields().Num(), 4);
+
+		const FJsonArenaValue* Name = Root.FindField(TEXT("Name"), EJson::String);
+		TestTrue(TEXT("Escaped strings are decoded to UTF-8"), Name && Name->GetStringView().Equals("caf\xC3\xA9", ESearchCase::CaseSensitive));
+
+		int32 Int32Count = 0;
+		int64 Int64Count = 0;
+		const FJsonArenaValue* Count = Root.FindField(TEXT("count"));
+		TestTrue(TEXT("Fields are found case insensitively"), Count != nullptr);
+		TestFalse(TEXT("Out of range numbers are not converted to int32"), Count && Count->TryGetNumber(Int32Count));
+		TestTrue(TEXT("Numbers are converted to int64"), Count && Count->TryGetNumber(Int64Count) && Int64Count == 3000000000ll);
+
+		bool bEnabled = false;
+		const FJsonArenaValue* Nested = Root.FindField(TEXT("Nested"), EJson::Object);
+		TestTrue(TEXT("Nested fields are found"), Nested && Nested->FindField(TEXT("bEnabled")) && Nested->FindField(TEXT("bEnabled"))->TryGetBool(bEnabled) && bEnabled);
+		TestTrue(TEXT("Missing fields are not found"), Root.FindField(TEXT("Missing")) == nullptr && Root.FindField(TEXT("Name"), EJson::Number) == nullptr);
+
+		const FJsonArenaValue* Items = Root.FindField(TEXT("Items"));
+		TestTrue(TEXT("Array elements are kept in document order"), Items && Items->GetArray().Num() == 3 && Items->GetArray()[1].GetStringView() == "two" && Items->GetArray()[2].IsNull());
+		TestTrue(TEXT("The arena holds the document"), Document.GetAllocatedSize() > 0);
+	}
+
+	// Field names keep the casing of the document, even when their FName was first made with another casing
+	{
+		const FName ExistingName(TEXT("arenakeycasing"));
+		FAnsiStringView Json("{\"ArenaKeyCasing\":1,\"Esc\\u0061ped\":{\"ARENAKEYCASING\":2}}");
+		FJsonArenaDocument Document;
+		TestTrue(TEXT("Keys: parses"), Document.Parse(Json));
+
+		TArrayView<const FJsonArenaField> Fields = Document.GetRoot().GetFields();
+		TestTrue(TEXT("Keys: the name finds the field case insensitively"), Fields.Num() == 2 && Fields[0].Name == ExistingName);
+		TestTrue(TEXT("Keys: the key keeps the casing"), Fields.Num() == 2 && Fields[0].GetKey().Equals("ArenaKeyCasing", ESearchCase::CaseSensitive));
+		TestTrue(TEXT("Keys: escaped keys are decoded"), Fields.Num() == 2 && Fields[1].GetKey().Equals("Escaped", ESearchCase::CaseSensitive));
+
+		TSharedPtr<FJsonValue> Value = Document.GetRoot().ToJsonValue();
+		TArray<FString> Keys;
+		Value->AsObject()->Values.GetKeys(Keys);
+		const TSharedPtr<FJsonObject>* Nested = nullptr;
+		TestTrue(TEXT("Keys: the DOM copy keeps the casing"), Keys.Num() == 2 && Keys[0].Equals(TEXT("ArenaKeyCasing"), ESearchCase::CaseSensitive) && Keys[1].Equals(TEXT("Escaped"), ESearchCase::CaseSensitive));
+		TestTrue(TEXT("Keys: nested keys keep the casing"), Value->AsObject()->TryGetObjectField(TEXT("Escaped"), Nested)
+			&& (*Nested)->Values.Num() == 1 && (*Nested)->Values.CreateConstIterator().Key().Equals(TEXT("ARENAKEYCASING"), ESearchCase::CaseSensitive));
+	}
+
+	return true;
+}
+
+
+/**
+ * Compares the time and memory taken to read a large Json file with TJsonReader into the shared pointer DOM,
+ * with FJsonSaxReader alone and into FJsonArenaDocument.
+ * The file is given with -JsonBenchmarkFile=<file>, a telemetry like payload of about 40 MB is generated otherwise.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJsonSaxReaderBenchmark, "System.Engine.FileSystem.JSON.SaxReaderBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FJsonSaxReaderBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace JsonSaxReaderTest;
+
+	TArray<ANSICHAR> Json;
+	FString JsonFilename;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-JsonBenchmarkFile="), JsonFilename))
+	{
+		TArray<uint8> FileData;
+		if (!TestTrue(FString::Printf(TEXT("Loaded %s"), *JsonFilename), FFileHelper::LoadFileToArray(FileData, *JsonFilename)))
+		{
+			return false;
+		}
+		Json = TArray<ANSICHAR>((const ANSICHAR*)FileData.GetData(), FileData.Num());
+	}
+	else
+	{
+		GenerateBenchmarkJson(100000, Json);
+	}
+
+	const FAnsiStringView JsonView(Json.GetData(), Json.Num());
+	const double SizeMB = Json.Num() / (1024.0 * 1024.0);
+
+	// TJsonReader reads TCHAR, so the UTF-8 to TCHAR conversion that callers do first is part of its time
+	double StartTime = FPlatformTime::Seconds();
+	{
+		FUTF8ToTCHAR Converted(Json.GetData(), Json.Num());
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+		TSharedPtr<FJsonValue> Value;
+		TestTrue(TEXT("TJsonReader reads the benchmark file"), FJsonSerializer::Deserialize(Reader, Value));
+	}
+	const double DomTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	int64 NumNotations = 0;
+	{
+		FJsonSaxReader Reader(JsonView);
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation) && Notation != EJsonNotation::Error)
+		{
+			++NumNotations;
+		}
+		TestTrue(TEXT("FJsonSaxReader reads the benchmark file"), Reader.GetErrorMessage().IsEmpty());
+	}
+	const double SaxTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	int32 ArenaSize = 0;
+	{
+		FJsonArenaDocument Document;
+		TestTrue(TEXT("FJsonArenaDocument parses the benchmark file"), Document.Parse(JsonView));
+		ArenaSize = Document.GetAllocatedSize();
+	}
+	const double ArenaTime = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("%.1f MB, %lld notations"), SizeMB, NumNotations));
+	AddInfo(FString::Printf(TEXT("TJsonReader + FJsonSerializer: %.1f ms, %.1f MB/s"), DomTime * 1000.0, SizeMB / FMath::Max(DomTime, SMALL_NUMBER)));
+	AddInfo(FString::Printf(TEXT("FJsonSaxReader: %.1f ms, %.1f MB/s"), SaxTime * 1000.0, SizeMB / FMath::Max(SaxTime, SMALL_NUMBER)));
+	AddInfo(FString::Printf(TEXT("FJsonArenaDocument: %.1f ms, %.1f MB/s, %.1f MB of arena"), ArenaTime * 1000.0, SizeMB / FMath::Max(ArenaTime, SMALL_NUMBER), ArenaSize / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+#include "Serialization/JsonTypes.h"
+
+class FJsonValue;
+struct FJsonArenaField;
+
+/**
+ * An immutable Json value of an FJsonArenaDocument.
+ * Values never own memory: strings are unescaped UTF-8 and the elements of arrays and the fields of objects are
+ * contiguous, all living in the document's arena or its source buffer.
+ */
+class JSON_API FJsonArenaValue
+{
+public:
+
+	FJsonArenaValue()
+		: Number(0.0)
+		, Num(0)
+		, Type(EJson::Null)
+	{ }
+
+	FORCEINLINE EJson GetType() const
+	{
+		return Type;
+	}
+
+	FORCEINLINE bool IsNull() const
+	{
+		return Type == EJson::Null;
+	}
+
+	/** Gets the UTF-8 text of a string value, or an empty view if this is not a string. */
+	FORCEINLINE FAnsiStringView GetStringView() const
+	{
+		return Type == EJson::String ? FAnsiStringView(String, Num) : FAnsiStringView();
+	}
+
+	/** Gets the elements of an array value, or an empty view if this is not an array. */
+	FORCEINLINE TArrayView<const FJsonArenaValue> GetArray() const
+	{
+		return Type == EJson::Array ? TArrayView<const FJsonArenaValue>(Array, Num) : TArrayView<const FJsonArenaValue>();
+	}
+
+	/** Gets the fields of an object value in document order, or an empty view if this is not an object. */
+	TArrayView<const FJsonArenaField> GetFields() const;
+
+	/**
+	 * Finds a field of an object value. Names compare like FName, so case insensitively as in FJsonObject,
+	 * and the last field wins when a name is repeated. Empty names are interned as NAME_None.
+	 *
+	 * @param Name The name of the field.
+	 * @return The value of the field, or nullptr if there is no such field or this is not an object.
+	 */
+	const FJsonArenaValue* FindField(FName Name) const;
+
+	/** Finds a field of an object value that has the given type. */
+	const FJsonArenaValue* FindField(FName Name, EJson FieldType) const;
+
+	/** Tries to get a number value, returning false if this is not a number */
+	bool TryGetNumber(double& OutNumber) const;
+
+	/** Tries to get a number value, returning false if this is not a number or it is out of range */
+	bool TryGetNumber(int32& OutNumber) const;
+
+	/** Tries to get a number value, returning false if this is not a number or it is out of range */
+	bool TryGetNumber(int64& OutNumber) const;
+
+	/** Tries to get a string value as TCHAR, returning false if this is not a string */
+	bool TryGetString(FString& OutString) const;
+
+	/** Tries to get a boolean value, returning false if this is not a boolean */
+	bool TryGetBool(bool& OutBool) const;
+
+	/** Copies this value into the shared pointer DOM, for APIs that take FJsonValue or FJsonObject. */
+	TSharedPtr<FJsonValue> ToJsonValue() const;
+
+private:
+
+	friend class FJsonArenaDocument;
+
+	union
+	{
+		double Number;
+		bool Bool;
+		const ANSICHAR* String;
+		const FJsonArenaValue* Array;
+		const FJsonArenaField* Fields;
+	};
+
+	/** Length of a string, or number of elements of an array or fields of an object. */
+	int32 Num;
+
+	EJson Type;
+};
+
+
+/** A name/value pair of an object of an FJsonArenaDocument. */
+struct FJsonArenaField
+{
+	/** The name interned for lookups, which may be cased like an earlier use of the same FName */
+	FName Name;
+	FJsonArenaValue Value;
+
+	/** The unescaped UTF-8 text of the name, cased as in the document */
+	FORCEINLINE FAnsiStringView GetKey() const
+	{
+		return FAnsiStringView(Key, KeyLen);
+	}
+
+	const ANSICHAR* Key;
+	int32 KeyLen;
+};
+
+
+FORCEINLINE TArrayView<const FJsonArenaField> FJsonArenaValue::GetFields() const
+{
+	return Type == EJson::Object ? TArrayView<const FJsonArenaField>(Fields, Num) : TArrayView<const FJsonArenaField>();
+}
+
+
+/**
+ * A Json document parsed from a UTF-8 buffer with FJsonSaxReader into immutable values allocated from an arena.
+ *
+ * Parsing does one allocation per arena page instead of one per value, field names are interned as FNames, and strings
+ * without escape sequences point into the source buffer instead of being copied, so the buffer must outlive the document.
+ * Everything is released at once when the document is destroyed or parses another buffer.
+ */
+class JSON_API FJsonArenaDocument
+	: public FNoncopyable
+{
+public:
+
+	FJsonArenaDocument();
+
+	/**
+	 * Parses a Json buffer, replacing the previous content of the document.
+	 *
+	 * @param Json The UTF-8 Json text, which must outlive the document.
+	 * @return true on success, false otherwise, in which case the root is null and GetErrorMessage() tells why.
+	 *         Field names longer than an FName can hold are an error.
+	 */
+	bool Parse(FAnsiStringView Json);
+
+	/** Gets the root object or array, null if nothing was parsed. */
+	FORCEINLINE const FJsonArenaValue& GetRoot() const
+	{
+		return Root;
+	}
+
+	FORCEINLINE const FString& GetErrorMessage() const
+	{
+		return ErrorMessage;
+	}
+
+	/** Gets the number of bytes in use in the arena. */
+	int32 GetAllocatedSize() const;
+
+private:
+
+	FMemStackBase Arena;
+	FJsonArenaValue Root;
+	FString ErrorMessage;
+};
@@ -28,8 +28,10 @@ MONOLITHIC_HEADER_BOILERPLATE()
 #include "Serialization/JsonTypes.h"
 #include "Dom/JsonValue.h"
 #include "Dom/JsonObject.h"
+#include "Dom/JsonArenaDocument.h"
 
 #include "Serialization/JsonReader.h"
+#include "Serialization/JsonSaxReader.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonSerializerMacros.h"
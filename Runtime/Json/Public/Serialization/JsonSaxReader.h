@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonTypes.h"
+
+/**
+ * Forward-only Json reader over a UTF-8 buffer that does not copy or allocate per token.
+ *
+ * It reads the same notations as TJsonReader, but identifiers and values are returned as views into the buffer,
+ * which must outlive the reader. Views of strings are raw: they still hold their escape sequences when
+ * HasEscapes() returns true, and can be decoded with GetValueAsString() or UnescapeString().
+ * Numbers are validated when read and only converted when asked for.
+ */
+class JSON_API FJsonSaxReader
+{
+public:
+
+	/**
+	 * Creates a reader over a UTF-8 buffer. A leading byte order mark and trailing null terminators are ignored.
+	 *
+	 * @param Json The Json text, which must outlive the reader.
+	 */
+	explicit FJsonSaxReader(FAnsiStringView Json);
+
+	/**
+	 * Reads the next notation, following the same rules as TJsonReader::ReadNext.
+	 *
+	 * @param Notation Will contain the notation that was read, EJsonNotation::Error if the input is malformed.
+	 * @return false once the root value has been read entirely or after an error was returned, true otherwise.
+	 */
+	bool ReadNext(EJsonNotation& Notation);
+
+	/** Skips to the end of the object that was just started. Skipped values are only checked for balanced scopes and terminated strings. */
+	bool SkipObject();
+
+	/** Skips to the end of the array that was just started. Skipped values are only checked for balanced scopes and terminated strings. */
+	bool SkipArray();
+
+	/** Gets the raw name of the last value read in an object, empty for values in arrays. */
+	FORCEINLINE FAnsiStringView GetIdentifier() const
+	{
+		return Identifier;
+	}
+
+	/** Whether the last identifier contains escape sequences. */
+	FORCEINLINE bool IdentifierHasEscapes() const
+	{
+		return bIdentifierHasEscapes;
+	}
+
+	/** Gets the raw text of the last string value, without quotes. */
+	FORCEINLINE FAnsiStringView GetValueAsStringView() const
+	{
+		check(CurrentToken == EJsonToken::String);
+		return Value;
+	}
+
+	/** Whether the last string value contains escape sequences. */
+	FORCEINLINE bool HasEscapes() const
+	{
+		return bValueHasEscapes;
+	}
+
+	/** Gets the text of the last number value, as it appears in the buffer. */
+	FORCEINLINE FAnsiStringView GetValueAsNumberString() const
+	{
+		check(CurrentToken == EJsonToken::Number);
+		return Value;
+	}
+
+	FORCEINLINE bool GetValueAsBoolean() const
+	{
+		check((CurrentToken == EJsonToken::True) || (CurrentToken == EJsonToken::False));
+		return CurrentToken == EJsonToken::True;
+	}
+
+	/** Decodes the last string value. */
+	FString GetValueAsString() const;
+
+	/** Converts the last number value. */
+	double GetValueAsNumber() const;
+
+	/** Decodes the last identifier. */
+	FString GetIdentifierAsString() const;
+
+	FORCEINLINE const FString& GetErrorMessage() const
+	{
+		return ErrorMessage;
+	}
+
+	/** Gets the line of the read position. It is computed on demand, so it is meant for error reporting. */
+	uint32 GetLineNumber() const;
+
+	/** Gets the character of the read position within its line, in bytes. It is computed on demand, so it is meant for error reporting. */
+	uint32 GetCharacterNumber() const;
+
+	/** Gets the byte offset of the read position. */
+	FORCEINLINE int32 GetOffset() const
+	{
+		return Pos;
+	}
+
+public:
+
+	/**
+	 * Decodes the escape sequences of a string that was validated by the reader.
+	 * The decoded string is never longer than the escaped one, so Out may alias Escaped.
+	 *
+	 * @param Escaped The raw string, as returned by GetIdentifier() or GetValueAsStringView().
+	 * @param Out Buffer of at least Escaped.Len() characters that receives the UTF-8 decoded string.
+	 * @return The length of the decoded string.
+	 */
+	static int32 UnescapeString(FAnsiStringView Escaped, ANSICHAR* Out);
+
+	/** Decodes a raw string to TCHAR, unescaping it if needed. */
+	static FString DecodeString(FAnsiStringView Raw, bool bHasEscapes);
+
+	/** Converts the text of a number that was validated by the reader. */
+	static double ParseNumber(FAnsiStringView Number);
+
+private:
+
+	bool ReadStart();
+	bool ReadNextObjectValue();
+	bool ReadNextArrayValue();
+	bool NextToken(EJsonToken& OutToken);
+	bool ParseStringToken(FAnsiStringView& OutString, bool& bOutHasEscapes);
+	bool ParseNumberToken();
+	bool ParseLiteralToken(EJsonToken& OutToken);
+	bool SkipToMatching(EJsonToken CloseToken);
+	void SkipWhiteSpace();
+	void SetErrorMessage(const TCHAR* Message);
+
+	FORCEINLINE static bool IsWhitespace(ANSICHAR Char)
+	{
+		return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+	}
+
+private:
+
+	TArray<EJson, TInlineAllocator<32>> ParseState;
+	EJsonToken CurrentToken;
+
+	const ANSICHAR* Data;
+	int32 Num;
+	int32 Pos;
+
+	FAnsiStringView Identifier;
+	FAnsiStringView Value;
+	FString ErrorMessage;
+
+	bool bIdentifierHasEscapes;
+	bool bValueHasEscapes;
+	bool FinishedReadingRootObject;
+};
@@ -4536,6 +4536,11 @@ static inline void EndFrameRenderThread(FRHICommandListImmediate& RHICmdList, ui
 	});
 
 	FCoreDelegates::OnEndFrameRT.Broadcast();
+	if (IsInActualRenderingThread())
+	{
+		// release the rendering thread's frame temporaries; without a rendering thread this runs on the game thread, which resets its own below
+		FFrameMemStack::Get().EndFrame();
+	}
 	RHICmdList.EndFrame();
 
 	GPU_STATS_ENDFRAME(RHICmdList);
@@ -5057,6 +5062,9 @@ void FEngineLoop::Tick()
 
 		FCoreDelegates::OnEndFrame.Broadcast();
 
+		// release the game thread's frame temporaries
+		FFrameMemStack::Get().EndFrame();
+
 		#if !UE_SERVER && WITH_ENGINE
 		{
 			// We emit dynamic resolution's end frame right before RHI's. GEngine is going to ignore it if no BeginFrame was done.
@@ -510,6 +510,39 @@ static FAutoConsoleVariableRef CVar_EnableNoCaching(
 	TEXT("if > 0, then we'll allow a read requests pak cache memory to be ditched early")
 );
 
+int32 GPakCache_ReadAhead = 1;
+static FAutoConsoleVariableRef CVar_ReadAhead(
+	TEXT("pakcache.ReadAhead"),
+	GPakCache_ReadAhead,
+	TEXT("if > 0, then async reads that walk sequentially through a file precache the data ahead of them")
+);
+
+int32 GPakCache_ReadAheadMinKB = 128;
+static FAutoConsoleVariableRef CVar_ReadAheadMinKB(
+	TEXT("pakcache.ReadAheadMinKB"),
+	GPakCache_ReadAheadMinKB,
+	TEXT("Size (in KB) of the first read ahead window once sequential access is detected. The window doubles with each further sequential read.")
+);
+
+int32 GPakCache_ReadAheadMaxKB = 4096;
+static FAutoConsoleVariableRef CVar_ReadAheadMaxKB(
+	TEXT("pakcache.ReadAheadMaxKB"),
+	GPakCache_ReadAheadMaxKB,
+	TEXT("Maximum size (in KB) of the read ahead window of a file handle.")
+);
+
+int32 GPakCache_ReadAheadMaxMemoryPerPakMB = 16;
+static FAutoConsoleVariableRef CVar_ReadAheadMaxMemoryPerPakMB(
+	TEXT("pakcache.ReadAheadMaxMemoryPerPakMB"),
+	GPakCache_ReadAheadMaxMemoryPerPakMB,
+	TEXT("Memory budget (in MB) for data read ahead and not yet consumed, per pak file.")
+);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("PakCache ReadAhead Requests"), STAT_PakCache_ReadAheadRequests, STATGROUP_PakFile);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("PakCache ReadAhead Requests Cancelled"), STAT_PakCache_ReadAheadCancelled, STATGROUP_PakFile);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("PakCache ReadAhead Requests Over Budget"), STAT_PakCache_ReadAheadOverBudget, STATGROUP_PakFile);
+DECLARE_MEMORY_STAT(TEXT("PakCache ReadAhead Memory"), STAT_PakCache_ReadAheadMemory, STATGROUP_PakFile);
+
 
 class FPakPrecacher;
 
@@ -1338,6 +1371,9 @@ class FPakPrecacher
 
 	TArray < TArray<FJoinedOffsetAndPakIndex>> OffsetAndPakIndexOfSavedBlocked;
 
+	/** Bytes of read ahead requests that have been issued and not yet consumed or cancelled, per pak file. */
+	TMap<FPakFile*, int64> ReadAheadMemoryPerPak;
+
 	struct FRequestToLower
 	{
 		IAsyncReadRequest* RequestHandle;
@@ -2849,6 +2885,33 @@ public:
 		StartNextRequest();
 	}
 
+	bool ReserveReadAheadMemory(FPakFile* InActualPakFile, int64 Size)
+	{
+		FScopeLock Lock(&CachedFilesScopeLock);
+		int64& PakReadAheadMemory = ReadAheadMemoryPerPak.FindOrAdd(InActualPakFile);
+		if (PakReadAheadMemory + Size > int64(GPakCache_ReadAheadMaxMemoryPerPakMB) * 1024 * 1024)
+		{
+			INC_DWORD_STAT(STAT_PakCache_ReadAheadOverBudget);
+			return false;
+		}
+		PakReadAheadMemory += Size;
+		INC_MEMORY_STAT_BY(STAT_PakCache_ReadAheadMemory, Size);
+		return true;
+	}
+
+	void ReleaseReadAheadMemory(FPakFile* InActualPakFile, int64 Size)
+	{
+		FScopeLock Lock(&CachedFilesScopeLock);
+		int64& PakReadAheadMemory = ReadAheadMemoryPerPak.FindChecked(InActualPakFile);
+		check(PakReadAheadMemory >= Size);
+		PakReadAheadMemory -= Size;
+		if (!PakReadAheadMemory)
+		{
+			ReadAheadMemoryPerPak.Remove(InActualPakFile);
+		}
+		DEC_MEMORY_STAT_BY(STAT_PakCache_ReadAheadMemory, Size);
+	}
+
 	bool IsProbablyIdle() // nothing to prevent new requests from being made before I return
 	{
 		FScopeLock Lock(&CachedFilesScopeLock);
@@ -3680,6 +3743,21 @@ class FPakAsyncReadFileHandle final : public IAsyncReadFileHandle
 
 	TMap<FCachedAsyncBlock*, FPakProcessedReadRequest*> OutstandingCancelMapBlock;
 
+	/** A precache request reading ahead of a sequential stream of reads, holding its data in the pak cache until it is consumed. */
+	struct FReadAheadRequest
+	{
+		IAsyncReadRequest* Request;
+		int64 UncompressedEnd;
+		int64 RawSize;
+	};
+	TArray<FReadAheadRequest> ReadAheadRequests;
+	/** Offset the next read has to start at to continue the current sequential stream. */
+	int64 NextSequentialOffset;
+	/** Uncompressed offset up to which read ahead requests have been issued. */
+	int64 ReadAheadEnd;
+	/** Current read ahead window size, grows while reads stay sequential. */
+	int64 ReadAheadWindow;
+
 	FCachedAsyncBlock& GetBlock(int32 Index)
 	{
 		if (!Blocks[Index])
@@ -3700,6 +3778,9 @@ public:
 		, NumLiveRawRequests(0)
 		, CompressedChunkOffset(0)
 		, EncryptionKeyGuid(InPakFile->GetInfo().EncryptionKeyGuid)
+		, NextSequentialOffset(0)
+		, ReadAheadEnd(0)
+		, ReadAheadWindow(0)
 	{
 		OffsetInPak = FileEntry.Offset + FileEntry.GetSerializedSize(InPakFile->GetInfo().Version);
 		UncompressedFileSize = FileEntry.UncompressedSize;
@@ -3727,6 +3808,7 @@ public:
 	~FPakAsyncReadFileHandle()
 	{
 		FScopeLock ScopedLock(&CriticalSection);
+		CancelReadAhead();
 		if (LiveRequests.Num() > 0 || NumLiveRawRequests > 0)
 		{
 			UE_LOG(LogPakFile, Fatal, TEXT("LiveRequests.Num or NumLiveRawReqeusts was > 0 in ~FPakAsyncReadFileHandle!"));
@@ -3762,14 +3844,20 @@ public:
 			check(Offset + BytesToRead + OffsetInPak <= PakFileSize);
 			check(!Blocks.Num());
 
+			IAsyncReadRequest* Result;
 			if (FileEntry.IsEncrypted())
 			{
-				return new FPakEncryptedReadRequest(ActualPakFile, PakFile, PakFileSize, CompleteCallback, OffsetInPak, Offset, BytesToRead, PriorityAndFlags, UserSuppliedMemory, EncryptionKeyGuid);
+				Result = new FPakEncryptedReadRequest(ActualPakFile, PakFile, PakFileSize, CompleteCallback, OffsetInPak, Offset, BytesToRead, PriorityAndFlags, UserSuppliedMemory, EncryptionKeyGuid);
 			}
 			else
 			{
-				return new FPakReadRequest(ActualPakFile, PakFile, PakFileSize, CompleteCallback, OffsetInPak + Offset, BytesToRead, PriorityAndFlags, UserSuppliedMemory);
+				Result = new FPakReadRequest(ActualPakFile, PakFile, PakFileSize, CompleteCallback, OffsetInPak + Offset, BytesToRead, PriorityAndFlags, UserSuppliedMemory);
 			}
+			{
+				FScopeLock ScopedLock(&CriticalSection);
+				UpdateReadAhead(Offset, BytesToRead, PriorityAndFlags);
+			}
+			return Result;
 		}
 		bool bAnyUnfinished = false;
 		FPakProcessedReadRequest* Result;
@@ -3804,10 +3892,119 @@ public:
 			{
 				Result->RequestIsComplete();
 			}
+			UpdateReadAhead(Offset, BytesToRead, PriorityAndFlags);
 		}
 		return Result;
 	}
 
+	/** Detects sequential reads and keeps a growing window of data ahead of them in the pak cache. Must be called with CriticalSection held, after the read itself was queued. */
+	void UpdateReadAhead(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags)
+	{
+		if (!GPakCache_ReadAhead || (PriorityAndFlags & AIOP_FLAG_PRECACHE))
+		{
+			return;
+		}
+
+		const int64 EndOffset = Offset + BytesToRead;
+		if (Offset != NextSequentialOffset)
+		{
+			// Random access, the data read ahead of the previous position is unlikely to be used
+			CancelReadAhead();
+			NextSequentialOffset = EndOffset;
+			ReadAheadEnd = EndOffset;
+			ReadAheadWindow = 0;
+			return;
+		}
+		NextSequentialOffset = EndOffset;
+
+		// Read ahead requests the stream has moved past were consumed by the read that was just queued
+		for (int32 Index = 0; Index < ReadAheadRequests.Num(); )
+		{
+			if (ReadAheadRequests[Index].UncompressedEnd <= EndOffset)
+			{
+				ReleaseReadAheadRequest(ReadAheadRequests[Index]);
+				ReadAheadRequests.RemoveAt(Index);
+			}
+			else
+			{
+				++Index;
+			}
+		}
+
+		const int64 MinWindow = int64(FMath::Max(GPakCache_ReadAheadMinKB, 1)) * 1024;
+		const int64 MaxWindow = FMath::Max(int64(GPakCache_ReadAheadMaxKB) * 1024, MinWindow);
+		ReadAheadWindow = ReadAheadWindow ? FMath::Min(ReadAheadWindow * 2, MaxWindow) : MinWindow;
+
+		const int64 Start = FMath::Max(ReadAheadEnd, EndOffset);
+		int64 End = FMath::Min(EndOffset + ReadAheadWindow, UncompressedFileSize);
+		if (Start >= End)
+		{
+			return;
+		}
+
+		int64 RawOffset;
+		int64 RawSize;
+		if (CompressionMethod == NAME_None)
+		{
+			RawOffset = OffsetInPak + Start;
+			RawSize = End - Start;
+		}
+		else
+		{
+			// Whole compression blocks, skipping those already being read
+			int32 FirstBlock = Start / FileEntry.CompressionBlockSize;
+			const int32 LastBlock = (End - 1) / FileEntry.CompressionBlockSize;
+			while (FirstBlock <= LastBlock && Blocks[FirstBlock] && Blocks[FirstBlock]->bInFlight)
+			{
+				++FirstBlock;
+			}
+			End = FMath::Min(int64(LastBlock + 1) * FileEntry.CompressionBlockSize, UncompressedFileSize);
+			if (FirstBlock > LastBlock)
+			{
+				ReadAheadEnd = End;
+				return;
+			}
+			RawOffset = FileEntry.CompressionBlocks[FirstBlock].CompressedStart + CompressedChunkOffset;
+			int64 RawEnd = FileEntry.CompressionBlocks[LastBlock].CompressedEnd + CompressedChunkOffset;
+			if (FileEntry.IsEncrypted())
+			{
+				RawEnd = RawOffset + Align(RawEnd - RawOffset, FAES::AESBlockSize);
+			}
+			RawSize = RawEnd - RawOffset;
+		}
+		RawSize = FMath::Min(RawSize, PakFileSize - RawOffset);
+		if (RawSize <= 0 || !FPakPrecacher::Get().ReserveReadAheadMemory(ActualPakFile, RawSize))
+		{
+			return;
+		}
+
+		INC_DWORD_STAT(STAT_PakCache_ReadAheadRequests);
+		const EAsyncIOPriorityAndFlags ReadAheadPriority = (PriorityAndFlags & AIOP_PRIORITY_MASK) | AIOP_FLAG_PRECACHE;
+		IAsyncReadRequest* Request = new FPakReadRequest(ActualPakFile, PakFile, PakFileSize, nullptr, RawOffset, RawSize, ReadAheadPriority, nullptr);
+		ReadAheadRequests.Add(FReadAheadRequest{ Request, End, RawSize });
+		ReadAheadEnd = End;
+	}
+
+	void ReleaseReadAheadRequest(FReadAheadRequest& ReadAhead)
+	{
+		ReadAhead.Request->Cancel();
+		ReadAhead.Request->WaitCompletion();
+		delete ReadAhead.Request;
+		ReadAhead.Request = nullptr;
+		FPakPrecacher::Get().ReleaseReadAheadMemory(ActualPakFile, ReadAhead.RawSize);
+	}
+
+	/** Drop all outstanding read ahead, e.g. when the access pattern stops being sequential. Must be called with CriticalSection held. */
+	void CancelReadAhead()
+	{
+		for (FReadAheadRequest& ReadAhead : ReadAheadRequests)
+		{
+			INC_DWORD_STAT(STAT_PakCache_ReadAheadCancelled);
+			ReleaseReadAheadRequest(ReadAhead);
+		}
+		ReadAheadRequests.Reset();
+	}
+
 	void StartBlock(int32 BlockIndex, EAsyncIOPriorityAndFlags PriorityAndFlags)
 	{
 		FCachedAsyncBlock& Block = GetBlock(BlockIndex);
@@ -6631,6 +6828,16 @@ public:
 			PlatformFile.HandleReloadPakReadersCommand(Cmd, Ar);
 			return true;
 		}
+		else if (FParse::Command(&Cmd, TEXT("PakLookupBenchmark")))
+		{
+			PlatformFile.HandlePakLookupBenchmarkCommand(Cmd, Ar);
+			return true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("PakReadAheadReplay")))
+		{
+			PlatformFile.HandlePakReadAheadReplayCommand(Cmd, Ar);
+			return true;
+		}
 		return false;
 	}
 };
@@ -6681,11 +6888,150 @@ void FPakPlatformFile::HandleReloadPakReadersCommand(const TCHAR* Cmd, FOutputDe
 		Pak.PakFile->RecreatePakReaders(LowerLevel);
 	}
 }
+
+int32 GetRecursiveAllocatedSize(const FPakFile::FDirectoryIndex& Index);
+
+void FPakPlatformFile::HandlePakLookupBenchmarkCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	int32 NumFilenames = 10000;
+	FParse::Value(Cmd, TEXT("Num="), NumFilenames);
+
+	TArray<FPakListEntry> Paks;
+	GetMountedPaks(Paks);
+
+	// Look up existing files from every pak, plus an equal number of missing ones
+	TArray<FString> Filenames;
+	for (int32 PakIndex = 0; PakIndex < Paks.Num() && Filenames.Num() < NumFilenames; ++PakIndex)
+	{
+		const FPakFile& PakFile = *Paks[PakIndex].PakFile;
+		if (!PakFile.bHasFullDirectoryIndex)
+		{
+			continue;
+		}
+		const int32 NumPerPak = FMath::Max(NumFilenames / Paks.Num(), 1);
+		int32 NumAdded = 0;
+		for (FPakFile::FFilenameIterator It(PakFile); It && NumAdded < NumPerPak; ++It, ++NumAdded)
+		{
+			Filenames.Add(PakFile.GetMountPoint() + It.Filename());
+		}
+	}
+	const int32 NumExisting = Filenames.Num();
+	for (int32 Index = 0; Index < NumExisting; ++Index)
+	{
+		Filenames.Add(Filenames[Index] + TEXT(".missing"));
+	}
+	if (Filenames.Num() == 0)
+	{
+		Ar.Logf(TEXT("PakLookupBenchmark: no mounted pak file has a directory index to take filenames from."));
+		return;
+	}
+
+	int32 NumFoundSearch = 0;
+	double SearchTime = 0.0;
+	{
+		FScopedDurationTimer Timer(SearchTime);
+		for (const FString& Filename : Filenames)
+		{
+			TArray<FPakListEntry> MountedPaks;
+			GetMountedPaks(MountedPaks);
+			NumFoundSearch += FindFileInPakFiles(MountedPaks, *Filename, nullptr) ? 1 : 0;
+		}
+	}
+
+	int32 NumFoundIndex = 0;
+	double IndexTime = 0.0;
+	{
+		FScopedDurationTimer Timer(IndexTime);
+		for (const FString& Filename : Filenames)
+		{
+			bool bFound = false;
+			if (!FindFileInGlobalPathIndex(*Filename, nullptr, nullptr, bFound))
+			{
+				Ar.Logf(TEXT("PakLookupBenchmark: %d mounted pak files are not in the global path index."), NumUnindexedPakFiles);
+				return;
+			}
+			NumFoundIndex += bFound ? 1 : 0;
+		}
+	}
+
+	Ar.Logf(TEXT("PakLookupBenchmark: %d lookups over %d pak files (%d files in the global path index)"), Filenames.Num(), Paks.Num(), GlobalPathIndex.Num());
+	Ar.Logf(TEXT("  Search all pak files: %.3fms, %.3fus per lookup, %d found"), SearchTime * 1000.0, SearchTime * 1000000.0 / Filenames.Num(), NumFoundSearch);
+	Ar.Logf(TEXT("  Global path index:    %.3fms, %.3fus per lookup, %d found"), IndexTime * 1000.0, IndexTime * 1000000.0 / Filenames.Num(), NumFoundIndex);
+
+	int32 NumIndexedFiles = 0;
+	int64 DirectoryIndexSize = 0;
+	for (const FPakListEntry& Pak : Paks)
+	{
+		FPakFile::FScopedPakDirectoryIndexAccess ScopeAccess(*Pak.PakFile);
+		NumIndexedFiles += Pak.PakFile->GetNumFiles();
+		DirectoryIndexSize += GetRecursiveAllocatedSize(Pak.PakFile->DirectoryIndex);
+	}
+	SIZE_T GlobalPathIndexSize = 0;
+	{
+		FReadScopeLock ScopeLock(GlobalPathIndexLock);
+		GlobalPathIndexSize = GetGlobalPathIndexAllocatedSize();
+	}
+	Ar.Logf(TEXT("  Global path index memory: %" SIZE_T_FMT " bytes, %.1f bytes per mounted file"),
+		GlobalPathIndexSize, double(GlobalPathIndexSize) / FMath::Max(NumIndexedFiles, 1));
+	Ar.Logf(TEXT("  Pak directory indexes:    %lld bytes, %.1f bytes per mounted file"), DirectoryIndexSize, double(DirectoryIndexSize) / FMath::Max(NumIndexedFiles, 1));
+	UE_CLOG(NumFoundSearch != NumFoundIndex, LogPakFile, Error, TEXT("PakLookupBenchmark: global path index disagrees with searching all pak files"));
+}
+
+void FPakPlatformFile::HandlePakReadAheadReplayCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+#if USE_PAK_PRECACHE
+	// Replays a streaming consumer: sequential async reads of a file in a pak, each waited on before the next is issued
+	FString Filename;
+	if (!FParse::Value(Cmd, TEXT("File="), Filename))
+	{
+		Ar.Logf(TEXT("Usage: PakReadAheadReplay File=<file in a mounted pak> [ChunkKB=64] [ReadAhead=0|1]"));
+		return;
+	}
+	int32 ChunkKB = 64;
+	FParse::Value(Cmd, TEXT("ChunkKB="), ChunkKB);
+	const int64 ChunkSize = int64(FMath::Max(ChunkKB, 1)) * 1024;
+	int32 ReadAhead = GPakCache_ReadAhead;
+	FParse::Value(Cmd, TEXT("ReadAhead="), ReadAhead);
+
+	TUniquePtr<IAsyncReadFileHandle> Handle(OpenAsyncRead(*Filename));
+	TUniquePtr<IAsyncReadRequest> SizeRequest(Handle.IsValid() ? Handle->SizeRequest() : nullptr);
+	if (SizeRequest.IsValid())
+	{
+		SizeRequest->WaitCompletion();
+	}
+	const int64 FileSize = SizeRequest.IsValid() ? SizeRequest->GetSizeResults() : -1;
+	if (FileSize <= 0)
+	{
+		Ar.Logf(TEXT("PakReadAheadReplay: could not open '%s'."), *Filename);
+		return;
+	}
+
+	TGuardValue<int32> ReadAheadGuard(GPakCache_ReadAhead, ReadAhead);
+	double ReadTime = 0.0;
+	{
+		FScopedDurationTimer Timer(ReadTime);
+		for (int64 Offset = 0; Offset < FileSize; Offset += ChunkSize)
+		{
+			TUniquePtr<IAsyncReadRequest> Request(Handle->ReadRequest(Offset, FMath::Min(ChunkSize, FileSize - Offset), AIOP_Normal));
+			Request->WaitCompletion();
+			FMemory::Free(Request->GetReadResults());
+		}
+	}
+	Handle.Reset();
+
+	Ar.Logf(TEXT("PakReadAheadReplay: %s, %lld bytes in %lldKB reads, read ahead %s: %.3fms, %.2fMB/s"),
+		*Filename, FileSize, ChunkSize / 1024, ReadAhead ? TEXT("on") : TEXT("off"), ReadTime * 1000.0, double(FileSize) / (1024.0 * 1024.0) / FMath::Max(ReadTime, SMALL_NUMBER));
+#else
+	Ar.Logf(TEXT("PakReadAheadReplay: read ahead requires the pak precacher, which is compiled out."));
+#endif
+}
 #endif // !UE_BUILD_SHIPPING
 
 FPakPlatformFile::FPakPlatformFile()
 	: LowerLevel(NULL)
 	, bSigned(false)
+	, GlobalPathIndexFreeEntry(INDEX_NONE)
+	, NumUnindexedPakFiles(0)
 {
 	FCoreDelegates::GetRegisterEncryptionKeyMulticastDelegate().AddRaw(this, &FPakPlatformFile::RegisterEncryptionKey);
 }
@@ -7017,6 +7363,13 @@ void FPakPlatformFile::OptimizeMemoryUsageForMountedPaks()
 	}
 #endif
 
+	{
+		// The GlobalPathIndex grows one pak file at a time while mounting; drop the slack once the initial pak files are mounted
+		FWriteScopeLock ScopeLock(GlobalPathIndexLock);
+		GlobalPathIndex.Shrink();
+		GlobalPathIndexEntries.Shrink();
+	}
+
 #if !UE_BUILD_SHIPPING
 	uint32 DirectoryHashSize = 0;
 	uint32 PathHashSize = 0;
@@ -7036,6 +7389,10 @@ void FPakPlatformFile::OptimizeMemoryUsageForMountedPaks()
 		EntriesSize += PakFile->Files.GetAllocatedSize();
 	}
 	UE_LOG(LogPakFile, Log, TEXT("AllPaks IndexSizes: DirectoryHashSize=%d, PathHashSize=%d, EntriesSize=%d, TotalSize=%d"), DirectoryHashSize, PathHashSize, EntriesSize, DirectoryHashSize + PathHashSize + EntriesSize);
+	{
+		FReadScopeLock ScopeLock(GlobalPathIndexLock);
+		UE_LOG(LogPakFile, Log, TEXT("GlobalPathIndexSize=%d"), (int32)GetGlobalPathIndexAllocatedSize());
+	}
 #endif
 }
 
@@ -7092,6 +7449,7 @@ bool FPakPlatformFile::Mount(const TCHAR* InPakFilename, uint32 PakOrder, const
 					Entry.PakFile = Pak;
 					PakFiles.Add(Entry);
 					PakFiles.StableSort();
+					AddToGlobalPathIndex(Pak, PakOrder);
 				}
 				bPakSuccess = true;
 			}
@@ -7187,6 +7545,7 @@ bool FPakPlatformFile::Unmount(const TCHAR* InPakFilename)
 			{
 				FPakListEntry& PakListEntry = PakFiles[PakIndex];
 				RemoveCachedPakSignaturesFile(*PakListEntry.PakFile->GetFilename());
+				RemoveFromGlobalPathIndex(PakListEntry.PakFile);
 				delete PakListEntry.PakFile;
 				PakFiles.RemoveAt(PakIndex);
 				return true;
@@ -7196,6 +7555,326 @@ bool FPakPlatformFile::Unmount(const TCHAR* InPakFilename)
 	return false;
 }
 
+static bool GPakUseGlobalPathIndex = true;
+static FAutoConsoleVariableRef CVar_PakUseGlobalPathIndex(
+	TEXT("pak.UseGlobalPathIndex"),
+	GPakUseGlobalPathIndex,
+	TEXT("If true, files are found through a single index of all mounted pak files rather than by searching every pak file in turn.")
+);
+
+/** One step of the 64-bit FNV-1a hash used for the GlobalPathIndex. */
+static FORCEINLINE uint64 HashGlobalPathChar(uint64 Hash, TCHAR Char)
+{
+	static const uint64 Prime = 0x00000100000001b3ull;
+	return (Hash ^ uint64(FChar::ToLower(Char))) * Prime;
+}
+
+uint64 FPakPlatformFile::HashGlobalPath(const TCHAR* Path, uint64 InHash)
+{
+	// Hash the lowercase characters, so that filenames never need to be copied to be hashed
+	uint64 Hash = InHash;
+	for (; *Path; ++Path)
+	{
+		Hash = HashGlobalPathChar(Hash, *Path);
+	}
+	return Hash;
+}
+
+bool FPakPlatformFile::TryHashStandardFilename(const TCHAR* Filename, uint64& OutHash)
+{
+	// A path below the root directory is already standard unless it has backslashes, duplicate slashes or relative components
+	const FString& RelativePathToRoot = FPaths::GetRelativePathToRoot();
+	if (RelativePathToRoot.IsEmpty() || FCString::Strncmp(Filename, *RelativePathToRoot, RelativePathToRoot.Len()) != 0)
+	{
+		return false;
+	}
+
+	uint64 Hash = HashGlobalPath(*RelativePathToRoot);
+	bool bComponentStart = RelativePathToRoot[RelativePathToRoot.Len() - 1] == TEXT('/');
+	for (const TCHAR* Path = Filename + RelativePathToRoot.Len(); *Path; ++Path)
+	{
+		const TCHAR Char = *Path;
+		if (Char == TEXT('\\') || Char == TEXT(':'))
+		{
+			return false;
+		}
+		else if (Char == TEXT('/'))
+		{
+			if (bComponentStart)
+			{
+				return false;
+			}
+			bComponentStart = true;
+		}
+		else
+		{
+			if (bComponentStart && Char == TEXT('.'))
+			{
+				const TCHAR* ComponentEnd = Path[1] == TEXT('.') ? Path + 2 : Path + 1;
+				if (*ComponentEnd == TEXT('/') || *ComponentEnd == TEXT('\0'))
+				{
+					return false;
+				}
+			}
+			bComponentStart = false;
+		}
+		Hash = HashGlobalPathChar(Hash, Char);
+	}
+
+	OutHash = Hash;
+	return true;
+}
+
+bool FPakPlatformFile::GlobalPathIndexPakHasFile(const FPakFile& PakFile, const FString& FullPath)
+{
+	// Only the pak file's own directory index holds the path strings, the GlobalPathIndex just keeps their hashes
+	FPakFile::FScopedPakDirectoryIndexAccess ScopeAccess(PakFile);
+	return FPakFile::FindLocationFromIndex(FullPath, PakFile.MountPoint, PakFile.DirectoryIndex) != nullptr;
+}
+
+void FPakPlatformFile::AddToGlobalPathIndex(FPakFile* PakFile, uint32 ReadOrder)
+{
+	FWriteScopeLock ScopeLock(GlobalPathIndexLock);
+
+	bool bHasFilenames = PakFile->bHasFullDirectoryIndex;
+#if ENABLE_PAKFILE_RUNTIME_PRUNING
+	// Paths found through the GlobalPathIndex are checked against the pak file's own index, which must keep every filename
+	bHasFilenames = bHasFilenames && !PakFile->bWillPruneDirectoryIndex;
+#endif
+	if (!bHasFilenames)
+	{
+		UE_LOG(LogPakFile, Verbose, TEXT("Pak file \"%s\" has no full directory index, files in mounted paks will be found by searching each pak file"), *PakFile->GetFilename());
+		++NumUnindexedPakFiles;
+		return;
+	}
+
+	int32 PakSlot = GlobalPathIndexPaks.IndexOfByPredicate([](const FPakGlobalIndexPak& Pak) { return Pak.PakFile == nullptr; });
+	if (PakSlot == INDEX_NONE)
+	{
+		PakSlot = GlobalPathIndexPaks.AddUninitialized();
+	}
+	GlobalPathIndexPaks[PakSlot] = FPakGlobalIndexPak{ PakFile, ReadOrder };
+
+	bool bHashCollision = false;
+	{
+		FPakFile::FScopedPakDirectoryIndexAccess ScopeAccess(*PakFile);
+		for (const TPair<FString, FPakDirectory>& Directory : PakFile->DirectoryIndex)
+		{
+			if (Directory.Value.Num() == 0)
+			{
+				continue;
+			}
+
+			const FString DirectoryPath = FPakFile::PakPathCombine(PakFile->MountPoint, Directory.Key);
+			const uint64 DirectoryHash = HashGlobalPath(*DirectoryPath);
+			for (const TPair<FString, FPakEntryLocation>& File : Directory.Value)
+			{
+				const uint64 PathHash = HashGlobalPath(*File.Key, DirectoryHash);
+
+				// Paths of this pak file are told apart by asking the pak file of a path's first entry, which fails if two of them have the same hash
+				for (FPakGlobalPathIndex::TConstKeyIterator It = GlobalPathIndex.CreateConstKeyIterator(PathHash); It && !bHashCollision; ++It)
+				{
+					for (int32 EntryIndex = It.Value(); EntryIndex != INDEX_NONE && !bHashCollision; EntryIndex = GlobalPathIndexEntries[EntryIndex].NextEntry)
+					{
+						bHashCollision = GlobalPathIndexEntries[EntryIndex].PakSlot == PakSlot;
+					}
+				}
+				if (bHashCollision)
+				{
+					break;
+				}
+
+				// A path with the same hash from another pak file is this path if that pak file has this path too
+				int32* FirstEntry = nullptr;
+				for (FPakGlobalPathIndex::TKeyIterator It = GlobalPathIndex.CreateKeyIterator(PathHash); It; ++It)
+				{
+					if (GlobalPathIndexPakHasFile(*GlobalPathIndexPaks[GlobalPathIndexEntries[It.Value()].PakSlot].PakFile, DirectoryPath + File.Key))
+					{
+						FirstEntry = &It.Value();
+						break;
+					}
+				}
+				if (!FirstEntry)
+				{
+					FirstEntry = &GlobalPathIndex.Add(PathHash, INDEX_NONE);
+				}
+
+				int32 EntryIndex = GlobalPathIndexFreeEntry;
+				if (EntryIndex != INDEX_NONE)
+				{
+					GlobalPathIndexFreeEntry = GlobalPathIndexEntries[EntryIndex].NextEntry;
+				}
+				else
+				{
+					EntryIndex = GlobalPathIndexEntries.AddUninitialized();
+				}
+
+				// Keep the entries for a path in the same order as PakFiles: descending ReadOrder, then mount order
+				int32* Link = FirstEntry;
+				while (*Link != INDEX_NONE && GlobalPathIndexPaks[GlobalPathIndexEntries[*Link].PakSlot].ReadOrder >= ReadOrder)
+				{
+					Link = &GlobalPathIndexEntries[*Link].NextEntry;
+				}
+				GlobalPathIndexEntries[EntryIndex] = FPakGlobalIndexEntry{ File.Value, PakSlot, *Link };
+				*Link = EntryIndex;
+			}
+			if (bHashCollision)
+			{
+				break;
+			}
+		}
+	}
+
+	if (bHashCollision)
+	{
+		// Its own index could not tell the two paths apart, so the pak file can only be searched
+		UE_LOG(LogPakFile, Warning, TEXT("Pak file \"%s\" has two paths with the same hash, files in mounted paks will be found by searching each pak file"), *PakFile->GetFilename());
+		RemoveGlobalPathIndexPak(PakSlot);
+		++NumUnindexedPakFiles;
+	}
+}
+
+void FPakPlatformFile::RemoveFromGlobalPathIndex(FPakFile* PakFile)
+{
+	FWriteScopeLock ScopeLock(GlobalPathIndexLock);
+
+	const int32 PakSlot = GlobalPathIndexPaks.IndexOfByPredicate([PakFile](const FPakGlobalIndexPak& Pak) { return Pak.PakFile == PakFile; });
+	if (PakSlot == INDEX_NONE)
+	{
+		check(NumUnindexedPakFiles > 0);
+		--NumUnindexedPakFiles;
+		return;
+	}
+	RemoveGlobalPathIndexPak(PakSlot);
+}
+
+void FPakPlatformFile::RemoveGlobalPathIndexPak(int32 PakSlot)
+{
+	GlobalPathIndexPaks[PakSlot].PakFile = nullptr;
+
+	// Unmounting is rare, so every path is visited rather than keeping a list of each pak file's paths
+	for (FPakGlobalPathIndex::TIterator It = GlobalPathIndex.CreateIterator(); It; ++It)
+	{
+		int32& FirstEntry = It.Value();
+		for (int32* Link = &FirstEntry; *Link != INDEX_NONE; Link = &GlobalPathIndexEntries[*Link].NextEntry)
+		{
+			FPakGlobalIndexEntry& Entry = GlobalPathIndexEntries[*Link];
+			if (Entry.PakSlot == PakSlot)
+			{
+				const int32 EntryIndex = *Link;
+				*Link = Entry.NextEntry;
+				Entry.NextEntry = GlobalPathIndexFreeEntry;
+				GlobalPathIndexFreeEntry = EntryIndex;
+				break;
+			}
+		}
+		if (FirstEntry == INDEX_NONE)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (GlobalPathIndex.Num() == 0)
+	{
+		GlobalPathIndex.Empty();
+		GlobalPathIndexEntries.Empty();
+		GlobalPathIndexFreeEntry = INDEX_NONE;
+	}
+}
+
+SIZE_T FPakPlatformFile::GetGlobalPathIndexAllocatedSize() const
+{
+	return GlobalPathIndex.GetAllocatedSize() + GlobalPathIndexEntries.GetAllocatedSize() + GlobalPathIndexPaks.GetAllocatedSize();
+}
+
+bool FPakPlatformFile::FindFileInGlobalPathIndex(const TCHAR* Filename, FPakFile** OutPakFile, FPakEntry* OutEntry, bool& bOutFound)
+{
+	FReadScopeLock ScopeLock(GlobalPathIndexLock);
+	if (NumUnindexedPakFiles > 0)
+	{
+		return false;
+	}
+
+	// Most filenames are standard already and are hashed where they are; only the others are standardized before they are hashed
+	FString StandardFilename;
+	uint64 PathHash;
+	if (!TryHashStandardFilename(Filename, PathHash))
+	{
+		StandardFilename = FPaths::CreateStandardFilename(Filename);
+		PathHash = HashGlobalPath(*StandardFilename);
+	}
+
+	bOutFound = false;
+	int32 FirstEntry = INDEX_NONE;
+	for (FPakGlobalPathIndex::TConstKeyIterator It = GlobalPathIndex.CreateConstKeyIterator(PathHash); It; ++It)
+	{
+		// A matching hash is not enough, another path can have the same hash. The pak file of the path's first entry has the path if it is this one.
+		if (StandardFilename.IsEmpty())
+		{
+			StandardFilename = Filename;
+		}
+		if (GlobalPathIndexPakHasFile(*GlobalPathIndexPaks[GlobalPathIndexEntries[It.Value()].PakSlot].PakFile, StandardFilename))
+		{
+			FirstEntry = It.Value();
+			break;
+		}
+	}
+	if (FirstEntry == INDEX_NONE)
+	{
+		return true;
+	}
+
+	// Same delete record handling as the search over all pak files
+	int32 DeletedReadOrder = -1;
+	for (int32 EntryIndex = FirstEntry; EntryIndex != INDEX_NONE; EntryIndex = GlobalPathIndexEntries[EntryIndex].NextEntry)
+	{
+		const FPakGlobalIndexEntry& Entry = GlobalPathIndexEntries[EntryIndex];
+		const FPakGlobalIndexPak& Pak = GlobalPathIndexPaks[Entry.PakSlot];
+		if (DeletedReadOrder != -1 && DeletedReadOrder > int32(Pak.ReadOrder))
+		{
+			UE_LOG(LogPakFile, Verbose, TEXT("Delete Record: Accepted a delete record for %s"), Filename);
+			return true;
+		}
+
+		FPakFile::EFindResult FindResult = Pak.PakFile->GetPakEntry(Entry.Location, OutEntry);
+		if (FindResult == FPakFile::EFindResult::Found)
+		{
+			if (OutPakFile != nullptr)
+			{
+				*OutPakFile = Pak.PakFile;
+			}
+			UE_CLOG(DeletedReadOrder != -1, LogPakFile, Verbose, TEXT("Delete Record: Ignored delete record for %s - found it in %s instead (asset was moved between chunks)"), Filename, *Pak.PakFile->GetFilename());
+			bOutFound = true;
+			return true;
+		}
+		else if (FindResult == FPakFile::EFindResult::FoundDeleted)
+		{
+			DeletedReadOrder = Pak.ReadOrder;
+			UE_LOG(LogPakFile, Verbose, TEXT("Delete Record: Found a delete record for %s in %s"), Filename, *Pak.PakFile->GetFilename());
+		}
+	}
+
+	UE_CLOG(DeletedReadOrder != -1, LogPakFile, Warning, TEXT("Delete Record: No lower priority pak files looking for %s. (maybe not downloaded?)"), Filename);
+	return true;
+}
+
+bool FPakPlatformFile::FindFileInPakFiles(const TCHAR* Filename, FPakFile** OutPakFile, FPakEntry* OutEntry)
+{
+	if (GPakUseGlobalPathIndex)
+	{
+		bool bFound = false;
+		if (FindFileInGlobalPathIndex(Filename, OutPakFile, OutEntry, bFound))
+		{
+			return bFound;
+		}
+	}
+
+	TArray<FPakListEntry> Paks;
+	GetMountedPaks(Paks);
+
+	return FindFileInPakFiles(Paks, Filename, OutPakFile, OutEntry);
+}
+
 bool FPakPlatformFile::ReloadPakReaders()
 {
 	TArray<FPakListEntry> Paks;
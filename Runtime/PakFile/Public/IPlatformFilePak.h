@@ -1946,6 +1946,30 @@ class PAKFILE_API FPakPlatformFile : public IPlatformFile
 		FGuid EncryptionKeyGuid;
 		int32 PakchunkIndex;
 	};
+
+	/** A mounted pak file that has been added to the GlobalPathIndex. */
+	struct FPakGlobalIndexPak
+	{
+		/** The pak file, or null if this slot is free. */
+		FPakFile* PakFile;
+		uint32 ReadOrder;
+	};
+
+	/** One mounted pak file containing (or holding a delete record for) a path in the GlobalPathIndex. */
+	struct FPakGlobalIndexEntry
+	{
+		FPakEntryLocation Location;
+		/** Index of the pak file in GlobalPathIndexPaks. */
+		int32 PakSlot;
+		/** Next entry for the same path in GlobalPathIndexEntries, or INDEX_NONE. Entries for a path are kept in the same order as PakFiles. */
+		int32 NextEntry;
+	};
+
+	/**
+	 * Map from the hash of a lowercase full path to the first of its entries in GlobalPathIndexEntries. Paths whose hashes collide each
+	 * have their own entries under the same key. No path is stored, the pak file of a path's first entry is asked whether it has the path.
+	 */
+	typedef TMultiMap<uint64, int32> FPakGlobalPathIndex;
 	
 	/** Wrapped file */
 	IPlatformFile* LowerLevel;
@@ -1957,6 +1981,18 @@ class PAKFILE_API FPakPlatformFile : public IPlatformFile
 	bool bSigned;
 	/** Synchronization object for accessing the list of currently mounted pak files. */
 	mutable FCriticalSection PakListCritical;
+	/** Index of every file in the mounted pak files, used to find a file without probing each pak. */
+	FPakGlobalPathIndex GlobalPathIndex;
+	/** Entries of the GlobalPathIndex, linked into one list per path. */
+	TArray<FPakGlobalIndexEntry> GlobalPathIndexEntries;
+	/** Head of the list of unused elements of GlobalPathIndexEntries. */
+	int32 GlobalPathIndexFreeEntry;
+	/** Pak files in the GlobalPathIndex, indexed by FPakGlobalIndexEntry::PakSlot. */
+	TArray<FPakGlobalIndexPak> GlobalPathIndexPaks;
+	/** Number of mounted pak files without filenames that could not be added to the GlobalPathIndex. */
+	int32 NumUnindexedPakFiles;
+	/** Synchronization object for accessing the GlobalPathIndex. Always acquired after PakListCritical. */
+	mutable FRWLock GlobalPathIndexLock;
 	/** Cache of extensions that we automatically reject if not found in pak file */
 	TSet<FName> ExcludedNonPakExtensions;
 	/** The extension used for ini files, used for excluding ini files */
@@ -2079,6 +2115,38 @@ class PAKFILE_API FPakPlatformFile : public IPlatformFile
 	 */
 	void RegisterEncryptionKey(const FGuid& InEncryptionKeyGuid, const FAES::FAESKey& InKey);
 
+	/** Hash a full path for the GlobalPathIndex. Case-insensitive; pass the result of a previous call as InHash to hash a path in several parts. */
+	static uint64 HashGlobalPath(const TCHAR* Path, uint64 InHash = 0xcbf29ce484222325ull);
+
+	/**
+	 * Hash a filename for the GlobalPathIndex without copying it, if it is already what FPaths::MakeStandardFilename would make of it.
+	 *
+	 * @return false if the filename needs to be standardized before it is hashed.
+	 */
+	static bool TryHashStandardFilename(const TCHAR* Filename, uint64& OutHash);
+
+	/** Whether a pak file in the GlobalPathIndex has a file at the given standardized full path. */
+	static bool GlobalPathIndexPakHasFile(const FPakFile& PakFile, const FString& FullPath);
+
+	/** Add every file of a newly mounted pak file to the GlobalPathIndex. Must be called with PakListCritical held. */
+	void AddToGlobalPathIndex(FPakFile* PakFile, uint32 ReadOrder);
+
+	/** Remove a pak file that is being unmounted from the GlobalPathIndex. Must be called with PakListCritical held. */
+	void RemoveFromGlobalPathIndex(FPakFile* PakFile);
+
+	/** Remove the entries of a pak file from the GlobalPathIndex and free its slot. Must be called with GlobalPathIndexLock held for writing. */
+	void RemoveGlobalPathIndexPak(int32 PakSlot);
+
+	/** Memory used by the GlobalPathIndex. Must be called with GlobalPathIndexLock held. */
+	SIZE_T GetGlobalPathIndexAllocatedSize() const;
+
+	/**
+	 * Finds a file using the GlobalPathIndex.
+	 *
+	 * @return false if the GlobalPathIndex can not be used because some mounted pak files are not indexed, otherwise true with bOutFound set to the result of the lookup.
+	 */
+	bool FindFileInGlobalPathIndex(const TCHAR* Filename, FPakFile** OutPakFile, FPakEntry* OutEntry, bool& bOutFound);
+
 public:
 
 	//~ For visibility of overloads we don't override
@@ -2266,13 +2334,7 @@ public:
 	 * @param OutPakFile Optional pointer to a pak file where the filename was found.
 	 * @return Pointer to pak entry if the file was found, NULL otherwise.
 	 */
-	bool FindFileInPakFiles(const TCHAR* Filename, FPakFile** OutPakFile = nullptr, FPakEntry* OutEntry = nullptr)
-	{
-		TArray<FPakListEntry> Paks;
-		GetMountedPaks(Paks);
-
-		return FindFileInPakFiles(Paks, Filename, OutPakFile, OutEntry);
-	}
+	bool FindFileInPakFiles(const TCHAR* Filename, FPakFile** OutPakFile = nullptr, FPakEntry* OutEntry = nullptr);
 
 	//~ Begin IPlatformFile Interface
 	virtual bool FileExists(const TCHAR* Filename) override
@@ -2987,6 +3049,8 @@ public:
 	void HandleUnmountCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 	void HandlePakCorruptCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 	void HandleReloadPakReadersCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	void HandlePakLookupBenchmarkCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	void HandlePakReadAheadReplayCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
 	// END Console commands
 	
@@ -468,11 +468,11 @@ FORCEINLINE bool IntersectBox8Plane(const FVector& InOrigin, const FVector& InEx
 }
 
 
-static int32 FrustumCullNumWordsPerTask = 128;
+static int32 FrustumCullNumWordsPerTask = 16;
 static FAutoConsoleVariableRef CVarFrustumCullNumWordsPerTask(
 	TEXT("r.FrustumCullNumWordsPerTask"),
 	FrustumCullNumWordsPerTask,
-	TEXT("Performance tweak. Controls the granularity for the ParallelFor for frustum culling."),
+	TEXT("Performance tweak. Controls the smallest batch of visibility words (32 primitives each) the ParallelForRange for frustum culling hands to a thread."),
 	ECVF_Default
 	);
 
@@ -497,10 +497,10 @@ static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
 
 	const int32 BitArrayNum = View.PrimitiveVisibilityMap.Num();
 	const int32 BitArrayWords = FMath::DivideAndRoundUp(View.PrimitiveVisibilityMap.Num(), (int32)NumBitsPerDWORD);
-	const int32 NumTasks = FMath::DivideAndRoundUp(BitArrayWords, FrustumCullNumWordsPerTask);
+	const bool bForceSingleThread = !FApp::ShouldUseThreadingForPerformance() || (UseCustomCulling && !View.CustomVisibilityQuery->IsThreadsafe()) || CVarParallelInitViews.GetValueOnRenderThread() == 0 || !IsInActualRenderingThread();
 
-	ParallelFor(NumTasks, 
-		[&NumCulledPrimitives, Scene, &View, MaxDrawDistanceScale, HLODState](int32 TaskIndex)
+	ParallelForRange(BitArrayWords, 
+		[&NumCulledPrimitives, Scene, &View, MaxDrawDistanceScale, HLODState](int32 BeginWord, int32 EndWord)
 		{
 			QUICK_SCOPE_CYCLE_COUNTER(STAT_FrustumCull_Loop);
 			const FPlane* PermutedPlanePtr = View.ViewFrustum.PermutedPlanes.GetData();
@@ -509,10 +509,7 @@ static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
 			float FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
 			uint8 CustomVisibilityFlags = EOcclusionFlags::CanBeOccluded | EOcclusionFlags::HasPrecomputedVisibility;
 
-			// Primitives may be explicitly removed from stereo views when using mono
-			const int32 TaskWordOffset = TaskIndex * FrustumCullNumWordsPerTask;
-
-			for (int32 WordIndex = TaskWordOffset; WordIndex < TaskWordOffset + FrustumCullNumWordsPerTask && WordIndex * NumBitsPerDWORD < BitArrayNumInner; WordIndex++)
+			for (int32 WordIndex = BeginWord; WordIndex < EndWord; WordIndex++)
 			{
 				uint32 Mask = 0x1;
 				uint32 VisBits = 0;
@@ -611,7 +608,8 @@ static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
 				}
 			}
 		},
-		!FApp::ShouldUseThreadingForPerformance() || (UseCustomCulling && !View.CustomVisibilityQuery->IsThreadsafe()) || CVarParallelInitViews.GetValueOnRenderThread() == 0 || !IsInActualRenderingThread()
+		FrustumCullNumWordsPerTask,
+		bForceSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None
 	);
 
 	return NumCulledPrimitives.GetValue();
@@ -6,6 +6,8 @@
 #include "UObject/UnrealType.h"
 #include "UObject/EnumProperty.h"
 #include "UObject/TextProperty.h"
+#include "Misc/ByteSwap.h"
+#include "Traits/IntType.h"
 
 FCborStructDeserializerBackend::FCborStructDeserializerBackend(FArchive& Archive, ECborEndianness CborDataEndianness)
 	: CborReader(&Archive, CborDataEndianness)
@@ -13,6 +15,111 @@ FCborStructDeserializerBackend::FCborStructDeserializerBackend(FArchive& Archive
 
 FCborStructDeserializerBackend::~FCborStructDeserializerBackend() = default;
 
+namespace CborStructDeserializerBackend
+{
+	template<typename ValueType>
+	ValueType LoadTypedArrayElement(const uint8* Element, bool bByteSwapped)
+	{
+		// Swap the bytes of floats as integers, as byte swapped floats may not survive being loaded as floats.
+		typename TUnsignedIntType<sizeof(ValueType)>::Type Bits;
+		FMemory::Memcpy(&Bits, Element, sizeof(ValueType));
+		if (bByteSwapped)
+		{
+			Bits = ByteSwap(Bits);
+		}
+
+		ValueType Value;
+		FMemory::Memcpy(&Value, &Bits, sizeof(ValueType));
+		return Value;
+	}
+
+	// Sets a numeric or bool property from an element of a typed array, converting the element to the property type.
+	bool ReadTypedArrayElement(FProperty* Property, FProperty* Outer, void* Data, int32 ArrayIndex, ECborTypedArrayType Type, bool bByteSwapped, const uint8* Element)
+	{
+		int64 IntValue = 0;
+		uint64 UIntValue = 0;
+		double FloatValue = 0.0;
+		bool bUnsigned = false;
+		bool bFloat = false;
+
+		switch (Type)
+		{
+		case ECborTypedArrayType::Uint8:
+			UIntValue = *Element;
+			bUnsigned = true;
+			break;
+		case ECborTypedArrayType::Uint16:
+			UIntValue = LoadTypedArrayElement<uint16>(Element, bByteSwapped);
+			bUnsigned = true;
+			break;
+		case ECborTypedArrayType::Uint32:
+			UIntValue = LoadTypedArrayElement<uint32>(Element, bByteSwapped);
+			bUnsigned = true;
+			break;
+		case ECborTypedArrayType::Uint64:
+			UIntValue = LoadTypedArrayElement<uint64>(Element, bByteSwapped);
+			bUnsigned = true;
+			break;
+		case ECborTypedArrayType::Int8:
+			IntValue = (int8)*Element;
+			break;
+		case ECborTypedArrayType::Int16:
+			IntValue = LoadTypedArrayElement<int16>(Element, bByteSwapped);
+			break;
+		case ECborTypedArrayType::Int32:
+			IntValue = LoadTypedArrayElement<int32>(Element, bByteSwapped);
+			break;
+		case ECborTypedArrayType::Int64:
+			IntValue = LoadTypedArrayElement<int64>(Element, bByteSwapped);
+			break;
+		case ECborTypedArrayType::Float:
+			FloatValue = LoadTypedArrayElement<float>(Element, bByteSwapped);
+			bFloat = true;
+			break;
+		case ECborTypedArrayType::Double:
+			FloatValue = LoadTypedArrayElement<double>(Element, bByteSwapped);
+			bFloat = true;
+			break;
+		}
+
+		if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			return StructDeserializerBackendUtilities::SetPropertyValue(BoolProperty, Outer, Data, ArrayIndex, bFloat ? FloatValue != 0.0 : (bUnsigned ? UIntValue != 0 : IntValue != 0));
+		}
+
+		FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+		if (NumericProperty == nullptr || NumericProperty->IsEnum())
+		{
+			UE_LOG(LogSerialization, Verbose, TEXT("Typed array element for field %s is not supported in FProperty type %s"), *Property->GetFName().ToString(), *Property->GetClass()->GetName());
+			return false;
+		}
+
+		void* ValuePtr = StructDeserializerBackendUtilities::GetPropertyValuePtr(NumericProperty, Outer, Data, ArrayIndex);
+		if (ValuePtr == nullptr)
+		{
+			return false;
+		}
+
+		if (NumericProperty->IsFloatingPoint())
+		{
+			NumericProperty->SetFloatingPointPropertyValue(ValuePtr, bFloat ? FloatValue : (bUnsigned ? (double)UIntValue : (double)IntValue));
+		}
+		else if (bFloat)
+		{
+			NumericProperty->SetIntPropertyValue(ValuePtr, (int64)FloatValue);
+		}
+		else if (bUnsigned)
+		{
+			NumericProperty->SetIntPropertyValue(ValuePtr, UIntValue);
+		}
+		else
+		{
+			NumericProperty->SetIntPropertyValue(ValuePtr, IntValue);
+		}
+		return true;
+	}
+}
+
 const FString& FCborStructDeserializerBackend::GetCurrentPropertyName() const
 {
 	return LastMapKey;
@@ -50,6 +157,53 @@ bool FCborStructDeserializerBackend::GetNextToken(EStructDeserializerBackendToke
 		return true;
 	}
 
+	if (bDeserializingTypedArray) // Deserializing the elements of a numeric array property written as a typed array?
+	{
+		if (DeserializingTypedArrayIndex < LastContext.AsByteArray().Num() / CborTypedArray::GetElementSize(TypedArrayType))
+		{
+			++DeserializingTypedArrayIndex;
+			OutToken = EStructDeserializerBackendTokens::Property;
+		}
+		else
+		{
+			bDeserializingTypedArray = false;
+			OutToken = EStructDeserializerBackendTokens::ArrayEnd;
+		}
+
+		return true;
+	}
+
+	if (bDeserializingStructColumns) // Deserializing the structures of an array written column by column, one property of each column at a time?
+	{
+		if (DeserializingStructColumn == INDEX_NONE)
+		{
+			if (DeserializingStructColumnElement < NumStructColumnElements)
+			{
+				DeserializingStructColumn = 0;
+				OutToken = EStructDeserializerBackendTokens::StructureStart;
+			}
+			else
+			{
+				StructColumns.Reset();
+				bDeserializingStructColumns = false;
+				OutToken = EStructDeserializerBackendTokens::ArrayEnd;
+			}
+		}
+		else if (DeserializingStructColumn < StructColumns.Num())
+		{
+			LastMapKey = StructColumns[DeserializingStructColumn++].Name;
+			OutToken = EStructDeserializerBackendTokens::Property;
+		}
+		else
+		{
+			DeserializingStructColumn = INDEX_NONE;
+			++DeserializingStructColumnElement;
+			OutToken = EStructDeserializerBackendTokens::StructureEnd;
+		}
+
+		return true;
+	}
+
 	if (!CborReader.ReadNext(LastContext))
 	{
 		OutToken = LastContext.IsError() ? EStructDeserializerBackendTokens::Error : EStructDeserializerBackendTokens::None;
@@ -80,6 +234,22 @@ bool FCborStructDeserializerBackend::GetNextToken(EStructDeserializerBackendToke
 		}
 	}
 
+	// Numeric arrays and arrays of structures written column by column are tagged, other tags only add semantics to their item, which is read as is.
+	while (LastContext.MajorType() == ECborCode::Tag)
+	{
+		const uint64 Tag = LastContext.AsTag();
+		if (!CborReader.ReadNext(LastContext))
+		{
+			OutToken = LastContext.IsError() ? EStructDeserializerBackendTokens::Error : EStructDeserializerBackendTokens::None;
+			return false;
+		}
+
+		if (ReadTaggedArray(Tag, OutToken))
+		{
+			return OutToken != EStructDeserializerBackendTokens::Error;
+		}
+	}
+
 	switch (LastContext.MajorType())
 	{
 	case ECborCode::Array:
@@ -110,8 +280,107 @@ bool FCborStructDeserializerBackend::GetNextToken(EStructDeserializerBackendToke
 	return true;
 }
 
+bool FCborStructDeserializerBackend::ReadTaggedArray(uint64 Tag, EStructDeserializerBackendTokens& OutToken)
+{
+	// Numeric array written as a typed array
+	if (CborTypedArray::ParseTag(Tag, TypedArrayType, bTypedArrayByteSwapped) && LastContext.MajorType() == ECborCode::ByteString)
+	{
+		if (LastContext.AsByteArray().Num() % CborTypedArray::GetElementSize(TypedArrayType) != 0)
+		{
+			UE_LOG(LogSerialization, Verbose, TEXT("Typed array size is not a multiple of its element size (%s)"), *GetDebugString());
+			OutToken = EStructDeserializerBackendTokens::Error;
+			return true;
+		}
+
+		DeserializingTypedArrayIndex = 0;
+		bDeserializingTypedArray = true;
+		OutToken = EStructDeserializerBackendTokens::ArrayStart;
+		return true;
+	}
+
+	// Array of structures written column by column
+	if (Tag == CborTypedArray::StructColumnsTag && LastContext.MajorType() == ECborCode::Array)
+	{
+		if (!ReadStructColumns())
+		{
+			UE_LOG(LogSerialization, Verbose, TEXT("Malformed array of structures written column by column (%s)"), *GetDebugString());
+			OutToken = EStructDeserializerBackendTokens::Error;
+			return true;
+		}
+
+		OutToken = EStructDeserializerBackendTokens::ArrayStart;
+		return true;
+	}
+
+	return false;
+}
+
+bool FCborStructDeserializerBackend::ReadStructColumns()
+{
+	// [number of structures, {property name: typed array of its values}]
+	FCborContext Context;
+	if (LastContext.AsLength() != 2 || !CborReader.ReadNext(Context) || Context.MajorType() != ECborCode::Uint || Context.AsUInt() > MAX_int32)
+	{
+		return false;
+	}
+
+	const int32 NumElements = (int32)Context.AsUInt();
+	if (!CborReader.ReadNext(Context) || Context.MajorType() != ECborCode::Map)
+	{
+		return false;
+	}
+
+	StructColumns.Reset();
+	while (CborReader.ReadNext(Context) && !Context.IsBreak())
+	{
+		FStructColumn& Column = StructColumns.AddDefaulted_GetRef();
+		if (Context.MajorType() != ECborCode::TextString)
+		{
+			return false;
+		}
+		Column.Name = Context.AsString();
+
+		if (!CborReader.ReadNext(Context) || Context.MajorType() != ECborCode::Tag || !CborTypedArray::ParseTag(Context.AsTag(), Column.Type, Column.bByteSwapped))
+		{
+			return false;
+		}
+
+		if (!CborReader.ReadNext(Column.Values) || Column.Values.MajorType() != ECborCode::ByteString
+			|| Column.Values.AsByteArray().Num() != (int64)NumElements * CborTypedArray::GetElementSize(Column.Type))
+		{
+			return false;
+		}
+	}
+
+	// The map must end, followed by the end of the array holding it.
+	if (!Context.IsBreak() || !CborReader.ReadNext(Context) || !Context.IsBreak())
+	{
+		return false;
+	}
+
+	NumStructColumnElements = NumElements;
+	DeserializingStructColumnElement = 0;
+	DeserializingStructColumn = INDEX_NONE;
+	bDeserializingStructColumns = true;
+	return true;
+}
+
 bool FCborStructDeserializerBackend::ReadProperty(FProperty* Property, FProperty* Outer, void* Data, int32 ArrayIndex)
 {
+	if (bDeserializingTypedArray) // Consume one element from the typed array.
+	{
+		const int32 ElementSize = CborTypedArray::GetElementSize(TypedArrayType);
+		const uint8* Element = LastContext.AsByteArray().GetData() + (DeserializingTypedArrayIndex - 1) * ElementSize;
+		return CborStructDeserializerBackend::ReadTypedArrayElement(Property, Outer, Data, ArrayIndex, TypedArrayType, bTypedArrayByteSwapped, Element);
+	}
+
+	if (bDeserializingStructColumns) // Consume the value of the current structure from the column of the property.
+	{
+		const FStructColumn& Column = StructColumns[DeserializingStructColumn - 1];
+		const uint8* Element = Column.Values.AsByteArray().GetData() + DeserializingStructColumnElement * CborTypedArray::GetElementSize(Column.Type);
+		return CborStructDeserializerBackend::ReadTypedArrayElement(Property, Outer, Data, ArrayIndex, Column.Type, Column.bByteSwapped, Element);
+	}
+
 	switch (LastContext.MajorType())
 	{
 	// Unsigned Integers
@@ -335,6 +604,15 @@ void FCborStructDeserializerBackend::SkipArray()
 		check(DeserializingByteArrayIndex == 0);
 		bDeserializingByteArray = false;
 	}
+	else if (bDeserializingTypedArray) // Deserializing a numeric array property as typed array?
+	{
+		bDeserializingTypedArray = false;
+	}
+	else if (bDeserializingStructColumns) // Deserializing an array of structures written column by column?
+	{
+		StructColumns.Reset();
+		bDeserializingStructColumns = false;
+	}
 	else
 	{
 		CborReader.SkipContainer(ECborCode::Array);
@@ -343,5 +621,13 @@ void FCborStructDeserializerBackend::SkipArray()
 
 void FCborStructDeserializerBackend::SkipStructure()
 {
-	CborReader.SkipContainer(ECborCode::Map);
+	if (bDeserializingStructColumns) // Skip the remaining properties of the current structure, which were already read.
+	{
+		DeserializingStructColumn = INDEX_NONE;
+		++DeserializingStructColumnElement;
+	}
+	else
+	{
+		CborReader.SkipContainer(ECborCode::Map);
+	}
 }
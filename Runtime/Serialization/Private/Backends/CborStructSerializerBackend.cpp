@@ -18,8 +18,93 @@ FCborStructSerializerBackend::FCborStructSerializerBackend(FArchive& InArchive,
 
 FCborStructSerializerBackend::~FCborStructSerializerBackend() = default;
 
+namespace CborStructSerializerBackend
+{
+	// Gets the element type of the typed array able to hold the values of a property, false if there is none.
+	bool GetTypedArrayType(const FProperty* Property, ECborTypedArrayType& OutType)
+	{
+		if (CastField<FBoolProperty>(Property))
+		{
+			OutType = ECborTypedArrayType::Uint8;
+		}
+		else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+		{
+			if (ByteProperty->IsEnum())
+			{
+				return false;
+			}
+			OutType = ECborTypedArrayType::Uint8;
+		}
+		else if (CastField<FInt8Property>(Property))
+		{
+			OutType = ECborTypedArrayType::Int8;
+		}
+		else if (CastField<FInt16Property>(Property))
+		{
+			OutType = ECborTypedArrayType::Int16;
+		}
+		else if (CastField<FUInt16Property>(Property))
+		{
+			OutType = ECborTypedArrayType::Uint16;
+		}
+		else if (CastField<FIntProperty>(Property))
+		{
+			OutType = ECborTypedArrayType::Int32;
+		}
+		else if (CastField<FUInt32Property>(Property))
+		{
+			OutType = ECborTypedArrayType::Uint32;
+		}
+		else if (CastField<FInt64Property>(Property))
+		{
+			OutType = ECborTypedArrayType::Int64;
+		}
+		else if (CastField<FUInt64Property>(Property))
+		{
+			OutType = ECborTypedArrayType::Uint64;
+		}
+		else if (CastField<FFloatProperty>(Property))
+		{
+			OutType = ECborTypedArrayType::Float;
+		}
+		else if (CastField<FDoubleProperty>(Property))
+		{
+			OutType = ECborTypedArrayType::Double;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+	// Whether a property is a structure whose properties can all be written as typed arrays.
+	bool IsColumnStruct(const FProperty* Property)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty == nullptr)
+		{
+			return false;
+		}
+
+		bool bHasProperties = false;
+		for (TFieldIterator<FProperty> It(StructProperty->Struct, EFieldIteratorFlags::IncludeSuper); It; ++It)
+		{
+			ECborTypedArrayType Type;
+			if (It->ArrayDim != 1 || !GetTypedArrayType(*It, Type))
+			{
+				return false;
+			}
+			bHasProperties = true;
+		}
+		return bHasProperties;
+	}
+}
+
 void FCborStructSerializerBackend::BeginArray(const FStructSerializerState& State)
 {
+	using namespace CborStructSerializerBackend;
+
 	// If TArray<uint8>/TArray<int8> content needs to be written as ByteString (to prevent paying a 1 byte header for each byte greater than 23 required by CBOR array).
 	if (EnumHasAnyFlags(Flags, EStructSerializerBackendFlags::WriteByteArrayAsByteStream))
 	{
@@ -35,6 +120,24 @@ void FCborStructSerializerBackend::BeginArray(const FStructSerializerState& Stat
 		}
 	}
 
+	// If TArray of larger numbers needs to be written as a typed array, or TArray of structures of numbers column by column.
+	FArrayProperty* ArrayProperty = CastField<FArrayProperty>(State.ValueProperty);
+	ECborTypedArrayType TypedArrayType = ECborTypedArrayType::Uint8;
+	if (ArrayProperty != nullptr && !bSerializingByteArray)
+	{
+		if (EnumHasAnyFlags(Flags, EStructSerializerBackendFlags::WriteNumericArraysAsTypedArrays) && GetTypedArrayType(ArrayProperty->Inner, TypedArrayType) && CborTypedArray::GetElementSize(TypedArrayType) > 1)
+		{
+			bSerializingTypedArray = true;
+		}
+		else if (EnumHasAnyFlags(Flags, EStructSerializerBackendFlags::WriteStructArraysAsColumns) && IsColumnStruct(ArrayProperty->Inner))
+		{
+			check(!bSerializingStructColumns);
+			StructColumns.Reset();
+			NumStructColumnElements = 0;
+			bSerializingStructColumns = true;
+		}
+	}
+
 	// Array nested in Array/Set
 	if (State.ValueProperty->GetOwner<FArrayProperty>() || State.ValueProperty->GetOwner<FSetProperty>())
 	{
@@ -53,7 +156,12 @@ void FCborStructSerializerBackend::BeginArray(const FStructSerializerState& Stat
 		CborWriter.WriteValue(State.ValueProperty->GetName());
 	}
 
-	if (!bSerializingByteArray) // TArray<uint8>/TArray<int8> are written as ByteString rather than CBOR array because it is more size efficient.
+	if (bSerializingTypedArray) // The elements are contiguous in memory, write them all at once.
+	{
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(State.ValueData));
+		CborWriter.WriteTypedArray(TypedArrayType, ArrayHelper.GetRawPtr(), ArrayHelper.Num());
+	}
+	else if (!bSerializingByteArray && !bSerializingStructColumns) // TArray<uint8>/TArray<int8> are written as ByteString rather than CBOR array because it is more size efficient.
 	{
 		CborWriter.WriteContainerStart(ECborCode::Array, -1/*Indefinite*/);
 	}
@@ -61,7 +169,11 @@ void FCborStructSerializerBackend::BeginArray(const FStructSerializerState& Stat
 
 void FCborStructSerializerBackend::BeginStructure(const FStructSerializerState& State)
 {
-	if (State.ValueProperty != nullptr)
+	if (bSerializingStructColumns) // Structures of an array written column by column have no map of their own.
+	{
+		NextStructColumn = 0;
+	}
+	else if (State.ValueProperty != nullptr)
 	{
 		// Object nested in Array/Set
 		if ((State.ValueProperty->ArrayDim > 1
@@ -101,6 +213,26 @@ void FCborStructSerializerBackend::EndArray(const FStructSerializerState& State)
 		CborWriter.WriteValue(AccumulatedBytes.GetData(), AccumulatedBytes.Num());
 		bSerializingByteArray = false;
 	}
+	else if (bSerializingTypedArray) // The elements were written when the array began.
+	{
+		bSerializingTypedArray = false;
+	}
+	else if (bSerializingStructColumns) // Does end a TArray of structures written column by column?
+	{
+		// Flush the columns as [number of structures, {property name: typed array of its values}].
+		CborWriter.WriteTag(CborTypedArray::StructColumnsTag);
+		CborWriter.WriteContainerStart(ECborCode::Array, 2);
+		CborWriter.WriteValue((uint64)NumStructColumnElements);
+		CborWriter.WriteContainerStart(ECborCode::Map, -1/*Indefinite*/);
+		for (const FStructColumn& Column : StructColumns)
+		{
+			check(Column.Values.Num() == NumStructColumnElements * CborTypedArray::GetElementSize(Column.Type));
+			CborWriter.WriteValue(Column.Property->GetName());
+			CborWriter.WriteTypedArray(Column.Type, Column.Values.GetData(), NumStructColumnElements);
+		}
+		CborWriter.WriteContainerEnd();
+		bSerializingStructColumns = false;
+	}
 	else
 	{
 		CborWriter.WriteContainerEnd();
@@ -109,7 +241,37 @@ void FCborStructSerializerBackend::EndArray(const FStructSerializerState& State)
 
 void FCborStructSerializerBackend::EndStructure(const FStructSerializerState& State)
 {
-	CborWriter.WriteContainerEnd();
+	if (bSerializingStructColumns)
+	{
+		++NumStructColumnElements;
+	}
+	else
+	{
+		CborWriter.WriteContainerEnd();
+	}
+}
+
+void FCborStructSerializerBackend::WriteStructColumnValue(const FStructSerializerState& State, int32 ArrayIndex)
+{
+	// Properties come in the same order for every structure, the columns are created by the first one.
+	if (!StructColumns.IsValidIndex(NextStructColumn) || StructColumns[NextStructColumn].Property != State.ValueProperty)
+	{
+		check(NumStructColumnElements == 0);
+		FStructColumn& NewColumn = StructColumns.AddDefaulted_GetRef();
+		NewColumn.Property = State.ValueProperty;
+		verify(CborStructSerializerBackend::GetTypedArrayType(State.ValueProperty, NewColumn.Type));
+		NextStructColumn = StructColumns.Num() - 1;
+	}
+
+	FStructColumn& Column = StructColumns[NextStructColumn++];
+	if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Column.Property))
+	{
+		Column.Values.Add(BoolProperty->GetPropertyValue_InContainer(State.ValueData, ArrayIndex) ? 1 : 0);
+	}
+	else
+	{
+		Column.Values.Append(Column.Property->ContainerPtrToValuePtr<uint8>(State.ValueData, ArrayIndex), CborTypedArray::GetElementSize(Column.Type));
+	}
 }
 
 void FCborStructSerializerBackend::WriteComment(const FString& Comment)
@@ -178,6 +340,16 @@ void FCborStructSerializerBackend::WriteProperty(const FStructSerializerState& S
 {
 	using namespace CborStructSerializerBackend;
 
+	if (bSerializingTypedArray) // The elements were written when the array began.
+	{
+		return;
+	}
+	else if (bSerializingStructColumns) // Writing a property of a structure of an array written column by column?
+	{
+		WriteStructColumnValue(State, ArrayIndex);
+		return;
+	}
+
 	// Bool
 	if (State.FieldType == FBoolProperty::StaticClass())
 	{
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Backends/JsonSaxStructDeserializerBackend.h"
+#include "Backends/JsonStructDeserializerBackendUtilities.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+
+/* IStructDeserializerBackend interface
+ *****************************************************************************/
+
+const FString& FJsonSaxStructDeserializerBackend::GetCurrentPropertyName() const
+{
+	return CurrentPropertyName;
+}
+
+
+FString FJsonSaxStructDeserializerBackend::GetDebugString() const
+{
+	return FString::Printf(TEXT("Line: %u, Ch: %u"), JsonReader.GetLineNumber(), JsonReader.GetCharacterNumber());
+}
+
+
+const FString& FJsonSaxStructDeserializerBackend::GetLastErrorMessage() const
+{
+	return JsonReader.GetErrorMessage();
+}
+
+
+bool FJsonSaxStructDeserializerBackend::GetNextToken( EStructDeserializerBackendTokens& OutToken )
+{
+	if (!JsonReader.ReadNext(LastNotation))
+	{
+		return false;
+	}
+
+	// Names are nearly always plain ASCII, which is widened into the buffer of the previous name without decoding
+	const FAnsiStringView Identifier = JsonReader.GetIdentifier();
+	bool bIsAscii = !JsonReader.IdentifierHasEscapes();
+	for (int32 Index = 0; bIsAscii && Index < Identifier.Len(); ++Index)
+	{
+		bIsAscii = (uint8)Identifier[Index] < 0x80;
+	}
+
+	if (bIsAscii)
+	{
+		CurrentPropertyName.Reset(Identifier.Len());
+		CurrentPropertyName.AppendChars(Identifier.GetData(), Identifier.Len());
+	}
+	else
+	{
+		CurrentPropertyName = JsonReader.GetIdentifierAsString();
+	}
+
+	switch (LastNotation)
+	{
+	case EJsonNotation::ArrayEnd:
+		OutToken = EStructDeserializerBackendTokens::ArrayEnd;
+		break;
+
+	case EJsonNotation::ArrayStart:
+		OutToken = EStructDeserializerBackendTokens::ArrayStart;
+		break;
+
+	case EJsonNotation::Boolean:
+	case EJsonNotation::Null:
+	case EJsonNotation::Number:
+	case EJsonNotation::String:
+		{
+			OutToken = EStructDeserializerBackendTokens::Property;
+		}
+		break;
+
+	case EJsonNotation::Error:
+		OutToken = EStructDeserializerBackendTokens::Error;
+		break;
+
+	case EJsonNotation::ObjectEnd:
+		OutToken = EStructDeserializerBackendTokens::StructureEnd;
+		break;
+
+	case EJsonNotation::ObjectStart:
+		OutToken = EStructDeserializerBackendTokens::StructureStart;
+		break;
+
+	default:
+		OutToken = EStructDeserializerBackendTokens::None;
+	}
+
+	return true;
+}
+
+
+bool FJsonSaxStructDeserializerBackend::ReadProperty( FProperty* Property, FProperty* Outer, void* Data, int32 ArrayIndex )
+{
+	return JsonStructDeserializerBackendUtilities::ReadProperty(JsonReader, LastNotation, *this, Property, Outer, Data, ArrayIndex);
+}
+
+
+void FJsonSaxStructDeserializerBackend::SkipArray()
+{
+	JsonReader.SkipArray();
+}
+
+
+void FJsonSaxStructDeserializerBackend::SkipStructure()
+{
+	JsonReader.SkipObject();
+}
@@ -3,14 +3,18 @@
 #include "Algo/ForEach.h"
 #include "CoreMinimal.h"
 #include "Misc/Guid.h"
+#include "Misc/ByteSwap.h"
+#include "HAL/PlatformTime.h"
 #include "Serialization/MemoryWriter.h"
 #include "Serialization/MemoryReader.h"
 #include "Misc/AutomationTest.h"
 #include "Templates/SubclassOf.h"
 #include "Backends/JsonStructDeserializerBackend.h"
 #include "Backends/JsonStructSerializerBackend.h"
+#include "Backends/JsonSaxStructDeserializerBackend.h"
 #include "Backends/CborStructDeserializerBackend.h"
 #include "Backends/CborStructSerializerBackend.h"
+#include "CborWriter.h"
 #include "StructDeserializer.h"
 #include "StructSerializer.h"
 #include "Tests/StructSerializerTestTypes.h"
@@ -500,11 +504,8 @@ namespace StructSerializerTest
 		}
 	}
 
-	void TestSerialization( FAutomationTestBase& Test, IStructSerializerBackend& SerializerBackend, IStructDeserializerBackend& DeserializerBackend )
+	void InitObjects( FStructSerializerTestStruct& TestStruct )
 	{
-		// serialization
-		FStructSerializerTestStruct TestStruct;
-
 		UClass* MetaDataClass = LoadClass<UMetaData>(nullptr, TEXT("/Script/CoreUObject.MetaData"));
 		UMetaData* MetaDataObject = NewObject<UMetaData>();
 		// setup object tests
@@ -516,20 +517,10 @@ namespace StructSerializerTest
 		TestStruct.Objects.SoftObject = MetaDataObject;
 		TestStruct.Objects.ClassPath = MetaDataClass;
 		TestStruct.Objects.ObjectPath = MetaDataObject;
+	}
 
-		{
-			FStructSerializer::Serialize(TestStruct, SerializerBackend);
-		}
-
-		// deserialization
-		FStructSerializerTestStruct TestStruct2(NoInit);
-		{
-			FStructDeserializerPolicies Policies;
-			Policies.MissingFields = EStructDeserializerErrorPolicies::Warning;
-			
-			Test.TestTrue(TEXT("Deserialization must succeed"), FStructDeserializer::Deserialize(TestStruct2, DeserializerBackend, Policies));
-		}
-
+	void ValidateAll( FAutomationTestBase& Test, const FStructSerializerTestStruct& TestStruct, const FStructSerializerTestStruct& TestStruct2 )
+	{
 		// test numerics
 		ValidateNumerics(Test, TestStruct.Numerics, TestStruct2.Numerics);
 
@@ -550,6 +541,84 @@ namespace StructSerializerTest
 		// test sets
 		ValidateSets(Test, TestStruct.Sets, TestStruct2.Sets);
 	}
+
+	void TestSerialization( FAutomationTestBase& Test, IStructSerializerBackend& SerializerBackend, IStructDeserializerBackend& DeserializerBackend )
+	{
+		// serialization
+		FStructSerializerTestStruct TestStruct;
+		InitObjects(TestStruct);
+
+		{
+			FStructSerializer::Serialize(TestStruct, SerializerBackend);
+		}
+
+		// deserialization
+		FStructSerializerTestStruct TestStruct2(NoInit);
+		{
+			FStructDeserializerPolicies Policies;
+			Policies.MissingFields = EStructDeserializerErrorPolicies::Warning;
+			
+			Test.TestTrue(TEXT("Deserialization must succeed"), FStructDeserializer::Deserialize(TestStruct2, DeserializerBackend, Policies));
+		}
+
+		ValidateAll(Test, TestStruct, TestStruct2);
+	}
+
+	void TestSaxDeserialization( FAutomationTestBase& Test, EStructSerializerBackendFlags Flags )
+	{
+		// serialization, FJsonStructSerializerBackend writes UCS2CHAR that is converted to UTF-8 for the SAX backend
+		FStructSerializerTestStruct TestStruct;
+		InitObjects(TestStruct);
+
+		TArray<uint8> Buffer;
+		{
+			FMemoryWriter Writer(Buffer);
+			FJsonStructSerializerBackend SerializerBackend(Writer, Flags);
+			FStructSerializer::Serialize(TestStruct, SerializerBackend);
+		}
+
+		FString Json;
+		Json.AppendChars((const UCS2CHAR*)Buffer.GetData(), Buffer.Num() / sizeof(UCS2CHAR));
+		FTCHARToUTF8 Utf8Json(*Json);
+
+		// deserialization
+		FStructSerializerTestStruct TestStruct2(NoInit);
+		{
+			FJsonSaxStructDeserializerBackend DeserializerBackend(FAnsiStringView(Utf8Json.Get(), Utf8Json.Length()));
+			FStructDeserializerPolicies Policies;
+			Policies.MissingFields = EStructDeserializerErrorPolicies::Warning;
+
+			Test.TestTrue(TEXT("Deserialization must succeed"), FStructDeserializer::Deserialize(TestStruct2, DeserializerBackend, Policies));
+		}
+
+		ValidateAll(Test, TestStruct, TestStruct2);
+	}
+
+	const EStructSerializerBackendFlags TypedArrayFlags = EStructSerializerBackendFlags::WriteNumericArraysAsTypedArrays | EStructSerializerBackendFlags::WriteStructArraysAsColumns;
+
+	void SerializeCbor( const FStructSerializerTypedArrays& Struct, EStructSerializerBackendFlags Flags, TArray<uint8>& OutBuffer )
+	{
+		FMemoryWriter Writer(OutBuffer);
+		FCborStructSerializerBackend SerializerBackend(Writer, Flags);
+		FStructSerializer::Serialize(Struct, SerializerBackend);
+	}
+
+	bool DeserializeCbor( const TArray<uint8>& Buffer, FStructSerializerTypedArrays& OutStruct, const FStructDeserializerPolicies& Policies = FStructDeserializerPolicies() )
+	{
+		FMemoryReader Reader(Buffer);
+		FCborStructDeserializerBackend DeserializerBackend(Reader);
+		return FStructDeserializer::Deserialize(OutStruct, DeserializerBackend, Policies);
+	}
+
+	void ValidateTypedArrays( FAutomationTestBase& Test, const FString& What, const FStructSerializerTypedArrays& Struct1, const FStructSerializerTypedArrays& Struct2 )
+	{
+		Test.TestTrue(What + TEXT(": values around the arrays must be the same before and after de-/serialization"), Struct2.Dummy1 == 1 && Struct2.Dummy2 == 2 && Struct2.Dummy3 == 3);
+		Test.TestTrue(What + TEXT(": TArray<uint16> must be the same before and after de-/serialization"), Struct1.UInt16Array == Struct2.UInt16Array);
+		Test.TestTrue(What + TEXT(": TArray<int64> must be the same before and after de-/serialization"), Struct1.Int64Array == Struct2.Int64Array);
+		Test.TestTrue(What + TEXT(": TArray<double> must be the same before and after de-/serialization"), Struct1.DoubleArray == Struct2.DoubleArray);
+		Test.TestTrue(What + TEXT(": TArray of structures of numbers must be the same before and after de-/serialization"), Struct1.ColumnArray == Struct2.ColumnArray);
+		Test.TestTrue(What + TEXT(": TArray<FVector> must be the same before and after de-/serialization"), Struct1.VectorArray == Struct2.VectorArray);
+	}
 }
 
 
@@ -577,6 +646,10 @@ bool FStructSerializerTest::RunTest( const FString& Parameters )
 		// uncomment this to look at the serialized data
 		//GLog->Logf(TEXT("%s"), (TCHAR*)Buffer.GetData());
 	}
+	// json read from UTF-8 by the SAX backend
+	{
+		StructSerializerTest::TestSaxDeserialization(*this, TestFlags);
+	}
 	// cbor
 	{
 		TArray<uint8> Buffer;
@@ -599,6 +672,28 @@ bool FStructSerializerTest::RunTest( const FString& Parameters )
 
 		StructSerializerTest::TestSerialization(*this, SerializerBackend, DeserializerBackend);
 	}
+	// cbor with typed arrays and arrays of structures written column by column
+	{
+		TArray<uint8> Buffer;
+		FMemoryReader Reader(Buffer);
+		FMemoryWriter Writer(Buffer);
+
+		FCborStructSerializerBackend SerializerBackend(Writer, TestFlags | StructSerializerTest::TypedArrayFlags);
+		FCborStructDeserializerBackend DeserializerBackend(Reader);
+
+		StructSerializerTest::TestSerialization(*this, SerializerBackend, DeserializerBackend);
+	}
+	// cbor with typed arrays and arrays of structures written column by column, standard compliant endianness (big endian)
+	{
+		TArray<uint8> Buffer;
+		FMemoryReader Reader(Buffer);
+		FMemoryWriter Writer(Buffer);
+
+		FCborStructSerializerBackend SerializerBackend(Writer, TestFlags | StructSerializerTest::TypedArrayFlags | EStructSerializerBackendFlags::WriteCborStandardEndianness);
+		FCborStructDeserializerBackend DeserializerBackend(Reader, ECborEndianness::StandardCompliant);
+
+		StructSerializerTest::TestSerialization(*this, SerializerBackend, DeserializerBackend);
+	}
 
 	return true;
 }
@@ -740,5 +835,165 @@ bool FStructSerializerCborByteArrayTest::RunTest( const FString& Parameters )
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructSerializerCborTypedArrayTest, "System.Core.Serialization.StructSerializerCborTypedArray", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FStructSerializerCborTypedArrayTest::RunTest( const FString& Parameters )
+{
+	using namespace StructSerializerTest;
+
+	const FStructSerializerTypedArrays WrittenStruct;
+
+	// Ensure numeric arrays and arrays of structures of numbers round trip, and are more compact than one CBOR item per value.
+	{
+		TArray<uint8> DefaultBuffer;
+		SerializeCbor(WrittenStruct, EStructSerializerBackendFlags::Default, DefaultBuffer);
+
+		TArray<uint8> Buffer;
+		SerializeCbor(WrittenStruct, EStructSerializerBackendFlags::Default | TypedArrayFlags, Buffer);
+		TestTrue(TEXT("Typed arrays must be more compact than CBOR arrays"), Buffer.Num() < DefaultBuffer.Num());
+
+		FStructSerializerTypedArrays ReadStruct(NoInit);
+		TestTrue(TEXT("Deserialization must succeed"), DeserializeCbor(Buffer, ReadStruct));
+		ValidateTypedArrays(*this, TEXT("Typed arrays"), WrittenStruct, ReadStruct);
+
+		// Data written without the flags is still read.
+		FStructSerializerTypedArrays ReadDefaultStruct(NoInit);
+		TestTrue(TEXT("Deserialization must succeed"), DeserializeCbor(DefaultBuffer, ReadDefaultStruct));
+		ValidateTypedArrays(*this, TEXT("CBOR arrays"), WrittenStruct, ReadDefaultStruct);
+	}
+
+	// Ensure empty arrays round trip.
+	{
+		FStructSerializerTypedArrays EmptyStruct(NoInit);
+		EmptyStruct.Dummy1 = 1;
+		EmptyStruct.Dummy2 = 2;
+		EmptyStruct.Dummy3 = 3;
+
+		TArray<uint8> Buffer;
+		SerializeCbor(EmptyStruct, EStructSerializerBackendFlags::Default | TypedArrayFlags, Buffer);
+
+		FStructSerializerTypedArrays ReadStruct(NoInit);
+		TestTrue(TEXT("Deserialization must succeed"), DeserializeCbor(Buffer, ReadStruct));
+		ValidateTypedArrays(*this, TEXT("Empty typed arrays"), EmptyStruct, ReadStruct);
+	}
+
+	// Ensure typed arrays and arrays of structures written column by column are skipped on deserialization if required by the policy.
+	{
+		TArray<uint8> Buffer;
+		SerializeCbor(WrittenStruct, EStructSerializerBackendFlags::Default | TypedArrayFlags, Buffer);
+
+		FStructDeserializerPolicies Policies;
+		Policies.PropertyFilter = [](const FProperty* CurrentProp, const FProperty* ParentProp)
+		{
+			return !CurrentProp->IsA<FArrayProperty>();
+		};
+
+		FStructSerializerTypedArrays ReadStruct(NoInit);
+		TestTrue(TEXT("Deserialization must succeed"), DeserializeCbor(Buffer, ReadStruct, Policies));
+		TestTrue(TEXT("Per deserializer policy, values around the arrays must be the same before and after de-/serialization"), ReadStruct.Dummy1 == 1 && ReadStruct.Dummy2 == 2 && ReadStruct.Dummy3 == 3);
+		TestTrue(TEXT("Per deserializer policy, the arrays must be skipped on deserialization"), ReadStruct.Int64Array.Num() == 0 && ReadStruct.ColumnArray.Num() == 0 && ReadStruct.VectorArray.Num() == 0);
+	}
+
+	// Ensure typed arrays in the other endianness than the platform one are byte swapped.
+	{
+		TArray<uint8> Buffer;
+		{
+			FMemoryWriter Writer(Buffer);
+			FCborWriter CborWriter(&Writer);
+
+			const uint64 ByteSwappedBit = 1 << 2;
+			TArray<int64> Int64Array;
+			for (int64 Value : WrittenStruct.Int64Array)
+			{
+				Int64Array.Add(ByteSwap(Value));
+			}
+
+			CborWriter.WriteContainerStart(ECborCode::Map, -1);
+			CborWriter.WriteValue(FString(TEXT("Int64Array")));
+			CborWriter.WriteTag(CborTypedArray::GetTag(ECborTypedArrayType::Int64) ^ ByteSwappedBit);
+			CborWriter.WriteValue(reinterpret_cast<const uint8*>(Int64Array.GetData()), Int64Array.Num() * sizeof(int64));
+
+			CborWriter.WriteValue(FString(TEXT("VectorArray")));
+			CborWriter.WriteTag(CborTypedArray::StructColumnsTag);
+			CborWriter.WriteContainerStart(ECborCode::Array, 2);
+			CborWriter.WriteValue((uint64)WrittenStruct.VectorArray.Num());
+			CborWriter.WriteContainerStart(ECborCode::Map, -1);
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				TArray<uint32> Column; // Byte swapped floats may not survive being loaded as floats
+				for (const FVector& Vector : WrittenStruct.VectorArray)
+				{
+					const float Value = Vector[Axis];
+					uint32 Bits;
+					FMemory::Memcpy(&Bits, &Value, sizeof(float));
+					Column.Add(ByteSwap(Bits));
+				}
+				CborWriter.WriteValue(FString::Printf(TEXT("%c"), TEXT('X') + Axis));
+				CborWriter.WriteTag(CborTypedArray::GetTag(ECborTypedArrayType::Float) ^ ByteSwappedBit);
+				CborWriter.WriteValue(reinterpret_cast<const uint8*>(Column.GetData()), Column.Num() * sizeof(float));
+			}
+			CborWriter.WriteContainerEnd();
+			CborWriter.WriteContainerEnd();
+		}
+
+		FStructDeserializerPolicies Policies;
+		Policies.MissingFields = EStructDeserializerErrorPolicies::Ignore;
+
+		FStructSerializerTypedArrays ReadStruct(NoInit);
+		TestTrue(TEXT("Deserialization must succeed"), DeserializeCbor(Buffer, ReadStruct, Policies));
+		TestTrue(TEXT("Byte swapped TArray<int64> must be the same before and after de-/serialization"), WrittenStruct.Int64Array == ReadStruct.Int64Array);
+		TestTrue(TEXT("Byte swapped TArray<FVector> must be the same before and after de-/serialization"), WrittenStruct.VectorArray == ReadStruct.VectorArray);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructSerializerCborTypedArrayPerfTest, "System.Core.Serialization.StructSerializerCborTypedArrayPerf", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FStructSerializerCborTypedArrayPerfTest::RunTest( const FString& Parameters )
+{
+	using namespace StructSerializerTest;
+
+	const int32 NumElements = 1 << 18;
+	FStructSerializerTypedArrays WrittenStruct;
+	WrittenStruct.UInt16Array.Reset(NumElements);
+	WrittenStruct.Int64Array.Reset(NumElements);
+	WrittenStruct.DoubleArray.Reset(NumElements);
+	WrittenStruct.ColumnArray.Reset(NumElements);
+	WrittenStruct.VectorArray.Reset(NumElements);
+	for (int32 Index = 0; Index < NumElements; ++Index)
+	{
+		WrittenStruct.UInt16Array.Add((uint16)Index);
+		WrittenStruct.Int64Array.Add((int64)Index * Index);
+		WrittenStruct.DoubleArray.Add(Index / 3.0);
+		WrittenStruct.ColumnArray.Emplace(Index);
+		WrittenStruct.VectorArray.Add(FVector(Index, Index * 0.5f, -Index));
+	}
+
+	auto Measure = [this, &WrittenStruct](const TCHAR* Name, EStructSerializerBackendFlags Flags)
+	{
+		TArray<uint8> Buffer;
+		double StartTime = FPlatformTime::Seconds();
+		SerializeCbor(WrittenStruct, Flags, Buffer);
+		const double EncodeTime = FPlatformTime::Seconds() - StartTime;
+
+		FStructSerializerTypedArrays ReadStruct(NoInit);
+		StartTime = FPlatformTime::Seconds();
+		const bool bDeserialized = DeserializeCbor(Buffer, ReadStruct);
+		const double DecodeTime = FPlatformTime::Seconds() - StartTime;
+
+		TestTrue(FString::Printf(TEXT("%s: deserialization must succeed"), Name), bDeserialized);
+		ValidateTypedArrays(*this, Name, WrittenStruct, ReadStruct);
+
+		const double MegaBytes = Buffer.Num() / (1024.0 * 1024.0);
+		AddInfo(FString::Printf(TEXT("%s: %d bytes, encode %.1f ms (%.1f MB/s), decode %.1f ms (%.1f MB/s)"), Name, Buffer.Num(), EncodeTime * 1000.0, MegaBytes / EncodeTime, DecodeTime * 1000.0, MegaBytes / DecodeTime));
+	};
+
+	Measure(TEXT("CBOR arrays"), EStructSerializerBackendFlags::Default);
+	Measure(TEXT("CBOR typed arrays and columns"), EStructSerializerBackendFlags::Default | TypedArrayFlags);
+
+	return true;
+}
+
 
 #endif //WITH_DEV_AUTOMATION_TESTS
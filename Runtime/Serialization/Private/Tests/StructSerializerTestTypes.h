@@ -284,6 +284,118 @@ struct FStructSerializerByteArray
 };
 
 
+/**
+ * Test structure for the elements of arrays of structures written column by column.
+ */
+USTRUCT()
+struct FStructSerializerColumnElement
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int8 Int8;
+
+	UPROPERTY()
+	uint8 UInt8;
+
+	UPROPERTY()
+	bool Bool;
+
+	UPROPERTY()
+	uint16 UInt16;
+
+	UPROPERTY()
+	int64 Int64;
+
+	UPROPERTY()
+	double Double;
+
+	FStructSerializerColumnElement()
+		: Int8(0)
+		, UInt8(0)
+		, Bool(false)
+		, UInt16(0)
+		, Int64(0)
+		, Double(0.0)
+	{ }
+
+	FStructSerializerColumnElement(int32 Index)
+		: Int8((int8)-Index)
+		, UInt8((uint8)Index)
+		, Bool((Index & 1) != 0)
+		, UInt16((uint16)(Index * 7))
+		, Int64(-(int64)Index << 40)
+		, Double(Index * 0.25)
+	{ }
+
+	bool operator==(const FStructSerializerColumnElement& Rhs) const
+	{
+		return Int8 == Rhs.Int8 && UInt8 == Rhs.UInt8 && Bool == Rhs.Bool && UInt16 == Rhs.UInt16 && Int64 == Rhs.Int64 && Double == Rhs.Double;
+	}
+};
+
+
+/**
+ * Test structure for numeric arrays written as CBOR typed arrays and arrays of structures written column by column.
+ */
+USTRUCT()
+struct FStructSerializerTypedArrays
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Dummy1; // To test 'skip array'.
+
+	UPROPERTY()
+	TArray<uint16> UInt16Array;
+
+	UPROPERTY()
+	TArray<int64> Int64Array;
+
+	UPROPERTY()
+	TArray<double> DoubleArray;
+
+	UPROPERTY()
+	int32 Dummy2; // To test 'skip array'.
+
+	UPROPERTY()
+	TArray<FStructSerializerColumnElement> ColumnArray;
+
+	UPROPERTY()
+	TArray<FVector> VectorArray;
+
+	UPROPERTY()
+	int32 Dummy3; // To test 'skip array'.
+
+	FStructSerializerTypedArrays()
+	{
+		Dummy1 = 1;
+		Dummy2 = 2;
+		Dummy3 = 3;
+
+		UInt16Array.Add(0);
+		UInt16Array.Add(65535);
+
+		Int64Array.Add(MIN_int64);
+		Int64Array.Add(-1);
+		Int64Array.Add(MAX_int64);
+
+		DoubleArray.Add(-1.0e300);
+		DoubleArray.Add(0.5);
+
+		for (int32 Index = 0; Index < 5; ++Index)
+		{
+			ColumnArray.Emplace(Index);
+		}
+
+		VectorArray.Add(FVector(1.0f, 2.0f, 3.0f));
+		VectorArray.Add(FVector(-1.0f, -2.0f, -3.0f));
+	}
+
+	FStructSerializerTypedArrays(ENoInit) { }
+};
+
+
 /**
  * Test structure for array properties.
  */
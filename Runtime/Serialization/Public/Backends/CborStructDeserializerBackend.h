@@ -35,6 +35,17 @@ public:
 	virtual void SkipStructure() override;
 
 private:
+	/**
+	 * Begins reading the item of a tag if it is a typed array or an array of structures written column by column.
+	 * @param Tag The tag of the last read context.
+	 * @param OutToken Set to ArrayStart, or Error if the array is malformed.
+	 * @return false if the item isn't a tagged array.
+	 */
+	bool ReadTaggedArray(uint64 Tag, EStructDeserializerBackendTokens& OutToken);
+
+	/** Reads the columns of an array of structures written column by column, returning false if they are malformed. */
+	bool ReadStructColumns();
+
 	/** Holds the Cbor reader used for the actual reading of the archive. */
 	FCborReader CborReader;
 
@@ -49,4 +60,41 @@ private:
 
 	/** Whether a TArray<uint8>/TArray<int8> property is being deserialized. */
 	bool bDeserializingByteArray = false;
+
+	/** The type of the elements of the typed array being deserialized, held by the last context. */
+	ECborTypedArrayType TypedArrayType = ECborTypedArrayType::Uint8;
+
+	/** Whether the elements of the typed array being deserialized are stored in the other endianness than the platform one. */
+	bool bTypedArrayByteSwapped = false;
+
+	/** The index of the next element of the typed array to deserialize. */
+	int32 DeserializingTypedArrayIndex = 0;
+
+	/** Whether a numeric array property written as a typed array is being deserialized. */
+	bool bDeserializingTypedArray = false;
+
+	/** Holds the values of a property of the structures of an array written column by column. */
+	struct FStructColumn
+	{
+		FString Name;
+		ECborTypedArrayType Type;
+		bool bByteSwapped;
+		/** The byte string holding the values. */
+		FCborContext Values;
+	};
+
+	/** Holds the columns of the array of structures being deserialized. */
+	TArray<FStructColumn> StructColumns;
+
+	/** The number of structures held by the columns. */
+	int32 NumStructColumnElements = 0;
+
+	/** The index of the structure being deserialized. */
+	int32 DeserializingStructColumnElement = 0;
+
+	/** The index of the column following the property being deserialized, INDEX_NONE before the structure starts. */
+	int32 DeserializingStructColumn = INDEX_NONE;
+
+	/** Whether an array of structures written column by column is being deserialized. */
+	bool bDeserializingStructColumns = false;
 };
@@ -44,6 +44,9 @@ public:
 	virtual void WriteProperty(const FStructSerializerState& State, int32 ArrayIndex = 0) override;
 
 private:
+	/** Accumulates the value of a property of a structure of an array written column by column. */
+	void WriteStructColumnValue(const FStructSerializerState& State, int32 ArrayIndex);
+
 	/** Holds the Cbor writer used for the actual serialization. */
 	FCborWriter CborWriter;
 
@@ -55,4 +58,27 @@ private:
 
 	/** Whether the serializer is encoding array of uint8/int8 */
 	bool bSerializingByteArray = false;
+
+	/** Whether the serializer is encoding a numeric array, which is written as a typed array when it begins. */
+	bool bSerializingTypedArray = false;
+
+	/** Holds the values of a property of the structures of an array written column by column. */
+	struct FStructColumn
+	{
+		FProperty* Property;
+		ECborTypedArrayType Type;
+		TArray<uint8> Values;
+	};
+
+	/** Stores the columns accumulated when writing an array of structures column by column. */
+	TArray<FStructColumn> StructColumns;
+
+	/** The number of structures accumulated in the columns. */
+	int32 NumStructColumnElements = 0;
+
+	/** The column expected to receive the next property of the current structure, as properties come in the same order for every element. */
+	int32 NextStructColumn = 0;
+
+	/** Whether the serializer is encoding an array of structures column by column. */
+	bool bSerializingStructColumns = false;
 };
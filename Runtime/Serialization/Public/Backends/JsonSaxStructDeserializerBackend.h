@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonSaxReader.h"
+#include "IStructDeserializerBackend.h"
+
+/**
+ * Implements a reader for UStruct deserialization from UTF-8 Json using FJsonSaxReader.
+ *
+ * Unlike FJsonStructDeserializerBackend, which reads UCS2CHAR Json from an archive one character at a time,
+ * it reads the buffer in place, only converts the strings of the properties it sets, and skips filtered out
+ * structures and arrays without tokenizing them. The buffer must outlive the backend.
+ */
+class SERIALIZATION_API FJsonSaxStructDeserializerBackend
+	: public IStructDeserializerBackend
+{
+public:
+
+	/**
+	 * Creates and initializes a new instance.
+	 *
+	 * @param Json The UTF-8 Json text to deserialize from.
+	 */
+	FJsonSaxStructDeserializerBackend( FAnsiStringView Json )
+		: JsonReader(Json)
+		, LastNotation(EJsonNotation::Error)
+	{ }
+
+public:
+
+	// IStructDeserializerBackend interface
+
+	virtual const FString& GetCurrentPropertyName() const override;
+	virtual FString GetDebugString() const override;
+	virtual const FString& GetLastErrorMessage() const override;
+	virtual bool GetNextToken( EStructDeserializerBackendTokens& OutToken ) override;
+	virtual bool ReadProperty( FProperty* Property, FProperty* Outer, void* Data, int32 ArrayIndex ) override;
+	virtual void SkipArray() override;
+	virtual void SkipStructure() override;
+
+private:
+
+	/** Holds the Json reader used for the actual reading of the buffer. */
+	FJsonSaxReader JsonReader;
+
+	/** Holds the name of the last read Json identifier, converted to TCHAR. */
+	FString CurrentPropertyName;
+
+	/** Holds the last read Json notation. */
+	EJsonNotation LastNotation;
+};
@@ -33,6 +33,18 @@ enum class EStructSerializerBackendFlags
 	 */
 	WriteCborStandardEndianness = 1 << 2,
 
+	/**
+	 * Write TArray of 16, 32 and 64 bit integers, floats and doubles as CBOR typed arrays (RFC 8746), a byte string of the elements
+	 * in the platform endianness tagged with their type, instead of one CBOR item per element. Caller must be opt-in.
+	 */
+	WriteNumericArraysAsTypedArrays = 1 << 3,
+
+	/**
+	 * Write TArray of structures whose properties are all numbers or bools (like FVector) column by column, as one CBOR typed array
+	 * per property, instead of one CBOR map per element. Caller must be opt-in, and the data can only be read back by Unreal.
+	 */
+	WriteStructArraysAsColumns = 1 << 4,
+
 	/**
 	 * Legacy settings for backwards compatibility with code compiled prior to 4.22.
 	 */